@@ -91,6 +91,8 @@
 #  MAGNUM_BUILD_DEPRECATED      - Defined if compiled with deprecated APIs
 #   included
 #  MAGNUM_BUILD_STATIC          - Defined if compiled as static libraries
+#  MAGNUM_BUILD_MULTITHREADED   - Defined if compiled with multithreading
+#   support in parallelized algorithms
 #  MAGNUM_TARGET_GLES           - Defined if compiled for OpenGL ES
 #  MAGNUM_TARGET_GLES2          - Defined if compiled for OpenGL ES 2.0
 #  MAGNUM_TARGET_GLES3          - Defined if compiled for OpenGL ES 3.0
@@ -193,6 +195,7 @@ file(READ ${MAGNUM_INCLUDE_DIR}/Magnum/configure.h _magnumConfigure)
 set(_magnumFlags
     BUILD_DEPRECATED
     BUILD_STATIC
+    BUILD_MULTITHREADED
     TARGET_GLES
     TARGET_GLES2
     TARGET_GLES3
@@ -475,11 +478,23 @@ foreach(component ${Magnum_FIND_COMPONENTS})
     elseif(${component} STREQUAL MeshTools)
         set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES CompressIndices.h)
 
+        # Parallelized algorithms
+        if(MAGNUM_BUILD_MULTITHREADED)
+            find_package(Threads REQUIRED)
+            set(_MAGNUM_${_COMPONENT}_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+        endif()
+
     # Primitives library
     elseif(${component} STREQUAL Primitives)
         set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES Cube.h)
 
-    # No special setup for SceneGraph library
+    # Scene graph library
+    elseif(${component} STREQUAL SceneGraph)
+        # Parallel animation steps
+        if(MAGNUM_BUILD_MULTITHREADED)
+            find_package(Threads REQUIRED)
+            set(_MAGNUM_${_COMPONENT}_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+        endif()
     # No special setup for Shaders library
     # No special setup for Shapes library
     # No special setup for Text library
@@ -53,7 +53,7 @@ struct MeshState {
     #endif
 
     #ifdef MAGNUM_TARGET_GLES
-    void(*multiDrawImplementation)(std::initializer_list<std::reference_wrapper<MeshView>>);
+    void(*multiDrawImplementation)(Containers::ArrayView<const std::reference_wrapper<MeshView>>);
     #endif
 
     GLuint currentVAO;
@@ -0,0 +1,175 @@
+#ifndef Magnum_Implementation_parallelFor_h
+#define Magnum_Implementation_parallelFor_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+
+#include "Magnum/Types.h"
+
+#ifdef MAGNUM_BUILD_MULTITHREADED
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#endif
+
+namespace Magnum { namespace Implementation {
+
+/* Begin of i-th out of n contiguous ranges splitting [0, count), the
+   remainder is distributed among the first ranges */
+inline std::size_t parallelForRangeBegin(std::size_t count, std::size_t n, std::size_t i) {
+    return i*(count/n) + (i < count%n ? i : count%n);
+}
+
+/* Splits [0, count) into at most threadCount contiguous ranges and calls
+   f(begin, end) on each of them in parallel, the first range is processed on
+   the calling thread. Zero thread count means hardware concurrency. Returns
+   after all ranges are processed. Without multithreading support the whole
+   range is processed on the calling thread. The threads are created and
+   joined on every call, use WorkerPool for work repeated every frame. */
+template<class F> void parallelFor(std::size_t count, UnsignedInt threadCount, F&& f) {
+    if(!count) return;
+
+    #ifdef MAGNUM_BUILD_MULTITHREADED
+    if(!threadCount) threadCount = std::thread::hardware_concurrency();
+    if(threadCount > count) threadCount = UnsignedInt(count);
+
+    if(threadCount > 1) {
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount - 1);
+
+        for(std::size_t i = 1; i != threadCount; ++i) {
+            const std::size_t begin = parallelForRangeBegin(count, threadCount, i);
+            const std::size_t end = parallelForRangeBegin(count, threadCount, i + 1);
+            threads.emplace_back([&f, begin, end]() { f(begin, end); });
+        }
+
+        f(std::size_t(0), parallelForRangeBegin(count, threadCount, 1));
+        for(std::thread& thread: threads) thread.join();
+        return;
+    }
+    #else
+    static_cast<void>(threadCount);
+    #endif
+
+    f(std::size_t(0), count);
+}
+
+#ifdef MAGNUM_BUILD_MULTITHREADED
+/* Set of threads living for the whole lifetime of the pool, sleeping on a
+   condition variable between calls to run(). Same semantics as parallelFor(),
+   but without the thread creation overhead on every call. */
+class WorkerPool {
+    public:
+        /* Zero thread count means hardware concurrency, the calling thread
+           is counted as one of the threads */
+        explicit WorkerPool(UnsignedInt threadCount): _generation{}, _count{}, _rangeCount{}, _pending{}, _quit{false}, _function{}, _state{} {
+            if(!threadCount) threadCount = std::thread::hardware_concurrency();
+            if(threadCount > 1) _threads.reserve(threadCount - 1);
+            for(std::size_t i = 1; i < threadCount; ++i)
+                _threads.emplace_back([this, i]() { work(i); });
+        }
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        ~WorkerPool() {
+            {
+                std::lock_guard<std::mutex> lock{_mutex};
+                _quit = true;
+            }
+            _start.notify_all();
+            for(std::thread& thread: _threads) thread.join();
+        }
+
+        UnsignedInt threadCount() const { return UnsignedInt(_threads.size() + 1); }
+
+        template<class F> void run(std::size_t count, F&& f) {
+            if(!count) return;
+
+            const std::size_t rangeCount = count < _threads.size() + 1 ? count : _threads.size() + 1;
+            if(rangeCount == 1) {
+                f(std::size_t(0), count);
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock{_mutex};
+                _count = count;
+                _rangeCount = rangeCount;
+                _pending = rangeCount - 1;
+                _function = [](void* state, std::size_t begin, std::size_t end) {
+                    (*static_cast<typename std::remove_reference<F>::type*>(state))(begin, end);
+                };
+                _state = &f;
+                ++_generation;
+            }
+            _start.notify_all();
+
+            f(std::size_t(0), parallelForRangeBegin(count, rangeCount, 1));
+
+            std::unique_lock<std::mutex> lock{_mutex};
+            _done.wait(lock, [this]() { return !_pending; });
+        }
+
+    private:
+        void work(const std::size_t i) {
+            std::size_t generation = 0;
+            std::unique_lock<std::mutex> lock{_mutex};
+            for(;;) {
+                _start.wait(lock, [this, generation]() { return _quit || _generation != generation; });
+                if(_quit) return;
+                generation = _generation;
+
+                /* Not needed for this call */
+                if(i >= _rangeCount) continue;
+
+                const std::size_t begin = parallelForRangeBegin(_count, _rangeCount, i);
+                const std::size_t end = parallelForRangeBegin(_count, _rangeCount, i + 1);
+                void(*const function)(void*, std::size_t, std::size_t) = _function;
+                void* const state = _state;
+                lock.unlock();
+                function(state, begin, end);
+                lock.lock();
+
+                if(!--_pending) _done.notify_one();
+            }
+        }
+
+        std::mutex _mutex;
+        std::condition_variable _start, _done;
+        std::size_t _generation, _count, _rangeCount, _pending;
+        bool _quit;
+        void(*_function)(void*, std::size_t, std::size_t);
+        void* _state;
+        std::vector<std::thread> _threads;
+};
+#endif
+
+}}
+
+#endif
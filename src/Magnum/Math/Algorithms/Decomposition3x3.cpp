@@ -0,0 +1,167 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Decomposition3x3.h"
+
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Implementation/lanes.h"
+
+namespace Magnum { namespace Math { namespace Algorithms {
+
+namespace {
+
+using Math::Implementation::Lanes;
+
+static_assert(sizeof(Matrix<3, Float>) == 9*sizeof(Float), "unexpected matrix layout");
+static_assert(sizeof(Vector3<Float>) == 3*sizeof(Float), "unexpected vector layout");
+
+/* Four matrices, column-major, one matrix in each lane. The last incomplete
+   batch goes through a zero-padded temporary. */
+void loadMatrices(const Matrix<3, Float>* const matrices, const std::size_t count, Lanes(&out)[3][3]) {
+    Matrix<3, Float> padded[4]{Matrix<3, Float>{ZeroInit}, Matrix<3, Float>{ZeroInit}, Matrix<3, Float>{ZeroInit}, Matrix<3, Float>{ZeroInit}};
+    const Float* data = matrices->data();
+    if(count != 4) {
+        std::copy(matrices, matrices + count, padded);
+        data = padded->data();
+    }
+
+    for(std::size_t col = 0; col != 3; ++col)
+        for(std::size_t row = 0; row != 3; ++row)
+            out[col][row] = Math::Implementation::loadStrided(data + col*3 + row, 9);
+}
+
+void storeMatrices(const Lanes(&in)[3][3], Matrix<3, Float>* const matrices, const std::size_t count) {
+    Matrix<3, Float> padded[4];
+    Float* const data = count == 4 ? matrices->data() : padded->data();
+
+    for(std::size_t col = 0; col != 3; ++col)
+        for(std::size_t row = 0; row != 3; ++row)
+            Math::Implementation::storeStrided(in[col][row], data + col*3 + row, 9);
+
+    if(count != 4) std::copy(padded, padded + count, matrices);
+}
+
+void storeVectors(const Lanes(&in)[3], Vector3<Float>* const vectors, const std::size_t count) {
+    Vector3<Float> padded[4];
+    Float* const data = count == 4 ? vectors->data() : padded->data();
+
+    for(std::size_t i = 0; i != 3; ++i)
+        Math::Implementation::storeStrided(in[i], data + i, 3);
+
+    if(count != 4) std::copy(padded, padded + count, vectors);
+}
+
+void symmetricEigen3x3(Lanes(&a)[6], Lanes(&v)[3][3]) {
+    for(std::size_t col = 0; col != 3; ++col)
+        for(std::size_t row = 0; row != 3; ++row)
+            v[col][row] = Lanes{col == row ? 1.0f : 0.0f};
+
+    for(std::size_t i = 0; i != Implementation::BatchSweeps; ++i)
+        Implementation::jacobiSweep(a, v);
+
+    Implementation::sortEigen(a, v);
+}
+
+/* The matrix is normalized in place so m^T m doesn't underflow or overflow,
+   the singular values are then scaled back */
+void svd3x3(Lanes(&m)[3][3], Lanes(&u)[3][3], Lanes(&w)[3], Lanes(&v)[3][3]) {
+    const Lanes scale = Implementation::normalizationScale(&m[0][0], 9);
+    Implementation::multiply(&m[0][0], 9, Lanes{1.0f}/scale);
+
+    Lanes a[6];
+    Implementation::normalMatrix(m, a);
+    symmetricEigen3x3(a, v);
+    Implementation::svdFromEigenvectors(m, v, u, w);
+    Implementation::multiply(w, 3, scale);
+}
+
+}
+
+void symmetricEigen3x3Into(const Corrade::Containers::ArrayView<const Matrix<3, Float>> matrices, const Corrade::Containers::ArrayView<Matrix<3, Float>> eigenvectors, const Corrade::Containers::ArrayView<Vector3<Float>> eigenvalues) {
+    CORRADE_ASSERT(matrices.size() == eigenvectors.size() && matrices.size() == eigenvalues.size(),
+        "Math::Algorithms::symmetricEigen3x3Into(): array sizes don't match, got" << matrices.size() << eigenvectors.size() << "and" << eigenvalues.size(), );
+
+    for(std::size_t i = 0; i < matrices.size(); i += 4) {
+        const std::size_t count = std::min(matrices.size() - i, std::size_t{4});
+
+        Lanes m[3][3], v[3][3];
+        loadMatrices(matrices.data() + i, count, m);
+        Lanes a[6]{m[0][0], m[1][1], m[2][2], m[0][1], m[0][2], m[1][2]};
+        const Lanes scale = Implementation::normalizationScale(a, 6);
+        Implementation::multiply(a, 6, Lanes{1.0f}/scale);
+        symmetricEigen3x3(a, v);
+
+        const Lanes lambda[3]{a[0]*scale, a[1]*scale, a[2]*scale};
+        storeMatrices(v, eigenvectors.data() + i, count);
+        storeVectors(lambda, eigenvalues.data() + i, count);
+    }
+}
+
+void svd3x3Into(const Corrade::Containers::ArrayView<const Matrix<3, Float>> matrices, const Corrade::Containers::ArrayView<Matrix<3, Float>> u, const Corrade::Containers::ArrayView<Vector3<Float>> w, const Corrade::Containers::ArrayView<Matrix<3, Float>> v) {
+    CORRADE_ASSERT(matrices.size() == u.size() && matrices.size() == w.size() && matrices.size() == v.size(),
+        "Math::Algorithms::svd3x3Into(): array sizes don't match, got" << matrices.size() << u.size() << w.size() << "and" << v.size(), );
+
+    for(std::size_t i = 0; i < matrices.size(); i += 4) {
+        const std::size_t count = std::min(matrices.size() - i, std::size_t{4});
+
+        Lanes m[3][3], uLanes[3][3], wLanes[3], vLanes[3][3];
+        loadMatrices(matrices.data() + i, count, m);
+        svd3x3(m, uLanes, wLanes, vLanes);
+
+        storeMatrices(uLanes, u.data() + i, count);
+        storeVectors(wLanes, w.data() + i, count);
+        storeMatrices(vLanes, v.data() + i, count);
+    }
+}
+
+void polarDecomposition3x3Into(const Corrade::Containers::ArrayView<const Matrix<3, Float>> matrices, const Corrade::Containers::ArrayView<Matrix<3, Float>> rotations, const Corrade::Containers::ArrayView<Matrix<3, Float>> stretches) {
+    CORRADE_ASSERT(matrices.size() == rotations.size() && matrices.size() == stretches.size(),
+        "Math::Algorithms::polarDecomposition3x3Into(): array sizes don't match, got" << matrices.size() << rotations.size() << "and" << stretches.size(), );
+
+    for(std::size_t i = 0; i < matrices.size(); i += 4) {
+        const std::size_t count = std::min(matrices.size() - i, std::size_t{4});
+
+        Lanes m[3][3], u[3][3], w[3], v[3][3];
+        loadMatrices(matrices.data() + i, count, m);
+        svd3x3(m, u, w, v);
+
+        /* R = U V^T, S = V Σ V^T */
+        Lanes r[3][3], s[3][3];
+        for(std::size_t col = 0; col != 3; ++col) {
+            for(std::size_t row = 0; row != 3; ++row) {
+                r[col][row] = u[0][row]*v[0][col] + u[1][row]*v[1][col] + u[2][row]*v[2][col];
+                s[col][row] = v[0][row]*w[0]*v[0][col] + v[1][row]*w[1]*v[1][col] + v[2][row]*w[2]*v[2][col];
+            }
+        }
+
+        storeMatrices(r, rotations.data() + i, count);
+        storeMatrices(s, stretches.data() + i, count);
+    }
+}
+
+}}}
@@ -0,0 +1,344 @@
+#ifndef Magnum_Math_Algorithms_Decomposition3x3_h
+#define Magnum_Math_Algorithms_Decomposition3x3_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::Algorithms::symmetricEigen3x3(), @ref Magnum::Math::Algorithms::svd3x3(), @ref Magnum::Math::Algorithms::polarDecomposition3x3(), @ref Magnum::Math::Algorithms::symmetricEigen3x3Into(), @ref Magnum::Math::Algorithms::svd3x3Into(), @ref Magnum::Math::Algorithms::polarDecomposition3x3Into()
+ */
+
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace Math { namespace Algorithms {
+
+namespace Implementation {
+
+/* The kernels below are written for both scalar types and SIMD lanes of the
+   batch variants, these are the scalar counterparts of the lane operations
+   that don't have any equivalent in Functions.h */
+template<class T> inline T flipSign(T a, T signSource) {
+    return std::signbit(signSource) ? -a : a;
+}
+
+template<class T> inline T selectLess(T a, T b, T ifTrue, T ifFalse) {
+    return a < b ? ifTrue : ifFalse;
+}
+
+/* Values smaller than this are treated as zero. Close to the smallest normal
+   float so it works also for squared values. */
+constexpr Float Tiny = 1.0e-36f;
+
+/* Fixed count of Jacobi sweeps in the batch variants, enough to converge to
+   float precision for any input */
+constexpr std::size_t BatchSweeps = 4;
+
+/* Largest absolute value of given values, used to bring them close to one
+   so their squares don't underflow or overflow. Zero is replaced with one. */
+template<class S> S normalizationScale(const S* const values, const std::size_t count) {
+    S scale = abs(values[0]);
+    for(std::size_t i = 1; i != count; ++i)
+        scale = max(scale, abs(values[i]));
+    return selectLess(scale, S(Tiny), S(1), scale);
+}
+
+template<class S> void multiply(S* const values, const std::size_t count, const S factor) {
+    for(std::size_t i = 0; i != count; ++i)
+        values[i] = values[i]*factor;
+}
+
+/* Jacobi rotation zeroing the apq element of a symmetric matrix, r being the
+   remaining index. The tangent t of the rotation angle is the smaller root of
+   t^2 + 2t(aqq - app)/(2apq) - 1 = 0, written without division by apq and
+   clamped to handle (nearly) zero apq without branching. Columns p and q of
+   v are rotated to accumulate the eigenvectors. */
+template<class S> void jacobiRotation(S& app, S& aqq, S& apq, S& arp, S& arq, S* const vp, S* const vq) {
+    const S tau = aqq - app;
+    const S twoApq = apq + apq;
+    const S denominator = max(abs(tau) + sqrt(tau*tau + twoApq*twoApq), S(Tiny));
+    const S t = min(max(flipSign(twoApq, tau)/denominator, S(-1)), S(1));
+    const S c = sqrtInverted(S(1) + t*t);
+    const S s = t*c;
+
+    app = app - t*apq;
+    aqq = aqq + t*apq;
+    apq = S(0);
+
+    const S rp = arp, rq = arq;
+    arp = c*rp - s*rq;
+    arq = s*rp + c*rq;
+
+    for(std::size_t i = 0; i != 3; ++i) {
+        const S p = vp[i], q = vq[i];
+        vp[i] = c*p - s*q;
+        vq[i] = s*p + c*q;
+    }
+}
+
+/* Symmetric matrix is stored as {a00, a11, a22, a01, a02, a12}, v is
+   column-major */
+template<class S> void jacobiSweep(S(&a)[6], S(&v)[3][3]) {
+    jacobiRotation(a[0], a[1], a[3], a[4], a[5], v[0], v[1]);
+    jacobiRotation(a[0], a[2], a[4], a[3], a[5], v[0], v[2]);
+    jacobiRotation(a[1], a[2], a[5], a[3], a[4], v[1], v[2]);
+}
+
+/* Swaps eigenvalue i with j and the corresponding eigenvectors if the first
+   is smaller. One of the vectors is negated to keep the eigenvector matrix a
+   rotation. */
+template<class S> void sortEigenPair(S& ai, S& aj, S* const vi, S* const vj) {
+    const S i = ai, j = aj;
+    ai = selectLess(i, j, j, i);
+    aj = selectLess(i, j, i, j);
+    for(std::size_t k = 0; k != 3; ++k) {
+        const S a = vi[k], b = vj[k];
+        vi[k] = selectLess(i, j, b, a);
+        vj[k] = selectLess(i, j, -a, b);
+    }
+}
+
+template<class S> void sortEigen(S(&a)[6], S(&v)[3][3]) {
+    sortEigenPair(a[0], a[1], v[0], v[1]);
+    sortEigenPair(a[0], a[2], v[0], v[2]);
+    sortEigenPair(a[1], a[2], v[1], v[2]);
+}
+
+/* Givens rotation zeroing element in column i and row j of b using rows i
+   and j, accumulating the transposed rotation into columns i and j of q */
+template<class S> void givensRotation(S(&b)[3][3], S(&q)[3][3], const std::size_t i, const std::size_t j) {
+    const S x = b[i][i], y = b[i][j];
+    const S lengthSquared = x*x + y*y;
+    const S lengthInverted = sqrtInverted(max(lengthSquared, S(Tiny)));
+    const S c = selectLess(lengthSquared, S(Tiny), S(1), x*lengthInverted);
+    const S s = selectLess(lengthSquared, S(Tiny), S(0), y*lengthInverted);
+
+    for(std::size_t k = 0; k != 3; ++k) {
+        const S bi = b[k][i], bj = b[k][j];
+        b[k][i] = c*bi + s*bj;
+        b[k][j] = c*bj - s*bi;
+    }
+
+    for(std::size_t k = 0; k != 3; ++k) {
+        const S qi = q[i][k], qj = q[j][k];
+        q[i][k] = c*qi + s*qj;
+        q[j][k] = c*qj - s*qi;
+    }
+}
+
+/* Given matrix m and sorted eigenvectors v of its m^T m, orthogonalizes
+   m v using Givens QR decomposition. Q is then the left singular vector
+   matrix and diagonal of R are the singular values. */
+template<class S> void svdFromEigenvectors(const S(&m)[3][3], const S(&v)[3][3], S(&u)[3][3], S(&w)[3]) {
+    S b[3][3];
+    for(std::size_t col = 0; col != 3; ++col)
+        for(std::size_t row = 0; row != 3; ++row)
+            b[col][row] = m[0][row]*v[col][0] + m[1][row]*v[col][1] + m[2][row]*v[col][2];
+
+    for(std::size_t col = 0; col != 3; ++col)
+        for(std::size_t row = 0; row != 3; ++row)
+            u[col][row] = S(col == row ? 1 : 0);
+
+    givensRotation(b, u, 0, 1);
+    givensRotation(b, u, 0, 2);
+    givensRotation(b, u, 1, 2);
+
+    w[0] = b[0][0];
+    w[1] = b[1][1];
+    w[2] = b[2][2];
+}
+
+template<class S> void normalMatrix(const S(&m)[3][3], S(&a)[6]) {
+    a[0] = m[0][0]*m[0][0] + m[0][1]*m[0][1] + m[0][2]*m[0][2];
+    a[1] = m[1][0]*m[1][0] + m[1][1]*m[1][1] + m[1][2]*m[1][2];
+    a[2] = m[2][0]*m[2][0] + m[2][1]*m[2][1] + m[2][2]*m[2][2];
+    a[3] = m[0][0]*m[1][0] + m[0][1]*m[1][1] + m[0][2]*m[1][2];
+    a[4] = m[0][0]*m[2][0] + m[0][1]*m[2][1] + m[0][2]*m[2][2];
+    a[5] = m[1][0]*m[2][0] + m[1][1]*m[2][1] + m[1][2]*m[2][2];
+}
+
+/* Iterates until the off-diagonal part vanishes relative to the matrix
+   norm, unlike the batch variants which do a fixed count of sweeps. Expects
+   the values to be normalized. */
+template<class T> void symmetricEigen3x3(T(&a)[6], T(&v)[3][3]) {
+    constexpr std::size_t MaxSweeps = 16;
+    const T epsilon = std::numeric_limits<T>::epsilon();
+    const T norm = a[0]*a[0] + a[1]*a[1] + a[2]*a[2] + T(2)*(a[3]*a[3] + a[4]*a[4] + a[5]*a[5]);
+
+    for(std::size_t col = 0; col != 3; ++col)
+        for(std::size_t row = 0; row != 3; ++row)
+            v[col][row] = T(col == row ? 1 : 0);
+
+    for(std::size_t i = 0; i != MaxSweeps; ++i) {
+        if(a[3]*a[3] + a[4]*a[4] + a[5]*a[5] <= epsilon*epsilon*norm) break;
+        jacobiSweep(a, v);
+    }
+
+    sortEigen(a, v);
+}
+
+template<class T> void toArray(const Matrix<3, T>& matrix, T(&out)[3][3]) {
+    for(std::size_t col = 0; col != 3; ++col)
+        for(std::size_t row = 0; row != 3; ++row)
+            out[col][row] = matrix[col][row];
+}
+
+template<class T> Matrix<3, T> fromArray(const T(&in)[3][3]) {
+    Matrix<3, T> out{ZeroInit};
+    for(std::size_t col = 0; col != 3; ++col)
+        for(std::size_t row = 0; row != 3; ++row)
+            out[col][row] = in[col][row];
+    return out;
+}
+
+}
+
+/**
+@{ @name 3x3 matrix decompositions
+
+Specialized variants of @ref svd() for 3x3 matrices, useful e.g. for
+extracting rotation from deformed transformations in shape matching or for
+computing oriented bounding boxes from covariance matrices. All of them are
+based on cyclic Jacobi eigenvalue algorithm, which for 3x3 matrices converges
+in a few sweeps. The SVD is computed from eigendecomposition of @f$ M^T M @f$
+followed by QR decomposition using Givens rotations, as described in
+*McAdams, A.; Selle, A.; Tamstorf, R.; Teran, J.; Sifakis, E. (2011).
+"Computing the Singular Value Decomposition of 3x3 matrices with minimal
+branching and elementary floating point operations"*. Unlike @ref svd(), the
+singular vector matrices are always rotations, which means that the last
+singular value is negative if the decomposed matrix contains a reflection.
+
+The `*Into()` variants process many @ref Magnum::Float "Float" matrices at
+once. The data are internally transposed to structure-of-arrays layout and
+processed four at a time with a fixed count of Jacobi sweeps and without any
+branching, with SSE2 if the library is compiled with it enabled. All arrays
+are expected to have the same size.
+*/
+
+/**
+@brief Eigendecomposition of symmetric 3x3 matrix
+
+Returns matrix with eigenvectors in columns and corresponding eigenvalues
+sorted from the largest. The eigenvector matrix is a rotation. Expects that
+the matrix is symmetric, only values below the diagonal are used. The matrix
+can be reconstructed as following:
+@code
+Matrix3x3 v;
+Vector3 lambda;
+std::tie(v, lambda) = Math::Algorithms::symmetricEigen3x3(m);
+
+// v*Matrix3x3::fromDiagonal(lambda)*v.transposed() == m
+@endcode
+@see @ref symmetricEigen3x3Into()
+*/
+template<class T> std::pair<Matrix<3, T>, Vector3<T>> symmetricEigen3x3(const Matrix<3, T>& matrix) {
+    T a[6]{matrix[0][0], matrix[1][1], matrix[2][2], matrix[0][1], matrix[0][2], matrix[1][2]};
+    const T scale = Implementation::normalizationScale(a, 6);
+    Implementation::multiply(a, 6, T(1)/scale);
+
+    T v[3][3];
+    Implementation::symmetricEigen3x3(a, v);
+    return {Implementation::fromArray(v), Vector3<T>{a[0], a[1], a[2]}*scale};
+}
+
+/**
+@brief Singular value decomposition of 3x3 matrix
+
+Returns @f$ U @f$, diagonal of @f$ \Sigma @f$ and non-transposed @f$ V @f$ so
+@f$ M = U \Sigma V^T @f$. Singular values are sorted by absolute value from
+the largest, both @f$ U @f$ and @f$ V @f$ are rotations and the last singular
+value is negative if determinant of the matrix is negative. The matrix can be
+reconstructed as following:
+@code
+Matrix3x3 u, v;
+Vector3 w;
+std::tie(u, w, v) = Math::Algorithms::svd3x3(m);
+
+// u*Matrix3x3::fromDiagonal(w)*v.transposed() == m
+@endcode
+@see @ref svd3x3Into(), @ref svd()
+*/
+template<class T> std::tuple<Matrix<3, T>, Vector3<T>, Matrix<3, T>> svd3x3(const Matrix<3, T>& matrix) {
+    T m[3][3];
+    Implementation::toArray(matrix, m);
+    const T scale = Implementation::normalizationScale(&m[0][0], 9);
+    Implementation::multiply(&m[0][0], 9, T(1)/scale);
+
+    T a[6], u[3][3], v[3][3], w[3];
+    Implementation::normalMatrix(m, a);
+    Implementation::symmetricEigen3x3(a, v);
+    Implementation::svdFromEigenvectors(m, v, u, w);
+    return std::make_tuple(Implementation::fromArray(u), Vector3<T>{w[0], w[1], w[2]}*scale, Implementation::fromArray(v));
+}
+
+/**
+@brief Polar decomposition of 3x3 matrix
+
+Returns rotation @f$ R @f$ and symmetric stretch @f$ S @f$ so @f$ M = R S @f$.
+Calculated from the SVD as @f$ R = U V^T @f$ and
+@f$ S = V \Sigma V^T @f$. The rotation is always a proper rotation, if the
+matrix contains a reflection, it is included in the stretch matrix.
+@see @ref polarDecomposition3x3Into(), @ref svd3x3()
+*/
+template<class T> std::pair<Matrix<3, T>, Matrix<3, T>> polarDecomposition3x3(const Matrix<3, T>& matrix) {
+    Matrix<3, T> u, v;
+    Vector3<T> w;
+    std::tie(u, w, v) = svd3x3(matrix);
+    const Matrix<3, T> vTransposed = v.transposed();
+    return {u*vTransposed, v*Matrix<3, T>::fromDiagonal(w)*vTransposed};
+}
+
+/**
+@brief Batch eigendecomposition of symmetric 3x3 matrices
+
+Equivalent to calling @ref symmetricEigen3x3() on each matrix.
+*/
+void MAGNUM_EXPORT symmetricEigen3x3Into(Corrade::Containers::ArrayView<const Matrix<3, Float>> matrices, Corrade::Containers::ArrayView<Matrix<3, Float>> eigenvectors, Corrade::Containers::ArrayView<Vector3<Float>> eigenvalues);
+
+/**
+@brief Batch singular value decomposition of 3x3 matrices
+
+Equivalent to calling @ref svd3x3() on each matrix.
+*/
+void MAGNUM_EXPORT svd3x3Into(Corrade::Containers::ArrayView<const Matrix<3, Float>> matrices, Corrade::Containers::ArrayView<Matrix<3, Float>> u, Corrade::Containers::ArrayView<Vector3<Float>> w, Corrade::Containers::ArrayView<Matrix<3, Float>> v);
+
+/**
+@brief Batch polar decomposition of 3x3 matrices
+
+Equivalent to calling @ref polarDecomposition3x3() on each matrix.
+*/
+void MAGNUM_EXPORT polarDecomposition3x3Into(Corrade::Containers::ArrayView<const Matrix<3, Float>> matrices, Corrade::Containers::ArrayView<Matrix<3, Float>> rotations, Corrade::Containers::ArrayView<Matrix<3, Float>> stretches);
+
+/*@}*/
+
+}}}
+
+#endif
@@ -0,0 +1,131 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Algorithms/Decomposition3x3.h"
+#include "Magnum/Math/Algorithms/Svd.h"
+#include "Magnum/Test/BenchmarkTimer.h"
+
+namespace Magnum { namespace Math { namespace Algorithms { namespace Test {
+
+struct Decomposition3x3Benchmark: Corrade::TestSuite::Tester {
+    explicit Decomposition3x3Benchmark();
+
+    void svd();
+    void polarDecomposition();
+};
+
+namespace {
+
+constexpr std::size_t Count = 1 << 16;
+constexpr std::size_t Iterations = 5;
+
+typedef Matrix<3, Float> Matrix3x3f;
+typedef Vector3<Float> Vector3f;
+
+std::vector<Matrix3x3f> matrices() {
+    std::vector<Matrix3x3f> data(Count);
+    for(std::size_t i = 0; i != Count; ++i) for(std::size_t c = 0; c != 3; ++c)
+        for(std::size_t r = 0; r != 3; ++r)
+            data[i][c][r] = Float(Int((i*7 + c*3 + r*13) % 201) - 100)/50.0f + (c == r ? 2.0f : 0.0f);
+    return data;
+}
+
+Float maxDifference(const Matrix3x3f& a, const Matrix3x3f& b) {
+    return Math::abs((a - b).toVector()).max();
+}
+
+}
+
+Decomposition3x3Benchmark::Decomposition3x3Benchmark() {
+    addTests({&Decomposition3x3Benchmark::svd,
+              &Decomposition3x3Benchmark::polarDecomposition});
+}
+
+void Decomposition3x3Benchmark::svd() {
+    const std::vector<Matrix3x3f> input = matrices();
+    std::vector<Matrix3x3f> u(Count), v(Count);
+    std::vector<Vector3f> w(Count);
+
+    Magnum::Test::BenchmarkTimer genericTimer{Iterations};
+    genericTimer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        for(std::size_t j = 0; j != Count; ++j)
+            std::tie(u[j], w[j], v[j]) = Algorithms::svd(RectangularMatrix<3, 3, Float>{input[j]});
+    genericTimer.stop();
+    const Double genericTime = genericTimer.milliseconds();
+
+    Magnum::Test::BenchmarkTimer scalarTimer{Iterations};
+    scalarTimer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        for(std::size_t j = 0; j != Count; ++j)
+            std::tie(u[j], w[j], v[j]) = Algorithms::svd3x3(input[j]);
+    scalarTimer.stop();
+    const Double scalarTime = scalarTimer.milliseconds();
+
+    Magnum::Test::BenchmarkTimer batchTimer{Iterations};
+    batchTimer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        Algorithms::svd3x3Into({input.data(), Count}, {u.data(), Count}, {w.data(), Count}, {v.data(), Count});
+    batchTimer.stop();
+    const Double batchTime = batchTimer.milliseconds();
+
+    /* Spot-check the batch result */
+    for(std::size_t j = 0; j < Count; j += 997)
+        CORRADE_VERIFY(maxDifference(u[j]*Matrix3x3f::fromDiagonal(w[j])*v[j].transposed(), input[j]) < 1.0e-4f);
+
+    Debug() << "   " << Count << "matrices, svd():" << genericTime << "ms, svd3x3():" << scalarTime << "ms, svd3x3Into():" << batchTime << "ms," << Count/(batchTime*1000.0) << "M matrices/s";
+}
+
+void Decomposition3x3Benchmark::polarDecomposition() {
+    const std::vector<Matrix3x3f> input = matrices();
+    std::vector<Matrix3x3f> r(Count), s(Count);
+
+    Magnum::Test::BenchmarkTimer scalarTimer{Iterations};
+    scalarTimer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        for(std::size_t j = 0; j != Count; ++j)
+            std::tie(r[j], s[j]) = Algorithms::polarDecomposition3x3(input[j]);
+    scalarTimer.stop();
+    const Double scalarTime = scalarTimer.milliseconds();
+
+    Magnum::Test::BenchmarkTimer batchTimer{Iterations};
+    batchTimer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        Algorithms::polarDecomposition3x3Into({input.data(), Count}, {r.data(), Count}, {s.data(), Count});
+    batchTimer.stop();
+    const Double batchTime = batchTimer.milliseconds();
+
+    for(std::size_t j = 0; j < Count; j += 997)
+        CORRADE_VERIFY(maxDifference(r[j]*s[j], input[j]) < 1.0e-4f);
+
+    Debug() << "   " << Count << "matrices, polarDecomposition3x3():" << scalarTime << "ms, polarDecomposition3x3Into():" << batchTime << "ms," << Count/(batchTime*1000.0) << "M matrices/s";
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Algorithms::Test::Decomposition3x3Benchmark)
@@ -0,0 +1,333 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Algorithms/Decomposition3x3.h"
+#include "Magnum/Math/Algorithms/Svd.h"
+
+namespace Magnum { namespace Math { namespace Algorithms { namespace Test {
+
+struct Decomposition3x3Test: Corrade::TestSuite::Tester {
+    explicit Decomposition3x3Test();
+
+    void symmetricEigen();
+    void symmetricEigenRepeated();
+    void symmetricEigenDouble();
+    void svd();
+    void svdReflection();
+    void svdRankDeficient();
+    void svdSmall();
+    void polarDecomposition();
+    void polarDecompositionReflection();
+
+    void batch();
+    void batchSizeMismatch();
+};
+
+typedef Matrix<3, Float> Matrix3x3f;
+typedef Vector3<Float> Vector3f;
+typedef Vector<3, Float> Vector3fBase;
+#ifndef MAGNUM_TARGET_GLES
+typedef Matrix<3, Double> Matrix3x3d;
+typedef Vector3<Double> Vector3d;
+#endif
+
+Decomposition3x3Test::Decomposition3x3Test() {
+    addTests({&Decomposition3x3Test::symmetricEigen,
+              &Decomposition3x3Test::symmetricEigenRepeated,
+              &Decomposition3x3Test::symmetricEigenDouble,
+              &Decomposition3x3Test::svd,
+              &Decomposition3x3Test::svdReflection,
+              &Decomposition3x3Test::svdRankDeficient,
+              &Decomposition3x3Test::svdSmall,
+              &Decomposition3x3Test::polarDecomposition,
+              &Decomposition3x3Test::polarDecompositionReflection,
+
+              &Decomposition3x3Test::batch,
+              &Decomposition3x3Test::batchSizeMismatch});
+}
+
+namespace {
+
+const Matrix3x3f Deformed{
+    Vector3fBase{ 1.5f,  0.3f, -0.7f},
+    Vector3fBase{-0.4f,  2.2f,  0.1f},
+    Vector3fBase{ 0.9f, -0.6f,  0.8f}};
+
+const Matrix3x3f Symmetric{
+    Vector3fBase{ 4.0f,  1.0f, -2.0f},
+    Vector3fBase{ 1.0f,  3.0f,  0.5f},
+    Vector3fBase{-2.0f,  0.5f,  1.0f}};
+
+Float maxDifference(const Matrix3x3f& a, const Matrix3x3f& b) {
+    return Math::abs((a - b).toVector()).max();
+}
+
+/* Singular values from the generic SVD, sorted from the largest */
+Vector3f referenceSingularValues(const Matrix3x3f& matrix) {
+    RectangularMatrix<3, 3, Float> u;
+    Vector<3, Float> w;
+    Matrix3x3f v;
+    std::tie(u, w, v) = Algorithms::svd(RectangularMatrix<3, 3, Float>{matrix});
+    std::sort(w.data(), w.data() + 3, [](Float a, Float b) { return a > b; });
+    return w;
+}
+
+}
+
+void Decomposition3x3Test::symmetricEigen() {
+    Matrix3x3f v;
+    Vector3f lambda;
+    std::tie(v, lambda) = Algorithms::symmetricEigen3x3(Symmetric);
+
+    /* Test composition */
+    CORRADE_VERIFY(maxDifference(v*Matrix3x3f::fromDiagonal(lambda)*v.transposed(), Symmetric) < 1.0e-5f);
+
+    /* Eigenvectors form a rotation */
+    CORRADE_VERIFY(v.isOrthogonal());
+    CORRADE_COMPARE(v.determinant(), 1.0f);
+
+    /* Eigenvalues are sorted, trace and determinant match */
+    CORRADE_VERIFY(lambda[0] >= lambda[1] && lambda[1] >= lambda[2]);
+    CORRADE_COMPARE(lambda.sum(), Symmetric.trace());
+    CORRADE_COMPARE(lambda.product(), Symmetric.determinant());
+
+    /* The matrix is indefinite, singular values are absolute values of the
+       eigenvalues */
+    CORRADE_VERIFY(lambda[2] < 0.0f);
+    Vector3f absoluteLambda{Math::abs(lambda)};
+    std::sort(absoluteLambda.data(), absoluteLambda.data() + 3, [](Float a, Float b) { return a > b; });
+    CORRADE_COMPARE(absoluteLambda, referenceSingularValues(Symmetric));
+}
+
+void Decomposition3x3Test::symmetricEigenRepeated() {
+    const Matrix3x3f rotation = Matrix3x3f{
+        Vector3fBase{0.0f, 0.6f, 0.8f},
+        Vector3fBase{1.0f, 0.0f, 0.0f},
+        Vector3fBase{0.0f, 0.8f, -0.6f}};
+    const Matrix3x3f a = rotation*Matrix3x3f::fromDiagonal({2.0f, -1.0f, 2.0f})*rotation.transposed();
+
+    Matrix3x3f v;
+    Vector3f lambda;
+    std::tie(v, lambda) = Algorithms::symmetricEigen3x3(a);
+    CORRADE_COMPARE(lambda, (Vector3f{2.0f, 2.0f, -1.0f}));
+    CORRADE_VERIFY(v.isOrthogonal());
+    CORRADE_VERIFY(maxDifference(v*Matrix3x3f::fromDiagonal(lambda)*v.transposed(), a) < 1.0e-5f);
+
+    /* Diagonal and zero matrix are already decomposed */
+    std::tie(v, lambda) = Algorithms::symmetricEigen3x3(Matrix3x3f::fromDiagonal({1.0f, 3.0f, 2.0f}));
+    CORRADE_COMPARE(lambda, (Vector3f{3.0f, 2.0f, 1.0f}));
+    CORRADE_COMPARE(v.determinant(), 1.0f);
+
+    std::tie(v, lambda) = Algorithms::symmetricEigen3x3(Matrix3x3f{ZeroInit});
+    CORRADE_COMPARE(lambda, Vector3f{});
+    CORRADE_COMPARE(v, Matrix3x3f{});
+}
+
+void Decomposition3x3Test::symmetricEigenDouble() {
+    #ifndef MAGNUM_TARGET_GLES
+    const Matrix3x3d a{
+        Vector<3, Double>{ 4.0,  1.0, -2.0},
+        Vector<3, Double>{ 1.0,  3.0,  0.5},
+        Vector<3, Double>{-2.0,  0.5,  1.0}};
+
+    Matrix3x3d v;
+    Vector3d lambda;
+    std::tie(v, lambda) = Algorithms::symmetricEigen3x3(a);
+    CORRADE_COMPARE(v*Matrix3x3d::fromDiagonal(lambda)*v.transposed(), a);
+    CORRADE_COMPARE(v.transposed()*v, Matrix3x3d{});
+    CORRADE_COMPARE(lambda.sum(), a.trace());
+    CORRADE_COMPARE(lambda.product(), a.determinant());
+    #else
+    CORRADE_SKIP("Double precision is not supported when targeting OpenGL ES.");
+    #endif
+}
+
+void Decomposition3x3Test::svd() {
+    Matrix3x3f u, v;
+    Vector3f w;
+    std::tie(u, w, v) = Algorithms::svd3x3(Deformed);
+
+    /* Test composition */
+    CORRADE_VERIFY(maxDifference(u*Matrix3x3f::fromDiagonal(w)*v.transposed(), Deformed) < 1.0e-5f);
+
+    /* Both U and V are rotations */
+    CORRADE_VERIFY(u.isOrthogonal());
+    CORRADE_VERIFY(v.isOrthogonal());
+    CORRADE_COMPARE(u.determinant(), 1.0f);
+    CORRADE_COMPARE(v.determinant(), 1.0f);
+
+    /* Same singular values as the generic implementation */
+    CORRADE_COMPARE(w, referenceSingularValues(Deformed));
+}
+
+void Decomposition3x3Test::svdReflection() {
+    const Matrix3x3f a = Deformed*Matrix3x3f::fromDiagonal({1.0f, -1.0f, 1.0f});
+    CORRADE_VERIFY(a.determinant() < 0.0f);
+
+    Matrix3x3f u, v;
+    Vector3f w;
+    std::tie(u, w, v) = Algorithms::svd3x3(a);
+    CORRADE_VERIFY(maxDifference(u*Matrix3x3f::fromDiagonal(w)*v.transposed(), a) < 1.0e-5f);
+    CORRADE_COMPARE(u.determinant(), 1.0f);
+    CORRADE_COMPARE(v.determinant(), 1.0f);
+
+    /* The reflection is in the last singular value */
+    CORRADE_VERIFY(w[2] < 0.0f);
+    CORRADE_COMPARE(Math::abs(w), referenceSingularValues(a));
+}
+
+void Decomposition3x3Test::svdRankDeficient() {
+    const Matrix3x3f a{
+        Vector3fBase{1.0f, 2.0f, 3.0f},
+        Vector3fBase{2.0f, 4.0f, 6.0f},
+        Vector3fBase{0.0f, 1.0f, 0.0f}};
+
+    Matrix3x3f u, v;
+    Vector3f w;
+    std::tie(u, w, v) = Algorithms::svd3x3(a);
+    CORRADE_VERIFY(maxDifference(u*Matrix3x3f::fromDiagonal(w)*v.transposed(), a) < 1.0e-5f);
+    CORRADE_VERIFY(u.isOrthogonal());
+    CORRADE_VERIFY(v.isOrthogonal());
+    CORRADE_VERIFY(Math::abs(w[2]) < 1.0e-5f);
+
+    /* Zero matrix */
+    std::tie(u, w, v) = Algorithms::svd3x3(Matrix3x3f{ZeroInit});
+    CORRADE_COMPARE(w, Vector3f{});
+    CORRADE_COMPARE(u, Matrix3x3f{});
+    CORRADE_COMPARE(v, Matrix3x3f{});
+}
+
+void Decomposition3x3Test::svdSmall() {
+    /* Squares of the values would underflow without normalization */
+    const Matrix3x3f a = Deformed*1.0e-20f;
+
+    Matrix3x3f u, v;
+    Vector3f w;
+    std::tie(u, w, v) = Algorithms::svd3x3(a);
+    CORRADE_VERIFY(maxDifference(u*Matrix3x3f::fromDiagonal(w)*v.transposed()*1.0e20f, Deformed) < 1.0e-5f);
+    CORRADE_COMPARE(w*1.0e20f, referenceSingularValues(Deformed));
+}
+
+void Decomposition3x3Test::polarDecomposition() {
+    const Matrix3x3f rotation = Matrix3x3f{
+        Vector3fBase{0.0f, 0.6f, 0.8f},
+        Vector3fBase{1.0f, 0.0f, 0.0f},
+        Vector3fBase{0.0f, 0.8f, -0.6f}};
+    const Matrix3x3f stretch{
+        Vector3fBase{2.0f, 0.5f, 0.0f},
+        Vector3fBase{0.5f, 1.0f, 0.2f},
+        Vector3fBase{0.0f, 0.2f, 3.0f}};
+
+    Matrix3x3f r, s;
+    std::tie(r, s) = Algorithms::polarDecomposition3x3(rotation*stretch);
+    CORRADE_VERIFY(maxDifference(r, rotation) < 1.0e-5f);
+    CORRADE_VERIFY(maxDifference(s, stretch) < 1.0e-5f);
+}
+
+void Decomposition3x3Test::polarDecompositionReflection() {
+    const Matrix3x3f a = Deformed*Matrix3x3f::fromDiagonal({1.0f, 1.0f, -1.0f});
+
+    Matrix3x3f r, s;
+    std::tie(r, s) = Algorithms::polarDecomposition3x3(a);
+    CORRADE_VERIFY(maxDifference(r*s, a) < 1.0e-5f);
+
+    /* The rotation is proper, the stretch is symmetric and contains the
+       reflection */
+    CORRADE_VERIFY(r.isOrthogonal());
+    CORRADE_COMPARE(r.determinant(), 1.0f);
+    CORRADE_VERIFY(maxDifference(s, s.transposed()) < 1.0e-5f);
+    CORRADE_VERIFY(s.determinant() < 0.0f);
+}
+
+void Decomposition3x3Test::batch() {
+    /* Not a multiple of four to test the remainder */
+    std::vector<Matrix3x3f> matrices{
+        Deformed,
+        Symmetric,
+        Deformed*Matrix3x3f::fromDiagonal({1.0f, -1.0f, 1.0f}),
+        Matrix3x3f{ZeroInit},
+        Matrix3x3f{},
+        Deformed*1.0e-20f,
+        Deformed.transposed()*Deformed};
+
+    std::vector<Matrix3x3f> eigenvectors(matrices.size()), u(matrices.size()), v(matrices.size()), r(matrices.size()), s(matrices.size());
+    std::vector<Vector3f> eigenvalues(matrices.size()), w(matrices.size());
+    Algorithms::symmetricEigen3x3Into({matrices.data(), matrices.size()}, {eigenvectors.data(), eigenvectors.size()}, {eigenvalues.data(), eigenvalues.size()});
+    Algorithms::svd3x3Into({matrices.data(), matrices.size()}, {u.data(), u.size()}, {w.data(), w.size()}, {v.data(), v.size()});
+    Algorithms::polarDecomposition3x3Into({matrices.data(), matrices.size()}, {r.data(), r.size()}, {s.data(), s.size()});
+
+    for(std::size_t i = 0; i != matrices.size(); ++i) {
+        const Matrix3x3f& a = matrices[i];
+        const Float scale = Math::abs(a.toVector()).max() + 1.0e-30f;
+
+        /* The eigendecomposition is meaningful only for symmetric matrices.
+           Not using fuzzy compare, as that would treat tiny matrices as
+           symmetric as well. */
+        if(maxDifference(a, a.transposed()) == 0.0f) {
+            Matrix3x3f expectedEigenvectors;
+            Vector3f expectedEigenvalues;
+            std::tie(expectedEigenvectors, expectedEigenvalues) = Algorithms::symmetricEigen3x3(a);
+            CORRADE_VERIFY(Math::abs(eigenvalues[i] - expectedEigenvalues).max() < 1.0e-5f*scale);
+            CORRADE_VERIFY(eigenvectors[i].isOrthogonal());
+            CORRADE_VERIFY(maxDifference(eigenvectors[i]*Matrix3x3f::fromDiagonal(eigenvalues[i])*eigenvectors[i].transposed(), a) < 1.0e-5f*scale);
+        }
+
+        Matrix3x3f expectedU, expectedV;
+        Vector3f expectedW;
+        std::tie(expectedU, expectedW, expectedV) = Algorithms::svd3x3(a);
+        CORRADE_VERIFY(Math::abs(w[i] - expectedW).max() < 1.0e-5f*scale);
+        CORRADE_VERIFY(u[i].isOrthogonal());
+        CORRADE_VERIFY(v[i].isOrthogonal());
+        CORRADE_VERIFY(maxDifference(u[i]*Matrix3x3f::fromDiagonal(w[i])*v[i].transposed(), a) < 1.0e-5f*scale);
+
+        CORRADE_VERIFY(r[i].isOrthogonal());
+        CORRADE_VERIFY(maxDifference(r[i]*s[i], a) < 1.0e-5f*scale);
+    }
+}
+
+void Decomposition3x3Test::batchSizeMismatch() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    Matrix3x3f matrices[3];
+    Matrix3x3f u[3], v[2];
+    Vector3f w[3];
+    Algorithms::symmetricEigen3x3Into(matrices, v, w);
+    Algorithms::svd3x3Into(matrices, u, w, v);
+    Algorithms::polarDecomposition3x3Into(matrices, u, v);
+    CORRADE_COMPARE(out.str(),
+        "Math::Algorithms::symmetricEigen3x3Into(): array sizes don't match, got 3 2 and 3\n"
+        "Math::Algorithms::svd3x3Into(): array sizes don't match, got 3 3 3 and 2\n"
+        "Math::Algorithms::polarDecomposition3x3Into(): array sizes don't match, got 3 3 and 2\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Algorithms::Test::Decomposition3x3Test)
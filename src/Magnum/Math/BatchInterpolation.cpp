@@ -0,0 +1,258 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BatchInterpolation.h"
+
+#include <cmath>
+#include <cstring>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Implementation/lanes.h"
+
+namespace Magnum { namespace Math {
+
+namespace {
+
+using Implementation::Lanes;
+using Implementation::loadLanes;
+
+/* Four quaternions, one component per member */
+struct QuaternionLanes {
+    Lanes x, y, z, w;
+};
+
+inline QuaternionLanes operator*(const QuaternionLanes& a, const QuaternionLanes& b) {
+    return {
+        a.w*b.x + b.w*a.x + (a.y*b.z - a.z*b.y),
+        a.w*b.y + b.w*a.y + (a.z*b.x - a.x*b.z),
+        a.w*b.z + b.w*a.z + (a.x*b.y - a.y*b.x),
+        a.w*b.w - (a.x*b.x + a.y*b.y + a.z*b.z)};
+}
+
+inline QuaternionLanes operator+(const QuaternionLanes& a, const QuaternionLanes& b) {
+    return {a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w};
+}
+
+inline QuaternionLanes operator*(const QuaternionLanes& a, Lanes b) {
+    return {a.x*b, a.y*b, a.z*b, a.w*b};
+}
+
+inline QuaternionLanes conjugated(const QuaternionLanes& a) {
+    return {-a.x, -a.y, -a.z, a.w};
+}
+
+inline QuaternionLanes flipSign(const QuaternionLanes& a, Lanes signSource) {
+    return {flipSign(a.x, signSource), flipSign(a.y, signSource), flipSign(a.z, signSource), flipSign(a.w, signSource)};
+}
+
+inline Lanes dot(const QuaternionLanes& a, const QuaternionLanes& b) {
+    return a.x*b.x + a.y*b.y + a.z*b.z + a.w*b.w;
+}
+
+/* The quaternions are rows of four floats in the source, the stride is in
+   floats to handle the dual quaternions as well. The last incomplete batch
+   goes through a zero-padded temporary. */
+QuaternionLanes loadQuaternions(const Float* const data, const std::size_t stride, const std::size_t count) {
+    Lanes lanes[4]{Lanes{0.0f}, Lanes{0.0f}, Lanes{0.0f}, Lanes{0.0f}};
+    if(count == 4) loadTransposed(data, stride, lanes);
+    else {
+        Float padded[16]{};
+        for(std::size_t i = 0; i != count; ++i)
+            std::memcpy(padded + 4*i, data + i*stride, 4*sizeof(Float));
+        loadTransposed(padded, 4, lanes);
+    }
+    return {lanes[0], lanes[1], lanes[2], lanes[3]};
+}
+
+void storeQuaternions(const QuaternionLanes& quaternions, Float* const data, const std::size_t stride, const std::size_t count) {
+    const Lanes lanes[4]{quaternions.x, quaternions.y, quaternions.z, quaternions.w};
+    if(count == 4) storeTransposed(lanes, data, stride);
+    else {
+        Float padded[16];
+        storeTransposed(lanes, padded, 4);
+        for(std::size_t i = 0; i != count; ++i)
+            std::memcpy(data + i*stride, padded + 4*i, 4*sizeof(Float));
+    }
+}
+
+Lanes loadPhases(const Float* const data, const std::size_t count) {
+    if(count == 4) return loadLanes(data);
+    Float padded[4]{};
+    std::memcpy(padded, data, count*sizeof(Float));
+    return loadLanes(padded);
+}
+
+/* Polynomial approximation of sin((1 - t)θ)/sin θ and sin(tθ)/sin θ from
+   "A Fast and Accurate Algorithm for Computing SLERP" by David Eberly,
+   expects cos θ to be non-negative. The paper uses eight terms, which gives
+   an error of about 2e-5 for angles close to 90°, fourteen terms with the
+   last one scaled to compensate for the truncated series bring it down to
+   1.5e-7, i.e. close to float precision. */
+constexpr Float OnePlusMu = 1.9066f;
+constexpr std::size_t SlerpTermCount = 14;
+constexpr Float SlerpU[SlerpTermCount]{
+    1.0f/(1*3), 1.0f/(2*5), 1.0f/(3*7), 1.0f/(4*9), 1.0f/(5*11),
+    1.0f/(6*13), 1.0f/(7*15), 1.0f/(8*17), 1.0f/(9*19), 1.0f/(10*21),
+    1.0f/(11*23), 1.0f/(12*25), 1.0f/(13*27), OnePlusMu/(14*29)};
+constexpr Float SlerpV[SlerpTermCount]{
+    1.0f/3, 2.0f/5, 3.0f/7, 4.0f/9, 5.0f/11,
+    6.0f/13, 7.0f/15, 8.0f/17, 9.0f/19, 10.0f/21,
+    11.0f/23, 12.0f/25, 13.0f/27, OnePlusMu*14/29};
+
+void slerpCoefficients(const Lanes cosAngle, const Lanes t, Lanes& coefficientA, Lanes& coefficientB) {
+    const Lanes one{1.0f};
+    const Lanes cosAngleMinusOne = cosAngle - one;
+    const Lanes tA = one - t;
+    const Lanes tA2 = tA*tA;
+    const Lanes tB2 = t*t;
+
+    Lanes a = one, b = one;
+    for(std::size_t i = SlerpTermCount; i != 0; --i) {
+        a = one + (Lanes{SlerpU[i - 1]}*tA2 - Lanes{SlerpV[i - 1]})*cosAngleMinusOne*a;
+        b = one + (Lanes{SlerpU[i - 1]}*tB2 - Lanes{SlerpV[i - 1]})*cosAngleMinusOne*b;
+    }
+
+    coefficientA = tA*a;
+    coefficientB = t*b;
+}
+
+QuaternionLanes lerpShortestPath(const QuaternionLanes& a, const QuaternionLanes& b, const Lanes t) {
+    const QuaternionLanes interpolated = a*(Lanes{1.0f} - t) + flipSign(b, dot(a, b))*t;
+    return interpolated*sqrtInverted(dot(interpolated, interpolated));
+}
+
+QuaternionLanes slerpShortestPath(const QuaternionLanes& a, const QuaternionLanes& b, const Lanes t) {
+    const Lanes cosAngle = dot(a, b);
+    Lanes coefficientA, coefficientB;
+    slerpCoefficients(flipSign(cosAngle, cosAngle), t, coefficientA, coefficientB);
+    return a*coefficientA + flipSign(b, cosAngle)*coefficientB;
+}
+
+/* Below this squared sine of the half-angle the screw motion is treated as a
+   pure translation, chosen so the cancellation error and the series
+   truncation error are roughly the same */
+constexpr Float ScrewEpsilon = 2.5e-4f;
+
+void sclerpShortestPath(const QuaternionLanes& realA, const QuaternionLanes& dualA, const QuaternionLanes& realB, const QuaternionLanes& dualB, const Lanes t, QuaternionLanes& real, QuaternionLanes& dual) {
+    /* Difference between the two, which is then raised to the power of t.
+       Negating it if the real scalar part is negative gives the shortest
+       path. */
+    const QuaternionLanes realAConjugated = conjugated(realA);
+    QuaternionLanes differenceReal = realAConjugated*realB;
+    QuaternionLanes differenceDual = realAConjugated*dualB + conjugated(dualA)*realB;
+    differenceDual = flipSign(differenceDual, differenceReal.w);
+    differenceReal = flipSign(differenceReal, differenceReal.w);
+
+    /* The rotation part is slerp from identity, with the half-angle φ:
+       w' = cos(tφ) = c_A + c_B cos φ, v' = l sin(tφ) = c_B v */
+    Lanes coefficientA, coefficientB;
+    slerpCoefficients(differenceReal.w, t, coefficientA, coefficientB);
+    const QuaternionLanes poweredReal{
+        differenceReal.x*coefficientB,
+        differenceReal.y*coefficientB,
+        differenceReal.z*coefficientB,
+        coefficientA + differenceReal.w*coefficientB};
+
+    /* With screw axis l = v/sin φ, moment m and pitch d expressed via the
+       dual part, the powered dual part simplifies to
+       v'_ε = c_B v_ε + k w_ε v, w'_ε = t c_B w_ε, where
+       k = (c_B cos φ - t cos(tφ))/sin²φ, which goes to t(t² - 1)/3 for pure
+       translation */
+    const Lanes sinAngleSquared = differenceReal.x*differenceReal.x + differenceReal.y*differenceReal.y + differenceReal.z*differenceReal.z;
+    const Lanes k = selectLess(sinAngleSquared, Lanes{ScrewEpsilon},
+        t*(t*t - Lanes{1.0f})*Lanes{1.0f/3.0f},
+        (coefficientB*differenceReal.w - t*poweredReal.w)/sinAngleSquared);
+    const Lanes kw = k*differenceDual.w;
+    const QuaternionLanes poweredDual{
+        coefficientB*differenceDual.x + kw*differenceReal.x,
+        coefficientB*differenceDual.y + kw*differenceReal.y,
+        coefficientB*differenceDual.z + kw*differenceReal.z,
+        t*coefficientB*differenceDual.w};
+
+    real = realA*poweredReal;
+    dual = realA*poweredDual + dualA*poweredReal;
+}
+
+}
+
+void lerpShortestPathInto(const Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedA, const Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedB, const Corrade::Containers::ArrayView<const Float> t, const Corrade::Containers::ArrayView<Quaternion<Float>> output) {
+    CORRADE_ASSERT(normalizedA.size() == normalizedB.size() && normalizedA.size() == t.size() && normalizedA.size() == output.size(),
+        "Math::lerpShortestPathInto(): array sizes don't match, got" << normalizedA.size() << normalizedB.size() << t.size() << "and" << output.size(), );
+    static_assert(sizeof(Quaternion<Float>) == 4*sizeof(Float), "unexpected quaternion layout");
+
+    const Float* const a = reinterpret_cast<const Float*>(normalizedA.data());
+    const Float* const b = reinterpret_cast<const Float*>(normalizedB.data());
+    Float* const out = reinterpret_cast<Float*>(output.data());
+    for(std::size_t i = 0; i < output.size(); i += 4) {
+        const std::size_t count = Math::min(output.size() - i, std::size_t(4));
+        storeQuaternions(lerpShortestPath(
+            loadQuaternions(a + 4*i, 4, count),
+            loadQuaternions(b + 4*i, 4, count),
+            loadPhases(t.data() + i, count)), out + 4*i, 4, count);
+    }
+}
+
+void slerpShortestPathInto(const Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedA, const Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedB, const Corrade::Containers::ArrayView<const Float> t, const Corrade::Containers::ArrayView<Quaternion<Float>> output) {
+    CORRADE_ASSERT(normalizedA.size() == normalizedB.size() && normalizedA.size() == t.size() && normalizedA.size() == output.size(),
+        "Math::slerpShortestPathInto(): array sizes don't match, got" << normalizedA.size() << normalizedB.size() << t.size() << "and" << output.size(), );
+
+    const Float* const a = reinterpret_cast<const Float*>(normalizedA.data());
+    const Float* const b = reinterpret_cast<const Float*>(normalizedB.data());
+    Float* const out = reinterpret_cast<Float*>(output.data());
+    for(std::size_t i = 0; i < output.size(); i += 4) {
+        const std::size_t count = Math::min(output.size() - i, std::size_t(4));
+        storeQuaternions(slerpShortestPath(
+            loadQuaternions(a + 4*i, 4, count),
+            loadQuaternions(b + 4*i, 4, count),
+            loadPhases(t.data() + i, count)), out + 4*i, 4, count);
+    }
+}
+
+void sclerpShortestPathInto(const Corrade::Containers::ArrayView<const DualQuaternion<Float>> normalizedA, const Corrade::Containers::ArrayView<const DualQuaternion<Float>> normalizedB, const Corrade::Containers::ArrayView<const Float> t, const Corrade::Containers::ArrayView<DualQuaternion<Float>> output) {
+    CORRADE_ASSERT(normalizedA.size() == normalizedB.size() && normalizedA.size() == t.size() && normalizedA.size() == output.size(),
+        "Math::sclerpShortestPathInto(): array sizes don't match, got" << normalizedA.size() << normalizedB.size() << t.size() << "and" << output.size(), );
+    static_assert(sizeof(DualQuaternion<Float>) == 8*sizeof(Float), "unexpected dual quaternion layout");
+
+    /* Real and dual parts are interleaved, so they're loaded as two separate
+       sets of rows with a stride of eight */
+    const Float* const a = reinterpret_cast<const Float*>(normalizedA.data());
+    const Float* const b = reinterpret_cast<const Float*>(normalizedB.data());
+    Float* const out = reinterpret_cast<Float*>(output.data());
+    for(std::size_t i = 0; i < output.size(); i += 4) {
+        const std::size_t count = Math::min(output.size() - i, std::size_t(4));
+        QuaternionLanes real, dual;
+        sclerpShortestPath(
+            loadQuaternions(a + 8*i, 8, count),
+            loadQuaternions(a + 8*i + 4, 8, count),
+            loadQuaternions(b + 8*i, 8, count),
+            loadQuaternions(b + 8*i + 4, 8, count),
+            loadPhases(t.data() + i, count), real, dual);
+        storeQuaternions(real, out + 8*i, 8, count);
+        storeQuaternions(dual, out + 8*i + 4, 8, count);
+    }
+}
+
+}}
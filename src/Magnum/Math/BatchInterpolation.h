@@ -0,0 +1,96 @@
+#ifndef Magnum_Math_BatchInterpolation_h
+#define Magnum_Math_BatchInterpolation_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+/** @file
+ * @brief Function @ref Magnum::Math::lerpShortestPathInto(), @ref Magnum::Math::slerpShortestPathInto(), @ref Magnum::Math::sclerpShortestPathInto()
+ */
+
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Math/DualQuaternion.h"
+
+namespace Magnum { namespace Math {
+
+/**
+@{ @name Batch interpolation
+
+Interpolation of many quaternion or dual quaternion pairs at once, each with
+its own interpolation phase, for example when sampling skeletal animation
+keyframes. The data are internally transposed to structure-of-arrays layout
+and processed four at a time, with SSE2 if the library is compiled with it
+enabled. All functions expect the quaternions to be normalized and all arrays
+to have the same size. Unlike @ref lerp(const Quaternion<T>&, const Quaternion<T>&, T)
+and @ref slerp(const Quaternion<T>&, const Quaternion<T>&, T), the functions
+always interpolate along the shortest path, i.e. the second quaternion is
+negated if the angle between them is larger than 180°.
+*/
+
+/**
+@brief Normalized linear interpolation of quaternion pairs along the shortest path
+
+Output for each pair is @f[
+    q_{LERP} = \frac{(1 - t) q_A + t q'_B}{|(1 - t) q_A + t q'_B|}
+    ~ ~ ~ ~ ~ ~ ~
+    q'_B = \begin{cases}
+        q_B, & q_A \cdot q_B \ge 0 \\
+        -q_B, & q_A \cdot q_B < 0
+    \end{cases}
+@f]
+@see @ref lerp(const Quaternion<T>&, const Quaternion<T>&, T)
+*/
+void MAGNUM_EXPORT lerpShortestPathInto(Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedA, Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedB, Corrade::Containers::ArrayView<const Float> t, Corrade::Containers::ArrayView<Quaternion<Float>> output);
+
+/**
+@brief Spherical linear interpolation of quaternion pairs along the shortest path
+
+Instead of evaluating the trigonometric functions from
+@ref slerp(const Quaternion<T>&, const Quaternion<T>&, T), the
+@f$ \frac{\sin(t \theta)}{\sin \theta} @f$ coefficients are approximated
+with a polynomial in @f$ \cos \theta @f$ from David Eberly's
+*A Fast and Accurate Algorithm for Computing SLERP*, extended to fourteen
+terms. It consists only of multiplications and additions and the result
+differs from the exact value by less than @f$ 10^{-6} @f$.
+@see @ref slerp(const Quaternion<T>&, const Quaternion<T>&, T)
+*/
+void MAGNUM_EXPORT slerpShortestPathInto(Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedA, Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedB, Corrade::Containers::ArrayView<const Float> t, Corrade::Containers::ArrayView<Quaternion<Float>> output);
+
+/**
+@brief Screw linear interpolation of dual quaternion pairs along the shortest path
+
+Output for each pair is @f[
+    \hat q_{ScLERP} = \hat q_A (\hat q_A^* \hat q_B)^t
+@f]
+i.e. the rotation is interpolated with constant angular velocity and the
+translation along the screw axis. The rotation part is computed the same way
+as in @ref slerpShortestPathInto(), without any trigonometric functions.
+*/
+void MAGNUM_EXPORT sclerpShortestPathInto(Corrade::Containers::ArrayView<const DualQuaternion<Float>> normalizedA, Corrade::Containers::ArrayView<const DualQuaternion<Float>> normalizedB, Corrade::Containers::ArrayView<const Float> t, Corrade::Containers::ArrayView<DualQuaternion<Float>> output);
+
+/*@}*/
+
+}}
+
+#endif
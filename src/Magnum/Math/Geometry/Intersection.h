@@ -123,6 +123,54 @@ class Intersection {
             const T f = dot(planePosition, planeNormal);
             return (f-dot(planeNormal, p))/dot(planeNormal, r);
         }
+
+        /**
+         * @brief Intersection of a triangle and line
+         * @param a             First triangle vertex
+         * @param b             Second triangle vertex
+         * @param c             Third triangle vertex
+         * @param p             Starting point of the line
+         * @param r             Direction of the line
+         * @return Intersection point position `t` on the line and barycentric
+         *      coordinates `u`, `v` of the intersection point relative to
+         *      @p b and @p c, in this order. NaN or infinity if the line is
+         *      parallel to the triangle plane or the triangle is degenerate.
+         *      Intersection point can be then computed with `p + t*r` or
+         *      `(1 - u - v)*a + u*b + v*c`. If both `u` and `v` are
+         *      non-negative and `u + v` is not larger than `1`, the
+         *      intersection is inside the triangle, if `t` is in range
+         *      @f$ [ 0 ; 1 ] @f$, the intersection is inside the line segment
+         *      defined by `p` and `p + r`.
+         *
+         * Uses the Möller-Trumbore algorithm, which doesn't need the triangle
+         * plane and thus works on the triangle edges
+         * @f$ \boldsymbol e_1 = \boldsymbol b - \boldsymbol a @f$,
+         * @f$ \boldsymbol e_2 = \boldsymbol c - \boldsymbol a @f$ directly.
+         * Solving the equation for **t**, **u** and **v** using Cramer's rule
+         * and the scalar triple product: @f[
+         *      \begin{array}{rcl}
+         *          \boldsymbol p + t \boldsymbol r & = & \boldsymbol a + u \boldsymbol e_1 + v \boldsymbol e_2 \\
+         *          \begin{pmatrix} t \\ u \\ v \end{pmatrix} & = & \cfrac{1}{(\boldsymbol r \times \boldsymbol e_2) \cdot \boldsymbol e_1}
+         *          \begin{pmatrix}
+         *              ((\boldsymbol p - \boldsymbol a) \times \boldsymbol e_1) \cdot \boldsymbol e_2 \\
+         *              (\boldsymbol r \times \boldsymbol e_2) \cdot (\boldsymbol p - \boldsymbol a) \\
+         *              ((\boldsymbol p - \boldsymbol a) \times \boldsymbol e_1) \cdot \boldsymbol r
+         *          \end{pmatrix}
+         *      \end{array}
+         * @f]
+         *
+         * Both front and back faces are intersected. For many lines against
+         * large meshes see @ref MeshTools::Bvh.
+         */
+        template<class T> static Vector3<T> triangleLine(const Vector3<T>& a, const Vector3<T>& b, const Vector3<T>& c, const Vector3<T>& p, const Vector3<T>& r) {
+            const Vector3<T> e1 = b - a;
+            const Vector3<T> e2 = c - a;
+            const Vector3<T> pvec = cross(r, e2);
+            const T invDet = T(1)/dot(pvec, e1);
+            const Vector3<T> tvec = p - a;
+            const Vector3<T> qvec = cross(tvec, e1);
+            return {dot(qvec, e2)*invDet, dot(pvec, tvec)*invDet, dot(qvec, r)*invDet};
+        }
 };
 
 }}}
@@ -34,6 +34,7 @@ struct IntersectionTest: Corrade::TestSuite::Tester {
 
     void planeLine();
     void lineLine();
+    void triangleLine();
 };
 
 typedef Math::Vector2<Float> Vector2;
@@ -42,7 +43,8 @@ typedef Math::Constants<Float> Constants;
 
 IntersectionTest::IntersectionTest() {
     addTests({&IntersectionTest::planeLine,
-              &IntersectionTest::lineLine});
+              &IntersectionTest::lineLine,
+              &IntersectionTest::triangleLine});
 }
 
 void IntersectionTest::planeLine() {
@@ -97,6 +99,30 @@ void IntersectionTest::lineLine() {
         {0.0f, 0.0f}, {1.0f, 2.0f}), Constants::inf());
 }
 
+void IntersectionTest::triangleLine() {
+    const Vector3 a(-1.0f, -1.0f, 0.5f);
+    const Vector3 b(3.0f, -1.0f, 0.5f);
+    const Vector3 c(-1.0f, 3.0f, 0.5f);
+
+    /* Inside triangle and line segment */
+    CORRADE_COMPARE(Intersection::triangleLine(a, b, c,
+        {0.0f, 0.0f, -1.0f}, {0.0f, 0.0f, 2.0f}), Vector3(0.75f, 0.25f, 0.25f));
+
+    /* Back face, outside line segment */
+    CORRADE_COMPARE(Intersection::triangleLine(a, b, c,
+        {1.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f}), Vector3(-0.5f, 0.5f, 0.25f));
+
+    /* Outside triangle */
+    const Vector3 outside = Intersection::triangleLine(a, b, c,
+        {2.0f, 2.0f, 0.0f}, {0.0f, 0.0f, 1.0f});
+    CORRADE_COMPARE(outside.x(), 0.5f);
+    CORRADE_VERIFY(outside.y() + outside.z() > 1.0f);
+
+    /* Line is parallel to the triangle */
+    CORRADE_COMPARE(Intersection::triangleLine(a, b, c,
+        {0.0f, 0.0f, 1.0f}, {1.0f, 0.0f, 0.0f}).x(), Constants::inf());
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Geometry::Test::IntersectionTest)
@@ -0,0 +1,248 @@
+#ifndef Magnum_Math_Implementation_lanes_h
+#define Magnum_Math_Implementation_lanes_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cmath>
+#include <cstring>
+
+#include "Magnum/Types.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace Magnum { namespace Math { namespace Implementation {
+
+/* Four values processed at once. With SSE2 each operation is a single
+   instruction, otherwise it's a plain loop the compiler may or may not
+   vectorize. The batch kernels are written only once on top of these. */
+#ifdef __SSE2__
+struct Lanes {
+    Lanes() = default;
+    /*implicit*/ Lanes(__m128 value): value{value} {}
+    explicit Lanes(Float value): value{_mm_set1_ps(value)} {}
+
+    __m128 value;
+};
+
+inline Lanes operator+(Lanes a, Lanes b) { return _mm_add_ps(a.value, b.value); }
+inline Lanes operator-(Lanes a, Lanes b) { return _mm_sub_ps(a.value, b.value); }
+inline Lanes operator*(Lanes a, Lanes b) { return _mm_mul_ps(a.value, b.value); }
+inline Lanes operator/(Lanes a, Lanes b) { return _mm_div_ps(a.value, b.value); }
+inline Lanes operator-(Lanes a) { return _mm_xor_ps(a.value, _mm_set1_ps(-0.0f)); }
+
+inline Lanes sqrtInverted(Lanes a) {
+    return _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(a.value));
+}
+
+/* Negates the value in lanes where the sign source is negative */
+inline Lanes flipSign(Lanes a, Lanes signSource) {
+    return _mm_xor_ps(a.value, _mm_and_ps(signSource.value, _mm_set1_ps(-0.0f)));
+}
+
+/* a < b ? ifTrue : ifFalse */
+inline Lanes selectLess(Lanes a, Lanes b, Lanes ifTrue, Lanes ifFalse) {
+    const __m128 mask = _mm_cmplt_ps(a.value, b.value);
+    return _mm_or_ps(_mm_and_ps(mask, ifTrue.value), _mm_andnot_ps(mask, ifFalse.value));
+}
+
+/* Bit i set if a < b (or a <= b) in lane i, false for NaNs */
+inline Int lessMask(Lanes a, Lanes b) { return _mm_movemask_ps(_mm_cmplt_ps(a.value, b.value)); }
+inline Int lessEqualMask(Lanes a, Lanes b) { return _mm_movemask_ps(_mm_cmple_ps(a.value, b.value)); }
+
+inline Lanes abs(Lanes a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.value); }
+inline Lanes sqrt(Lanes a) { return _mm_sqrt_ps(a.value); }
+inline Lanes min(Lanes a, Lanes b) { return _mm_min_ps(a.value, b.value); }
+inline Lanes max(Lanes a, Lanes b) { return _mm_max_ps(a.value, b.value); }
+
+/* Load four values from four rows of four and transpose them so each lane
+   contains one row */
+inline void loadTransposed(const Float* const data, const std::size_t stride, Lanes* const out) {
+    __m128 a = _mm_loadu_ps(data);
+    __m128 b = _mm_loadu_ps(data + stride);
+    __m128 c = _mm_loadu_ps(data + 2*stride);
+    __m128 d = _mm_loadu_ps(data + 3*stride);
+    _MM_TRANSPOSE4_PS(a, b, c, d);
+    out[0] = a;
+    out[1] = b;
+    out[2] = c;
+    out[3] = d;
+}
+
+inline void storeTransposed(const Lanes* const in, Float* const data, const std::size_t stride) {
+    __m128 a = in[0].value, b = in[1].value, c = in[2].value, d = in[3].value;
+    _MM_TRANSPOSE4_PS(a, b, c, d);
+    _mm_storeu_ps(data, a);
+    _mm_storeu_ps(data + stride, b);
+    _mm_storeu_ps(data + 2*stride, c);
+    _mm_storeu_ps(data + 3*stride, d);
+}
+
+inline Lanes loadLanes(const Float* const data) { return _mm_loadu_ps(data); }
+inline void storeLanes(const Lanes a, Float* const data) { _mm_storeu_ps(data, a.value); }
+#else
+struct Lanes {
+    Lanes() = default;
+    explicit Lanes(Float value): value{value, value, value, value} {}
+
+    Float value[4];
+};
+
+template<class F> inline Lanes apply(F f) {
+    Lanes out;
+    for(std::size_t i = 0; i != 4; ++i) out.value[i] = f(i);
+    return out;
+}
+
+inline Lanes operator+(Lanes a, Lanes b) { return apply([&](std::size_t i) { return a.value[i] + b.value[i]; }); }
+inline Lanes operator-(Lanes a, Lanes b) { return apply([&](std::size_t i) { return a.value[i] - b.value[i]; }); }
+inline Lanes operator*(Lanes a, Lanes b) { return apply([&](std::size_t i) { return a.value[i]*b.value[i]; }); }
+inline Lanes operator/(Lanes a, Lanes b) { return apply([&](std::size_t i) { return a.value[i]/b.value[i]; }); }
+inline Lanes operator-(Lanes a) { return apply([&](std::size_t i) { return -a.value[i]; }); }
+
+inline Lanes sqrtInverted(Lanes a) {
+    return apply([&](std::size_t i) { return 1.0f/std::sqrt(a.value[i]); });
+}
+
+inline Lanes flipSign(Lanes a, Lanes signSource) {
+    return apply([&](std::size_t i) { return signSource.value[i] < 0.0f ? -a.value[i] : a.value[i]; });
+}
+
+inline Lanes selectLess(Lanes a, Lanes b, Lanes ifTrue, Lanes ifFalse) {
+    return apply([&](std::size_t i) { return a.value[i] < b.value[i] ? ifTrue.value[i] : ifFalse.value[i]; });
+}
+
+inline Int lessMask(Lanes a, Lanes b) {
+    Int out = 0;
+    for(std::size_t i = 0; i != 4; ++i) if(a.value[i] < b.value[i]) out |= 1 << i;
+    return out;
+}
+
+inline Int lessEqualMask(Lanes a, Lanes b) {
+    Int out = 0;
+    for(std::size_t i = 0; i != 4; ++i) if(a.value[i] <= b.value[i]) out |= 1 << i;
+    return out;
+}
+
+inline Lanes abs(Lanes a) { return apply([&](std::size_t i) { return std::abs(a.value[i]); }); }
+inline Lanes sqrt(Lanes a) { return apply([&](std::size_t i) { return std::sqrt(a.value[i]); }); }
+inline Lanes min(Lanes a, Lanes b) { return apply([&](std::size_t i) { return a.value[i] < b.value[i] ? a.value[i] : b.value[i]; }); }
+inline Lanes max(Lanes a, Lanes b) { return apply([&](std::size_t i) { return a.value[i] < b.value[i] ? b.value[i] : a.value[i]; }); }
+
+inline void loadTransposed(const Float* const data, const std::size_t stride, Lanes* const out) {
+    for(std::size_t row = 0; row != 4; ++row)
+        for(std::size_t i = 0; i != 4; ++i)
+            out[i].value[row] = data[row*stride + i];
+}
+
+inline void storeTransposed(const Lanes* const in, Float* const data, const std::size_t stride) {
+    for(std::size_t row = 0; row != 4; ++row)
+        for(std::size_t i = 0; i != 4; ++i)
+            data[row*stride + i] = in[i].value[row];
+}
+
+inline Lanes loadLanes(const Float* const data) {
+    Lanes out;
+    std::memcpy(out.value, data, sizeof(out.value));
+    return out;
+}
+
+inline void storeLanes(const Lanes a, Float* const data) {
+    std::memcpy(data, a.value, sizeof(a.value));
+}
+#endif
+
+#ifdef __SSE2__
+/* Narrowing four 32-bit lanes into the destination type. Values are expected
+   to be already in the type range, so the saturation never kicks in. SSE2
+   has no unsigned 32-to-16 saturating pack, so the values are shifted to
+   signed range and back. */
+template<class> void storeLanes(void* out, __m128i lanes);
+template<> inline void storeLanes<Byte>(void* const out, __m128i lanes) {
+    lanes = _mm_packs_epi32(lanes, lanes);
+    const Int packed = _mm_cvtsi128_si32(_mm_packs_epi16(lanes, lanes));
+    std::memcpy(out, &packed, 4);
+}
+template<> inline void storeLanes<UnsignedByte>(void* const out, __m128i lanes) {
+    lanes = _mm_packs_epi32(lanes, lanes);
+    const Int packed = _mm_cvtsi128_si32(_mm_packus_epi16(lanes, lanes));
+    std::memcpy(out, &packed, 4);
+}
+template<> inline void storeLanes<Short>(void* const out, const __m128i lanes) {
+    _mm_storel_epi64(static_cast<__m128i*>(out), _mm_packs_epi32(lanes, lanes));
+}
+template<> inline void storeLanes<UnsignedShort>(void* const out, __m128i lanes) {
+    lanes = _mm_sub_epi32(lanes, _mm_set1_epi32(0x8000));
+    lanes = _mm_xor_si128(_mm_packs_epi32(lanes, lanes), _mm_set1_epi16(Short(0x8000)));
+    _mm_storel_epi64(static_cast<__m128i*>(out), lanes);
+}
+template<> inline void storeLanes<UnsignedInt>(void* const out, const __m128i lanes) {
+    _mm_storeu_si128(static_cast<__m128i*>(out), lanes);
+}
+
+/* Widening four values of the source type into 32-bit lanes, sign- or
+   zero-extending them by an arithmetic or logical shift */
+template<class> __m128i loadLanes(const void* in);
+template<> inline __m128i loadLanes<Byte>(const void* const in) {
+    Int packed;
+    std::memcpy(&packed, in, 4);
+    __m128i lanes = _mm_cvtsi32_si128(packed);
+    lanes = _mm_unpacklo_epi8(lanes, lanes);
+    return _mm_srai_epi32(_mm_unpacklo_epi16(lanes, lanes), 24);
+}
+template<> inline __m128i loadLanes<UnsignedByte>(const void* const in) {
+    Int packed;
+    std::memcpy(&packed, in, 4);
+    __m128i lanes = _mm_cvtsi32_si128(packed);
+    lanes = _mm_unpacklo_epi8(lanes, lanes);
+    return _mm_srli_epi32(_mm_unpacklo_epi16(lanes, lanes), 24);
+}
+template<> inline __m128i loadLanes<Short>(const void* const in) {
+    const __m128i lanes = _mm_loadl_epi64(static_cast<const __m128i*>(in));
+    return _mm_srai_epi32(_mm_unpacklo_epi16(lanes, lanes), 16);
+}
+template<> inline __m128i loadLanes<UnsignedShort>(const void* const in) {
+    const __m128i lanes = _mm_loadl_epi64(static_cast<const __m128i*>(in));
+    return _mm_srli_epi32(_mm_unpacklo_epi16(lanes, lanes), 16);
+}
+#endif
+
+/* Gather one value from each of four consecutive items that are stride
+   floats apart and scatter them back */
+inline Lanes loadStrided(const Float* const data, const std::size_t stride) {
+    const Float values[4]{data[0], data[stride], data[2*stride], data[3*stride]};
+    return loadLanes(values);
+}
+
+inline void storeStrided(const Lanes a, Float* const data, const std::size_t stride) {
+    Float values[4];
+    storeLanes(a, values);
+    for(std::size_t i = 0; i != 4; ++i) data[i*stride] = values[i];
+}
+
+}}}
+
+#endif
@@ -0,0 +1,183 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Packing.h"
+
+#include <cstring>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Implementation/lanes.h"
+
+#if defined(__F16C__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace Magnum { namespace Math {
+
+/* Float to half-float conversion with round to nearest even, based on
+   "Fast Half Float Conversions" by Jeroen van der Zijp */
+UnsignedShort packHalf(const Float value) {
+    UnsignedInt bits;
+    std::memcpy(&bits, &value, sizeof(Float));
+
+    const UnsignedShort sign = (bits >> 16) & 0x8000;
+    const UnsignedInt absolute = bits & 0x7fffffff;
+
+    /* NaN stays NaN (with the quiet bit set), infinity and too large values
+       become infinity */
+    if(absolute >= 0x47800000) {
+        if(absolute > 0x7f800000)
+            return sign | 0x7e00 | ((absolute >> 13) & 0x3ff);
+        return sign | 0x7c00;
+    }
+
+    /* Normalized half */
+    if(absolute >= 0x38800000) {
+        const UnsignedInt rounded = absolute + 0x0fff + ((absolute >> 13) & 1);
+        return sign | UnsignedShort((rounded - 0x38000000) >> 13);
+    }
+
+    /* Denormalized half or zero */
+    if(absolute < 0x33000000) return sign;
+    const UnsignedInt exponent = absolute >> 23;
+    const UnsignedInt mantissa = (absolute & 0x7fffff) | 0x800000;
+    const UnsignedInt shift = 126 - exponent;
+    const UnsignedInt halfway = 1u << (shift - 1);
+    const UnsignedInt rest = mantissa & ((1u << shift) - 1);
+    UnsignedInt result = mantissa >> shift;
+    if(rest > halfway || (rest == halfway && (result & 1))) ++result;
+    return sign | UnsignedShort(result);
+}
+
+Float unpackHalf(const UnsignedShort value) {
+    const UnsignedInt sign = UnsignedInt(value & 0x8000) << 16;
+    const UnsignedInt exponent = (value >> 10) & 0x1f;
+    UnsignedInt mantissa = value & 0x3ff;
+
+    UnsignedInt bits;
+
+    /* Zero or denormal, renormalize the mantissa */
+    if(!exponent) {
+        if(!mantissa) bits = sign;
+        else {
+            UnsignedInt floatExponent = 127 - 15 + 1;
+            while(!(mantissa & 0x400)) {
+                mantissa <<= 1;
+                --floatExponent;
+            }
+            bits = sign | (floatExponent << 23) | ((mantissa & 0x3ff) << 13);
+        }
+
+    /* Infinity or NaN, keep the payload and set the quiet bit the same way
+       as the hardware conversion does */
+    } else if(exponent == 0x1f)
+        bits = sign | 0x7f800000 | (mantissa ? 0x400000 : 0) | (mantissa << 13);
+
+    /* Normalized value, just rebias the exponent */
+    else bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+
+    Float out;
+    std::memcpy(&out, &bits, sizeof(Float));
+    return out;
+}
+
+void packHalfInto(const Corrade::Containers::ArrayView<const Float> input, const Corrade::Containers::ArrayView<UnsignedShort> output) {
+    CORRADE_ASSERT(input.size() == output.size(),
+        "Math::packHalfInto(): expected output size" << input.size() << "but got" << output.size(), );
+
+    std::size_t i = 0;
+    #ifdef __F16C__
+    /* The instruction rounds to nearest even with immediate 0, matching the
+       scalar variant bit-for-bit */
+    for(; i + 4 <= input.size(); i += 4)
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(output.data() + i), _mm_cvtps_ph(_mm_loadu_ps(input.data() + i), 0));
+    #endif
+    for(; i != input.size(); ++i)
+        output[i] = packHalf(input[i]);
+}
+
+void unpackHalfInto(const Corrade::Containers::ArrayView<const UnsignedShort> input, const Corrade::Containers::ArrayView<Float> output) {
+    CORRADE_ASSERT(input.size() == output.size(),
+        "Math::unpackHalfInto(): expected output size" << input.size() << "but got" << output.size(), );
+
+    std::size_t i = 0;
+    #ifdef __F16C__
+    for(; i + 4 <= input.size(); i += 4)
+        _mm_storeu_ps(output.data() + i, _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(input.data() + i))));
+    #endif
+    for(; i != input.size(); ++i)
+        output[i] = unpackHalf(input[i]);
+}
+
+template<class T> void packInto(const Corrade::Containers::ArrayView<const Float> input, const Corrade::Containers::ArrayView<T> output) {
+    CORRADE_ASSERT(input.size() == output.size(),
+        "Math::packInto(): expected output size" << input.size() << "but got" << output.size(), );
+
+    std::size_t i = 0;
+    #ifdef __SSE2__
+    /* Same operations in the same order as pack(), the conversion uses the
+       current rounding mode just like std::nearbyint() */
+    const __m128 min = _mm_set1_ps(std::is_signed<T>::value ? -1.0f : 0.0f);
+    const __m128 max = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(Float(std::numeric_limits<T>::max()));
+    for(; i + 4 <= input.size(); i += 4) {
+        const __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(input.data() + i), min), max);
+        Implementation::storeLanes<T>(output.data() + i, _mm_cvtps_epi32(_mm_mul_ps(clamped, scale)));
+    }
+    #endif
+    for(; i != input.size(); ++i)
+        output[i] = pack<T>(input[i]);
+}
+
+template<class T> void unpackInto(const Corrade::Containers::ArrayView<const T> input, const Corrade::Containers::ArrayView<Float> output) {
+    CORRADE_ASSERT(input.size() == output.size(),
+        "Math::unpackInto(): expected output size" << input.size() << "but got" << output.size(), );
+
+    std::size_t i = 0;
+    #ifdef __SSE2__
+    /* Division and not multiplication by reciprocal to match unpack()
+       exactly */
+    const __m128 scale = _mm_set1_ps(Float(std::numeric_limits<T>::max()));
+    const __m128 min = _mm_set1_ps(-1.0f);
+    for(; i + 4 <= input.size(); i += 4) {
+        __m128 value = _mm_div_ps(_mm_cvtepi32_ps(Implementation::loadLanes<T>(input.data() + i)), scale);
+        if(std::is_signed<T>::value) value = _mm_max_ps(value, min);
+        _mm_storeu_ps(output.data() + i, value);
+    }
+    #endif
+    for(; i != input.size(); ++i)
+        output[i] = unpack<Float, T>(input[i]);
+}
+
+template MAGNUM_EXPORT void packInto<Byte>(Corrade::Containers::ArrayView<const Float>, Corrade::Containers::ArrayView<Byte>);
+template MAGNUM_EXPORT void packInto<UnsignedByte>(Corrade::Containers::ArrayView<const Float>, Corrade::Containers::ArrayView<UnsignedByte>);
+template MAGNUM_EXPORT void packInto<Short>(Corrade::Containers::ArrayView<const Float>, Corrade::Containers::ArrayView<Short>);
+template MAGNUM_EXPORT void packInto<UnsignedShort>(Corrade::Containers::ArrayView<const Float>, Corrade::Containers::ArrayView<UnsignedShort>);
+template MAGNUM_EXPORT void unpackInto<Byte>(Corrade::Containers::ArrayView<const Byte>, Corrade::Containers::ArrayView<Float>);
+template MAGNUM_EXPORT void unpackInto<UnsignedByte>(Corrade::Containers::ArrayView<const UnsignedByte>, Corrade::Containers::ArrayView<Float>);
+template MAGNUM_EXPORT void unpackInto<Short>(Corrade::Containers::ArrayView<const Short>, Corrade::Containers::ArrayView<Float>);
+template MAGNUM_EXPORT void unpackInto<UnsignedShort>(Corrade::Containers::ArrayView<const UnsignedShort>, Corrade::Containers::ArrayView<Float>);
+
+}}
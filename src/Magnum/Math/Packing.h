@@ -0,0 +1,217 @@
+#ifndef Magnum_Math_Packing_h
+#define Magnum_Math_Packing_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+/** @file
+ * @brief Functions @ref Magnum::Math::packHalf(), @ref Magnum::Math::unpackHalf(), @ref Magnum::Math::pack(), @ref Magnum::Math::unpack(), @ref Magnum::Math::packHalfInto(), @ref Magnum::Math::unpackHalfInto(), @ref Magnum::Math::packInto(), @ref Magnum::Math::unpackInto()
+ */
+
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace Math {
+
+/**
+@{ @name Packing and unpacking
+
+Conversion between floating-point values and their compact half-float or
+normalized integral representation, for single values, vectors and whole
+arrays.
+*/
+
+/**
+@brief Pack 32-bit float value into 16-bit half-float representation
+
+Rounds to nearest with ties to even, values out of range are converted to
+infinity, NaNs stay NaNs. See also
+[Wikipedia](https://en.wikipedia.org/wiki/Half-precision_floating-point_format)
+for more information about the format.
+@see @ref unpackHalf(), @ref packHalfInto()
+*/
+UnsignedShort MAGNUM_EXPORT packHalf(Float value);
+
+/** @overload */
+template<std::size_t size> Vector<size, UnsignedShort> packHalf(const Vector<size, Float>& value) {
+    Vector<size, UnsignedShort> out;
+    for(std::size_t i = 0; i != size; ++i)
+        out[i] = packHalf(value[i]);
+    return out;
+}
+
+/**
+@brief Unpack 16-bit half-float value into 32-bit float representation
+
+The conversion is exact, including denormals and infinities. NaNs keep
+their payload and are converted to quiet NaNs.
+@see @ref packHalf(), @ref unpackHalfInto()
+*/
+Float MAGNUM_EXPORT unpackHalf(UnsignedShort value);
+
+/** @overload */
+template<std::size_t size> Vector<size, Float> unpackHalf(const Vector<size, UnsignedShort>& value) {
+    Vector<size, Float> out;
+    for(std::size_t i = 0; i != size; ++i)
+        out[i] = unpackHalf(value[i]);
+    return out;
+}
+
+/**
+@brief Pack floating-point value into normalized integral representation
+
+Unlike @ref denormalize() the value is first clamped to @f$ [0, 1] @f$ for
+*unsigned* and to @f$ [-1, 1] @f$ for *signed* `Integral` types and then
+rounded to nearest, with ties to even in the default rounding mode, so the
+result is always defined and @ref unpack() of it is the closest representable
+value.
+@see @ref packInto()
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+template<class Integral, class FloatingPoint> inline Integral pack(const FloatingPoint& value);
+#else
+template<class Integral, class FloatingPoint> inline typename std::enable_if<std::is_arithmetic<FloatingPoint>::value, Integral>::type pack(FloatingPoint value) {
+    static_assert(std::is_floating_point<FloatingPoint>::value && std::is_integral<Integral>::value,
+                  "Math::pack(): packing must be done from floating-point to integral type");
+    return Integral(std::nearbyint(Math::clamp(value, std::is_signed<Integral>::value ? FloatingPoint(-1) : FloatingPoint(0), FloatingPoint(1))*FloatingPoint(std::numeric_limits<Integral>::max())));
+}
+template<class Integral, class FloatingPoint> inline typename std::enable_if<std::is_arithmetic<typename Integral::Type>::value, Integral>::type pack(const FloatingPoint& value) {
+    Integral out;
+    for(std::size_t i = 0; i != Integral::Size; ++i)
+        out[i] = pack<typename Integral::Type>(value[i]);
+    return out;
+}
+#endif
+
+/**
+@brief Pack floating-point value into integer representation with given bit count
+
+Alternative to @ref pack(FloatingPoint) with ability to specify how many bits
+of the integral representation to use, e.g. for 10-bit components of packed
+vertex formats. The value is clamped and rounded the same way. The source
+type is deduced, so only the result type and bit count are specified:
+@code
+Int a = Math::pack<Int, 10>(0.5f); // 256
+@endcode
+@see @ref unpack(const Integral&)
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+template<class Integral, UnsignedInt bits, class FloatingPoint> inline Integral pack(FloatingPoint value);
+#else
+template<class Integral, UnsignedInt bits, class FloatingPoint> inline typename std::enable_if<std::is_arithmetic<FloatingPoint>::value, Integral>::type pack(FloatingPoint value) {
+    static_assert(std::is_floating_point<FloatingPoint>::value && std::is_integral<Integral>::value,
+                  "Math::pack(): packing must be done from floating-point to integral type");
+    static_assert(bits <= sizeof(Integral)*8,
+                  "Math::pack(): bit count larger than size of the integral type");
+    return Integral(std::nearbyint(Math::clamp(value, std::is_signed<Integral>::value ? FloatingPoint(-1) : FloatingPoint(0), FloatingPoint(1))*FloatingPoint((1ull << (bits - std::is_signed<Integral>::value)) - 1)));
+}
+#endif
+
+/**
+@brief Unpack normalized integral value into floating-point representation
+
+Equivalent to @ref normalize(), provided for symmetry with @ref pack().
+@see @ref unpackInto()
+*/
+template<class FloatingPoint, class Integral> inline FloatingPoint unpack(const Integral& value) {
+    return normalize<FloatingPoint, Integral>(value);
+}
+
+/**
+@brief Unpack integer value with given bit count into floating-point representation
+
+Alternative to @ref unpack(const Integral&) with ability to specify how many
+bits of the integral representation are used, inverse to
+@ref pack(FloatingPoint) with given bit count. Similarly to it, the source
+type is deduced:
+@code
+Float a = Math::unpack<Float, 10>(256); // 0.500978
+@endcode
+*/
+template<class FloatingPoint, UnsignedInt bits, class Integral> inline FloatingPoint unpack(const Integral& value) {
+    static_assert(std::is_floating_point<FloatingPoint>::value && std::is_integral<Integral>::value,
+                  "Math::unpack(): unpacking must be done from integral to floating-point type");
+    static_assert(bits <= sizeof(Integral)*8,
+                  "Math::unpack(): bit count larger than size of the integral type");
+    return Math::max(FloatingPoint(value)/FloatingPoint((1ull << (bits - std::is_signed<Integral>::value)) - 1), std::is_signed<Integral>::value ? FloatingPoint(-1) : FloatingPoint(0));
+}
+
+/**
+@brief Pack array of floats into half-floats
+
+Same as calling @ref packHalf(Float) on each element, but if the library is
+compiled with F16C instructions enabled, four values are converted at once.
+The result is the same in both cases. Expects that both arrays have the same
+size.
+*/
+void MAGNUM_EXPORT packHalfInto(Corrade::Containers::ArrayView<const Float> input, Corrade::Containers::ArrayView<UnsignedShort> output);
+
+/**
+@brief Unpack array of half-floats into floats
+
+Same as calling @ref unpackHalf(UnsignedShort) on each element, but if the
+library is compiled with F16C instructions enabled, four values are
+converted at once. The result is the same in both cases. Expects that both
+arrays have the same size.
+*/
+void MAGNUM_EXPORT unpackHalfInto(Corrade::Containers::ArrayView<const UnsignedShort> input, Corrade::Containers::ArrayView<Float> output);
+
+/**
+@brief Pack array of floats into normalized integers
+
+Same as calling @ref pack() on each element, but if the library is compiled
+with SSE2 instructions enabled, four values are converted at once. The result
+is the same in both cases. Expects that both arrays have the same size.
+Available for @ref Magnum::Byte "Byte", @ref Magnum::UnsignedByte "UnsignedByte",
+@ref Magnum::Short "Short" and @ref Magnum::UnsignedShort "UnsignedShort".
+*/
+template<class T> void packInto(Corrade::Containers::ArrayView<const Float> input, Corrade::Containers::ArrayView<T> output);
+
+/**
+@brief Unpack array of normalized integers into floats
+
+Same as calling @ref unpack() on each element, but if the library is compiled
+with SSE2 instructions enabled, four values are converted at once. The result
+is the same in both cases. Expects that both arrays have the same size.
+Available for @ref Magnum::Byte "Byte", @ref Magnum::UnsignedByte "UnsignedByte",
+@ref Magnum::Short "Short" and @ref Magnum::UnsignedShort "UnsignedShort".
+*/
+template<class T> void unpackInto(Corrade::Containers::ArrayView<const T> input, Corrade::Containers::ArrayView<Float> output);
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template MAGNUM_EXPORT void packInto<Byte>(Corrade::Containers::ArrayView<const Float>, Corrade::Containers::ArrayView<Byte>);
+extern template MAGNUM_EXPORT void packInto<UnsignedByte>(Corrade::Containers::ArrayView<const Float>, Corrade::Containers::ArrayView<UnsignedByte>);
+extern template MAGNUM_EXPORT void packInto<Short>(Corrade::Containers::ArrayView<const Float>, Corrade::Containers::ArrayView<Short>);
+extern template MAGNUM_EXPORT void packInto<UnsignedShort>(Corrade::Containers::ArrayView<const Float>, Corrade::Containers::ArrayView<UnsignedShort>);
+extern template MAGNUM_EXPORT void unpackInto<Byte>(Corrade::Containers::ArrayView<const Byte>, Corrade::Containers::ArrayView<Float>);
+extern template MAGNUM_EXPORT void unpackInto<UnsignedByte>(Corrade::Containers::ArrayView<const UnsignedByte>, Corrade::Containers::ArrayView<Float>);
+extern template MAGNUM_EXPORT void unpackInto<Short>(Corrade::Containers::ArrayView<const Short>, Corrade::Containers::ArrayView<Float>);
+extern template MAGNUM_EXPORT void unpackInto<UnsignedShort>(Corrade::Containers::ArrayView<const UnsignedShort>, Corrade::Containers::ArrayView<Float>);
+#endif
+
+/*@}*/
+
+}}
+
+#endif
@@ -0,0 +1,173 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/BatchInterpolation.h"
+
+namespace Magnum { namespace Math { namespace Test {
+
+struct BatchInterpolationTest: Corrade::TestSuite::Tester {
+    explicit BatchInterpolationTest();
+
+    void lerpShortestPath();
+    void slerpShortestPath();
+    void sclerpShortestPath();
+    void sclerpPureTranslation();
+    void sizeMismatch();
+};
+
+typedef Math::Deg<Float> Deg;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Quaternion<Float> Quaternion;
+typedef Math::DualQuaternion<Float> DualQuaternion;
+
+BatchInterpolationTest::BatchInterpolationTest() {
+    addTests({&BatchInterpolationTest::lerpShortestPath,
+              &BatchInterpolationTest::slerpShortestPath,
+              &BatchInterpolationTest::sclerpShortestPath,
+              &BatchInterpolationTest::sclerpPureTranslation,
+              &BatchInterpolationTest::sizeMismatch});
+}
+
+namespace {
+
+/* Six pairs to test both the full batch and the remainder. The third pair is
+   more than 180° apart, the fourth is identical. */
+std::vector<Quaternion> quaternionsA() {
+    return {
+        Quaternion::rotation(Deg(15.0f), Vector3::xAxis()),
+        Quaternion::rotation(Deg(-30.0f), Vector3(1.0f, 2.0f, 3.0f).normalized()),
+        Quaternion::rotation(Deg(10.0f), Vector3::yAxis()),
+        Quaternion::rotation(Deg(45.0f), Vector3::zAxis()),
+        Quaternion{},
+        Quaternion::rotation(Deg(170.0f), Vector3::yAxis())};
+}
+
+std::vector<Quaternion> quaternionsB() {
+    return {
+        Quaternion::rotation(Deg(75.0f), Vector3::xAxis()),
+        Quaternion::rotation(Deg(120.0f), Vector3(-3.0f, 1.0f, 2.0f).normalized()),
+        Quaternion::rotation(Deg(300.0f), Vector3::yAxis()),
+        Quaternion::rotation(Deg(45.0f), Vector3::zAxis()),
+        Quaternion::rotation(Deg(90.0f), Vector3::zAxis()),
+        Quaternion::rotation(Deg(-170.0f), Vector3::yAxis())};
+}
+
+const std::vector<Float> phases{0.25f, 0.5f, 0.8f, 0.3f, 1.0f, 0.5f};
+
+Quaternion shortest(const Quaternion& a, const Quaternion& b) {
+    return Math::dot(a, b) < 0.0f ? -b : b;
+}
+
+}
+
+void BatchInterpolationTest::lerpShortestPath() {
+    const std::vector<Quaternion> a = quaternionsA();
+    const std::vector<Quaternion> b = quaternionsB();
+    std::vector<Quaternion> out(a.size());
+    Math::lerpShortestPathInto({a.data(), a.size()}, {b.data(), b.size()}, {phases.data(), phases.size()}, {out.data(), out.size()});
+
+    for(std::size_t i = 0; i != a.size(); ++i)
+        CORRADE_COMPARE(out[i], Math::lerp(a[i], shortest(a[i], b[i]), phases[i]));
+}
+
+void BatchInterpolationTest::slerpShortestPath() {
+    const std::vector<Quaternion> a = quaternionsA();
+    const std::vector<Quaternion> b = quaternionsB();
+    std::vector<Quaternion> out(a.size());
+    Math::slerpShortestPathInto({a.data(), a.size()}, {b.data(), b.size()}, {phases.data(), phases.size()}, {out.data(), out.size()});
+
+    /* Math::slerp() can't handle identical quaternions */
+    for(std::size_t i = 0; i != a.size(); ++i)
+        CORRADE_COMPARE(out[i], a[i] == b[i] ? a[i] : Math::slerp(a[i], shortest(a[i], b[i]), phases[i]));
+
+    /* Going from 170° to -170° the short way over 180° */
+    CORRADE_COMPARE(out[5], Quaternion::rotation(Deg(180.0f), Vector3::yAxis()));
+}
+
+void BatchInterpolationTest::sclerpShortestPath() {
+    const std::vector<Quaternion> a = quaternionsA();
+    const std::vector<Quaternion> b = quaternionsB();
+    std::vector<DualQuaternion> da, db;
+    for(std::size_t i = 0; i != a.size(); ++i) {
+        da.push_back(DualQuaternion::translation({1.0f, 2.0f, Float(i)})*DualQuaternion{a[i]});
+        db.push_back(DualQuaternion::translation({-3.0f, 0.5f, 1.0f})*DualQuaternion{b[i]});
+    }
+
+    std::vector<DualQuaternion> out(a.size());
+    Math::sclerpShortestPathInto({da.data(), da.size()}, {db.data(), db.size()}, {phases.data(), phases.size()}, {out.data(), out.size()});
+
+    for(std::size_t i = 0; i != a.size(); ++i) {
+        /* Rotation is the same as with slerp, result is normalized */
+        CORRADE_VERIFY(out[i].isNormalized());
+        CORRADE_COMPARE(out[i].rotation(), a[i] == b[i] ? a[i] : Math::slerp(a[i], shortest(a[i], b[i]), phases[i]));
+    }
+
+    /* Ends of the interval */
+    const Float ends[]{0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f};
+    Math::sclerpShortestPathInto({da.data(), da.size()}, {db.data(), db.size()}, {ends, 6}, {out.data(), out.size()});
+    /* With the shortest path the result may be negated B, which is the same
+       transformation, so comparing matrices */
+    for(std::size_t i = 0; i != a.size(); ++i)
+        CORRADE_COMPARE(out[i].toMatrix(), (i % 2 ? db : da)[i].toMatrix());
+
+    /* Rotation by 90° around Z combined with translation along Z is a screw
+       motion, half of it is rotation by 45° and half the translation */
+    const DualQuaternion screwA{};
+    const DualQuaternion screwB = DualQuaternion::translation({0.0f, 0.0f, 2.0f})*DualQuaternion::rotation(Deg(90.0f), Vector3::zAxis());
+    const Float half = 0.5f;
+    DualQuaternion screw;
+    Math::sclerpShortestPathInto({&screwA, 1}, {&screwB, 1}, {&half, 1}, {&screw, 1});
+    CORRADE_COMPARE(screw, DualQuaternion::translation({0.0f, 0.0f, 1.0f})*DualQuaternion::rotation(Deg(45.0f), Vector3::zAxis()));
+}
+
+void BatchInterpolationTest::sclerpPureTranslation() {
+    const DualQuaternion a = DualQuaternion::translation({1.0f, 2.0f, 3.0f})*DualQuaternion::rotation(Deg(30.0f), Vector3::xAxis());
+    const DualQuaternion b = DualQuaternion::translation({-1.0f, 4.0f, 3.0f})*DualQuaternion::rotation(Deg(30.0f), Vector3::xAxis());
+    const Float t = 0.25f;
+    DualQuaternion out;
+    Math::sclerpShortestPathInto({&a, 1}, {&b, 1}, {&t, 1}, {&out, 1});
+
+    CORRADE_COMPARE(out.rotation(), a.rotation());
+    CORRADE_COMPARE(out.translation(), (Vector3{0.5f, 2.5f, 3.0f}));
+}
+
+void BatchInterpolationTest::sizeMismatch() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    const std::vector<Quaternion> a(3), b(3);
+    const std::vector<Float> t(2);
+    std::vector<Quaternion> output(3);
+    Math::slerpShortestPathInto({a.data(), a.size()}, {b.data(), b.size()}, {t.data(), t.size()}, {output.data(), output.size()});
+    CORRADE_COMPARE(out.str(), "Math::slerpShortestPathInto(): array sizes don't match, got 3 3 2 and 3\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::BatchInterpolationTest)
@@ -0,0 +1,192 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Test/BenchmarkTimer.h"
+
+namespace Magnum { namespace Math { namespace Test {
+
+struct PackingBenchmark: Corrade::TestSuite::Tester {
+    explicit PackingBenchmark();
+
+    void packHalf();
+    void unpackHalf();
+    void packShort();
+    void unpackShort();
+    void packUnsignedByte();
+
+    private:
+        void print(const char* name, Double scalar, Double array);
+};
+
+namespace {
+
+constexpr std::size_t Count = 1 << 20;
+constexpr std::size_t Iterations = 20;
+
+std::vector<Float> floats() {
+    std::vector<Float> data(Count);
+    for(std::size_t i = 0; i != Count; ++i)
+        data[i] = Float(Int(i % 2001) - 1000)/1000.0f;
+    return data;
+}
+
+}
+
+PackingBenchmark::PackingBenchmark() {
+    addTests({&PackingBenchmark::packHalf,
+              &PackingBenchmark::unpackHalf,
+              &PackingBenchmark::packShort,
+              &PackingBenchmark::unpackShort,
+              &PackingBenchmark::packUnsignedByte});
+}
+
+void PackingBenchmark::print(const char* name, const Double scalar, const Double array) {
+    Debug() << "   " << Count << "values," << name << "scalar loop:" << scalar << "ms, array variant:" << array << "ms," << Count/(array*1000.0) << "M values/s";
+}
+
+void PackingBenchmark::packHalf() {
+    const std::vector<Float> input = floats();
+    std::vector<UnsignedShort> scalar(Count), array(Count);
+
+    Magnum::Test::BenchmarkTimer scalarTimer{Iterations};
+    scalarTimer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        for(std::size_t j = 0; j != Count; ++j)
+            scalar[j] = Math::packHalf(input[j]);
+    scalarTimer.stop();
+    const Double scalarTime = scalarTimer.milliseconds();
+
+    Magnum::Test::BenchmarkTimer arrayTimer{Iterations};
+    arrayTimer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        Math::packHalfInto({input.data(), Count}, {array.data(), Count});
+    arrayTimer.stop();
+    const Double arrayTime = arrayTimer.milliseconds();
+
+    CORRADE_VERIFY(scalar == array);
+    print("packHalf()", scalarTime, arrayTime);
+}
+
+void PackingBenchmark::unpackHalf() {
+    std::vector<UnsignedShort> input(Count);
+    Math::packHalfInto({floats().data(), Count}, {input.data(), Count});
+    std::vector<Float> scalar(Count), array(Count);
+
+    Magnum::Test::BenchmarkTimer scalarTimer{Iterations};
+    scalarTimer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        for(std::size_t j = 0; j != Count; ++j)
+            scalar[j] = Math::unpackHalf(input[j]);
+    scalarTimer.stop();
+    const Double scalarTime = scalarTimer.milliseconds();
+
+    Magnum::Test::BenchmarkTimer arrayTimer{Iterations};
+    arrayTimer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        Math::unpackHalfInto({input.data(), Count}, {array.data(), Count});
+    arrayTimer.stop();
+    const Double arrayTime = arrayTimer.milliseconds();
+
+    CORRADE_VERIFY(scalar == array);
+    print("unpackHalf()", scalarTime, arrayTime);
+}
+
+void PackingBenchmark::packShort() {
+    const std::vector<Float> input = floats();
+    std::vector<Short> scalar(Count), array(Count);
+
+    Magnum::Test::BenchmarkTimer scalarTimer{Iterations};
+    scalarTimer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        for(std::size_t j = 0; j != Count; ++j)
+            scalar[j] = Math::pack<Short>(input[j]);
+    scalarTimer.stop();
+    const Double scalarTime = scalarTimer.milliseconds();
+
+    Magnum::Test::BenchmarkTimer arrayTimer{Iterations};
+    arrayTimer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        Math::packInto<Short>({input.data(), Count}, {array.data(), Count});
+    arrayTimer.stop();
+    const Double arrayTime = arrayTimer.milliseconds();
+
+    CORRADE_VERIFY(scalar == array);
+    print("pack<Short>()", scalarTime, arrayTime);
+}
+
+void PackingBenchmark::unpackShort() {
+    std::vector<Short> input(Count);
+    Math::packInto<Short>({floats().data(), Count}, {input.data(), Count});
+    std::vector<Float> scalar(Count), array(Count);
+
+    Magnum::Test::BenchmarkTimer scalarTimer{Iterations};
+    scalarTimer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        for(std::size_t j = 0; j != Count; ++j)
+            scalar[j] = Math::unpack<Float>(input[j]);
+    scalarTimer.stop();
+    const Double scalarTime = scalarTimer.milliseconds();
+
+    Magnum::Test::BenchmarkTimer arrayTimer{Iterations};
+    arrayTimer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        Math::unpackInto<Short>({input.data(), Count}, {array.data(), Count});
+    arrayTimer.stop();
+    const Double arrayTime = arrayTimer.milliseconds();
+
+    CORRADE_VERIFY(scalar == array);
+    print("unpack<Short>()", scalarTime, arrayTime);
+}
+
+void PackingBenchmark::packUnsignedByte() {
+    const std::vector<Float> input = floats();
+    std::vector<UnsignedByte> scalar(Count), array(Count);
+
+    Magnum::Test::BenchmarkTimer scalarTimer{Iterations};
+    scalarTimer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        for(std::size_t j = 0; j != Count; ++j)
+            scalar[j] = Math::pack<UnsignedByte>(input[j]);
+    scalarTimer.stop();
+    const Double scalarTime = scalarTimer.milliseconds();
+
+    Magnum::Test::BenchmarkTimer arrayTimer{Iterations};
+    arrayTimer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        Math::packInto<UnsignedByte>({input.data(), Count}, {array.data(), Count});
+    arrayTimer.stop();
+    const Double arrayTime = arrayTimer.milliseconds();
+
+    CORRADE_VERIFY(scalar == array);
+    print("pack<UnsignedByte>()", scalarTime, arrayTime);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::PackingBenchmark)
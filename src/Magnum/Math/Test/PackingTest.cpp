@@ -0,0 +1,260 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace Math { namespace Test {
+
+struct PackingTest: Corrade::TestSuite::Tester {
+    explicit PackingTest();
+
+    void packHalf();
+    void unpackHalf();
+    void halfVector();
+    void packUnsigned();
+    void packSigned();
+    void packVector();
+    void unpackVector();
+    void packBits();
+    void unpackBits();
+
+    void packHalfArray();
+    void unpackHalfArray();
+    void packArray();
+    void unpackArray();
+    void arraySizeMismatch();
+};
+
+typedef Math::Constants<Float> Constants;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector3<UnsignedShort> Vector3us;
+typedef Math::Vector3<Byte> Vector3b;
+
+PackingTest::PackingTest() {
+    addTests({&PackingTest::packHalf,
+              &PackingTest::unpackHalf,
+              &PackingTest::halfVector,
+              &PackingTest::packUnsigned,
+              &PackingTest::packSigned,
+              &PackingTest::packVector,
+              &PackingTest::unpackVector,
+              &PackingTest::packBits,
+              &PackingTest::unpackBits,
+
+              &PackingTest::packHalfArray,
+              &PackingTest::unpackHalfArray,
+              &PackingTest::packArray,
+              &PackingTest::unpackArray,
+              &PackingTest::arraySizeMismatch});
+}
+
+void PackingTest::packHalf() {
+    CORRADE_COMPARE(Math::packHalf(0.0f), 0x0000);
+    CORRADE_COMPARE(Math::packHalf(-0.0f), 0x8000);
+    CORRADE_COMPARE(Math::packHalf(1.0f), 0x3c00);
+    CORRADE_COMPARE(Math::packHalf(-2.5f), 0xc100);
+
+    /* Largest representable, overflow */
+    CORRADE_COMPARE(Math::packHalf(65504.0f), 0x7bff);
+    CORRADE_COMPARE(Math::packHalf(65520.0f), 0x7c00);
+    CORRADE_COMPARE(Math::packHalf(-Constants::inf()), 0xfc00);
+
+    /* Denormals, smallest denormal, tie rounded to even zero */
+    CORRADE_COMPARE(Math::packHalf(1.0e-7f), 0x0002);
+    CORRADE_COMPARE(Math::packHalf(5.96046448e-8f), 0x0001);
+    CORRADE_COMPARE(Math::packHalf(2.98023224e-8f), 0x0000);
+
+    /* Ties rounded to even */
+    CORRADE_COMPARE(Math::packHalf(1.0f + 1.0f/2048.0f), 0x3c00);
+    CORRADE_COMPARE(Math::packHalf(1.0f + 3.0f/2048.0f), 0x3c02);
+
+    CORRADE_COMPARE(Math::packHalf(Constants::nan()) & 0x7e00, 0x7e00);
+}
+
+void PackingTest::unpackHalf() {
+    CORRADE_COMPARE(Math::unpackHalf(0x0000), 0.0f);
+    CORRADE_COMPARE(Math::unpackHalf(0x3c00), 1.0f);
+    CORRADE_COMPARE(Math::unpackHalf(0xc100), -2.5f);
+    CORRADE_COMPARE(Math::unpackHalf(0x7bff), 65504.0f);
+    CORRADE_COMPARE(Math::unpackHalf(0x0001), 5.96046448e-8f);
+    CORRADE_COMPARE(Math::unpackHalf(0x03ff), 6.09755516e-5f);
+    CORRADE_COMPARE(Math::unpackHalf(0xfc00), -Constants::inf());
+    CORRADE_VERIFY(Math::unpackHalf(0x7e00) != Math::unpackHalf(0x7e00));
+
+    /* Every non-NaN value survives a roundtrip */
+    for(UnsignedInt i = 0; i != 0x10000; ++i) {
+        if((i & 0x7c00) == 0x7c00 && (i & 0x03ff)) continue;
+        if(Math::packHalf(Math::unpackHalf(i)) != i) {
+            CORRADE_COMPARE(Math::packHalf(Math::unpackHalf(i)), i);
+            break;
+        }
+    }
+}
+
+void PackingTest::halfVector() {
+    CORRADE_COMPARE(Math::packHalf(Vector3{1.0f, -2.5f, 0.0f}), (Vector3us{0x3c00, 0xc100, 0x0000}));
+    CORRADE_COMPARE(Math::unpackHalf(Vector3us{0x3c00, 0xc100, 0x0000}), (Vector3{1.0f, -2.5f, 0.0f}));
+}
+
+void PackingTest::packUnsigned() {
+    CORRADE_COMPARE((Math::pack<UnsignedByte, Float>(0.0f)), 0);
+    CORRADE_COMPARE((Math::pack<UnsignedByte, Float>(1.0f)), 255);
+    CORRADE_COMPARE((Math::pack<UnsignedShort, Float>(1.0f)), 65535);
+
+    /* Rounded, unlike denormalize() */
+    CORRADE_COMPARE((Math::pack<UnsignedByte, Float>(0.999f)), 255);
+    CORRADE_COMPARE((Math::denormalize<UnsignedByte, Float>(0.999f)), 254);
+
+    /* Clamped */
+    CORRADE_COMPARE((Math::pack<UnsignedByte, Float>(-0.5f)), 0);
+    CORRADE_COMPARE((Math::pack<UnsignedShort, Float>(1.5f)), 65535);
+}
+
+void PackingTest::packSigned() {
+    CORRADE_COMPARE((Math::pack<Byte, Float>(-1.0f)), -127);
+    CORRADE_COMPARE((Math::pack<Byte, Float>(1.0f)), 127);
+    CORRADE_COMPARE((Math::pack<Short, Float>(-1.0f)), -32767);
+    CORRADE_COMPARE((Math::pack<Short, Float>(0.0f)), 0);
+
+    /* Rounded */
+    CORRADE_COMPARE((Math::pack<Byte, Float>(-0.999f)), -127);
+
+    /* Clamped */
+    CORRADE_COMPARE((Math::pack<Byte, Float>(-2.0f)), -127);
+    CORRADE_COMPARE((Math::pack<Short, Float>(3.0f)), 32767);
+}
+
+void PackingTest::packVector() {
+    CORRADE_COMPARE((Math::pack<Vector3b>(Vector3{0.999f, -1.5f, 0.0f})), (Vector3b{127, -127, 0}));
+}
+
+void PackingTest::unpackVector() {
+    CORRADE_COMPARE((Math::unpack<Vector3, Vector3b>(Vector3b{127, -128, 0})), (Vector3{1.0f, -1.0f, 0.0f}));
+}
+
+void PackingTest::packBits() {
+    CORRADE_COMPARE((Math::pack<Int, 10>(1.0f)), 511);
+    CORRADE_COMPARE((Math::pack<Int, 10>(-1.0f)), -511);
+    CORRADE_COMPARE((Math::pack<UnsignedShort, 10>(1.0f)), 1023);
+    CORRADE_COMPARE((Math::pack<Int, 2>(-1.0f)), -1);
+
+    /* Rounded to nearest even */
+    CORRADE_COMPARE((Math::pack<Int, 10>(0.999f)), 510);
+    CORRADE_COMPARE((Math::pack<Int, 10>(-0.5f)), -256);
+    CORRADE_COMPARE((Math::pack<Int, 2>(0.6f)), 1);
+
+    /* Clamped */
+    CORRADE_COMPARE((Math::pack<Int, 10>(-2.0f)), -511);
+    CORRADE_COMPARE((Math::pack<UnsignedShort, 10>(1.5f)), 1023);
+
+    /* Full bit count is the same as without it */
+    CORRADE_COMPARE((Math::pack<Short, 16>(-0.3f)), (Math::pack<Short>(-0.3f)));
+}
+
+void PackingTest::unpackBits() {
+    CORRADE_COMPARE((Math::unpack<Float, 10>(511)), 1.0f);
+    CORRADE_COMPARE((Math::unpack<Float, 10>(-512)), -1.0f);
+    CORRADE_COMPARE((Math::unpack<Float, 10>(UnsignedShort(1023))), 1.0f);
+    CORRADE_COMPARE((Math::unpack<Float, 10>(Math::pack<Int, 10>(-0.5f))), -256.0f/511.0f);
+}
+
+void PackingTest::packHalfArray() {
+    /* Some values more than the SIMD width to test the remainder too */
+    const std::vector<Float> input{0.0f, -0.0f, 1.0f, -2.5f, 65504.0f, 65520.0f,
+        1.0e-7f, 5.96046448e-8f, 2.98023224e-8f, 1.0f + 1.0f/2048.0f,
+        Constants::inf()};
+
+    std::vector<UnsignedShort> output(input.size());
+    Math::packHalfInto({input.data(), input.size()}, {output.data(), output.size()});
+    for(std::size_t i = 0; i != input.size(); ++i)
+        CORRADE_COMPARE(output[i], Math::packHalf(input[i]));
+}
+
+void PackingTest::unpackHalfArray() {
+    std::vector<UnsignedShort> input;
+    for(UnsignedInt i = 0; i < 0x10000; i += 7) input.push_back(i);
+
+    std::vector<Float> output(input.size());
+    Math::unpackHalfInto({input.data(), input.size()}, {output.data(), output.size()});
+    for(std::size_t i = 0; i != input.size(); ++i) {
+        const Float expected = Math::unpackHalf(input[i]);
+        if(expected != expected) CORRADE_VERIFY(output[i] != output[i]);
+        else CORRADE_COMPARE(output[i], expected);
+    }
+}
+
+void PackingTest::packArray() {
+    const std::vector<Float> input{0.0f, 1.0f, -1.0f, 0.5f, -0.5f, 0.999f,
+        -0.999f, 2.0f, -2.0f, 0.25f, 1.0f/254.0f};
+
+    std::vector<Byte> b(input.size());
+    std::vector<UnsignedByte> ub(input.size());
+    std::vector<Short> s(input.size());
+    std::vector<UnsignedShort> us(input.size());
+    Math::packInto<Byte>({input.data(), input.size()}, {b.data(), b.size()});
+    Math::packInto<UnsignedByte>({input.data(), input.size()}, {ub.data(), ub.size()});
+    Math::packInto<Short>({input.data(), input.size()}, {s.data(), s.size()});
+    Math::packInto<UnsignedShort>({input.data(), input.size()}, {us.data(), us.size()});
+    for(std::size_t i = 0; i != input.size(); ++i) {
+        CORRADE_COMPARE(b[i], (Math::pack<Byte, Float>(input[i])));
+        CORRADE_COMPARE(ub[i], (Math::pack<UnsignedByte, Float>(input[i])));
+        CORRADE_COMPARE(s[i], (Math::pack<Short, Float>(input[i])));
+        CORRADE_COMPARE(us[i], (Math::pack<UnsignedShort, Float>(input[i])));
+    }
+}
+
+void PackingTest::unpackArray() {
+    const std::vector<Byte> b{0, 127, -127, -128, 64, -64, 1};
+    const std::vector<UnsignedShort> us{0, 65535, 32767, 32768, 1, 2, 65534};
+
+    std::vector<Float> output(b.size());
+    Math::unpackInto<Byte>({b.data(), b.size()}, {output.data(), output.size()});
+    for(std::size_t i = 0; i != b.size(); ++i)
+        CORRADE_COMPARE(output[i], (Math::unpack<Float, Byte>(b[i])));
+
+    Math::unpackInto<UnsignedShort>({us.data(), us.size()}, {output.data(), output.size()});
+    for(std::size_t i = 0; i != us.size(); ++i)
+        CORRADE_COMPARE(output[i], (Math::unpack<Float, UnsignedShort>(us[i])));
+}
+
+void PackingTest::arraySizeMismatch() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    std::vector<Float> input(3);
+    std::vector<Short> output(2);
+    Math::packInto<Short>({input.data(), input.size()}, {output.data(), output.size()});
+    CORRADE_COMPARE(out.str(), "Math::packInto(): expected output size 3 but got 2\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::PackingTest)
@@ -0,0 +1,129 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Batch.h"
+
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Matrix4.h"
+
+namespace Magnum { namespace MeshTools {
+
+std::pair<Trade::MeshData3D, std::vector<BatchRange>> batch(const std::vector<std::reference_wrapper<const Trade::MeshData3D>>& meshes, const std::vector<Matrix4>& transformations) {
+    CORRADE_ASSERT(!meshes.empty(), "MeshTools::batch(): no meshes passed",
+        std::make_pair(Trade::MeshData3D{MeshPrimitive::Triangles, {}, {{}}, {}, {}}, std::vector<BatchRange>{}));
+    CORRADE_ASSERT(transformations.empty() || transformations.size() == meshes.size(),
+        "MeshTools::batch(): expected" << meshes.size() << "transformations but got" << transformations.size(),
+        std::make_pair(Trade::MeshData3D{MeshPrimitive::Triangles, {}, {{}}, {}, {}}, std::vector<BatchRange>{}));
+
+    const Trade::MeshData3D& first = meshes.front();
+    CORRADE_ASSERT(first.primitive() == MeshPrimitive::Points || first.primitive() == MeshPrimitive::Lines || first.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::batch(): can't batch" << first.primitive(),
+        std::make_pair(Trade::MeshData3D{MeshPrimitive::Triangles, {}, {{}}, {}, {}}, std::vector<BatchRange>{}));
+    const bool hasNormals = first.hasNormals();
+    const bool hasTextureCoords2D = first.hasTextureCoords2D();
+
+    /* Calculate total size */
+    std::size_t indexCount = 0, vertexCount = 0;
+    for(std::size_t i = 0; i != meshes.size(); ++i) {
+        const Trade::MeshData3D& mesh = meshes[i];
+        CORRADE_ASSERT(mesh.primitive() == first.primitive() && mesh.hasNormals() == hasNormals && mesh.hasTextureCoords2D() == hasTextureCoords2D,
+            "MeshTools::batch(): mesh" << i << "has different primitive or attributes than the first one",
+            std::make_pair(Trade::MeshData3D{MeshPrimitive::Triangles, {}, {{}}, {}, {}}, std::vector<BatchRange>{}));
+
+        const std::size_t meshVertexCount = mesh.positions(0).size();
+        indexCount += mesh.isIndexed() ? mesh.indices().size() : meshVertexCount;
+        vertexCount += meshVertexCount;
+    }
+
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    std::vector<Vector3> normals;
+    std::vector<Vector2> textureCoords2D;
+    indices.reserve(indexCount);
+    positions.reserve(vertexCount);
+    if(hasNormals) normals.reserve(vertexCount);
+    if(hasTextureCoords2D) textureCoords2D.reserve(vertexCount);
+
+    std::vector<BatchRange> ranges;
+    ranges.reserve(meshes.size());
+    for(std::size_t i = 0; i != meshes.size(); ++i) {
+        const Trade::MeshData3D& mesh = meshes[i];
+        const UnsignedInt vertexOffset = positions.size();
+        const UnsignedInt meshVertexCount = mesh.positions(0).size();
+
+        /* Indices offset to the concatenated vertices */
+        BatchRange range;
+        range.indexOffset = indices.size();
+        range.vertexOffset = vertexOffset;
+        range.vertexCount = meshVertexCount;
+        if(mesh.isIndexed()) {
+            for(const UnsignedInt index: mesh.indices())
+                indices.push_back(index + vertexOffset);
+            const auto minmax = std::minmax_element(indices.begin() + range.indexOffset, indices.end());
+            range.indexStart = minmax.first == indices.end() ? vertexOffset : *minmax.first;
+            range.indexEnd = minmax.second == indices.end() ? vertexOffset : *minmax.second;
+        } else {
+            for(UnsignedInt j = 0; j != meshVertexCount; ++j)
+                indices.push_back(vertexOffset + j);
+            range.indexStart = vertexOffset;
+            range.indexEnd = meshVertexCount ? vertexOffset + meshVertexCount - 1 : vertexOffset;
+        }
+        range.indexCount = indices.size() - range.indexOffset;
+        ranges.push_back(range);
+
+        /* Vertex data, transformed if requested */
+        if(transformations.empty()) {
+            positions.insert(positions.end(), mesh.positions(0).begin(), mesh.positions(0).end());
+            if(hasNormals)
+                normals.insert(normals.end(), mesh.normals(0).begin(), mesh.normals(0).end());
+        } else {
+            const Matrix4& transformation = transformations[i];
+            for(const Vector3& position: mesh.positions(0))
+                positions.push_back(transformation.transformPoint(position));
+            if(hasNormals) {
+                const Matrix3x3 normalMatrix = transformation.rotationScaling().inverted().transposed();
+                for(const Vector3& normal: mesh.normals(0))
+                    normals.push_back((normalMatrix*normal).normalized());
+            }
+        }
+        if(hasTextureCoords2D)
+            textureCoords2D.insert(textureCoords2D.end(), mesh.textureCoords2D(0).begin(), mesh.textureCoords2D(0).end());
+    }
+
+    /* Initializer lists would copy the arrays */
+    std::vector<std::vector<Vector3>> positionArrays;
+    positionArrays.push_back(std::move(positions));
+    std::vector<std::vector<Vector3>> normalArrays;
+    if(hasNormals) normalArrays.push_back(std::move(normals));
+    std::vector<std::vector<Vector2>> textureCoordArrays;
+    if(hasTextureCoords2D) textureCoordArrays.push_back(std::move(textureCoords2D));
+
+    return std::make_pair(Trade::MeshData3D{first.primitive(), std::move(indices), std::move(positionArrays), std::move(normalArrays), std::move(textureCoordArrays)}, std::move(ranges));
+}
+
+}}
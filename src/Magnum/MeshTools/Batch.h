@@ -0,0 +1,136 @@
+#ifndef Magnum_MeshTools_Batch_h
+#define Magnum_MeshTools_Batch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::MeshTools::BatchRange, function @ref Magnum::MeshTools::batch()
+ */
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Trade/MeshData3D.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Range of batched mesh
+
+Describes where the data of one of the meshes passed to @ref batch() are in
+the batched mesh.
+*/
+struct BatchRange {
+    /**
+     * @brief Offset of the first index
+     *
+     * Pass it to @ref MeshView::setIndexRange().
+     */
+    UnsignedInt indexOffset;
+
+    /**
+     * @brief Index count
+     *
+     * Pass it to @ref MeshView::setCount().
+     */
+    UnsignedInt indexCount;
+
+    /**
+     * @brief Minimal index
+     *
+     * Pass it as `start` to @ref MeshView::setIndexRange().
+     */
+    UnsignedInt indexStart;
+
+    /**
+     * @brief Maximal index
+     *
+     * Pass it as `end` to @ref MeshView::setIndexRange().
+     */
+    UnsignedInt indexEnd;
+
+    /** @brief Offset of the first vertex */
+    UnsignedInt vertexOffset;
+
+    /** @brief Vertex count */
+    UnsignedInt vertexCount;
+};
+
+/**
+@brief Batch meshes together
+@param meshes           Meshes to batch
+@param transformations  Transformations to apply to the meshes or empty
+    vector if the meshes should be kept as they are
+@return Batched mesh and range of each mesh in it
+
+Concatenates vertex and index data of all meshes into one, so they can be
+uploaded into a single vertex and index buffer and share one vertex array
+object. The indices are offset to point to the concatenated vertices, so
+unlike with base vertex the ranges can be drawn also on OpenGL ES and WebGL.
+Only the first position, normal and texture coordinate array of each mesh is
+used, all meshes are expected to have the same primitive, which can be only
+@ref MeshPrimitive::Points, @ref MeshPrimitive::Lines or
+@ref MeshPrimitive::Triangles, and the same set of attributes. Non-indexed
+meshes are converted to indexed ones.
+
+If @p transformations are specified, the positions are transformed with
+@ref Matrix4::transformPoint() and normals with normalized inverse transpose
+of @ref Matrix4::rotationScaling(), which is useful for baking static props
+into world space.
+
+The ranges can then be drawn back to back or with a single multi-draw call:
+@code
+std::vector<std::reference_wrapper<const Trade::MeshData3D>> props;
+std::vector<Matrix4> transformations;
+
+Trade::MeshData3D batched{MeshPrimitive::Triangles, {}, {{}}, {}, {}};
+std::vector<MeshTools::BatchRange> ranges;
+std::tie(batched, ranges) = MeshTools::batch(props, transformations);
+
+Mesh mesh;
+std::unique_ptr<Buffer> vertexBuffer, indexBuffer;
+std::tie(mesh, vertexBuffer, indexBuffer) = MeshTools::compile(batched, BufferUsage::StaticDraw);
+
+std::deque<MeshView> views;
+std::vector<std::reference_wrapper<MeshView>> visible;
+for(const MeshTools::BatchRange& range: ranges) {
+    views.emplace_back(mesh);
+    views.back().setCount(range.indexCount)
+        .setIndexRange(range.indexOffset, range.indexStart, range.indexEnd);
+    visible.push_back(views.back());
+}
+
+MeshView::draw(shader, {visible.data(), visible.size()});
+@endcode
+@see @ref compile(), @ref MeshView::draw(AbstractShaderProgram&, Containers::ArrayView<const std::reference_wrapper<MeshView>>)
+*/
+MAGNUM_MESHTOOLS_EXPORT std::pair<Trade::MeshData3D, std::vector<BatchRange>> batch(const std::vector<std::reference_wrapper<const Trade::MeshData3D>>& meshes, const std::vector<Matrix4>& transformations = {});
+
+}}
+
+#endif
@@ -0,0 +1,592 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Bvh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Trade/MeshData3D.h"
+#include "Magnum/Implementation/parallelFor.h"
+#include "Magnum/Math/Implementation/lanes.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+using Math::Implementation::Lanes;
+using Math::Implementation::loadLanes;
+using Math::Implementation::storeLanes;
+using Math::Implementation::lessMask;
+using Math::Implementation::lessEqualMask;
+
+constexpr UnsignedInt BinCount = 16;
+
+/* Larger ranges are always split */
+constexpr UnsignedInt MaxLeafSize = 16;
+
+/* Below this depth only median splits are done, which limits the tree depth
+   to roughly MaxSahDepth + log2(triangle count) */
+constexpr UnsignedInt MaxSahDepth = 48;
+
+/* Ranges are split serially until there's at most MaxTaskCount of them or
+   they are smaller than MinTaskSize, then each is built on its own */
+constexpr UnsignedInt MinTaskSize = 4096;
+constexpr std::size_t MaxTaskCount = 64;
+
+/* Ranges split serially are binned in this many chunks in parallel */
+constexpr std::size_t BinningChunkCount = 16;
+
+/* Traversal pushes at most three nodes on each level, which with the depth
+   limit above fits even for 2^32 triangles */
+constexpr std::size_t StackSize = 256;
+
+Range3D emptyRange() {
+    return {Vector3{Constants::inf()}, Vector3{-Constants::inf()}};
+}
+
+Range3D join(const Range3D& a, const Range3D& b) {
+    return {Math::min(a.min(), b.min()), Math::max(a.max(), b.max())};
+}
+
+/* Half of the surface area, zero for empty ranges */
+Float halfArea(const Range3D& range) {
+    const Vector3 size = Math::max(range.size(), Vector3{});
+    return size.x()*size.y() + size.y()*size.z() + size.z()*size.x();
+}
+
+/* Triangles are tested in groups of four, so the cost is the group count */
+Float packetCost(const UnsignedInt count) {
+    return Float((count + 3)/4);
+}
+
+struct BuildNode {
+    Range3D bounds;
+    Range3D centroidBounds;
+    UnsignedInt begin, count;
+
+    /* Children are at firstChild and firstChild + 1, zero for leaves as the
+       root is never a child */
+    UnsignedInt firstChild;
+};
+
+/* Triangle bounds are partitioned directly instead of through an index
+   array so the build accesses memory sequentially */
+struct BuildItem {
+    Range3D bounds;
+    Vector3 centroid;
+    UnsignedInt triangle;
+};
+
+BuildNode makeNode(const std::vector<BuildItem>& items, const UnsignedInt begin, const UnsignedInt end) {
+    BuildNode node{emptyRange(), emptyRange(), begin, end - begin, 0};
+    for(UnsignedInt i = begin; i != end; ++i) {
+        node.bounds = join(node.bounds, items[i].bounds);
+        node.centroidBounds = join(node.centroidBounds, {items[i].centroid, items[i].centroid});
+    }
+    return node;
+}
+
+UnsignedInt binIndex(const BuildItem& item, const Vector3& offset, const Vector3& scale, const UnsignedInt axis) {
+    return Math::min(UnsignedInt((item.centroid[axis] - offset[axis])*scale[axis]), BinCount - 1);
+}
+
+struct Bins {
+    UnsignedInt counts[3][BinCount];
+    Range3D bounds[3][BinCount];
+};
+
+void clearBins(Bins& bins) {
+    for(UnsignedInt axis = 0; axis != 3; ++axis) {
+        std::fill_n(bins.counts[axis], BinCount, 0);
+        std::fill_n(bins.bounds[axis], BinCount, emptyRange());
+    }
+}
+
+/* Axes with zero scale have zero extent and aren't binned */
+void binItems(const BuildItem* const items, const std::size_t count, const Vector3& offset, const Vector3& scale, Bins& bins) {
+    for(std::size_t i = 0; i != count; ++i) {
+        for(UnsignedInt axis = 0; axis != 3; ++axis) {
+            if(!scale[axis]) continue;
+            const UnsignedInt b = binIndex(items[i], offset, scale, axis);
+            ++bins.counts[axis][b];
+            bins.bounds[axis][b] = join(bins.bounds[axis][b], items[i].bounds);
+        }
+    }
+}
+
+/* Partitions the triangles in the node, returns count of triangles in the
+   left child or zero if the node should be a leaf. Large nodes are binned
+   in parallel, merging the bins doesn't depend on their order so the result
+   is always the same. */
+UnsignedInt split(std::vector<BuildItem>& allItems, const BuildNode& node, const UnsignedInt depth, const UnsignedInt threadCount) {
+    BuildItem* const items = allItems.data() + node.begin;
+    const UnsignedInt count = node.count;
+
+    /* A single group of four triangles is never worth splitting, as the
+       split cost includes the cost of the node itself */
+    if(count <= 4) return 0;
+
+    const Vector3 offset = node.centroidBounds.min();
+    const Vector3 extent = node.centroidBounds.size();
+    Vector3 scale;
+    for(UnsignedInt axis = 0; axis != 3; ++axis)
+        scale[axis] = extent[axis] > 0.0f ? BinCount/extent[axis] : 0.0f;
+
+    /* Binned surface area heuristic on all three axes at once */
+    if(depth < MaxSahDepth) {
+        Bins bins;
+        clearBins(bins);
+        if(threadCount == 1 || count < MinTaskSize) {
+            binItems(items, count, offset, scale, bins);
+        } else {
+            std::vector<Bins> chunks(BinningChunkCount);
+            Magnum::Implementation::parallelFor(BinningChunkCount, threadCount, [&](std::size_t begin, std::size_t end) {
+                for(std::size_t i = begin; i != end; ++i) {
+                    const std::size_t chunkBegin = count*i/BinningChunkCount;
+                    const std::size_t chunkEnd = count*(i + 1)/BinningChunkCount;
+                    clearBins(chunks[i]);
+                    binItems(items + chunkBegin, chunkEnd - chunkBegin, offset, scale, chunks[i]);
+                }
+            });
+            for(const Bins& chunk: chunks) for(UnsignedInt axis = 0; axis != 3; ++axis) {
+                for(UnsignedInt b = 0; b != BinCount; ++b) {
+                    bins.counts[axis][b] += chunk.counts[axis][b];
+                    bins.bounds[axis][b] = join(bins.bounds[axis][b], chunk.bounds[axis][b]);
+                }
+            }
+        }
+
+        Float bestCost = Constants::inf();
+        UnsignedInt bestAxis{}, bestPlane{};
+        for(UnsignedInt axis = 0; axis != 3; ++axis) {
+            if(!(extent[axis] > 0.0f)) continue;
+
+            /* Cost of everything right of each plane, then sweep from the
+               left and evaluate each plane that splits the range into two
+               non-empty halves */
+            Float rightCost[BinCount];
+            Range3D right = emptyRange();
+            UnsignedInt rightCount = 0;
+            for(UnsignedInt plane = BinCount - 1; plane != 0; --plane) {
+                right = join(right, bins.bounds[axis][plane]);
+                rightCount += bins.counts[axis][plane];
+                rightCost[plane] = halfArea(right)*packetCost(rightCount);
+            }
+
+            Range3D left = emptyRange();
+            UnsignedInt leftCount = 0;
+            for(UnsignedInt plane = 1; plane != BinCount; ++plane) {
+                left = join(left, bins.bounds[axis][plane - 1]);
+                leftCount += bins.counts[axis][plane - 1];
+                if(!leftCount || leftCount == count) continue;
+
+                const Float cost = halfArea(left)*packetCost(leftCount) + rightCost[plane];
+                if(cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestPlane = plane;
+                }
+            }
+        }
+
+        if(bestCost != Constants::inf()) {
+            /* Splitting costs one more node test */
+            const Float area = halfArea(node.bounds);
+            if(count <= MaxLeafSize && area*packetCost(count) <= area + bestCost)
+                return 0;
+
+            return UnsignedInt(std::partition(items, items + count, [&](const BuildItem& item) {
+                return binIndex(item, offset, scale, bestAxis) < bestPlane;
+            }) - items);
+        }
+    }
+
+    if(count <= MaxLeafSize) return 0;
+
+    /* Median split on the axis with the largest extent, ties broken by ID
+       so the result is always the same */
+    const UnsignedInt axis = extent.x() >= extent.y() && extent.x() >= extent.z() ? 0 :
+        extent.y() >= extent.z() ? 1 : 2;
+    const UnsignedInt half = count/2;
+    std::nth_element(items, items + half, items + count, [axis](const BuildItem& a, const BuildItem& b) {
+        return a.centroid[axis] < b.centroid[axis] || (a.centroid[axis] == b.centroid[axis] && a.triangle < b.triangle);
+    });
+    return half;
+}
+
+/* Returns false if the node should be a leaf, otherwise appends its two
+   children */
+bool splitNode(std::vector<BuildItem>& items, std::vector<BuildNode>& nodes, const std::size_t index, const UnsignedInt depth, const UnsignedInt threadCount = 1) {
+    const UnsignedInt leftCount = split(items, nodes[index], depth, threadCount);
+    if(!leftCount) return false;
+
+    const UnsignedInt begin = nodes[index].begin;
+    const UnsignedInt middle = begin + leftCount;
+    const UnsignedInt end = begin + nodes[index].count;
+    nodes[index].firstChild = UnsignedInt(nodes.size());
+    nodes.push_back(makeNode(items, begin, middle));
+    nodes.push_back(makeNode(items, middle, end));
+    return true;
+}
+
+void buildRecursive(std::vector<BuildItem>& items, std::vector<BuildNode>& nodes, const std::size_t index, const UnsignedInt depth) {
+    if(!splitNode(items, nodes, index, depth)) return;
+
+    const UnsignedInt firstChild = nodes[index].firstChild;
+    buildRecursive(items, nodes, firstChild, depth + 1);
+    buildRecursive(items, nodes, firstChild + 1, depth + 1);
+}
+
+struct Ray {
+    Lanes origin[3];
+    Lanes direction[3];
+    Lanes invertedDirection[3];
+};
+
+Ray makeRay(const Vector3& origin, const Vector3& direction) {
+    Ray ray;
+    for(std::size_t i = 0; i != 3; ++i) {
+        ray.origin[i] = Lanes{origin[i]};
+        ray.direction[i] = Lanes{direction[i]};
+
+        /* Avoid 0*inf = NaN for rays going exactly along a box face */
+        const Float d = std::abs(direction[i]) < 1.0e-30f ? std::copysign(1.0e-30f, direction[i]) : direction[i];
+        ray.invertedDirection[i] = Lanes{1.0f/d};
+    }
+    return ray;
+}
+
+/* Slab test of four boxes, returns a mask of boxes hit in [0, maxDistance]
+   and their entry distances */
+Int boxMask(const Float(&min)[3][4], const Float(&max)[3][4], const Ray& ray, const Float maxDistance, Float(&distances)[4]) {
+    Lanes tNear{0.0f}, tFar{maxDistance};
+    for(std::size_t i = 0; i != 3; ++i) {
+        const Lanes t1 = (loadLanes(min[i]) - ray.origin[i])*ray.invertedDirection[i];
+        const Lanes t2 = (loadLanes(max[i]) - ray.origin[i])*ray.invertedDirection[i];
+        tNear = Math::Implementation::max(tNear, Math::Implementation::min(t1, t2));
+        tFar = Math::Implementation::min(tFar, Math::Implementation::max(t1, t2));
+    }
+    storeLanes(tNear, distances);
+    return lessEqualMask(tNear, tFar);
+}
+
+inline void cross(const Lanes(&a)[3], const Lanes(&b)[3], Lanes(&out)[3]) {
+    out[0] = a[1]*b[2] - a[2]*b[1];
+    out[1] = a[2]*b[0] - a[0]*b[2];
+    out[2] = a[0]*b[1] - a[1]*b[0];
+}
+
+inline Lanes dot(const Lanes(&a)[3], const Lanes(&b)[3]) {
+    return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+}
+
+/* Möller-Trumbore test of four triangles, same as
+   Math::Geometry::Intersection::triangleLine(). Returns a mask of triangles
+   hit in [0, maxDistance), degenerate triangles are never hit. */
+Int triangleMask(const Float(&a)[3][4], const Float(&e1)[3][4], const Float(&e2)[3][4], const Ray& ray, const Float maxDistance, Float(&t)[4], Float(&u)[4], Float(&v)[4]) {
+    Lanes e1l[3], e2l[3], tvec[3];
+    for(std::size_t i = 0; i != 3; ++i) {
+        e1l[i] = loadLanes(e1[i]);
+        e2l[i] = loadLanes(e2[i]);
+        tvec[i] = ray.origin[i] - loadLanes(a[i]);
+    }
+
+    Lanes pvec[3], qvec[3];
+    cross(ray.direction, e2l, pvec);
+    cross(tvec, e1l, qvec);
+    const Lanes det = dot(pvec, e1l);
+    const Lanes invDet = Lanes{1.0f}/det;
+    const Lanes tl = dot(qvec, e2l)*invDet;
+    const Lanes ul = dot(pvec, tvec)*invDet;
+    const Lanes vl = dot(qvec, ray.direction)*invDet;
+    storeLanes(tl, t);
+    storeLanes(ul, u);
+    storeLanes(vl, v);
+
+    const Lanes zero{0.0f};
+    return lessMask(zero, Math::Implementation::abs(det)) &
+        lessEqualMask(zero, ul) & lessEqualMask(zero, vl) &
+        lessEqualMask(ul + vl, Lanes{1.0f}) &
+        lessEqualMask(zero, tl) & lessMask(tl, Lanes{maxDistance});
+}
+
+}
+
+Bvh::Bvh(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const UnsignedInt threadCount): _triangleCount{} {
+    build(indices, positions, threadCount);
+}
+
+Bvh::Bvh(const Trade::MeshData3D& meshData, const UnsignedInt threadCount): _triangleCount{} {
+    CORRADE_ASSERT(meshData.primitive() == MeshPrimitive::Triangles && meshData.isIndexed(),
+        "MeshTools::Bvh::Bvh(): expected indexed triangle mesh", );
+
+    build(meshData.indices(), meshData.positions(0), threadCount);
+}
+
+void Bvh::build(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::Bvh::Bvh(): index count is not divisible by 3!", );
+    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
+    for(const UnsignedInt index: indices)
+        CORRADE_ASSERT(index < positions.size(), "MeshTools::Bvh::Bvh(): index" << index << "out of bounds for" << positions.size() << "vertices", );
+    #endif
+
+    const UnsignedInt triangleCount = UnsignedInt(indices.size()/3);
+    if(!triangleCount) return;
+
+    /* Triangle bounds and centroids */
+    std::vector<BuildItem> items(triangleCount);
+    Magnum::Implementation::parallelFor(triangleCount, threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) {
+            const Vector3 a = positions[indices[i*3]];
+            const Vector3 b = positions[indices[i*3 + 1]];
+            const Vector3 c = positions[indices[i*3 + 2]];
+            items[i].bounds = {Math::min(Math::min(a, b), c), Math::max(Math::max(a, b), c)};
+            items[i].centroid = items[i].bounds.center();
+            items[i].triangle = UnsignedInt(i);
+        }
+    });
+
+    std::vector<BuildNode> nodes{makeNode(items, 0, triangleCount)};
+
+    /* Split the largest ranges serially until there's enough of them to
+       build in parallel. This is done the same way regardless of thread
+       count so the tree is always the same. */
+    struct Task {
+        std::size_t node;
+        UnsignedInt depth;
+    };
+    std::vector<Task> tasks{{0, 0}};
+    while(tasks.size() < MaxTaskCount) {
+        const auto largest = std::max_element(tasks.begin(), tasks.end(), [&nodes](const Task& a, const Task& b) {
+            return nodes[a.node].count < nodes[b.node].count;
+        });
+        const Task task = *largest;
+        if(nodes[task.node].count < MinTaskSize || !splitNode(items, nodes, task.node, task.depth, threadCount))
+            break;
+
+        const UnsignedInt firstChild = nodes[task.node].firstChild;
+        *largest = {firstChild, task.depth + 1};
+        tasks.push_back({firstChild + 1, task.depth + 1});
+    }
+
+    std::vector<std::vector<BuildNode>> subtrees(tasks.size());
+    Magnum::Implementation::parallelFor(tasks.size(), threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) {
+            subtrees[i].push_back(nodes[tasks[i].node]);
+            buildRecursive(items, subtrees[i], 0, tasks[i].depth);
+        }
+    });
+
+    /* Put the subtrees in place of the task nodes */
+    for(std::size_t i = 0; i != tasks.size(); ++i) {
+        const UnsignedInt offset = UnsignedInt(nodes.size()) - 1;
+        for(std::size_t j = 0; j != subtrees[i].size(); ++j) {
+            BuildNode node = subtrees[i][j];
+            if(node.firstChild) node.firstChild += offset;
+            if(j) nodes.push_back(node);
+            else nodes[tasks[i].node] = node;
+        }
+    }
+
+    /* Collapse the binary tree so each node has up to four children, always
+       expanding the child with the largest surface area. Triangles of each
+       leaf are put into groups of four. */
+    _nodes.emplace_back();
+    std::vector<std::pair<std::size_t, std::size_t>> stack{{0, 0}};
+    while(!stack.empty()) {
+        const std::size_t binary = stack.back().first;
+        const std::size_t wide = stack.back().second;
+        stack.pop_back();
+
+        std::size_t children[4]{binary};
+        std::size_t childCount = 1;
+        while(childCount != 4) {
+            std::size_t expand = childCount;
+            for(std::size_t i = 0; i != childCount; ++i) {
+                if(!nodes[children[i]].firstChild) continue;
+                if(expand == childCount || halfArea(nodes[children[i]].bounds) > halfArea(nodes[children[expand]].bounds))
+                    expand = i;
+            }
+            if(expand == childCount) break;
+
+            const UnsignedInt firstChild = nodes[children[expand]].firstChild;
+            children[expand] = firstChild;
+            children[childCount++] = firstChild + 1;
+        }
+
+        _nodes[wide].childCount = UnsignedInt(childCount);
+        for(std::size_t i = 0; i != childCount; ++i) {
+            const BuildNode& child = nodes[children[i]];
+            for(std::size_t axis = 0; axis != 3; ++axis) {
+                _nodes[wide].min[axis][i] = child.bounds.min()[axis];
+                _nodes[wide].max[axis][i] = child.bounds.max()[axis];
+            }
+
+            if(child.firstChild) {
+                _nodes[wide].children[i] = Int(_nodes.size());
+                stack.emplace_back(children[i], _nodes.size());
+                _nodes.emplace_back();
+                continue;
+            }
+
+            _nodes[wide].children[i] = ~Int(_packets.size());
+            _nodes[wide].packetCounts[i] = (child.count + 3)/4;
+            for(UnsignedInt j = 0; j < child.count; j += 4) {
+                Packet packet{};
+                for(UnsignedInt lane = 0; lane != 4; ++lane) {
+                    if(j + lane >= child.count) {
+                        packet.triangles[lane] = ~UnsignedInt{};
+                        continue;
+                    }
+
+                    const UnsignedInt triangle = items[child.begin + j + lane].triangle;
+                    const Vector3 a = positions[indices[triangle*3]];
+                    const Vector3 e1 = positions[indices[triangle*3 + 1]] - a;
+                    const Vector3 e2 = positions[indices[triangle*3 + 2]] - a;
+                    for(std::size_t axis = 0; axis != 3; ++axis) {
+                        packet.a[axis][lane] = a[axis];
+                        packet.e1[axis][lane] = e1[axis];
+                        packet.e2[axis][lane] = e2[axis];
+                    }
+                    packet.triangles[lane] = triangle;
+                }
+                _packets.push_back(packet);
+            }
+        }
+    }
+
+    _triangleCount = triangleCount;
+    _bounds = nodes[0].bounds;
+}
+
+BvhHit Bvh::closestHit(const Vector3& origin, const Vector3& direction, const Float maxDistance) const {
+    BvhHit hit{~UnsignedInt{}, Constants::inf(), {}};
+    if(_nodes.empty()) return hit;
+
+    const Ray ray = makeRay(origin, direction);
+    Float closest = maxDistance;
+
+    struct Entry {
+        Int node;
+        Float distance;
+    } stack[StackSize];
+    std::size_t stackSize = 1;
+    stack[0] = {0, 0.0f};
+    while(stackSize) {
+        const Entry entry = stack[--stackSize];
+        if(entry.distance >= closest) continue;
+
+        const Node& node = _nodes[entry.node];
+        Float distances[4];
+        const Int mask = boxMask(node.min, node.max, ray, closest, distances) & ((1 << node.childCount) - 1);
+
+        Entry children[4];
+        std::size_t childCount = 0;
+        for(std::size_t i = 0; i != 4; ++i) {
+            if(!(mask & (1 << i))) continue;
+
+            if(node.children[i] >= 0) {
+                children[childCount++] = {node.children[i], distances[i]};
+                continue;
+            }
+
+            const UnsignedInt first = ~node.children[i];
+            for(UnsignedInt j = first; j != first + node.packetCounts[i]; ++j) {
+                const Packet& packet = _packets[j];
+                Float t[4], u[4], v[4];
+                const Int hitMask = triangleMask(packet.a, packet.e1, packet.e2, ray, closest, t, u, v);
+                for(std::size_t lane = 0; lane != 4; ++lane) {
+                    if(!(hitMask & (1 << lane)) || !(t[lane] < closest)) continue;
+                    closest = t[lane];
+                    hit = {packet.triangles[lane], t[lane], {u[lane], v[lane]}};
+                }
+            }
+        }
+
+        /* Sort the children from the farthest and push them so the nearest
+           is processed next */
+        for(std::size_t i = 1; i < childCount; ++i) {
+            const Entry child = children[i];
+            std::size_t j = i;
+            for(; j && children[j - 1].distance < child.distance; --j)
+                children[j] = children[j - 1];
+            children[j] = child;
+        }
+        for(std::size_t i = 0; i != childCount; ++i)
+            stack[stackSize++] = children[i];
+    }
+
+    return hit;
+}
+
+bool Bvh::anyHit(const Vector3& origin, const Vector3& direction, const Float maxDistance) const {
+    if(_nodes.empty()) return false;
+
+    const Ray ray = makeRay(origin, direction);
+
+    Int stack[StackSize];
+    std::size_t stackSize = 1;
+    stack[0] = 0;
+    while(stackSize) {
+        const Node& node = _nodes[stack[--stackSize]];
+        Float distances[4];
+        const Int mask = boxMask(node.min, node.max, ray, maxDistance, distances) & ((1 << node.childCount) - 1);
+
+        for(std::size_t i = 0; i != 4; ++i) {
+            if(!(mask & (1 << i))) continue;
+
+            if(node.children[i] >= 0) {
+                stack[stackSize++] = node.children[i];
+                continue;
+            }
+
+            const UnsignedInt first = ~node.children[i];
+            for(UnsignedInt j = first; j != first + node.packetCounts[i]; ++j) {
+                const Packet& packet = _packets[j];
+                Float t[4], u[4], v[4];
+                if(triangleMask(packet.a, packet.e1, packet.e2, ray, maxDistance, t, u, v))
+                    return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void Bvh::closestHitInto(const Containers::ArrayView<const Vector3> origins, const Containers::ArrayView<const Vector3> directions, const Containers::ArrayView<BvhHit> hits, const Float maxDistance, const UnsignedInt threadCount) const {
+    CORRADE_ASSERT(origins.size() == directions.size() && origins.size() == hits.size(),
+        "MeshTools::Bvh::closestHitInto(): array sizes don't match, got" << origins.size() << directions.size() << "and" << hits.size(), );
+
+    Magnum::Implementation::parallelFor(origins.size(), threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i)
+            hits[i] = closestHit(origins[i], directions[i], maxDistance);
+    });
+}
+
+}}
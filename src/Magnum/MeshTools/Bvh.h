@@ -0,0 +1,235 @@
+#ifndef Magnum_MeshTools_Bvh_h
+#define Magnum_MeshTools_Bvh_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::MeshTools::Bvh, struct @ref Magnum::MeshTools::BvhHit
+ */
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Ray hit
+
+Result of @ref Bvh::closestHit().
+*/
+struct BvhHit {
+    /**
+     * @brief Triangle ID
+     *
+     * Index of the first vertex index of the triangle divided by three.
+     * `0xffffffffu` if nothing was hit.
+     */
+    UnsignedInt triangle;
+
+    /**
+     * @brief Distance
+     *
+     * Position of the hit on the ray in units of ray direction length, i.e.
+     * the hit point is `origin + distance*direction`. Infinity if nothing was
+     * hit.
+     */
+    Float distance;
+
+    /**
+     * @brief Barycentric coordinates
+     *
+     * Coordinates of the hit point relative to the second and third vertex of
+     * the triangle, the hit point is
+     * `(1 - u - v)*a + u*b + v*c`. Use them to interpolate vertex attributes
+     * at the hit point.
+     */
+    Vector2 barycentric;
+
+    /** @brief Whether anything was hit */
+    explicit operator bool() const { return triangle != ~UnsignedInt{}; }
+};
+
+/**
+@brief Bounding volume hierarchy for ray queries on a triangle mesh
+
+Bounding volume hierarchy over mesh triangles for fast picking and visibility
+queries. Only triangle indices and vertex positions are used during the
+build, the mesh data don't need to be kept around afterwards.
+
+@code
+std::optional<Trade::MeshData3D> data = importer.mesh3D(0);
+MeshTools::Bvh bvh{*data};
+
+// ray from the camera through the cursor, in mesh space
+BvhHit hit = bvh.closestHit(origin, direction);
+if(hit) {
+    Vector3 position = origin + hit.distance*direction;
+    // ...
+}
+@endcode
+
+@section MeshTools-Bvh-build Building
+
+The tree is built top-down using binned surface area heuristic, splitting on
+the axis and plane with the lowest expected cost. Ranges that can't be split
+reasonably (e.g. all triangles having the same centroid) fall back to a median
+split. The resulting binary tree is then collapsed into a tree with four
+children in each node and its leaves contain triangles in groups of four, so
+one node and one triangle group is tested against a ray with a single pass of
+SSE2 instructions. Without SSE2 the same code is executed as plain loops.
+
+If @p threadCount is not `1` and Magnum is built with `BUILD_MULTITHREADED`
+(see @ref building), the upper levels of the tree are split serially and the
+resulting subtrees are then built in parallel. The resulting tree doesn't
+depend on thread count, so queries return the same results in both cases.
+
+@section MeshTools-Bvh-queries Queries
+
+Both front and back faces of the triangles are hit, see
+@ref Math::Geometry::Intersection::triangleLine() for details about the
+intersection test. Line segment from @f$ \boldsymbol a @f$ to
+@f$ \boldsymbol b @f$ is queried by passing @f$ \boldsymbol a @f$ as origin,
+@f$ \boldsymbol b - \boldsymbol a @f$ as direction and `1.0f` as max distance.
+The queries are `const` and thus can be done from multiple threads at
+once, @ref closestHitInto() does that for many rays.
+*/
+class MAGNUM_MESHTOOLS_EXPORT Bvh {
+    public:
+        /**
+         * @brief Constructor
+         * @param indices       Triangle indices
+         * @param positions     Vertex positions
+         * @param threadCount   Count of threads to use, `0` means hardware
+         *      concurrency
+         *
+         * Expects that index count is divisible by three and all indices are
+         * in bounds.
+         */
+        explicit Bvh(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, UnsignedInt threadCount = 1);
+
+        /**
+         * @brief Construct from mesh data
+         * @param meshData      Mesh data
+         * @param threadCount   Count of threads to use, `0` means hardware
+         *      concurrency
+         *
+         * Uses the index array and the first position array. Expects that the
+         * mesh is indexed @ref MeshPrimitive::Triangles.
+         */
+        explicit Bvh(const Trade::MeshData3D& meshData, UnsignedInt threadCount = 1);
+
+        /** @brief Triangle count */
+        std::size_t triangleCount() const { return _triangleCount; }
+
+        /**
+         * @brief Node count
+         *
+         * Each node has up to four children.
+         */
+        std::size_t nodeCount() const { return _nodes.size(); }
+
+        /**
+         * @brief Bounds of all triangles
+         *
+         * Zero range if the mesh is empty.
+         */
+        Range3D bounds() const { return _bounds; }
+
+        /**
+         * @brief Closest hit along a ray
+         * @param origin        Ray origin
+         * @param direction     Ray direction, doesn't need to be normalized
+         * @param maxDistance   Max distance in units of direction length
+         *
+         * Returns the hit closest to @p origin with distance in range
+         * @f$ [ 0 ; maxDistance ) @f$.
+         * @see @ref anyHit(), @ref closestHitInto()
+         */
+        BvhHit closestHit(const Vector3& origin, const Vector3& direction, Float maxDistance = Constants::inf()) const;
+
+        /**
+         * @brief Whether a ray hits anything
+         *
+         * Like @ref closestHit(), but stops at the first hit found, which is
+         * faster e.g. for visibility queries.
+         */
+        bool anyHit(const Vector3& origin, const Vector3& direction, Float maxDistance = Constants::inf()) const;
+
+        /**
+         * @brief Closest hit along many rays
+         * @param[in] origins       Ray origins
+         * @param[in] directions    Ray directions
+         * @param[out] hits         Where to put the hits
+         * @param[in] maxDistance   Max distance in units of direction length
+         * @param[in] threadCount   Count of threads to use, `0` means
+         *      hardware concurrency
+         *
+         * Equivalent to calling @ref closestHit() for each ray, but with the
+         * rays distributed among @p threadCount threads. Expects that all
+         * arrays have the same size.
+         */
+        void closestHitInto(Containers::ArrayView<const Vector3> origins, Containers::ArrayView<const Vector3> directions, Containers::ArrayView<BvhHit> hits, Float maxDistance = Constants::inf(), UnsignedInt threadCount = 1) const;
+
+    private:
+        /* Bounds of up to four children in structure-of-arrays layout.
+           Non-negative child is index of another node, negative child is
+           bitwise-negated offset of the first triangle group with the group
+           count in packetCounts. */
+        struct Node {
+            Float min[3][4];
+            Float max[3][4];
+            Int children[4];
+            UnsignedInt packetCounts[4];
+            UnsignedInt childCount;
+        };
+
+        /* Four triangles as first vertex and two edges in
+           structure-of-arrays layout, unused lanes are degenerate triangles
+           with ~0 ID */
+        struct Packet {
+            Float a[3][4];
+            Float e1[3][4];
+            Float e2[3][4];
+            UnsignedInt triangles[4];
+        };
+
+        void build(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, UnsignedInt threadCount);
+
+        std::vector<Node> _nodes;
+        std::vector<Packet> _packets;
+        std::size_t _triangleCount;
+        Range3D _bounds;
+};
+
+}}
+
+#endif
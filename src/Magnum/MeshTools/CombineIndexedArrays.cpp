@@ -25,12 +25,12 @@
 
 #include "CombineIndexedArrays.h"
 
+#include <algorithm>
 #include <cstring>
-#include <unordered_map>
 #include <Corrade/Utility/Assert.h>
-#include <Corrade/Utility/MurmurHash2.h>
 
 #include "Magnum/Magnum.h"
+#include "Magnum/Implementation/parallelFor.h"
 
 namespace Magnum { namespace MeshTools {
 
@@ -87,68 +87,137 @@ std::vector<UnsignedInt> combineIndexArrays(const std::reference_wrapper<std::ve
 
 namespace {
 
-class IndexHash {
-    public:
-        explicit IndexHash(const std::vector<UnsignedInt>& indices, UnsignedInt stride): indices(indices), stride(stride) {}
-
-        std::size_t operator()(UnsignedInt key) const {
-            return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2()(reinterpret_cast<const char*>(indices.data()+key*stride), sizeof(UnsignedInt)*stride).byteArray());
-        }
+/* Multiply-shift mix of each index, finalized with MurmurHash3 64-bit
+   finalizer */
+inline UnsignedLong hashIndices(const UnsignedInt* const indices, const UnsignedInt stride) {
+    UnsignedLong hash = 0x9e3779b97f4a7c15ull ^ stride;
+    for(UnsignedInt i = 0; i != stride; ++i) {
+        hash = (hash ^ indices[i])*0xff51afd7ed558ccdull;
+        hash ^= hash >> 32;
+    }
 
-    private:
-        const std::vector<UnsignedInt>& indices;
-        UnsignedInt stride;
-};
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
 
-class IndexEqual {
+/* Flat open-addressing hash table with linear probing, containing just
+   indices into the interleaved array. Sized for given count of insertions
+   upfront, so it never needs to grow. */
+class IndexTable {
     public:
-        explicit IndexEqual(const std::vector<UnsignedInt>& indices, UnsignedInt stride): indices(indices), stride(stride) {}
+        explicit IndexTable(const std::vector<UnsignedInt>& interleavedArrays, const UnsignedInt stride, const std::size_t count): _interleavedArrays(interleavedArrays), _stride(stride) {
+            std::size_t capacity = 2;
+            while(capacity < count*2) capacity <<= 1;
+            _mask = capacity - 1;
+            _slots.resize(capacity, Empty);
+        }
 
-        bool operator()(UnsignedInt a, UnsignedInt b) const {
-            return std::memcmp(indices.data()+a*stride, indices.data()+b*stride, sizeof(UnsignedInt)*stride) == 0;
+        /* Returns index of first occurence of the same index combination,
+           inserting the index if not already present */
+        UnsignedInt insert(const UnsignedInt index, const UnsignedLong hash) {
+            const UnsignedInt* const data = _interleavedArrays.data() + index*_stride;
+            for(std::size_t slot = hash & _mask; ; slot = (slot + 1) & _mask) {
+                UnsignedInt& existing = _slots[slot];
+                if(existing == Empty) return existing = index;
+                if(std::memcmp(_interleavedArrays.data() + existing*_stride, data, sizeof(UnsignedInt)*_stride) == 0)
+                    return existing;
+            }
         }
 
     private:
-        const std::vector<UnsignedInt>& indices;
-        UnsignedInt stride;
+        enum: UnsignedInt { Empty = ~UnsignedInt{} };
+
+        const std::vector<UnsignedInt>& _interleavedArrays;
+        const UnsignedInt _stride;
+        std::size_t _mask;
+        std::vector<UnsignedInt> _slots;
 };
 
 }
 
-std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> combineIndexArrays(const std::vector<UnsignedInt>& interleavedArrays, const UnsignedInt stride) {
+std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> combineIndexArrays(const std::vector<UnsignedInt>& interleavedArrays, const UnsignedInt stride, const UnsignedInt threadCount) {
     CORRADE_ASSERT(stride != 0, "MeshTools::combineIndexArrays(): stride can't be zero", {});
     CORRADE_ASSERT(interleavedArrays.size() % stride == 0, "MeshTools::combineIndexArrays(): array size is not divisible by stride", {});
 
-    /* Hash map with index combinations, containing just indices into
-       interleavedArrays vector, hashing and comparison is done using IndexHash
-       and IndexEqual functors. Reserving more buckets than necessary (i.e. as
-       if each combination was unique). */
-    std::unordered_map<UnsignedInt, UnsignedInt, IndexHash, IndexEqual> indexCombinations(
-        interleavedArrays.size()/stride,
-        IndexHash(interleavedArrays, stride),
-        IndexEqual(interleavedArrays, stride));
+    /* For each index combination find first occurence of it. The table is
+       sized as if each combination was unique. */
+    const std::size_t count = interleavedArrays.size()/stride;
+    std::vector<UnsignedInt> combinedIndices(count);
+
+    /* Not worth going parallel for small arrays */
+    #ifdef MAGNUM_BUILD_MULTITHREADED
+    const bool parallel = threadCount != 1 && count >= 65536;
+    #else
+    static_cast<void>(threadCount);
+    const bool parallel = false;
+    #endif
+
+    if(!parallel) {
+        IndexTable table{interleavedArrays, stride, count};
+        for(std::size_t i = 0; i != count; ++i)
+            combinedIndices[i] = table.insert(UnsignedInt(i), hashIndices(interleavedArrays.data() + i*stride, stride));
+
+    /* Partition the combinations by hash prefix, each partition can be then
+       processed independently */
+    } else {
+        enum: UnsignedInt {
+            PartitionBits = 6,
+            PartitionCount = 1 << PartitionBits
+        };
+
+        std::vector<UnsignedLong> hashes(count);
+        Magnum::Implementation::parallelFor(count, threadCount, [&](std::size_t begin, std::size_t end) {
+            for(std::size_t i = begin; i != end; ++i)
+                hashes[i] = hashIndices(interleavedArrays.data() + i*stride, stride);
+        });
+
+        /* Counting sort of the indices by partition, preserving order */
+        std::size_t offsets[PartitionCount + 1]{};
+        for(const UnsignedLong hash: hashes)
+            ++offsets[(hash >> (64 - PartitionBits)) + 1];
+        for(std::size_t i = 0; i != PartitionCount; ++i)
+            offsets[i + 1] += offsets[i];
+        std::vector<UnsignedInt> partitioned(count);
+        {
+            std::size_t positions[PartitionCount];
+            std::copy(offsets, offsets + PartitionCount, positions);
+            for(std::size_t i = 0; i != count; ++i)
+                partitioned[positions[hashes[i] >> (64 - PartitionBits)]++] = UnsignedInt(i);
+        }
+
+        Magnum::Implementation::parallelFor(PartitionCount, threadCount, [&](std::size_t begin, std::size_t end) {
+            for(std::size_t partition = begin; partition != end; ++partition) {
+                IndexTable table{interleavedArrays, stride, offsets[partition + 1] - offsets[partition]};
+                for(std::size_t i = offsets[partition]; i != offsets[partition + 1]; ++i)
+                    combinedIndices[partitioned[i]] = table.insert(partitioned[i], hashes[partitioned[i]]);
+            }
+        });
+    }
 
     /* Make the index combinations unique. Original indices into original
        `interleavedArrays` array were 0, 1, 2, 3, ..., `combinedIndices`
-       contains new ones into new (shorter) `newInterleavedArrays` array. */
-    std::vector<UnsignedInt> combinedIndices;
-    combinedIndices.reserve(interleavedArrays.size()/stride);
+       contains new ones into new (shorter) `newInterleavedArrays` array. The
+       first occurence is always before or at current index, so its new
+       index is already known. */
     std::vector<UnsignedInt> newInterleavedArrays;
-    for(std::size_t oldIndex = 0, end = interleavedArrays.size()/stride; oldIndex != end; ++oldIndex) {
-        /* Try to insert new index combination to the map */
-        const auto result = indexCombinations.emplace(oldIndex, indexCombinations.size());
-
-        /* Add the (either new or already existing) index to resulting index array */
-        combinedIndices.push_back(result.first->second);
+    UnsignedInt newCount = 0;
+    for(std::size_t oldIndex = 0; oldIndex != count; ++oldIndex) {
+        const UnsignedInt first = combinedIndices[oldIndex];
+        if(first != oldIndex) {
+            combinedIndices[oldIndex] = combinedIndices[first];
+            continue;
+        }
 
-        /* If this is new combination, copy it to new interleaved arrays */
-        if(result.second) newInterleavedArrays.insert(newInterleavedArrays.end(),
+        /* This is new combination, copy it to new interleaved arrays */
+        combinedIndices[oldIndex] = newCount++;
+        newInterleavedArrays.insert(newInterleavedArrays.end(),
             interleavedArrays.begin()+oldIndex*stride,
             interleavedArrays.begin()+(oldIndex+1)*stride);
     }
 
-    CORRADE_INTERNAL_ASSERT(combinedIndices.size() == interleavedArrays.size()/stride &&
-                            newInterleavedArrays.size() <= interleavedArrays.size());
+    CORRADE_INTERNAL_ASSERT(newInterleavedArrays.size() <= interleavedArrays.size());
 
     return {std::move(combinedIndices), std::move(newInterleavedArrays)};
 }
@@ -78,7 +78,7 @@ which can be then indexed with the combined index array:
 Again, first triangle in the mesh will have positions `a c f` and normals
 `B D E`.
 
-This function calls @ref combineIndexArrays(const std::vector<UnsignedInt>&, UnsignedInt)
+This function calls @ref combineIndexArrays(const std::vector<UnsignedInt>&, UnsignedInt, UnsignedInt)
 internally. See also @ref combineIndexedArrays() which does the vertex data
 reordering automatically.
 */
@@ -110,9 +110,15 @@ And second pair value is the cleaned up interleaved array:
 
     0 1 2 3 5 4 0 4 1 6 3 1 2 1
 
+The unique combinations are found using a flat hash table sized upfront for
+the whole input. If @p threadCount is not `1` and Magnum is built with
+`BUILD_MULTITHREADED` (see @ref building), large inputs are partitioned by
+hash and the partitions are processed in parallel using given count of
+threads, `0` meaning hardware concurrency. The output is the same regardless
+of thread count.
 @see @ref combineIndexedArrays()
 */
-MAGNUM_MESHTOOLS_EXPORT std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> combineIndexArrays(const std::vector<UnsignedInt>& interleavedArrays, UnsignedInt stride);
+MAGNUM_MESHTOOLS_EXPORT std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> combineIndexArrays(const std::vector<UnsignedInt>& interleavedArrays, UnsignedInt stride, UnsignedInt threadCount = 1);
 
 namespace Implementation {
 
@@ -25,10 +25,17 @@
 
 #include "Compile.h"
 
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+
 #include "Magnum/Buffer.h"
-#include "Magnum/Math/Vector3.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/Vector4.h"
 #include "Magnum/MeshTools/CompressIndices.h"
 #include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/InterleaveStrided.h"
 #include "Magnum/Trade/MeshData2D.h"
 #include "Magnum/Trade/MeshData3D.h"
 
@@ -93,58 +100,229 @@ std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const
     return std::make_tuple(std::move(mesh), std::move(vertexBuffer), std::move(indexBuffer));
 }
 
-std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData3D& meshData, const BufferUsage usage) {
-    Mesh mesh;
-    mesh.setPrimitive(meshData.primitive());
+namespace {
 
-    /* Decide about stride and offsets */
-    UnsignedInt stride = sizeof(Shaders::Generic3D::Position::Type);
-    const UnsignedInt normalOffset = sizeof(Shaders::Generic3D::Position::Type);
-    UnsignedInt textureCoordsOffset = sizeof(Shaders::Generic3D::Position::Type);
+/* Value that the GPU sees after the attribute is packed with given
+   conversion */
+template<class T> Float roundtripNormalized(const Float value) {
+    return Math::unpack<Float>(Math::pack<T>(value));
+}
+
+Float roundtrip1010102(const Float value) {
+    return Math::unpack<Float, 10>(Math::pack<Int, 10>(value));
+}
+
+/* Interleaved vertex data together with attribute offsets */
+struct PackedVertices {
+    Containers::Array<char> data;
+    UnsignedInt stride, normalOffset, textureCoordsOffset, tangentOffset;
+};
+
+PackedVertices packVertices3D(const Trade::MeshData3D& meshData, const std::vector<Vector4>* const tangents, const CompileFlags flags, CompileQuantization& quantization) {
+    const std::vector<Vector3>& positions = meshData.positions(0);
+    std::vector<StridedAttribute> attributes;
+
+    /* Positions. Quantization to bounding box needs the positions
+       transformed first, the dequantization matrix undoes that. */
+    std::vector<Vector3> quantizedPositions;
+    UnsignedInt positionSize = sizeof(Shaders::Generic3D::Position::Type);
+    if(flags & CompileFlag::PositionsNormalizedShort) {
+        Vector3 min{Constants::inf()}, max{-Constants::inf()};
+        for(const Vector3& position: positions) {
+            min = Math::min(min, position);
+            max = Math::max(max, position);
+        }
+
+        const Vector3 center = (min + max)*0.5f;
+        Vector3 halfExtent = (max - min)*0.5f;
+        for(std::size_t i = 0; i != 3; ++i)
+            if(!(halfExtent[i] > 0.0f)) halfExtent[i] = 1.0f;
+
+        quantizedPositions.reserve(positions.size());
+        for(const Vector3& position: positions) {
+            const Vector3 quantized = (position - center)/halfExtent;
+            quantizedPositions.push_back(quantized);
+
+            const Vector3 dequantized = center + halfExtent*Vector3{
+                roundtripNormalized<Short>(quantized.x()),
+                roundtripNormalized<Short>(quantized.y()),
+                roundtripNormalized<Short>(quantized.z())};
+            quantization.positionError = Math::max(quantization.positionError, (dequantized - position).length());
+        }
+
+        quantization.positionDequantization = Matrix4::translation(center)*Matrix4::scaling(halfExtent);
+        attributes.push_back({quantizedPositions, AttributeConversion::NormalizedShort});
+        attributes.push_back(2);
+        positionSize = 8;
+
+    } else if(flags & CompileFlag::PositionsHalf) {
+        for(const Vector3& position: positions)
+            quantization.positionError = Math::max(quantization.positionError, (Math::unpackHalf(Math::packHalf(position)) - position).length());
+
+        attributes.push_back({positions, AttributeConversion::Half});
+        attributes.push_back(2);
+        positionSize = 8;
+
+    } else attributes.push_back(positions);
+
+    /* Normals */
+    UnsignedInt normalSize = 0;
     if(meshData.hasNormals()) {
-        stride += sizeof(Shaders::Generic3D::Normal::Type);
-        textureCoordsOffset += sizeof(Shaders::Generic3D::Normal::Type);
+        const std::vector<Vector3>& normals = meshData.normals(0);
+        Float(*roundtrip)(Float) = nullptr;
+        if(flags & CompileFlag::NormalsNormalizedByte) {
+            attributes.push_back({normals, AttributeConversion::NormalizedByte});
+            attributes.push_back(1);
+            roundtrip = roundtripNormalized<Byte>;
+            normalSize = 4;
+        } else if(flags & CompileFlag::NormalsNormalizedShort) {
+            attributes.push_back({normals, AttributeConversion::NormalizedShort});
+            attributes.push_back(2);
+            roundtrip = roundtripNormalized<Short>;
+            normalSize = 8;
+        }
+        #ifndef MAGNUM_TARGET_GLES2
+        else if(flags & CompileFlag::NormalsInt2101010Rev) {
+            attributes.push_back({normals, AttributeConversion::NormalizedInt2101010Rev});
+            roundtrip = roundtrip1010102;
+            normalSize = 4;
+        }
+        #endif
+        else {
+            attributes.push_back(normals);
+            normalSize = sizeof(Shaders::Generic3D::Normal::Type);
+        }
+
+        /* Angle between the original and the packed direction, the shader
+           renormalizes anyway */
+        if(roundtrip) for(const Vector3& normal: normals) {
+            const Vector3 packed{roundtrip(normal.x()), roundtrip(normal.y()), roundtrip(normal.z())};
+            if(normal.isZero() || packed.isZero()) continue;
+            const Rad angle{std::acos(Math::clamp(Math::dot(normal.normalized(), packed.normalized()), -1.0f, 1.0f))};
+            if(angle > quantization.normalError) quantization.normalError = angle;
+        }
     }
-    if(meshData.hasTextureCoords2D())
-        stride += sizeof(Shaders::Generic3D::TextureCoordinates::Type);
+
+    /* Texture coordinates */
+    UnsignedInt textureCoordsSize = 0;
+    if(meshData.hasTextureCoords2D()) {
+        const std::vector<Vector2>& textureCoords = meshData.textureCoords2D(0);
+        if(flags & CompileFlag::TextureCoordinatesNormalizedUnsignedShort) {
+            for(const Vector2& textureCoord: textureCoords) {
+                const Vector2 packed{
+                    roundtripNormalized<UnsignedShort>(textureCoord.x()),
+                    roundtripNormalized<UnsignedShort>(textureCoord.y())};
+                quantization.textureCoordinateError = Math::max(quantization.textureCoordinateError, (packed - textureCoord).length());
+            }
+
+            attributes.push_back({textureCoords, AttributeConversion::NormalizedUnsignedShort});
+            textureCoordsSize = 4;
+
+        } else if(flags & CompileFlag::TextureCoordinatesHalf) {
+            for(const Vector2& textureCoord: textureCoords)
+                quantization.textureCoordinateError = Math::max(quantization.textureCoordinateError, (Math::unpackHalf(Math::packHalf(textureCoord)) - textureCoord).length());
+
+            attributes.push_back({textureCoords, AttributeConversion::Half});
+            textureCoordsSize = 4;
+
+        } else {
+            attributes.push_back(textureCoords);
+            textureCoordsSize = sizeof(Shaders::Generic3D::TextureCoordinates::Type);
+        }
+    }
+
+    /* Tangents */
+    if(tangents) attributes.push_back(*tangents);
+
+    /* Decide about stride and offsets */
+    PackedVertices out;
+    out.stride = interleavedStride({attributes.data(), attributes.size()});
+    out.normalOffset = positionSize;
+    out.textureCoordsOffset = out.normalOffset + normalSize;
+    out.tangentOffset = out.textureCoordsOffset + textureCoordsSize;
+
+    /* Interleave everything into a single buffer */
+    out.data = Containers::Array<char>{out.stride*positions.size()};
+    interleaveInto(out.data, {attributes.data(), attributes.size()});
+
+    return out;
+}
+
+std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile3D(const Trade::MeshData3D& meshData, const std::vector<Vector4>* const tangents, const CompileFlags flags, CompileQuantization& quantization, const BufferUsage usage) {
+    Mesh mesh;
+    mesh.setPrimitive(meshData.primitive());
+
+    const PackedVertices vertices = packVertices3D(meshData, tangents, flags, quantization);
+    const UnsignedInt stride = vertices.stride;
+    const UnsignedInt normalOffset = vertices.normalOffset;
+    const UnsignedInt textureCoordsOffset = vertices.textureCoordsOffset;
+    const UnsignedInt tangentOffset = vertices.tangentOffset;
 
     /* Create vertex buffer */
     std::unique_ptr<Buffer> vertexBuffer{new Buffer{Buffer::TargetHint::Array}};
 
-    /* Interleave positions */
-    Containers::Array<char> data = MeshTools::interleave(
-        meshData.positions(0),
-        stride - sizeof(Shaders::Generic3D::Position::Type));
-    mesh.addVertexBuffer(*vertexBuffer, 0,
+    /* Bind positions */
+    if(flags & (CompileFlag::PositionsHalf|CompileFlag::PositionsNormalizedShort)) {
+        mesh.addVertexBuffer(*vertexBuffer, 0,
+            flags & CompileFlag::PositionsHalf ?
+                Shaders::Generic3D::Position{Shaders::Generic3D::Position::DataType::HalfFloat} :
+                Shaders::Generic3D::Position{Shaders::Generic3D::Position::DataType::Short, Shaders::Generic3D::Position::DataOption::Normalized},
+            stride - 3*sizeof(UnsignedShort));
+    } else mesh.addVertexBuffer(*vertexBuffer, 0,
         Shaders::Generic3D::Position(),
         stride - sizeof(Shaders::Generic3D::Position::Type));
 
-    /* Add also normals, if present */
+    /* Bind also normals, if present */
     if(meshData.hasNormals()) {
-        MeshTools::interleaveInto(data,
+        if(flags & CompileFlag::NormalsNormalizedByte) mesh.addVertexBuffer(*vertexBuffer, 0,
             normalOffset,
-            meshData.normals(0),
-            stride - normalOffset - sizeof(Shaders::Generic3D::Normal::Type));
-        mesh.addVertexBuffer(*vertexBuffer, 0,
+            Shaders::Generic3D::Normal{Shaders::Generic3D::Normal::DataType::Byte, Shaders::Generic3D::Normal::DataOption::Normalized},
+            stride - normalOffset - 3*sizeof(Byte));
+        else if(flags & CompileFlag::NormalsNormalizedShort) mesh.addVertexBuffer(*vertexBuffer, 0,
+            normalOffset,
+            Shaders::Generic3D::Normal{Shaders::Generic3D::Normal::DataType::Short, Shaders::Generic3D::Normal::DataOption::Normalized},
+            stride - normalOffset - 3*sizeof(Short));
+        #ifndef MAGNUM_TARGET_GLES2
+        /* Packed types need four components, the shader uses only the first
+           three */
+        else if(flags & CompileFlag::NormalsInt2101010Rev) {
+            typedef Attribute<Shaders::Generic3D::Normal::Location, Vector4> PackedNormal;
+            mesh.addVertexBuffer(*vertexBuffer, 0,
+                normalOffset,
+                PackedNormal{PackedNormal::DataType::Int2101010Rev, PackedNormal::DataOption::Normalized},
+                stride - normalOffset - sizeof(UnsignedInt));
+        }
+        #endif
+        else mesh.addVertexBuffer(*vertexBuffer, 0,
             normalOffset,
             Shaders::Generic3D::Normal(),
             stride - normalOffset - sizeof(Shaders::Generic3D::Normal::Type));
     }
 
-    /* Add also texture coordinates, if present */
+    /* Bind also texture coordinates, if present */
     if(meshData.hasTextureCoords2D()) {
-        MeshTools::interleaveInto(data,
+        if(flags & CompileFlag::TextureCoordinatesNormalizedUnsignedShort) mesh.addVertexBuffer(*vertexBuffer, 0,
             textureCoordsOffset,
-            meshData.textureCoords2D(0),
-            stride - textureCoordsOffset - sizeof(Shaders::Generic3D::TextureCoordinates::Type));
-        mesh.addVertexBuffer(*vertexBuffer, 0,
+            Shaders::Generic3D::TextureCoordinates{Shaders::Generic3D::TextureCoordinates::DataType::UnsignedShort, Shaders::Generic3D::TextureCoordinates::DataOption::Normalized},
+            stride - textureCoordsOffset - 2*sizeof(UnsignedShort));
+        else if(flags & CompileFlag::TextureCoordinatesHalf) mesh.addVertexBuffer(*vertexBuffer, 0,
+            textureCoordsOffset,
+            Shaders::Generic3D::TextureCoordinates{Shaders::Generic3D::TextureCoordinates::DataType::HalfFloat},
+            stride - textureCoordsOffset - 2*sizeof(UnsignedShort));
+        else mesh.addVertexBuffer(*vertexBuffer, 0,
             textureCoordsOffset,
             Shaders::Generic3D::TextureCoordinates(),
             stride - textureCoordsOffset - sizeof(Shaders::Generic3D::TextureCoordinates::Type));
     }
 
+    /* Bind also tangents, if present */
+    if(tangents) mesh.addVertexBuffer(*vertexBuffer, 0,
+        tangentOffset,
+        Shaders::Generic3D::Tangent(),
+        stride - tangentOffset - sizeof(Shaders::Generic3D::Tangent::Type));
+
     /* Fill vertex buffer with interleaved data */
-    vertexBuffer->setData(data, usage);
+    vertexBuffer->setData(vertices.data, usage);
 
     /* If indexed, fill index buffer and configure indexed mesh */
     std::unique_ptr<Buffer> indexBuffer;
@@ -165,4 +343,53 @@ std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const
     return std::make_tuple(std::move(mesh), std::move(vertexBuffer), std::move(indexBuffer));
 }
 
+}
+
+std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData3D& meshData, const BufferUsage usage) {
+    CompileQuantization quantization{};
+    return compile3D(meshData, nullptr, {}, quantization, usage);
+}
+
+std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData3D& meshData, const std::vector<Vector4>& tangents, const BufferUsage usage) {
+    CORRADE_ASSERT(tangents.size() == meshData.positions(0).size(),
+        "MeshTools::compile(): expected" << meshData.positions(0).size() << "tangents but got" << tangents.size(), (std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>>{}));
+    CompileQuantization quantization{};
+    return compile3D(meshData, &tangents, {}, quantization, usage);
+}
+
+namespace {
+
+bool checkFlags(const CompileFlags flags) {
+    CORRADE_ASSERT(!(flags & CompileFlag::PositionsHalf) || !(flags & CompileFlag::PositionsNormalizedShort),
+        "MeshTools::compile(): only one position packing flag can be set", false);
+    CORRADE_ASSERT(UnsignedInt(bool(flags & CompileFlag::NormalsNormalizedByte)) + UnsignedInt(bool(flags & CompileFlag::NormalsNormalizedShort))
+        #ifndef MAGNUM_TARGET_GLES2
+        + UnsignedInt(bool(flags & CompileFlag::NormalsInt2101010Rev))
+        #endif
+        <= 1,
+        "MeshTools::compile(): only one normal packing flag can be set", false);
+    CORRADE_ASSERT(!(flags & CompileFlag::TextureCoordinatesHalf) || !(flags & CompileFlag::TextureCoordinatesNormalizedUnsignedShort),
+        "MeshTools::compile(): only one texture coordinate packing flag can be set", false);
+    static_cast<void>(flags);
+    return true;
+}
+
+}
+
+std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>, CompileQuantization> compile(const Trade::MeshData3D& meshData, const CompileFlags flags, const BufferUsage usage) {
+    if(!checkFlags(flags)) return std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>, CompileQuantization>{};
+
+    CompileQuantization quantization{};
+    std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compiled = compile3D(meshData, nullptr, flags, quantization, usage);
+    return std::make_tuple(std::move(std::get<0>(compiled)), std::move(std::get<1>(compiled)), std::move(std::get<2>(compiled)), quantization);
+}
+
+std::tuple<Containers::Array<char>, UnsignedInt, CompileQuantization> packVertices(const Trade::MeshData3D& meshData, const CompileFlags flags) {
+    if(!checkFlags(flags)) return std::tuple<Containers::Array<char>, UnsignedInt, CompileQuantization>{};
+
+    CompileQuantization quantization{};
+    PackedVertices vertices = packVertices3D(meshData, nullptr, flags, quantization);
+    return std::make_tuple(std::move(vertices.data), vertices.stride, quantization);
+}
+
 }}
@@ -26,13 +26,17 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::compile()
+ * @brief Function @ref Magnum::MeshTools::compile(), enum @ref Magnum::MeshTools::CompileFlag, enum set @ref Magnum::MeshTools::CompileFlags, struct @ref Magnum::MeshTools::CompileQuantization
  */
 
 #include <tuple>
 #include <memory>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/EnumSet.h>
 
 #include "Magnum/Magnum.h"
+#include "Magnum/Math/Matrix4.h"
 #include "Magnum/Trade/Trade.h"
 #include "Magnum/MeshTools/visibility.h"
 
@@ -80,6 +84,145 @@ greater flexibility.
 */
 MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData3D& meshData, BufferUsage usage);
 
+/**
+@brief Compile 3D mesh data with tangents
+
+Same as @ref compile(const Trade::MeshData3D&, BufferUsage), but additionally
+binds @p tangents to @ref Shaders::Generic3D::Tangent attribute. The tangents
+are expected to be indexed the same way as the positions, see
+@ref generateTangents(Trade::MeshData3D&, UnsignedInt).
+*/
+MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData3D& meshData, const std::vector<Vector4>& tangents, BufferUsage usage);
+
+/**
+@brief Vertex packing flag
+
+@see @ref CompileFlags, @ref compile(const Trade::MeshData3D&, CompileFlags, BufferUsage)
+*/
+enum class CompileFlag: UnsignedByte {
+    /**
+     * Store positions as three half-floats, padded to 8 bytes. The precision
+     * is relative to distance from origin, so this works best for meshes
+     * centered around it.
+     */
+    PositionsHalf = 1 << 0,
+
+    /**
+     * Store positions as three normalized shorts relative to the mesh bounding
+     * box, padded to 8 bytes. The mapping back to the original coordinates is
+     * returned in @ref CompileQuantization::positionDequantization and has to
+     * be applied to the transformation matrix. Mutually exclusive with
+     * @ref CompileFlag::PositionsHalf.
+     */
+    PositionsNormalizedShort = 1 << 1,
+
+    /** Store normals as three normalized bytes, padded to 4 bytes */
+    NormalsNormalizedByte = 1 << 2,
+
+    /**
+     * Store normals as three normalized shorts, padded to 8 bytes. Mutually
+     * exclusive with @ref CompileFlag::NormalsNormalizedByte.
+     */
+    NormalsNormalizedShort = 1 << 3,
+
+    #ifndef MAGNUM_TARGET_GLES2
+    /**
+     * Store normals as normalized signed 10:10:10:2 packed integer, 4 bytes in
+     * total. Mutually exclusive with @ref CompileFlag::NormalsNormalizedByte
+     * and @ref CompileFlag::NormalsNormalizedShort.
+     * @requires_gl33 Extension @extension{ARB,vertex_type_2_10_10_10_rev}
+     * @requires_gles30 Packed attributes are not available in OpenGL
+     *      ES 2.0.
+     */
+    NormalsInt2101010Rev = 1 << 4,
+    #endif
+
+    /** Store texture coordinates as two half-floats */
+    TextureCoordinatesHalf = 1 << 5,
+
+    /**
+     * Store texture coordinates as two normalized unsigned shorts. Values
+     * outside of @f$ [0, 1] @f$ are clamped. Mutually exclusive with
+     * @ref CompileFlag::TextureCoordinatesHalf.
+     */
+    TextureCoordinatesNormalizedUnsignedShort = 1 << 6
+};
+
+/**
+@brief Vertex packing flags
+
+@see @ref compile(const Trade::MeshData3D&, CompileFlags, BufferUsage)
+*/
+typedef Containers::EnumSet<CompileFlag> CompileFlags;
+
+CORRADE_ENUMSET_OPERATORS(CompileFlags)
+
+/**
+@brief Quantization info
+
+Returned from @ref compile(const Trade::MeshData3D&, CompileFlags, BufferUsage).
+All errors are zero for attributes that are either not present or not packed.
+*/
+struct CompileQuantization {
+    /**
+     * @brief Position dequantization matrix
+     *
+     * Transforms packed positions back to the original coordinate system,
+     * multiply the transformation matrix with it before passing it to the
+     * shader. Identity if @ref CompileFlag::PositionsNormalizedShort is not
+     * set.
+     */
+    Matrix4 positionDequantization;
+
+    /**
+     * @brief Max position error
+     *
+     * Max distance between original and dequantized position.
+     */
+    Float positionError;
+
+    /** @brief Max angle between original and packed normal */
+    Rad normalError;
+
+    /**
+     * @brief Max texture coordinate error
+     *
+     * Max distance between original and packed texture coordinates,
+     * including the effect of clamping.
+     */
+    Float textureCoordinateError;
+};
+
+/**
+@brief Compile 3D mesh data with packed vertex attributes
+
+Same as @ref compile(const Trade::MeshData3D&, BufferUsage), but stores the
+attributes in smaller formats according to @p flags. All attributes are
+padded to four bytes, so for example normalized short positions together with
+10:10:10:2 normals and normalized unsigned short texture coordinates take 16
+bytes per vertex instead of 32. Packed attributes are bound with
+@ref Attribute::DataOption::Normalized, so they are usable by the
+@ref Shaders::Generic3D "generic" shaders without any change. The last
+returned value describes how to undo the position quantization and what the
+precision loss is.
+
+Flags for attributes that the mesh doesn't have are ignored. The vertex data
+are prepared using @ref packVertices().
+*/
+MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>, CompileQuantization> compile(const Trade::MeshData3D& meshData, CompileFlags flags, BufferUsage usage);
+
+/**
+@brief Pack 3D mesh vertex data
+
+Converts and interleaves the vertex data the same way as
+@ref compile(const Trade::MeshData3D&, CompileFlags, BufferUsage), but
+doesn't need any GL context. Returns the interleaved data, vertex stride and
+quantization info. Positions are first, followed by normals and texture
+coordinates, if present. Each attribute is padded to four bytes, for example
+normalized short positions take 8 bytes.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::tuple<Containers::Array<char>, UnsignedInt, CompileQuantization> packVertices(const Trade::MeshData3D& meshData, CompileFlags flags);
+
 }}
 
 #endif
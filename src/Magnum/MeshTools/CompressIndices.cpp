@@ -28,8 +28,10 @@
 #include <cstring>
 #include <algorithm>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
 
 #include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Implementation/lanes.h"
 
 namespace Magnum { namespace MeshTools {
 
@@ -40,39 +42,103 @@ template<> constexpr Mesh::IndexType indexType<UnsignedByte>() { return Mesh::In
 template<> constexpr Mesh::IndexType indexType<UnsignedShort>() { return Mesh::IndexType::UnsignedShort; }
 template<> constexpr Mesh::IndexType indexType<UnsignedInt>() { return Mesh::IndexType::UnsignedInt; }
 
-template<class T> inline std::pair<Containers::Array<char>, Mesh::IndexType> compress(const std::vector<UnsignedInt>& indices) {
-    Containers::Array<char> buffer(indices.size()*sizeof(T));
-    for(std::size_t i = 0; i != indices.size(); ++i) {
-        T index = static_cast<T>(indices[i]);
-        std::memcpy(buffer.begin()+i*sizeof(T), &index, sizeof(T));
+/* Narrows the indices four at a time using the same SSE2 packing as
+   Math::packInto(), the remaining ones one by one */
+template<class T> void compressInto(const UnsignedInt* const indices, const std::size_t count, const UnsignedInt offset, char* const out) {
+    std::size_t i = 0;
+    #ifdef __SSE2__
+    const __m128i offsetLanes = _mm_set1_epi32(Int(offset));
+    for(; i + 4 <= count; i += 4)
+        Math::Implementation::storeLanes<T>(out + i*sizeof(T), _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i)), offsetLanes));
+    #endif
+    for(; i != count; ++i) {
+        const T index = T(indices[i] - offset);
+        std::memcpy(out + i*sizeof(T), &index, sizeof(T));
     }
+}
 
+template<class T> inline std::pair<Containers::Array<char>, Mesh::IndexType> compress(const std::vector<UnsignedInt>& indices, const UnsignedInt offset) {
+    Containers::Array<char> buffer(indices.size()*sizeof(T));
+    compressInto<T>(indices.data(), indices.size(), offset, buffer.begin());
     return {std::move(buffer), indexType<T>()};
 }
 
+/* Separate min and max loops vectorize, std::minmax_element() doesn't */
+std::pair<UnsignedInt, UnsignedInt> minmax(const UnsignedInt* const indices, const std::size_t count) {
+    if(!count) return {};
+
+    UnsignedInt min = indices[0], max = indices[0];
+    for(std::size_t i = 0; i != count; ++i)
+        min = std::min(min, indices[i]);
+    for(std::size_t i = 0; i != count; ++i)
+        max = std::max(max, indices[i]);
+    return {min, max};
 }
 
-std::tuple<Containers::Array<char>, Mesh::IndexType, UnsignedInt, UnsignedInt> compressIndices(const std::vector<UnsignedInt>& indices) {
-    /** @todo Performance hint when range can be represented by smaller value? */
-    auto minmax = std::minmax_element(indices.begin(), indices.end());
-    std::pair<Containers::Array<char>, Mesh::IndexType> typeData;
-    switch(Math::log(256, *minmax.second)) {
+std::pair<Containers::Array<char>, Mesh::IndexType> compress(const std::vector<UnsignedInt>& indices, const UnsignedInt offset, const UnsignedInt max) {
+    switch(Math::log(256, max)) {
         case 0:
-            typeData = compress<UnsignedByte>(indices);
-            break;
+            return compress<UnsignedByte>(indices, offset);
         case 1:
-            typeData = compress<UnsignedShort>(indices);
-            break;
+            return compress<UnsignedShort>(indices, offset);
         case 2:
         case 3:
-            typeData = compress<UnsignedInt>(indices);
-            break;
+            return compress<UnsignedInt>(indices, offset);
+    }
+
+    CORRADE_ASSERT_UNREACHABLE();
+}
 
-        default:
-            CORRADE_ASSERT(false, "MeshTools::compressIndices(): no type able to index" << *minmax.second << "elements.", {});
+}
+
+std::tuple<Containers::Array<char>, Mesh::IndexType, UnsignedInt, UnsignedInt> compressIndices(const std::vector<UnsignedInt>& indices) {
+    const std::pair<UnsignedInt, UnsignedInt> range = minmax(indices.data(), indices.size());
+    std::pair<Containers::Array<char>, Mesh::IndexType> typeData = compress(indices, 0, range.second);
+    return std::make_tuple(std::move(typeData.first), typeData.second, range.first, range.second);
+}
+
+std::tuple<Containers::Array<char>, Mesh::IndexType, UnsignedInt, UnsignedInt, Int> compressIndicesWithBaseVertex(const std::vector<UnsignedInt>& indices) {
+    const std::pair<UnsignedInt, UnsignedInt> range = minmax(indices.data(), indices.size());
+    std::pair<Containers::Array<char>, Mesh::IndexType> typeData = compress(indices, range.first, range.second - range.first);
+    return std::make_tuple(std::move(typeData.first), typeData.second, 0u, range.second - range.first, Int(range.first));
+}
+
+std::pair<Containers::Array<char>, std::vector<IndexChunk>> compressIndicesChunked(const std::vector<UnsignedInt>& indices, const MeshPrimitive primitive) {
+    std::size_t primitiveSize = 0;
+    switch(primitive) {
+        case MeshPrimitive::Points: primitiveSize = 1; break;
+        case MeshPrimitive::Lines: primitiveSize = 2; break;
+        case MeshPrimitive::Triangles: primitiveSize = 3; break;
+        default: CORRADE_ASSERT(false, "MeshTools::compressIndicesChunked(): can't split" << primitive << "into chunks", {});
     }
+    CORRADE_ASSERT(!(indices.size()%primitiveSize), "MeshTools::compressIndicesChunked(): index count is not divisible by" << primitiveSize, {});
+
+    /* Greedily extend each chunk while its index range fits into 16 bits */
+    std::vector<IndexChunk> chunks;
+    for(std::size_t i = 0; i != indices.size(); ) {
+        UnsignedInt min = indices[i], max = indices[i];
+        std::size_t end = i;
+        while(end != indices.size()) {
+            const std::pair<UnsignedInt, UnsignedInt> range = minmax(indices.data() + end, primitiveSize);
+            const UnsignedInt newMin = std::min(min, range.first);
+            const UnsignedInt newMax = std::max(max, range.second);
+            if(newMax - newMin > 0xffff) break;
+
+            min = newMin;
+            max = newMax;
+            end += primitiveSize;
+        }
+        CORRADE_ASSERT(end != i, "MeshTools::compressIndicesChunked(): primitive" << i/primitiveSize << "spans more than 65536 vertices", {});
+
+        chunks.push_back({UnsignedInt(i), UnsignedInt(end - i), 0, max - min, Int(min)});
+        i = end;
+    }
+
+    Containers::Array<char> buffer(indices.size()*sizeof(UnsignedShort));
+    for(const IndexChunk& chunk: chunks)
+        compressInto<UnsignedShort>(indices.data() + chunk.indexOffset, chunk.indexCount, chunk.baseVertex, buffer.begin() + chunk.indexOffset*sizeof(UnsignedShort));
 
-    return std::make_tuple(std::move(typeData.first), typeData.second, *minmax.first, *minmax.second);
+    return {std::move(buffer), std::move(chunks)};
 }
 
 }}
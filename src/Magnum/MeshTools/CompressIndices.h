@@ -26,10 +26,11 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::compressIndices()
+ * @brief Function @ref Magnum::MeshTools::compressIndices(), @ref Magnum::MeshTools::compressIndicesWithBaseVertex(), @ref Magnum::MeshTools::compressIndicesChunked(), struct @ref Magnum::MeshTools::IndexChunk
  */
 
 #include <tuple>
+#include <vector>
 
 #include "Magnum/Mesh.h"
 #include "Magnum/MeshTools/visibility.h"
@@ -62,10 +63,130 @@ Mesh mesh;
 mesh.setCount(indices.size())
     .setIndexBuffer(indexBuffer, 0, indexType, indexStart, indexEnd);
 @endcode
+
+The index type is chosen based on the largest index. If the indices occupy
+only a small range of large values, use @ref compressIndicesWithBaseVertex()
+instead.
 @todo Extract IndexType out of Mesh class
 */
 std::tuple<Containers::Array<char>, Mesh::IndexType, UnsignedInt, UnsignedInt> MAGNUM_MESHTOOLS_EXPORT compressIndices(const std::vector<UnsignedInt>& indices);
 
+/**
+@brief Compress vertex indices relative to the smallest one
+@param indices  Index array
+@return Compressed index array, type, index range and base vertex
+
+Like @ref compressIndices(), but subtracts the smallest index from all indices
+first, so e.g. a sub-mesh using indices in range @f$ [70000, 70200] @f$ is
+stored using 8-bit indices instead of 32-bit. The returned index range is
+also relative to the smallest index and the smallest index is returned as
+base vertex, which is added back by the GPU when drawing:
+@code
+std::vector<UnsignedInt> indices;
+
+Containers::Array<char> indexData;
+Mesh::IndexType indexType;
+UnsignedInt indexStart, indexEnd;
+Int baseVertex;
+std::tie(indexData, indexType, indexStart, indexEnd, baseVertex) = MeshTools::compressIndicesWithBaseVertex(indices);
+
+Buffer indexBuffer;
+indexBuffer.setData(indexData, BufferUsage::StaticDraw);
+
+Mesh mesh;
+mesh.setCount(indices.size())
+    .setBaseVertex(baseVertex)
+    .setIndexBuffer(indexBuffer, 0, indexType, indexStart, indexEnd);
+@endcode
+
+Base vertex for indexed meshes is not available in OpenGL ES and WebGL, you
+can offset the vertex buffer in @ref Mesh::addVertexBuffer() by
+`baseVertex*stride` bytes there instead.
+@see @ref compressIndicesChunked()
+*/
+std::tuple<Containers::Array<char>, Mesh::IndexType, UnsignedInt, UnsignedInt, Int> MAGNUM_MESHTOOLS_EXPORT compressIndicesWithBaseVertex(const std::vector<UnsignedInt>& indices);
+
+/**
+@brief Chunk of compressed index array
+
+@see @ref compressIndicesChunked()
+*/
+struct IndexChunk {
+    /**
+     * @brief Offset of the first index
+     *
+     * Pass it to @ref MeshView::setIndexRange().
+     */
+    UnsignedInt indexOffset;
+
+    /**
+     * @brief Index count
+     *
+     * Pass it to @ref MeshView::setCount().
+     */
+    UnsignedInt indexCount;
+
+    /**
+     * @brief Minimal index
+     *
+     * Relative to @ref baseVertex. Pass it as `start` to
+     * @ref MeshView::setIndexRange().
+     */
+    UnsignedInt indexStart;
+
+    /**
+     * @brief Maximal index
+     *
+     * Relative to @ref baseVertex. Pass it as `end` to
+     * @ref MeshView::setIndexRange().
+     */
+    UnsignedInt indexEnd;
+
+    /**
+     * @brief Base vertex
+     *
+     * Pass it to @ref MeshView::setBaseVertex().
+     */
+    Int baseVertex;
+};
+
+/**
+@brief Compress vertex indices into 16-bit chunks
+@param indices      Index array
+@param primitive    Primitive type
+@return Compressed index array and chunk table
+
+Splits the index array into consecutive chunks where the difference between
+largest and smallest index fits into 16 bits and compresses each chunk
+relative to its smallest index like @ref compressIndicesWithBaseVertex(). The
+indices are always of @ref Mesh::IndexType::UnsignedShort type, which is
+supported everywhere and needs half the memory of 32-bit indices. The chunks
+never split a primitive, thus @p primitive can be only
+@ref MeshPrimitive::Points, @ref MeshPrimitive::Lines or
+@ref MeshPrimitive::Triangles. Each chunk is then drawn using separate
+@ref MeshView:
+@code
+std::vector<UnsignedInt> indices;
+
+Containers::Array<char> indexData;
+std::vector<MeshTools::IndexChunk> chunks;
+std::tie(indexData, chunks) = MeshTools::compressIndicesChunked(indices);
+
+Buffer indexBuffer;
+indexBuffer.setData(indexData, BufferUsage::StaticDraw);
+mesh.setIndexBuffer(indexBuffer, 0, Mesh::IndexType::UnsignedShort);
+
+for(const MeshTools::IndexChunk& chunk: chunks) {
+    MeshView view{mesh};
+    view.setCount(chunk.indexCount)
+        .setBaseVertex(chunk.baseVertex)
+        .setIndexRange(chunk.indexOffset, chunk.indexStart, chunk.indexEnd);
+    view.draw(shader);
+}
+@endcode
+*/
+std::pair<Containers::Array<char>, std::vector<IndexChunk>> MAGNUM_MESHTOOLS_EXPORT compressIndicesChunked(const std::vector<UnsignedInt>& indices, MeshPrimitive primitive = MeshPrimitive::Triangles);
+
 }}
 
 #endif
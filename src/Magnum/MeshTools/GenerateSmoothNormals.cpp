@@ -0,0 +1,176 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GenerateSmoothNormals.h"
+
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Implementation/parallelFor.h"
+#include "Magnum/MeshTools/Implementation/VertexCorners.h"
+
+namespace Magnum { namespace MeshTools {
+
+Debug operator<<(Debug debug, const NormalWeighting value) {
+    switch(value) {
+        #define _c(value) case NormalWeighting::value: return debug << "MeshTools::NormalWeighting::" #value;
+        _c(Area)
+        _c(Angle)
+        #undef _c
+    }
+
+    return debug << "MeshTools::NormalWeighting::(invalid)";
+}
+
+namespace {
+
+Float angle(const Vector3& a, const Vector3& b) {
+    const Float lengths = std::sqrt(a.dot()*b.dot());
+    if(lengths == 0.0f) return 0.0f;
+    return std::acos(Math::clamp(Math::dot(a, b)/lengths, -1.0f, 1.0f));
+}
+
+}
+
+std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>> generateSmoothNormals(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const NormalWeighting weighting, const Rad creaseAngle, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::generateSmoothNormals(): index count is not divisible by 3!", (std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>>()));
+    const std::size_t vertexCount = positions.size();
+    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
+    for(const UnsignedInt index: indices)
+        CORRADE_ASSERT(index < vertexCount, "MeshTools::generateSmoothNormals(): index" << index << "out of bounds for" << vertexCount << "vertices", (std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>>()));
+    #endif
+
+    /* Unit normal for every face (assuming counterclockwise winding) and
+       weight of every face corner */
+    const std::size_t faceCount = indices.size()/3;
+    std::vector<Vector3> faceNormals(faceCount);
+    std::vector<Float> cornerWeights(indices.size());
+    Magnum::Implementation::parallelFor(faceCount, threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t face = begin; face != end; ++face) {
+            const Vector3& a = positions[indices[face*3]];
+            const Vector3& b = positions[indices[face*3 + 1]];
+            const Vector3& c = positions[indices[face*3 + 2]];
+            const Vector3 cross = Math::cross(c - b, a - b);
+            const Float length = cross.length();
+
+            /* Degenerate faces don't contribute to anything */
+            if(length == 0.0f) continue;
+
+            faceNormals[face] = cross/length;
+            if(weighting == NormalWeighting::Area) {
+                cornerWeights[face*3] = cornerWeights[face*3 + 1] = cornerWeights[face*3 + 2] = length*0.5f;
+            } else {
+                cornerWeights[face*3] = angle(b - a, c - a);
+                cornerWeights[face*3 + 1] = angle(c - b, a - b);
+                cornerWeights[face*3 + 2] = angle(a - c, b - c);
+            }
+        }
+    });
+
+    /* Face corners adjacent to each vertex */
+    std::vector<UnsignedInt> neighborOffset, neighbors;
+    Implementation::vertexCorners(indices, vertexCount, neighborOffset, neighbors);
+
+    /* Without creases each vertex gets exactly one normal, gathered from all
+       adjacent corners */
+    if(creaseAngle >= Rad(Constants::pi())) {
+        std::vector<Vector3> normals(vertexCount);
+        Magnum::Implementation::parallelFor(vertexCount, threadCount, [&](std::size_t begin, std::size_t end) {
+            for(std::size_t vertex = begin; vertex != end; ++vertex) {
+                Vector3 normal;
+                for(UnsignedInt i = neighborOffset[vertex]; i != neighborOffset[vertex + 1]; ++i)
+                    normal += faceNormals[neighbors[i]/3]*cornerWeights[neighbors[i]];
+                if(normal != Vector3()) normals[vertex] = normal.normalized();
+            }
+        });
+
+        return std::make_tuple(indices, std::move(normals));
+    }
+
+    /* Otherwise calculate normal for each corner from adjacent corners with
+       face normals inside the threshold. Corners of the same vertex with
+       equal normals then share the same normal index. */
+    const Float creaseCos = Math::cos(creaseAngle);
+    std::vector<Vector3> cornerNormals(indices.size());
+    std::vector<UnsignedInt> cornerNormalIds(indices.size());
+    std::vector<UnsignedInt> normalOffset(vertexCount + 1);
+    Magnum::Implementation::parallelFor(vertexCount, threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t vertex = begin; vertex != end; ++vertex) {
+            UnsignedInt distinctCount = 0;
+            for(UnsignedInt i = neighborOffset[vertex]; i != neighborOffset[vertex + 1]; ++i) {
+                const UnsignedInt corner = neighbors[i];
+                const Vector3& faceNormal = faceNormals[corner/3];
+
+                Vector3 normal;
+                for(UnsignedInt j = neighborOffset[vertex]; j != neighborOffset[vertex + 1]; ++j) {
+                    const Vector3& otherNormal = faceNormals[neighbors[j]/3];
+                    if(j == i || Math::dot(faceNormal, otherNormal) >= creaseCos)
+                        normal += otherNormal*cornerWeights[neighbors[j]];
+                }
+                if(normal != Vector3()) normal = normal.normalized();
+
+                /* Reuse normal of a previous corner, if the same */
+                UnsignedInt id = distinctCount;
+                for(UnsignedInt j = neighborOffset[vertex]; j != i; ++j) {
+                    if(cornerNormals[neighbors[j]] != normal) continue;
+                    id = cornerNormalIds[neighbors[j]];
+                    break;
+                }
+                if(id == distinctCount) ++distinctCount;
+
+                cornerNormals[corner] = normal;
+                cornerNormalIds[corner] = id;
+            }
+
+            normalOffset[vertex + 1] = distinctCount;
+        }
+    });
+
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        normalOffset[i + 1] += normalOffset[i];
+
+    /* Compact the distinct normals and make the indices global, each vertex
+       writes just to its own range */
+    std::vector<UnsignedInt> normalIndices(indices.size());
+    std::vector<Vector3> normals(normalOffset.back());
+    Magnum::Implementation::parallelFor(vertexCount, threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t vertex = begin; vertex != end; ++vertex) {
+            for(UnsignedInt i = neighborOffset[vertex]; i != neighborOffset[vertex + 1]; ++i) {
+                const UnsignedInt corner = neighbors[i];
+                const UnsignedInt id = normalOffset[vertex] + cornerNormalIds[corner];
+                normalIndices[corner] = id;
+                normals[id] = cornerNormals[corner];
+            }
+        }
+    });
+
+    return std::make_tuple(std::move(normalIndices), std::move(normals));
+}
+
+}}
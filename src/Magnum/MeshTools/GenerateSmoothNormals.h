@@ -0,0 +1,108 @@
+#ifndef Magnum_MeshTools_GenerateSmoothNormals_h
+#define Magnum_MeshTools_GenerateSmoothNormals_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::generateSmoothNormals(), enum @ref Magnum::MeshTools::NormalWeighting
+ */
+
+#include <tuple>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Angle.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Normal weighting
+
+@see @ref generateSmoothNormals()
+*/
+enum class NormalWeighting: UnsignedByte {
+    /**
+     * Each face normal is weighted by the face area. Cheap, but long thin
+     * triangles have disproportionate influence.
+     */
+    Area,
+
+    /**
+     * Each face normal is weighted by the face angle at given vertex. The
+     * result doesn't depend on how the surface around the vertex is
+     * triangulated.
+     */
+    Angle
+};
+
+/** @debugoperatorenum{Magnum::MeshTools::NormalWeighting} */
+MAGNUM_MESHTOOLS_EXPORT Debug operator<<(Debug debug, NormalWeighting value);
+
+/**
+@brief Generate smooth normals
+@param indices      Array of triangle face indices
+@param positions    Array of vertex positions
+@param weighting    Face normal weighting
+@param creaseAngle  Crease angle threshold
+@param threadCount  Count of threads to use, `0` means hardware concurrency
+@return Normal indices and vectors
+
+For each vertex calculates weighted average of normals of all faces sharing
+it, assuming counterclockwise winding. If @p creaseAngle is less than
+180 degrees, only faces with angle between the normals not larger than
+the threshold are taken into account for each face corner, so a single vertex
+can have more than one normal and the hard edges stay hard:
+@code
+std::vector<UnsignedInt> vertexIndices;
+std::vector<Vector3> positions;
+
+std::vector<UnsignedInt> normalIndices;
+std::vector<Vector3> normals;
+std::tie(normalIndices, normals) = MeshTools::generateSmoothNormals(vertexIndices, positions, MeshTools::NormalWeighting::Angle, Deg(60.0f));
+@endcode
+You can then use @ref combineIndexedArrays() to combine normal and vertex
+array to use the same indices. Without the crease threshold the returned
+normal indices are the same as @p indices and there is exactly one normal for
+each position, so the combining step can be skipped. Normals of vertices not
+referenced by any face or surrounded only by degenerate faces are zero.
+
+The faces adjacent to each vertex are found using a compressed vertex-to-face
+adjacency table (similar to the one used by @ref tipsify()), so each normal is
+gathered from its faces without any concurrent writes. If Magnum is built with
+`BUILD_MULTITHREADED` (see @ref building), face normals and vertex normals
+are calculated in parallel using given count of threads. The output is the
+same regardless of thread count.
+
+@attention The function requires the mesh to have triangle faces, thus index
+    count must be divisible by 3.
+
+@see @ref generateFlatNormals()
+*/
+std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>> MAGNUM_MESHTOOLS_EXPORT generateSmoothNormals(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, NormalWeighting weighting = NormalWeighting::Angle, Rad creaseAngle = Deg(180.0f), UnsignedInt threadCount = 1);
+
+}}
+
+#endif
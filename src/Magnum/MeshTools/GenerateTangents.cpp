@@ -0,0 +1,212 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GenerateTangents.h"
+
+#include <cmath>
+#include <functional>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/MeshTools/CombineIndexedArrays.h"
+#include "Magnum/MeshTools/Duplicate.h"
+#include "Magnum/MeshTools/Implementation/VertexCorners.h"
+#include "Magnum/Implementation/parallelFor.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+Float angle(const Vector3& a, const Vector3& b) {
+    const Float lengths = std::sqrt(a.dot()*b.dot());
+    if(lengths == 0.0f) return 0.0f;
+    return std::acos(Math::clamp(Math::dot(a, b)/lengths, -1.0f, 1.0f));
+}
+
+/* Projects the vector into plane perpendicular to the normal */
+Vector3 project(const Vector3& vector, const Vector3& normal) {
+    return vector - normal*Math::dot(normal, vector);
+}
+
+/* Arbitrary unit vector perpendicular to the normal */
+Vector3 perpendicular(const Vector3& normal) {
+    const Vector3 axis = std::abs(normal.x()) < 0.9f ? Vector3::xAxis() : Vector3::yAxis();
+    const Vector3 tangent = project(axis, normal);
+    return tangent.dot() == 0.0f ? axis : tangent.normalized();
+}
+
+enum: UnsignedByte {
+    Degenerate = 0,
+    OrientationPreserving = 1,
+    OrientationReversing = 2
+};
+
+}
+
+std::tuple<std::vector<UnsignedInt>, std::vector<Vector4>> generateTangents(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::vector<Vector3>& normals, const std::vector<Vector2>& textureCoordinates, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::generateTangents(): index count is not divisible by 3!", (std::tuple<std::vector<UnsignedInt>, std::vector<Vector4>>()));
+    CORRADE_ASSERT(normals.size() == positions.size() && textureCoordinates.size() == positions.size(),
+        "MeshTools::generateTangents(): expected" << positions.size() << "normals and texture coordinates but got" << normals.size() << "and" << textureCoordinates.size(), (std::tuple<std::vector<UnsignedInt>, std::vector<Vector4>>()));
+    const std::size_t vertexCount = positions.size();
+    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
+    for(const UnsignedInt index: indices)
+        CORRADE_ASSERT(index < vertexCount, "MeshTools::generateTangents(): index" << index << "out of bounds for" << vertexCount << "vertices", (std::tuple<std::vector<UnsignedInt>, std::vector<Vector4>>()));
+    #endif
+
+    /* Orientation of every face and its tangent projected to each corner.
+       The unnormalized tangent is divided by (signed) area in texture space,
+       so it needs to be flipped if the area is negative. */
+    const std::size_t faceCount = indices.size()/3;
+    std::vector<UnsignedByte> faceOrientations(faceCount);
+    std::vector<Vector3> cornerTangents(indices.size());
+    Magnum::Implementation::parallelFor(faceCount, threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t face = begin; face != end; ++face) {
+            const UnsignedInt* const faceIndices = indices.data() + face*3;
+            const Vector3 d1 = positions[faceIndices[1]] - positions[faceIndices[0]];
+            const Vector3 d2 = positions[faceIndices[2]] - positions[faceIndices[0]];
+            const Vector2 t21 = textureCoordinates[faceIndices[1]] - textureCoordinates[faceIndices[0]];
+            const Vector2 t31 = textureCoordinates[faceIndices[2]] - textureCoordinates[faceIndices[0]];
+
+            const Float signedArea = t21.x()*t31.y() - t21.y()*t31.x();
+            const Vector3 tangent = d1*t31.y() - d2*t21.y();
+            const Float length = tangent.length();
+            if(signedArea == 0.0f || length == 0.0f) continue;
+
+            faceOrientations[face] = signedArea > 0.0f ? OrientationPreserving : OrientationReversing;
+            const Vector3 faceTangent = tangent*((signedArea > 0.0f ? 1.0f : -1.0f)/length);
+
+            /* Project the tangent to each corner normal and weight it by the
+               corner angle, also projected to the normal plane */
+            for(std::size_t i = 0; i != 3; ++i) {
+                const Vector3& normal = normals[faceIndices[i]];
+                const Vector3& position = positions[faceIndices[i]];
+                const Vector3 projected = project(faceTangent, normal);
+                if(projected.dot() == 0.0f) continue;
+
+                const Float weight = angle(
+                    project(positions[faceIndices[(i + 1)%3]] - position, normal),
+                    project(positions[faceIndices[(i + 2)%3]] - position, normal));
+                cornerTangents[face*3 + i] = projected.normalized()*weight;
+            }
+        }
+    });
+
+    std::vector<UnsignedInt> cornerOffset, corners;
+    Implementation::vertexCorners(indices, vertexCount, cornerOffset, corners);
+
+    /* For each vertex average the tangents of corners with the same
+       orientation. There are at most two distinct tangents for each vertex,
+       the orientation-preserving one goes first.
+       Corners of degenerate faces join the group of first non-degenerate
+       corner. */
+    std::vector<Vector4> groupTangents(vertexCount*2);
+    std::vector<UnsignedByte> cornerGroups(indices.size());
+    std::vector<UnsignedInt> tangentOffset(vertexCount + 1);
+    Magnum::Implementation::parallelFor(vertexCount, threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t vertex = begin; vertex != end; ++vertex) {
+            Vector3 sums[2];
+            bool used[2]{};
+            UnsignedByte fallback = Degenerate;
+            for(UnsignedInt i = cornerOffset[vertex]; i != cornerOffset[vertex + 1]; ++i) {
+                const UnsignedByte orientation = faceOrientations[corners[i]/3];
+                if(orientation == Degenerate) continue;
+                if(fallback == Degenerate) fallback = orientation;
+                sums[orientation - 1] += cornerTangents[corners[i]];
+            }
+            if(fallback == Degenerate) fallback = OrientationPreserving;
+
+            for(UnsignedInt i = cornerOffset[vertex]; i != cornerOffset[vertex + 1]; ++i) {
+                UnsignedByte orientation = faceOrientations[corners[i]/3];
+                if(orientation == Degenerate) orientation = fallback;
+                cornerGroups[corners[i]] = orientation - 1;
+                used[orientation - 1] = true;
+            }
+
+            /* Number the used groups consecutively */
+            const Vector3& normal = normals[vertex];
+            UnsignedByte groupIds[2]{};
+            UnsignedInt count = 0;
+            for(std::size_t group = 0; group != 2; ++group) {
+                if(!used[group]) continue;
+                const Vector3 tangent = sums[group].dot() == 0.0f ? perpendicular(normal) : sums[group].normalized();
+                groupIds[group] = count;
+                groupTangents[vertex*2 + count++] = Vector4{tangent, group == 0 ? 1.0f : -1.0f};
+            }
+            for(UnsignedInt i = cornerOffset[vertex]; i != cornerOffset[vertex + 1]; ++i)
+                cornerGroups[corners[i]] = groupIds[cornerGroups[corners[i]]];
+            tangentOffset[vertex + 1] = count;
+        }
+    });
+
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        tangentOffset[i + 1] += tangentOffset[i];
+
+    /* Compact the tangents and make the indices global, each vertex writes
+       just to its own range */
+    std::vector<UnsignedInt> tangentIndices(indices.size());
+    std::vector<Vector4> tangents(tangentOffset.back());
+    Magnum::Implementation::parallelFor(vertexCount, threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t vertex = begin; vertex != end; ++vertex) {
+            for(UnsignedInt i = tangentOffset[vertex]; i != tangentOffset[vertex + 1]; ++i)
+                tangents[i] = groupTangents[vertex*2 + i - tangentOffset[vertex]];
+            for(UnsignedInt i = cornerOffset[vertex]; i != cornerOffset[vertex + 1]; ++i)
+                tangentIndices[corners[i]] = tangentOffset[vertex] + cornerGroups[corners[i]];
+        }
+    });
+
+    return std::make_tuple(std::move(tangentIndices), std::move(tangents));
+}
+
+std::vector<Vector4> generateTangents(Trade::MeshData3D& meshData, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(meshData.primitive() == MeshPrimitive::Triangles && meshData.isIndexed(),
+        "MeshTools::generateTangents(): expected indexed triangle mesh", {});
+    CORRADE_ASSERT(meshData.hasNormals() && meshData.hasTextureCoords2D(),
+        "MeshTools::generateTangents(): the mesh has no normals or texture coordinates", {});
+
+    std::vector<UnsignedInt> tangentIndices;
+    std::vector<Vector4> tangents;
+    std::tie(tangentIndices, tangents) = generateTangents(meshData.indices(), meshData.positions(0), meshData.normals(0), meshData.textureCoords2D(0), threadCount);
+
+    /* Each vertex got exactly one tangent, nothing to do */
+    if(tangents.size() == meshData.positions(0).size() && tangentIndices == meshData.indices())
+        return tangents;
+
+    /* Otherwise combine the indices and duplicate all vertex data
+       accordingly */
+    std::vector<UnsignedInt> vertexIndices = meshData.indices();
+    meshData.indices() = combineIndexArrays({std::ref(vertexIndices), std::ref(tangentIndices)});
+    for(UnsignedInt i = 0; i != meshData.positionArrayCount(); ++i)
+        meshData.positions(i) = duplicate(vertexIndices, meshData.positions(i));
+    for(UnsignedInt i = 0; i != meshData.normalArrayCount(); ++i)
+        meshData.normals(i) = duplicate(vertexIndices, meshData.normals(i));
+    for(UnsignedInt i = 0; i != meshData.textureCoords2DArrayCount(); ++i)
+        meshData.textureCoords2D(i) = duplicate(vertexIndices, meshData.textureCoords2D(i));
+    return duplicate(tangentIndices, tangents);
+}
+
+}}
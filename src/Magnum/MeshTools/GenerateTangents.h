@@ -0,0 +1,109 @@
+#ifndef Magnum_MeshTools_GenerateTangents_h
+#define Magnum_MeshTools_GenerateTangents_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::generateTangents()
+ */
+
+#include <tuple>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Generate tangents
+@param indices              Array of triangle face indices
+@param positions            Array of vertex positions
+@param normals              Array of vertex normals
+@param textureCoordinates   Array of vertex texture coordinates
+@param threadCount          Count of threads to use, `0` means hardware
+    concurrency
+@return Tangent indices and vectors
+
+All three attribute arrays are expected to be indexed with @p indices and have
+the same size. For each face corner the face tangent is projected into the
+plane perpendicular to the vertex normal and the tangents of all corners
+sharing the vertex are averaged using the corner angle as weight. The returned
+tangents contain tangent direction in XYZ and sign of the bitangent in W, see
+@ref Shaders::Generic3D::Tangent.
+
+Faces with mirrored texture mapping (i.e. with bitangent sign different from
+other faces sharing the vertex) are averaged separately, so a vertex on a
+mirroring seam gets two tangents, but otherwise each vertex has exactly one.
+Use @ref combineIndexedArrays() to combine the tangent indices with vertex
+indices, splitting the vertices only where needed, or use
+@ref generateTangents(Trade::MeshData3D&, UnsignedInt), which does all that
+automatically. Vertices with faces without valid texture mapping get an
+arbitrary tangent perpendicular to the normal, vertices not referenced by any
+face don't get any tangent.
+
+If Magnum is built with `BUILD_MULTITHREADED` (see @ref building), the faces
+and vertices are processed in parallel using given count of threads. The
+output is the same regardless of thread count.
+
+@attention The function requires the mesh to have triangle faces, thus index
+    count must be divisible by 3.
+
+@see @ref generateSmoothNormals()
+*/
+std::tuple<std::vector<UnsignedInt>, std::vector<Vector4>> MAGNUM_MESHTOOLS_EXPORT generateTangents(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::vector<Vector3>& normals, const std::vector<Vector2>& textureCoordinates, UnsignedInt threadCount = 1);
+
+/**
+@brief Generate tangents for mesh data
+@param[in,out] meshData Mesh data
+@param threadCount      Count of threads to use, `0` means hardware
+    concurrency
+@return Tangents indexed with @ref Trade::MeshData3D::indices()
+
+Calculates tangents from first position, normal and texture coordinate array
+using @ref generateTangents(const std::vector<UnsignedInt>&, const std::vector<Vector3>&, const std::vector<Vector3>&, const std::vector<Vector2>&, UnsignedInt)
+and then splits vertices which have more than one tangent, duplicating all
+vertex data arrays and updating the index array, so the returned array can be
+indexed with the same indices as the rest of the data. Vertices not referenced
+by any face are removed in that case. The result can be directly passed to
+@ref compile(const Trade::MeshData3D&, const std::vector<Vector4>&, BufferUsage):
+@code
+std::optional<Trade::MeshData3D> data = importer.mesh3D(0);
+std::vector<Vector4> tangents = MeshTools::generateTangents(*data);
+
+Mesh mesh;
+std::unique_ptr<Buffer> vertices, indices;
+std::tie(mesh, vertices, indices) = MeshTools::compile(*data, tangents, BufferUsage::StaticDraw);
+@endcode
+
+Expects that the mesh is indexed @ref MeshPrimitive::Triangles and has
+normals and texture coordinates.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<Vector4> generateTangents(Trade::MeshData3D& meshData, UnsignedInt threadCount = 1);
+
+}}
+
+#endif
@@ -1,5 +1,5 @@
-#ifndef Magnum_MeshTools_Test_SubdivideRemoveDuplicatesBenchmark_h
-#define Magnum_MeshTools_Test_SubdivideRemoveDuplicatesBenchmark_h
+#ifndef Magnum_MeshTools_Implementation_VertexCorners_h
+#define Magnum_MeshTools_Implementation_VertexCorners_h
 /*
     This file is part of Magnum.
 
@@ -25,25 +25,30 @@
     DEALINGS IN THE SOFTWARE.
 */
 
-#include <QtCore/QObject>
-
-#include "Magnum/Magnum.h"
-
-namespace Magnum { namespace MeshTools { namespace Test {
-
-class SubdivideRemoveDuplicatesBenchmark: public QObject {
-    Q_OBJECT
-
-    private slots:
-        void subdivide();
-        void subdivideAndRemoveDuplicatesMeshAfter();
-        void subdivideAndRemoveDuplicatesMeshBetween();
-
-    private:
-        static Magnum::Vector4 interpolator(const Magnum::Vector4& a, const Magnum::Vector4& b) {
-            return (a+b).xyz().normalized();
-        }
-};
+#include <vector>
+
+#include "Magnum/Types.h"
+
+namespace Magnum { namespace MeshTools { namespace Implementation {
+
+/* Compressed vertex-to-corner adjacency. Face corners (i.e. positions in the
+   index array) referencing i-th vertex are in
+   corners[offsets[i]] ; corners[offsets[i+1]], in increasing order. The
+   offsets are shifted to the right first and the second loop shifts them
+   back, same as in Tipsify::buildAdjacency(). All indices are expected to be
+   less than vertexCount. */
+inline void vertexCorners(const std::vector<UnsignedInt>& indices, const std::size_t vertexCount, std::vector<UnsignedInt>& offsets, std::vector<UnsignedInt>& corners) {
+    offsets.assign(vertexCount + 2, 0);
+    for(const UnsignedInt index: indices)
+        ++offsets[index + 2];
+    for(std::size_t i = 2; i != vertexCount + 2; ++i)
+        offsets[i] += offsets[i - 1];
+
+    corners.resize(indices.size());
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        corners[offsets[indices[i] + 1]++] = i;
+    offsets.pop_back();
+}
 
 }}}
 
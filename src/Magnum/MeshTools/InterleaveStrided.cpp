@@ -0,0 +1,239 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "InterleaveStrided.h"
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Packing.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Signed normalized 10-bit XYZ and 2-bit W in one 32-bit value. Rounds
+   the same way as Math::pack() does. */
+void convert2101010(char* out, const std::size_t outStride, const char* in, const std::size_t inStride, const std::size_t componentCount, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i, out += outStride, in += inStride) {
+        UnsignedInt packed = 0;
+        for(std::size_t j = 0; j != componentCount; ++j) {
+            Float value;
+            std::memcpy(&value, in + j*sizeof(Float), sizeof(Float));
+            if(j == 3) packed |= (UnsignedInt(Math::pack<Int, 2>(value)) & 0x3) << 30;
+            else packed |= (UnsignedInt(Math::pack<Int, 10>(value)) & 0x3ff) << (10*j);
+        }
+        std::memcpy(out, &packed, sizeof(UnsignedInt));
+    }
+}
+
+/* Copy with element size known at compile time, the compiler will expand
+   the memcpy into (possibly wide) loads and stores */
+template<std::size_t size> void copyFixed(char* out, const std::size_t outStride, const char* in, const std::size_t inStride, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i, out += outStride, in += inStride)
+        std::memcpy(out, in, size);
+}
+
+void copy(char* out, const std::size_t outStride, const char* in, const std::size_t inStride, const std::size_t size, const std::size_t count) {
+    /* Both contiguous, copy everything at once */
+    if(outStride == size && inStride == size) {
+        std::memcpy(out, in, size*count);
+        return;
+    }
+
+    switch(size) {
+        case 1: return copyFixed<1>(out, outStride, in, inStride, count);
+        case 2: return copyFixed<2>(out, outStride, in, inStride, count);
+        case 4: return copyFixed<4>(out, outStride, in, inStride, count);
+        case 6: return copyFixed<6>(out, outStride, in, inStride, count);
+        case 8: return copyFixed<8>(out, outStride, in, inStride, count);
+        case 12: return copyFixed<12>(out, outStride, in, inStride, count);
+        case 16: return copyFixed<16>(out, outStride, in, inStride, count);
+    }
+
+    for(std::size_t i = 0; i != count; ++i, out += outStride, in += inStride)
+        std::memcpy(out, in, size);
+}
+
+/* Normalized packing goes through Math::packInto() to make use of its SIMD
+   path. Contiguous arrays are packed at once, otherwise the components are
+   gathered into a temporary in batches and the result scattered back. */
+template<class T> void convertNormalized(char* out, const std::size_t outStride, const char* in, const std::size_t inStride, const std::size_t componentCount, const std::size_t count) {
+    if(inStride == componentCount*sizeof(Float) && outStride == componentCount*sizeof(T) &&
+       !(reinterpret_cast<std::uintptr_t>(in) % alignof(Float)) &&
+       !(reinterpret_cast<std::uintptr_t>(out) % alignof(T))) {
+        Math::packInto<T>({reinterpret_cast<const Float*>(in), componentCount*count},
+                          {reinterpret_cast<T*>(out), componentCount*count});
+        return;
+    }
+
+    constexpr std::size_t BatchSize = 256;
+    Float values[BatchSize];
+    T packed[BatchSize];
+    std::size_t vertex = 0, component = 0;
+    while(vertex != count) {
+        const std::size_t firstVertex = vertex, firstComponent = component;
+        std::size_t size = 0;
+        for(; size != BatchSize && vertex != count; ++size) {
+            std::memcpy(values + size, in + vertex*inStride + component*sizeof(Float), sizeof(Float));
+            if(++component == componentCount) {
+                component = 0;
+                ++vertex;
+            }
+        }
+
+        Math::packInto<T>({values, size}, {packed, size});
+
+        vertex = firstVertex;
+        component = firstComponent;
+        for(std::size_t i = 0; i != size; ++i) {
+            std::memcpy(out + vertex*outStride + component*sizeof(T), packed + i, sizeof(T));
+            if(++component == componentCount) {
+                component = 0;
+                ++vertex;
+            }
+        }
+    }
+}
+
+template<class T, T(*convert)(Float)> void convertFloats(char* out, const std::size_t outStride, const char* in, const std::size_t inStride, const std::size_t componentCount, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i, out += outStride, in += inStride) {
+        for(std::size_t j = 0; j != componentCount; ++j) {
+            Float value;
+            std::memcpy(&value, in + j*sizeof(Float), sizeof(Float));
+            const T converted = convert(value);
+            std::memcpy(out + j*sizeof(T), &converted, sizeof(T));
+        }
+    }
+}
+
+}
+
+Debug operator<<(Debug debug, const AttributeConversion value) {
+    switch(value) {
+        #define _c(value) case AttributeConversion::value: return debug << "MeshTools::AttributeConversion::" #value;
+        _c(None)
+        _c(Half)
+        _c(NormalizedByte)
+        _c(NormalizedUnsignedByte)
+        _c(NormalizedShort)
+        _c(NormalizedUnsignedShort)
+        _c(NormalizedInt2101010Rev)
+        #undef _c
+    }
+
+    return debug << "MeshTools::AttributeConversion::(invalid)";
+}
+
+std::size_t StridedAttribute::convertedSize() const {
+    const std::size_t componentCount = _size/sizeof(Float);
+    switch(_conversion) {
+        case AttributeConversion::None: return _size;
+        case AttributeConversion::Half: return componentCount*sizeof(UnsignedShort);
+        case AttributeConversion::NormalizedByte: return componentCount*sizeof(Byte);
+        case AttributeConversion::NormalizedUnsignedByte: return componentCount*sizeof(UnsignedByte);
+        case AttributeConversion::NormalizedShort: return componentCount*sizeof(Short);
+        case AttributeConversion::NormalizedUnsignedShort: return componentCount*sizeof(UnsignedShort);
+        case AttributeConversion::NormalizedInt2101010Rev: return sizeof(UnsignedInt);
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+std::size_t interleavedStride(const Containers::ArrayView<const StridedAttribute> attributes) {
+    std::size_t stride = 0;
+    for(const StridedAttribute& attribute: attributes)
+        stride += attribute.convertedSize();
+    return stride;
+}
+
+std::size_t interleavedStride(const std::initializer_list<StridedAttribute> attributes) {
+    return interleavedStride({attributes.begin(), attributes.size()});
+}
+
+void interleaveInto(const Containers::ArrayView<char> buffer, const Containers::ArrayView<const StridedAttribute> attributes) {
+    /* Verify the attributes, get count and stride */
+    std::size_t count = ~std::size_t{};
+    std::size_t stride = 0;
+    for(const StridedAttribute& attribute: attributes) {
+        CORRADE_ASSERT(attribute.conversion() == AttributeConversion::None || attribute.size() % sizeof(Float) == 0,
+            "MeshTools::interleaveInto(): expected attribute size to be multiple of" << sizeof(Float) << "for" << attribute.conversion() << "but got" << attribute.size(), );
+        CORRADE_ASSERT(attribute.conversion() != AttributeConversion::NormalizedInt2101010Rev || attribute.size() == 3*sizeof(Float) || attribute.size() == 4*sizeof(Float),
+            "MeshTools::interleaveInto(): expected three or four components for" << attribute.conversion() << "but got" << attribute.size()/sizeof(Float), );
+        stride += attribute.convertedSize();
+        if(attribute.isGap()) continue;
+        CORRADE_ASSERT(count == ~std::size_t{} || attribute.count() == count,
+            "MeshTools::interleaveInto(): attribute arrays don't have the same length, expected" << count << "but got" << attribute.count(), );
+        count = attribute.count();
+    }
+
+    /* Only gaps, nothing to do */
+    if(count == ~std::size_t{}) return;
+
+    CORRADE_ASSERT(count*stride <= buffer.size(), "MeshTools::interleaveInto(): the data buffer is too small, expected" << count*stride << "but got" << buffer.size(), );
+
+    /* Write the attributes one after another */
+    char* out = buffer.begin();
+    for(const StridedAttribute& attribute: attributes) {
+        const char* const in = static_cast<const char*>(attribute.data());
+        const std::size_t componentCount = attribute.size()/sizeof(Float);
+        switch(attribute.conversion()) {
+            case AttributeConversion::None:
+                if(!attribute.isGap())
+                    copy(out, stride, in, attribute.stride(), attribute.size(), count);
+                break;
+            case AttributeConversion::Half:
+                convertFloats<UnsignedShort, Math::packHalf>(out, stride, in, attribute.stride(), componentCount, count);
+                break;
+            case AttributeConversion::NormalizedByte:
+                convertNormalized<Byte>(out, stride, in, attribute.stride(), componentCount, count);
+                break;
+            case AttributeConversion::NormalizedUnsignedByte:
+                convertNormalized<UnsignedByte>(out, stride, in, attribute.stride(), componentCount, count);
+                break;
+            case AttributeConversion::NormalizedShort:
+                convertNormalized<Short>(out, stride, in, attribute.stride(), componentCount, count);
+                break;
+            case AttributeConversion::NormalizedUnsignedShort:
+                convertNormalized<UnsignedShort>(out, stride, in, attribute.stride(), componentCount, count);
+                break;
+            case AttributeConversion::NormalizedInt2101010Rev:
+                convert2101010(out, stride, in, attribute.stride(), componentCount, count);
+                break;
+        }
+
+        out += attribute.convertedSize();
+    }
+}
+
+void interleaveInto(const Containers::ArrayView<char> buffer, const std::initializer_list<StridedAttribute> attributes) {
+    interleaveInto(buffer, {attributes.begin(), attributes.size()});
+}
+
+}}
@@ -0,0 +1,230 @@
+#ifndef Magnum_MeshTools_InterleaveStrided_h
+#define Magnum_MeshTools_InterleaveStrided_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::MeshTools::StridedAttribute, enum @ref Magnum::MeshTools::AttributeConversion, function @ref Magnum::MeshTools::interleavedStride(), @ref Magnum::MeshTools::interleaveInto()
+ */
+
+#include <initializer_list>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Attribute conversion
+
+Conversion done by @ref interleaveInto(Containers::ArrayView<char>, std::initializer_list<StridedAttribute>)
+when writing the attribute. All conversions except @ref AttributeConversion::None
+expect the source attribute to consist of @ref Magnum::Float "Float"
+components.
+@see @ref StridedAttribute
+*/
+enum class AttributeConversion: UnsignedByte {
+    /** Data are copied as-is */
+    None,
+
+    /**
+     * Each component is converted to 16-bit half-float, rounded to nearest
+     * even. Values out of range are converted to infinity.
+     */
+    Half,
+
+    /**
+     * Each component is clamped to @f$ [-1, 1] @f$ and converted to
+     * normalized @ref Magnum::Byte "Byte", rounded to nearest
+     * @see @ref Math::pack(), @ref Math::packInto()
+     */
+    NormalizedByte,
+
+    /**
+     * Each component is clamped to @f$ [0, 1] @f$ and converted to
+     * normalized @ref Magnum::UnsignedByte "UnsignedByte", rounded to nearest
+     * @see @ref Math::pack(), @ref Math::packInto()
+     */
+    NormalizedUnsignedByte,
+
+    /**
+     * Each component is clamped to @f$ [-1, 1] @f$ and converted to
+     * normalized @ref Magnum::Short "Short", rounded to nearest
+     * @see @ref Math::pack(), @ref Math::packInto()
+     */
+    NormalizedShort,
+
+    /**
+     * Each component is clamped to @f$ [0, 1] @f$ and converted to
+     * normalized @ref Magnum::UnsignedShort "UnsignedShort", rounded to nearest
+     * @see @ref Math::pack(), @ref Math::packInto()
+     */
+    NormalizedUnsignedShort,
+
+    /**
+     * Three or four components are clamped to @f$ [-1, 1] @f$ and packed
+     * into a single @ref Magnum::UnsignedInt "UnsignedInt" as normalized
+     * signed 10-bit X, Y, Z and 2-bit W, with X in the least significant
+     * bits, rounded to nearest. If the source has only three components, W
+     * is zero. Matches the layout of @ref Attribute::DataType::Int2101010Rev.
+     * @see @ref Math::pack()
+     */
+    NormalizedInt2101010Rev
+};
+
+/** @debugoperatorenum{Magnum::MeshTools::AttributeConversion} */
+MAGNUM_MESHTOOLS_EXPORT Debug operator<<(Debug debug, AttributeConversion value);
+
+/**
+@brief Strided attribute source
+
+Describes one attribute for @ref interleaveInto(Containers::ArrayView<char>, std::initializer_list<StridedAttribute>)
+--- arbitrary strided data with optional format conversion or a gap. The class
+doesn't own the data, it must be kept in scope until the interleaving is done.
+*/
+class StridedAttribute {
+    public:
+        /**
+         * @brief Gap
+         *
+         * Leaves @p size bytes untouched in each vertex.
+         */
+        constexpr /*implicit*/ StridedAttribute(std::size_t size) noexcept: _data{}, _count{~std::size_t{}}, _stride{}, _size{size}, _conversion{AttributeConversion::None} {}
+
+        /**
+         * @brief Constructor
+         * @param data          Pointer to first element
+         * @param count         Element count
+         * @param stride        Byte distance between two consecutive
+         *      elements
+         * @param size          Size of one element in bytes
+         * @param conversion    Conversion to do when writing the element
+         *
+         * If @p conversion is not @ref AttributeConversion::None, @p size is
+         * expected to be multiple of `sizeof(Float)`. For
+         * @ref AttributeConversion::NormalizedInt2101010Rev it's expected to
+         * be three or four floats.
+         */
+        constexpr /*implicit*/ StridedAttribute(const void* data, std::size_t count, std::size_t stride, std::size_t size, AttributeConversion conversion = AttributeConversion::None) noexcept: _data{data}, _count{count}, _stride{stride}, _size{size}, _conversion{conversion} {}
+
+        /**
+         * @brief Construct from contiguous array
+         *
+         * Equivalent to calling @ref StridedAttribute(const void*, std::size_t, std::size_t, std::size_t, AttributeConversion)
+         * with `sizeof(T)` as both stride and size.
+         */
+        template<class T> /*implicit*/ StridedAttribute(Containers::ArrayView<const T> data, AttributeConversion conversion = AttributeConversion::None) noexcept: StridedAttribute{data.data(), data.size(), sizeof(T), sizeof(T), conversion} {}
+
+        /** @overload */
+        template<class T> /*implicit*/ StridedAttribute(const std::vector<T>& data, AttributeConversion conversion = AttributeConversion::None) noexcept: StridedAttribute{data.data(), data.size(), sizeof(T), sizeof(T), conversion} {}
+
+        /** @brief Whether this is a gap */
+        constexpr bool isGap() const { return _count == ~std::size_t{}; }
+
+        /** @brief Pointer to first element, `nullptr` for gaps */
+        constexpr const void* data() const { return _data; }
+
+        /** @brief Element count, `~std::size_t{}` for gaps */
+        constexpr std::size_t count() const { return _count; }
+
+        /** @brief Source stride */
+        constexpr std::size_t stride() const { return _stride; }
+
+        /** @brief Source element size */
+        constexpr std::size_t size() const { return _size; }
+
+        /** @brief Conversion */
+        constexpr AttributeConversion conversion() const { return _conversion; }
+
+        /**
+         * @brief Size of converted element
+         *
+         * Size of the element after applying @ref conversion(), in bytes.
+         */
+        std::size_t convertedSize() const;
+
+    private:
+        const void* _data;
+        std::size_t _count, _stride, _size;
+        AttributeConversion _conversion;
+};
+
+/**
+@brief Stride of interleaved strided attributes
+
+Sum of @ref StridedAttribute::convertedSize() of all attributes including
+gaps.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t interleavedStride(Containers::ArrayView<const StridedAttribute> attributes);
+
+/** @overload */
+MAGNUM_MESHTOOLS_EXPORT std::size_t interleavedStride(std::initializer_list<StridedAttribute> attributes);
+
+/**
+@brief Interleave strided vertex attributes into existing memory
+
+Unlike the variadic @ref interleaveInto() this function takes arbitrary
+strided sources instead of containers and is able to convert the data on the
+fly, so for example data loaded by an importer can be written directly into
+memory returned by @ref Buffer::map() without creating any intermediate
+arrays:
+@code
+std::vector<Vector3> positions;
+std::vector<Vector3> normals;
+std::vector<Vector2> textureCoordinates;
+
+// 12 bytes of positions, 6 bytes of normals, 2 gap bytes, 8 bytes of texture
+// coordinates
+std::initializer_list<MeshTools::StridedAttribute> attributes{
+    positions,
+    {normals, MeshTools::AttributeConversion::NormalizedShort}, 2,
+    textureCoordinates};
+const std::size_t size = MeshTools::interleavedStride(attributes)*positions.size();
+
+Buffer vertexBuffer;
+vertexBuffer.setData({nullptr, size}, BufferUsage::StaticDraw);
+MeshTools::interleaveInto({vertexBuffer.map<char>(0, size, Buffer::MapFlag::Write|Buffer::MapFlag::InvalidateBuffer), size}, attributes);
+CORRADE_INTERNAL_ASSERT_OUTPUT(vertexBuffer.unmap());
+@endcode
+
+Gaps are left untouched. Attributes are processed one after another, copies
+without conversion are done with fixed-size `std::memcpy()` calls for
+common element sizes, which compilers turn into wide loads and stores. If both
+the source and the destination are contiguous, the whole attribute is copied
+at once.
+
+@attention The function expects that all attributes have the same count and
+    that the buffer is large enough to contain the interleaved data.
+*/
+MAGNUM_MESHTOOLS_EXPORT void interleaveInto(Containers::ArrayView<char> buffer, Containers::ArrayView<const StridedAttribute> attributes);
+
+/** @overload */
+MAGNUM_MESHTOOLS_EXPORT void interleaveInto(Containers::ArrayView<char> buffer, std::initializer_list<StridedAttribute> attributes);
+
+}}
+
+#endif
@@ -0,0 +1,221 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Meshlets.h"
+
+#include <algorithm>
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Tipsify.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+void fillBounds(Meshlet& meshlet, const std::vector<UnsignedInt>& indices, const std::vector<UnsignedInt>& vertices, const std::vector<Vector3>& positions) {
+    /* Index range */
+    const auto minmax = std::minmax_element(vertices.begin(), vertices.end());
+    meshlet.indexStart = *minmax.first;
+    meshlet.indexEnd = *minmax.second;
+
+    /* Bounding sphere centered in the bounding box */
+    Vector3 min = positions[vertices.front()], max = min;
+    for(const UnsignedInt vertex: vertices) {
+        min = Math::min(min, positions[vertex]);
+        max = Math::max(max, positions[vertex]);
+    }
+    meshlet.center = (min + max)*0.5f;
+    Float radiusSquared = 0.0f;
+    for(const UnsignedInt vertex: vertices)
+        radiusSquared = Math::max(radiusSquared, (positions[vertex] - meshlet.center).dot());
+    meshlet.radius = std::sqrt(radiusSquared);
+
+    /* Normal cone around average face normal */
+    std::vector<Vector3> normals;
+    normals.reserve(meshlet.indexCount/3);
+    Vector3 axis;
+    for(std::size_t i = meshlet.indexOffset, end = meshlet.indexOffset + meshlet.indexCount; i != end; i += 3) {
+        const Vector3 normal = Math::cross(positions[indices[i + 1]] - positions[indices[i]],
+                                           positions[indices[i + 2]] - positions[indices[i]]);
+        const Float length = normal.length();
+        if(length == 0.0f) continue;
+
+        normals.push_back(normal/length);
+        axis += normals.back();
+    }
+
+    const Float axisLength = axis.length();
+    meshlet.coneAxis = axisLength == 0.0f ? Vector3{} : axis/axisLength;
+    meshlet.coneCutoff = 1.0f;
+    if(axisLength == 0.0f) return;
+
+    Float minDot = 1.0f;
+    for(const Vector3& normal: normals)
+        minDot = Math::min(minDot, Math::dot(normal, meshlet.coneAxis));
+    if(minDot > 0.0f) meshlet.coneCutoff = std::sqrt(1.0f - minDot*minDot);
+}
+
+}
+
+std::vector<Meshlet> buildMeshlets(std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const UnsignedInt maxVertices, const UnsignedInt maxTriangles) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::buildMeshlets(): index count is not divisible by 3!", {});
+    CORRADE_ASSERT(maxVertices >= 3 && maxTriangles >= 1,
+        "MeshTools::buildMeshlets(): expected at least 3 vertices and 1 triangle per cluster but got" << maxVertices << "and" << maxTriangles, {});
+    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
+    for(const UnsignedInt index: indices)
+        CORRADE_ASSERT(index < positions.size(), "MeshTools::buildMeshlets(): index" << index << "out of bounds for" << positions.size() << "vertices", {});
+    #endif
+
+    /* Neighboring triangles for each vertex */
+    std::vector<UnsignedInt> liveTriangleCount, neighborOffset, neighbors;
+    Implementation::Tipsify{indices, UnsignedInt(positions.size())}.buildAdjacency(liveTriangleCount, neighborOffset, neighbors);
+
+    const std::size_t faceCount = indices.size()/3;
+    std::vector<bool> emitted(faceCount);
+    std::size_t emittedCount = 0;
+
+    /* ID of the last cluster each vertex was added to, offset by one */
+    std::vector<UnsignedInt> vertexMeshlet(positions.size());
+
+    std::vector<UnsignedInt> outputIndices;
+    outputIndices.reserve(indices.size());
+    std::vector<Meshlet> meshlets;
+
+    std::vector<UnsignedInt> vertices, candidates;
+    std::size_t seed = 0;
+    while(emittedCount != faceCount) {
+        const UnsignedInt id = meshlets.size() + 1;
+        const auto newVertexCount = [&](UnsignedInt triangle) {
+            UnsignedInt count = 0;
+            for(std::size_t i = 0; i != 3; ++i)
+                if(vertexMeshlet[indices[triangle*3 + i]] != id) ++count;
+            return count;
+        };
+
+        vertices.clear();
+        candidates.clear();
+        std::size_t candidateCursor = 0;
+        UnsignedInt triangleCount = 0;
+        const std::size_t indexOffset = outputIndices.size();
+
+        while(triangleCount != maxTriangles) {
+            /* Pick the oldest candidate adding the least new vertices. Oldest
+               candidates are the closest to the seed, keeping the cluster
+               compact. */
+            UnsignedInt triangle = ~UnsignedInt{}, triangleNewVertexCount = 4;
+            while(candidateCursor != candidates.size() && emitted[candidates[candidateCursor]])
+                ++candidateCursor;
+            for(std::size_t i = candidateCursor; i != candidates.size(); ++i) {
+                if(emitted[candidates[i]]) continue;
+
+                const UnsignedInt count = newVertexCount(candidates[i]);
+                if(count < triangleNewVertexCount) {
+                    triangle = candidates[i];
+                    triangleNewVertexCount = count;
+                    if(!count) break;
+                }
+            }
+
+            /* No connected triangle left, close the cluster to keep it
+               compact. Seed of a new cluster is the next triangle in index
+               order. */
+            if(triangle == ~UnsignedInt{}) {
+                if(triangleCount) break;
+                while(emitted[seed]) ++seed;
+                triangle = seed;
+                triangleNewVertexCount = newVertexCount(triangle);
+            }
+
+            if(vertices.size() + triangleNewVertexCount > maxVertices) break;
+
+            emitted[triangle] = true;
+            ++emittedCount;
+            ++triangleCount;
+            for(std::size_t i = 0; i != 3; ++i) {
+                const UnsignedInt vertex = indices[triangle*3 + i];
+                outputIndices.push_back(vertex);
+                if(vertexMeshlet[vertex] == id) continue;
+
+                vertexMeshlet[vertex] = id;
+                vertices.push_back(vertex);
+                for(UnsignedInt j = neighborOffset[vertex]; j != neighborOffset[vertex + 1]; ++j)
+                    if(!emitted[neighbors[j]]) candidates.push_back(neighbors[j]);
+            }
+        }
+
+        Meshlet meshlet;
+        meshlet.indexOffset = indexOffset;
+        meshlet.indexCount = outputIndices.size() - indexOffset;
+        fillBounds(meshlet, outputIndices, vertices, positions);
+        meshlets.push_back(meshlet);
+    }
+
+    /* Swap original index buffer with reordered */
+    using std::swap;
+    swap(indices, outputIndices);
+
+    return meshlets;
+}
+
+std::vector<UnsignedInt> cullMeshlets(const std::vector<Meshlet>& meshlets, const Matrix4& transformationProjectionMatrix, const Vector3& cameraPosition) {
+    /* Frustum planes in mesh space, extracted from the matrix rows and
+       normalized so the distance can be compared to sphere radius */
+    Vector4 planes[6];
+    const Vector4 w = transformationProjectionMatrix.row(3);
+    for(std::size_t i = 0; i != 3; ++i) {
+        planes[i*2] = w + transformationProjectionMatrix.row(i);
+        planes[i*2 + 1] = w - transformationProjectionMatrix.row(i);
+    }
+    for(Vector4& plane: planes) plane /= plane.xyz().length();
+
+    std::vector<UnsignedInt> visible;
+    for(std::size_t i = 0; i != meshlets.size(); ++i) {
+        const Meshlet& meshlet = meshlets[i];
+
+        /* Bounding sphere fully outside of any plane */
+        bool outside = false;
+        for(const Vector4& plane: planes) {
+            if(Math::dot(plane.xyz(), meshlet.center) + plane.w() < -meshlet.radius) {
+                outside = true;
+                break;
+            }
+        }
+        if(outside) continue;
+
+        /* All faces facing away from every point of the bounding sphere */
+        const Vector3 direction = meshlet.center - cameraPosition;
+        if(Math::dot(direction, meshlet.coneAxis) >= meshlet.coneCutoff*direction.length() + meshlet.radius)
+            continue;
+
+        visible.push_back(i);
+    }
+
+    return visible;
+}
+
+}}
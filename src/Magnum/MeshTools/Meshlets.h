@@ -0,0 +1,158 @@
+#ifndef Magnum_MeshTools_Meshlets_h
+#define Magnum_MeshTools_Meshlets_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::MeshTools::Meshlet, function @ref Magnum::MeshTools::buildMeshlets(), @ref Magnum::MeshTools::cullMeshlets()
+ */
+
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Mesh cluster
+
+Contiguous range of the index array produced by @ref buildMeshlets(), together
+with data for culling it.
+@see @ref cullMeshlets()
+*/
+struct Meshlet {
+    /**
+     * @brief Offset of the first index
+     *
+     * Pass it to @ref MeshView::setIndexRange().
+     */
+    UnsignedInt indexOffset;
+
+    /**
+     * @brief Index count
+     *
+     * Pass it to @ref MeshView::setCount().
+     */
+    UnsignedInt indexCount;
+
+    /**
+     * @brief Minimal index
+     *
+     * Pass it as `start` to @ref MeshView::setIndexRange().
+     */
+    UnsignedInt indexStart;
+
+    /**
+     * @brief Maximal index
+     *
+     * Pass it as `end` to @ref MeshView::setIndexRange().
+     */
+    UnsignedInt indexEnd;
+
+    /** @brief Bounding sphere center */
+    Vector3 center;
+
+    /** @brief Bounding sphere radius */
+    Float radius;
+
+    /**
+     * @brief Normal cone axis
+     *
+     * Normalized average of all face normals.
+     */
+    Vector3 coneAxis;
+
+    /**
+     * @brief Normal cone cutoff
+     *
+     * Sine of the angle between @ref coneAxis and the most deviating face
+     * normal. If the angle is larger than 90°, it's `1.0f` and the
+     * cluster is never considered backfacing.
+     */
+    Float coneCutoff;
+};
+
+/**
+@brief Split the mesh into clusters
+@param[in,out] indices  Index array to operate on
+@param[in] positions    Vertex positions
+@param[in] maxVertices  Max unique vertex count in one cluster
+@param[in] maxTriangles Max triangle count in one cluster
+@return Cluster table
+
+Reorders the index array so each cluster occupies a contiguous range and
+returns the range together with bounding sphere and normal cone for each
+cluster. The clusters are grown greedily from a seed triangle using the same
+vertex-triangle adjacency as @ref tipsify(), preferring triangles which add
+the least new vertices. A cluster is closed when adding next triangle would
+exceed either of the limits or when there are no more connected triangles, so
+disconnected parts of the mesh always end up in different clusters. The
+default limits of 64 vertices and 126 triangles are a common choice for mesh
+shaders, for CPU culling larger clusters may be better.
+
+The clusters are drawn using @ref MeshView ranges:
+@code
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions;
+std::vector<MeshTools::Meshlet> meshlets = MeshTools::buildMeshlets(indices, positions);
+
+// upload the indices and positions to mesh ...
+
+for(UnsignedInt i: MeshTools::cullMeshlets(meshlets, transformationProjectionMatrix, cameraPosition)) {
+    MeshView view{mesh};
+    view.setCount(meshlets[i].indexCount)
+        .setIndexRange(meshlets[i].indexOffset, meshlets[i].indexStart, meshlets[i].indexEnd);
+    view.draw(shader);
+}
+@endcode
+
+The function expects the mesh to have triangle faces. Output is
+deterministic, the same input always produces the same clusters.
+@see @ref Meshlet
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<Meshlet> buildMeshlets(std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, UnsignedInt maxVertices = 64, UnsignedInt maxTriangles = 126);
+
+/**
+@brief Cull clusters
+@param meshlets                         Cluster table
+@param transformationProjectionMatrix   Transformation and projection matrix
+    of the mesh
+@param cameraPosition                   Camera position in mesh space
+@return IDs of potentially visible clusters
+
+A cluster is culled if its bounding sphere is outside of the frustum given by
+@p transformationProjectionMatrix or if all its faces are facing away from
+@p cameraPosition. The camera position is in the coordinate system of the
+mesh, i.e. translation of inverted mesh transformation relative to the
+camera.
+@see @ref buildMeshlets()
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<UnsignedInt> cullMeshlets(const std::vector<Meshlet>& meshlets, const Matrix4& transformationProjectionMatrix, const Vector3& cameraPosition);
+
+}}
+
+#endif
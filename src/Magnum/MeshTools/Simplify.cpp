@@ -0,0 +1,394 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Simplify.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Subdivide.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Symmetric 4x4 matrix of plane equation products, together with sum of
+   weights of all planes to be able to normalize the error */
+struct Quadric {
+    static Quadric plane(const Vector3& normal, const Float distance, const Double weight) {
+        const Double a = normal.x(), b = normal.y(), c = normal.z(), d = distance;
+
+        Quadric q;
+        q.a00 = weight*a*a; q.a01 = weight*a*b; q.a02 = weight*a*c; q.a03 = weight*a*d;
+        q.a11 = weight*b*b; q.a12 = weight*b*c; q.a13 = weight*b*d;
+        q.a22 = weight*c*c; q.a23 = weight*c*d;
+        q.a33 = weight*d*d;
+        q.weight = weight;
+        return q;
+    }
+
+    Quadric& operator+=(const Quadric& other) {
+        a00 += other.a00; a01 += other.a01; a02 += other.a02; a03 += other.a03;
+        a11 += other.a11; a12 += other.a12; a13 += other.a13;
+        a22 += other.a22; a23 += other.a23;
+        a33 += other.a33;
+        weight += other.weight;
+        return *this;
+    }
+
+    /* Weighted sum of squared distances of the point to all planes */
+    Double error(const Vector3& point) const {
+        const Double x = point.x(), y = point.y(), z = point.z();
+        return a00*x*x + 2.0*a01*x*y + 2.0*a02*x*z + 2.0*a03*x +
+               a11*y*y + 2.0*a12*y*z + 2.0*a13*y +
+               a22*z*z + 2.0*a23*z +
+               a33;
+    }
+
+    Double a00{}, a01{}, a02{}, a03{}, a11{}, a12{}, a13{}, a22{}, a23{}, a33{}, weight{};
+};
+
+struct Collapse {
+    bool operator>(const Collapse& other) const { return error > other.error; }
+
+    Float error;
+    UnsignedInt from, to;
+};
+
+/* Weight of quadrics keeping the border in place, relative to face
+   quadrics */
+constexpr Float BorderWeight = 10.0f;
+
+class Simplifier {
+    public:
+        explicit Simplifier(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions);
+
+        std::vector<std::pair<std::vector<UnsignedInt>, Float>> run(const std::vector<std::size_t>& targetFaceCounts);
+
+    private:
+        /* Vertex index the collapse from @p from to @p to would use in the
+           faces or ~0 if the collapse isn't allowed */
+        UnsignedInt target(UnsignedInt from, UnsignedInt to) const;
+        bool flips(UnsignedInt from, UnsignedInt to) const;
+        Float error(UnsignedInt from, UnsignedInt to) const;
+        void collapse(UnsignedInt from, UnsignedInt to, UnsignedInt index);
+        void addCollapse(UnsignedInt from, UnsignedInt to);
+        std::vector<UnsignedInt> aliveIndices() const;
+
+        const std::vector<Vector3>& _positions;
+        std::vector<UnsignedInt> _indices;
+        std::size_t _faceCount, _aliveFaceCount;
+
+        /* Per-vertex data, indexed with the remapped vertex -- all vertices
+           with the same position are treated as one */
+        std::vector<UnsignedInt> _remap;
+        std::vector<Quadric> _quadrics;
+        std::vector<std::vector<UnsignedInt>> _faces;
+        std::vector<bool> _aliveFaces, _aliveVertices, _locked, _border;
+
+        std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> _queue;
+};
+
+Simplifier::Simplifier(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions): _positions{positions}, _indices{indices}, _faceCount{indices.size()/3}, _aliveFaceCount{_faceCount}, _remap(positions.size()), _quadrics(positions.size()), _faces(positions.size()), _aliveFaces(_faceCount, true), _aliveVertices(positions.size(), true), _locked(positions.size(), false), _border(positions.size(), false) {
+    /* Remap all vertices with the same position to the one with smallest
+       index, vertices on attribute seams (more than one referenced index for
+       the same position) are locked */
+    std::vector<bool> referenced(positions.size(), false);
+    for(const UnsignedInt index: indices) referenced[index] = true;
+    std::vector<UnsignedInt> order(positions.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&positions](UnsignedInt a, UnsignedInt b) {
+        const Vector3& pa = positions[a];
+        const Vector3& pb = positions[b];
+        if(pa.x() != pb.x()) return pa.x() < pb.x();
+        if(pa.y() != pb.y()) return pa.y() < pb.y();
+        if(pa.z() != pb.z()) return pa.z() < pb.z();
+        return a < b;
+    });
+    for(std::size_t i = 0; i != order.size(); ) {
+        std::size_t end = i + 1;
+        while(end != order.size() && positions[order[end]] == positions[order[i]]) ++end;
+
+        std::size_t referencedCount = 0;
+        for(std::size_t j = i; j != end; ++j) {
+            _remap[order[j]] = order[i];
+            if(referenced[order[j]]) ++referencedCount;
+        }
+        if(referencedCount > 1) _locked[order[i]] = true;
+
+        i = end;
+    }
+
+    /* Face quadrics weighted by area */
+    for(std::size_t f = 0; f != _faceCount; ++f) {
+        const Vector3& a = positions[indices[f*3]];
+        const Vector3 normal = Math::cross(positions[indices[f*3 + 1]] - a, positions[indices[f*3 + 2]] - a);
+        const Float length = normal.length();
+        if(length == 0.0f) continue;
+
+        const Vector3 unitNormal = normal/length;
+        const Quadric q = Quadric::plane(unitNormal, -Math::dot(unitNormal, a), 0.5*length);
+        for(std::size_t i = 0; i != 3; ++i)
+            _quadrics[_remap[indices[f*3 + i]]] += q;
+    }
+
+    /* Faces adjacent to each vertex */
+    for(std::size_t f = 0; f != _faceCount; ++f) {
+        for(std::size_t i = 0; i != 3; ++i) {
+            std::vector<UnsignedInt>& faces = _faces[_remap[indices[f*3 + i]]];
+            if(faces.empty() || faces.back() != f) faces.push_back(f);
+        }
+    }
+
+    /* Count faces adjacent to each edge to find borders and non-manifold
+       edges */
+    Implementation::EdgeMap edges{indices.size()};
+    std::vector<UnsignedInt> edgeFaceCounts;
+    std::vector<UnsignedInt> faceEdges(indices.size());
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        const UnsignedInt a = _remap[indices[i]];
+        const UnsignedInt b = _remap[indices[i%3 == 2 ? i - 2 : i + 1]];
+        const UnsignedInt edge = edges.insert(a, b, edgeFaceCounts.size()).first;
+        if(edge == edgeFaceCounts.size()) edgeFaceCounts.push_back(0);
+        ++edgeFaceCounts[edge];
+        faceEdges[i] = edge;
+    }
+
+    /* Border quadrics are planes perpendicular to the face going through the
+       border edge */
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        const UnsignedInt a = _remap[indices[i]];
+        const UnsignedInt b = _remap[indices[i%3 == 2 ? i - 2 : i + 1]];
+        if(edgeFaceCounts[faceEdges[i]] > 2) {
+            _locked[a] = _locked[b] = true;
+            continue;
+        }
+        if(edgeFaceCounts[faceEdges[i]] != 1) continue;
+
+        _border[a] = _border[b] = true;
+
+        const std::size_t f = i - i%3;
+        const Vector3& pa = positions[indices[f]];
+        const Vector3 normal = Math::cross(positions[indices[f + 1]] - pa, positions[indices[f + 2]] - pa);
+        const Vector3 edge = positions[b] - positions[a];
+        const Vector3 borderNormal = Math::cross(edge, normal);
+        const Float length = borderNormal.length();
+        if(length == 0.0f) continue;
+
+        const Vector3 unitBorderNormal = borderNormal/length;
+        Quadric q = Quadric::plane(unitBorderNormal, -Math::dot(unitBorderNormal, positions[a]), edge.dot()*BorderWeight);
+        /* Border quadrics don't contribute to the normalization */
+        q.weight = 0.0;
+        _quadrics[a] += q;
+        _quadrics[b] += q;
+    }
+
+    /* Initial collapse candidates */
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        const UnsignedInt a = _remap[indices[i]];
+        const UnsignedInt b = _remap[indices[i%3 == 2 ? i - 2 : i + 1]];
+        addCollapse(a, b);
+        addCollapse(b, a);
+    }
+}
+
+UnsignedInt Simplifier::target(const UnsignedInt from, const UnsignedInt to) const {
+    if(from == to || _locked[from] || !_aliveVertices[from] || !_aliveVertices[to])
+        return ~UnsignedInt{};
+
+    /* Vertex index of the target in faces shared with the source, all of them
+       have to agree, otherwise the source lies between two attribute seams */
+    UnsignedInt index = ~UnsignedInt{};
+    std::size_t sharedFaceCount = 0;
+    for(const UnsignedInt f: _faces[from]) {
+        if(!_aliveFaces[f]) continue;
+        for(std::size_t i = 0; i != 3; ++i) {
+            if(_remap[_indices[f*3 + i]] != to) continue;
+            if(index != ~UnsignedInt{} && index != _indices[f*3 + i])
+                return ~UnsignedInt{};
+            index = _indices[f*3 + i];
+            ++sharedFaceCount;
+        }
+    }
+
+    /* Border vertices can be collapsed only along the border */
+    if(_border[from] && (!_border[to] || sharedFaceCount != 1))
+        return ~UnsignedInt{};
+
+    return index;
+}
+
+bool Simplifier::flips(const UnsignedInt from, const UnsignedInt to) const {
+    for(const UnsignedInt f: _faces[from]) {
+        if(!_aliveFaces[f]) continue;
+
+        Vector3 before[3], after[3];
+        bool shared = false;
+        for(std::size_t i = 0; i != 3; ++i) {
+            const UnsignedInt vertex = _remap[_indices[f*3 + i]];
+            if(vertex == to) shared = true;
+            before[i] = _positions[vertex];
+            after[i] = vertex == from ? _positions[to] : before[i];
+        }
+
+        /* Faces containing both vertices will be removed */
+        if(shared) continue;
+
+        const Vector3 normalBefore = Math::cross(before[1] - before[0], before[2] - before[0]);
+        const Vector3 normalAfter = Math::cross(after[1] - after[0], after[2] - after[0]);
+        if(Math::dot(normalBefore, normalAfter) <= 0.0f) return true;
+    }
+
+    return false;
+}
+
+Float Simplifier::error(const UnsignedInt from, const UnsignedInt to) const {
+    Quadric q = _quadrics[from];
+    q += _quadrics[to];
+    return Float(std::max(q.error(_positions[to]), 0.0)/std::max(q.weight, 1.0e-12));
+}
+
+void Simplifier::addCollapse(const UnsignedInt from, const UnsignedInt to) {
+    if(from == to || _locked[from] || (_border[from] && !_border[to])) return;
+    _queue.push({error(from, to), from, to});
+}
+
+void Simplifier::collapse(const UnsignedInt from, const UnsignedInt to, const UnsignedInt index) {
+    for(const UnsignedInt f: _faces[from]) {
+        if(!_aliveFaces[f]) continue;
+
+        bool shared = false;
+        for(std::size_t i = 0; i != 3; ++i)
+            if(_remap[_indices[f*3 + i]] == to) shared = true;
+
+        if(shared) {
+            _aliveFaces[f] = false;
+            --_aliveFaceCount;
+            continue;
+        }
+
+        for(std::size_t i = 0; i != 3; ++i)
+            if(_remap[_indices[f*3 + i]] == from) _indices[f*3 + i] = index;
+        _faces[to].push_back(f);
+    }
+
+    _quadrics[to] += _quadrics[from];
+    _aliveVertices[from] = false;
+    std::vector<UnsignedInt>{}.swap(_faces[from]);
+
+    /* Remove dead faces from the target so the lists don't grow
+       indefinitely */
+    _faces[to].erase(std::remove_if(_faces[to].begin(), _faces[to].end(), [this](UnsignedInt f) { return !_aliveFaces[f]; }), _faces[to].end());
+
+    /* Errors of all collapses around the target changed */
+    for(const UnsignedInt f: _faces[to]) {
+        for(std::size_t i = 0; i != 3; ++i) {
+            const UnsignedInt vertex = _remap[_indices[f*3 + i]];
+            if(vertex == to) continue;
+            addCollapse(vertex, to);
+            addCollapse(to, vertex);
+        }
+    }
+}
+
+std::vector<UnsignedInt> Simplifier::aliveIndices() const {
+    std::vector<UnsignedInt> indices;
+    indices.reserve(_aliveFaceCount*3);
+    for(std::size_t f = 0; f != _faceCount; ++f) {
+        if(!_aliveFaces[f]) continue;
+        indices.insert(indices.end(), _indices.begin() + f*3, _indices.begin() + f*3 + 3);
+    }
+    return indices;
+}
+
+std::vector<std::pair<std::vector<UnsignedInt>, Float>> Simplifier::run(const std::vector<std::size_t>& targetFaceCounts) {
+    std::vector<std::pair<std::vector<UnsignedInt>, Float>> levels;
+    levels.reserve(targetFaceCounts.size());
+
+    Float maxError = 0.0f;
+    for(const std::size_t targetFaceCount: targetFaceCounts) {
+        while(_aliveFaceCount > targetFaceCount && !_queue.empty()) {
+            const Collapse candidate = _queue.top();
+            _queue.pop();
+
+            const UnsignedInt index = target(candidate.from, candidate.to);
+            if(index == ~UnsignedInt{} || flips(candidate.from, candidate.to))
+                continue;
+
+            /* The error increased since the candidate was added, postpone
+               it */
+            const Float currentError = error(candidate.from, candidate.to);
+            if(currentError > candidate.error) {
+                _queue.push({currentError, candidate.from, candidate.to});
+                continue;
+            }
+
+            collapse(candidate.from, candidate.to, index);
+            maxError = Math::max(maxError, currentError);
+        }
+
+        levels.emplace_back(aliveIndices(), std::sqrt(maxError));
+    }
+
+    return levels;
+}
+
+}
+
+std::pair<std::vector<UnsignedInt>, Float> simplify(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::size_t targetIndexCount) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::simplify(): index count is not divisible by 3!", {});
+    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
+    for(const UnsignedInt index: indices)
+        CORRADE_ASSERT(index < positions.size(), "MeshTools::simplify(): index" << index << "out of bounds for" << positions.size() << "vertices", {});
+    #endif
+
+    return std::move(Simplifier{indices, positions}.run({targetIndexCount/3}).front());
+}
+
+std::vector<std::pair<std::vector<UnsignedInt>, Float>> simplifyLodChain(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::vector<Float>& ratios) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::simplifyLodChain(): index count is not divisible by 3!", {});
+    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
+    for(const UnsignedInt index: indices)
+        CORRADE_ASSERT(index < positions.size(), "MeshTools::simplifyLodChain(): index" << index << "out of bounds for" << positions.size() << "vertices", {});
+    for(std::size_t i = 0; i != ratios.size(); ++i)
+        CORRADE_ASSERT(ratios[i] >= 0.0f && ratios[i] <= 1.0f && (i == 0 || ratios[i] <= ratios[i - 1]),
+            "MeshTools::simplifyLodChain(): expected non-increasing ratios in range [0, 1] but got" << ratios[i] << "at position" << i, {});
+    #endif
+
+    std::vector<std::size_t> targetFaceCounts;
+    targetFaceCounts.reserve(ratios.size());
+    for(const Float ratio: ratios)
+        targetFaceCounts.push_back(std::size_t(ratio*(indices.size()/3)));
+
+    return Simplifier{indices, positions}.run(targetFaceCounts);
+}
+
+}}
@@ -0,0 +1,100 @@
+#ifndef Magnum_MeshTools_Simplify_h
+#define Magnum_MeshTools_Simplify_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::simplify(), @ref Magnum::MeshTools::simplifyLodChain()
+ */
+
+#include <utility>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Simplify the mesh
+@param indices          Array of triangle face indices
+@param positions        Array of vertex positions
+@param targetIndexCount Target index count
+@return Simplified index array and its error
+
+Reduces triangle count using edge collapses ordered by quadric error metric
+until the index count is not larger than @p targetIndexCount or no more edges
+can be collapsed. Vertices are always collapsed into existing vertices, so
+the returned indices refer to the original @p positions (and any other vertex
+attributes) and no vertex data need to be modified. See
+@ref simplifyLodChain() for more information about the algorithm and
+the returned error.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::pair<std::vector<UnsignedInt>, Float> simplify(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, std::size_t targetIndexCount);
+
+/**
+@brief Generate LOD chain
+@param indices      Array of triangle face indices
+@param positions    Array of vertex positions
+@param ratios       Face count ratios of the levels
+@return Index array and error for each level
+
+Simplifies the mesh like @ref simplify() in a single pass, saving the index
+array each time the face count drops below the next ratio. The ratios are
+expected to be in range @f$ [0, 1] @f$ and non-increasing. All levels index
+the original vertex data, so they can share a single vertex buffer:
+@code
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions;
+
+std::vector<std::pair<std::vector<UnsignedInt>, Float>> lods =
+    MeshTools::simplifyLodChain(indices, positions, {1.0f, 0.5f, 0.25f, 0.125f});
+@endcode
+
+Each vertex is assigned a quadric which is a sum of squared distances to
+planes of its adjacent faces, weighted by face area. Collapsing an edge merges
+the quadrics and the cheapest collapse is always done first. The mesh is
+treated as connected based on vertex positions, vertices with the same
+position but different index (i.e. with different normals or texture
+coordinates on an attribute seam) are kept in place, as well as vertices on
+non-manifold edges. Vertices on borders are collapsed only along the border
+and additional quadrics preserve the border shape. Collapses that would flip
+a face are rejected.
+
+The returned error of each level is the largest error of all collapses done
+so far, calculated as square root of area-weighted mean squared distance to
+the original planes. It's thus an approximate geometric error in the same
+units as @p positions and the renderer can pick the level by projecting it
+to screen space. If given face count can't be reached, the level contains
+the most simplified mesh possible.
+
+@attention The function requires the mesh to have triangle faces, thus index
+    count must be divisible by 3.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<std::pair<std::vector<UnsignedInt>, Float>> simplifyLodChain(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::vector<Float>& ratios);
+
+}}
+
+#endif
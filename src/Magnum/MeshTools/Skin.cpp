@@ -0,0 +1,87 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Skin.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/DualQuaternion.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+void skin(const std::vector<DualQuaternion>& jointTransformations, const std::vector<Vector4ui>& jointIndices, const std::vector<Vector4>& jointWeights, std::vector<Vector3>& positions, std::vector<Vector3>* const normals) {
+    CORRADE_ASSERT(jointIndices.size() == positions.size() && jointWeights.size() == positions.size(),
+        "MeshTools::skinInPlace(): expected" << positions.size() << "joint indices and weights but got" << jointIndices.size() << "and" << jointWeights.size(), );
+    CORRADE_ASSERT(!normals || normals->size() == positions.size(),
+        "MeshTools::skinInPlace(): expected" << positions.size() << "normals but got" << normals->size(), );
+
+    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
+    for(const Vector4ui& indices: jointIndices)
+        for(std::size_t i = 0; i != 4; ++i)
+            CORRADE_ASSERT(indices[i] < jointTransformations.size(), "MeshTools::skinInPlace(): joint index" << indices[i] << "out of bounds for" << jointTransformations.size() << "joints", );
+    #endif
+
+    for(std::size_t i = 0; i != positions.size(); ++i) {
+        const Vector4ui& indices = jointIndices[i];
+        const Vector4& weights = jointWeights[i];
+
+        /* Blend the transformations, flip the ones in the other hemisphere
+           so all of them take the shortest path */
+        const DualQuaternion& first = jointTransformations[indices[0]];
+        Quaternion real = first.real()*weights[0];
+        Quaternion dual = first.dual()*weights[0];
+        for(std::size_t j = 1; j != 4; ++j) {
+            const DualQuaternion& joint = jointTransformations[indices[j]];
+            const Float weight = Math::dot(first.real(), joint.real()) < 0.0f ? -weights[j] : weights[j];
+            real += joint.real()*weight;
+            dual += joint.dual()*weight;
+        }
+
+        /* Normalize and remove the dual part component parallel to the real
+           part, which the blending introduces, so the result is a proper
+           unit dual quaternion */
+        const Float lengthInverted = 1.0f/real.length();
+        real *= lengthInverted;
+        dual *= lengthInverted;
+        const DualQuaternion blended{real, dual - real*Math::dot(real, dual)};
+
+        positions[i] = blended.transformPointNormalized(positions[i]);
+        if(normals) (*normals)[i] = blended.real().transformVectorNormalized((*normals)[i]);
+    }
+}
+
+}
+
+void skinInPlace(const std::vector<DualQuaternion>& jointTransformations, const std::vector<Vector4ui>& jointIndices, const std::vector<Vector4>& jointWeights, std::vector<Vector3>& positions) {
+    skin(jointTransformations, jointIndices, jointWeights, positions, nullptr);
+}
+
+void skinInPlace(const std::vector<DualQuaternion>& jointTransformations, const std::vector<Vector4ui>& jointIndices, const std::vector<Vector4>& jointWeights, std::vector<Vector3>& positions, std::vector<Vector3>& normals) {
+    skin(jointTransformations, jointIndices, jointWeights, positions, &normals);
+}
+
+}}
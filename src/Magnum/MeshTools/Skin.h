@@ -0,0 +1,73 @@
+#ifndef Magnum_MeshTools_Skin_h
+#define Magnum_MeshTools_Skin_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+/** @file
+ * @brief Function @ref Magnum::MeshTools::skinInPlace()
+ */
+
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Skin positions in-place using dual quaternion blending
+@param jointTransformations Normalized joint transformations, usually
+    product of the current joint pose and the inverse bind pose
+@param jointIndices     Four joint indices for each vertex
+@param jointWeights     Four joint weights for each vertex
+@param positions        Vertex positions to transform
+
+For each vertex the four joint transformations are blended together according
+to the weights, with the ones pointing in the opposite hemisphere than the
+first joint negated, the blended dual quaternion is normalized and then used
+to transform the position. Compared to linear blending of matrices this
+doesn't suffer from the "candy wrapper" collapse on twisted joints. Unused
+joint slots should have zero weight, but still a valid index. Weights don't
+need to sum up to one.
+
+The joint transformations are commonly interpolated from animation keyframes
+using @ref Math::sclerpShortestPathInto().
+@see @ref transformPointsInPlace(),
+    @ref DualQuaternion::transformPointNormalized()
+*/
+MAGNUM_MESHTOOLS_EXPORT void skinInPlace(const std::vector<DualQuaternion>& jointTransformations, const std::vector<Vector4ui>& jointIndices, const std::vector<Vector4>& jointWeights, std::vector<Vector3>& positions);
+
+/**
+@brief Skin positions and normals in-place using dual quaternion blending
+
+Same as @ref skinInPlace(const std::vector<DualQuaternion>&, const std::vector<Vector4ui>&, const std::vector<Vector4>&, std::vector<Vector3>&),
+but additionally rotates @p normals with the rotation part of the blended
+transformation. Expects that there is the same count of positions and
+normals.
+*/
+MAGNUM_MESHTOOLS_EXPORT void skinInPlace(const std::vector<DualQuaternion>& jointTransformations, const std::vector<Vector4ui>& jointIndices, const std::vector<Vector4>& jointWeights, std::vector<Vector3>& positions, std::vector<Vector3>& normals);
+
+}}
+
+#endif
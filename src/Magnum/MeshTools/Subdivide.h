@@ -26,12 +26,16 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::subdivide()
+ * @brief Function @ref Magnum::MeshTools::subdivide(), @ref Magnum::MeshTools::subdivideShared(), @ref Magnum::MeshTools::subdivideLoop()
  */
 
+#include <utility>
 #include <vector>
+#include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Debug.h>
 
+#include "Magnum/Magnum.h"
+
 namespace Magnum { namespace MeshTools {
 
 namespace Implementation {
@@ -58,6 +62,70 @@ template<class Vertex, class Interpolator> class Subdivide {
         }
 };
 
+/* Flat open-addressing map from an undirected edge to an index, with linear
+   probing. Sized for given maximal count of edges upfront, so it never needs
+   to grow. */
+class EdgeMap {
+    public:
+        explicit EdgeMap(std::size_t maxEdgeCount) {
+            std::size_t capacity = 2;
+            while(capacity < maxEdgeCount*2) capacity <<= 1;
+            _mask = capacity - 1;
+            _keys.resize(capacity, Empty);
+            _values.resize(capacity);
+        }
+
+        /* Returns value associated with given edge and `true` if it was just
+           inserted with @p value, `false` if it was present already */
+        std::pair<UnsignedInt, bool> insert(UnsignedInt a, UnsignedInt b, UnsignedInt value) {
+            if(a > b) std::swap(a, b);
+            const UnsignedLong key = UnsignedLong(a) << 32 | b;
+
+            /* Multiply-shift hash, using the upper bits */
+            for(std::size_t slot = std::size_t((key*0x9e3779b97f4a7c15ull) >> 32) & _mask; ; slot = (slot + 1) & _mask) {
+                if(_keys[slot] == Empty) {
+                    _keys[slot] = key;
+                    _values[slot] = value;
+                    return {value, true};
+                }
+                if(_keys[slot] == key) return {_values[slot], false};
+            }
+        }
+
+    private:
+        enum: UnsignedLong { Empty = ~UnsignedLong{} };
+
+        std::size_t _mask;
+        std::vector<UnsignedLong> _keys;
+        std::vector<UnsignedInt> _values;
+};
+
+/* Splits each face into four, edgeVertex(i) returns index of new vertex for
+   edge starting at index i */
+template<class EdgeVertex> void splitFaces(std::vector<UnsignedInt>& indices, EdgeVertex edgeVertex) {
+    const std::size_t indexCount = indices.size();
+    indices.reserve(indices.size()*4);
+
+    for(std::size_t i = 0; i != indexCount; i += 3) {
+        UnsignedInt newVertices[3];
+        for(std::size_t j = 0; j != 3; ++j)
+            newVertices[j] = edgeVertex(i + j);
+
+        /* Same layout as in Subdivide::operator()() */
+        indices.push_back(indices[i]);
+        indices.push_back(newVertices[0]);
+        indices.push_back(newVertices[2]);
+        indices.push_back(newVertices[0]);
+        indices.push_back(indices[i+1]);
+        indices.push_back(newVertices[1]);
+        indices.push_back(newVertices[2]);
+        indices.push_back(newVertices[1]);
+        indices.push_back(indices[i+2]);
+        for(std::size_t j = 0; j != 3; ++j)
+            indices[i+j] = newVertices[j];
+    }
+}
+
 }
 
 /**
@@ -71,11 +139,168 @@ template<class Vertex, class Interpolator> class Subdivide {
 
 Goes through all triangle faces and subdivides them into four new. Removing
 duplicate vertices in the mesh is up to user.
+@see @ref subdivideShared()
 */
 template<class Vertex, class Interpolator> inline void subdivide(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices, Interpolator interpolator) {
     Implementation::Subdivide<Vertex, Interpolator>(indices, vertices)(interpolator);
 }
 
+/**
+@brief Subdivide the mesh, sharing vertices on edges
+@tparam Vertex          Vertex data type
+@tparam Interpolator    See `interpolator` function parameter
+@param[in,out] indices  Index array to operate on
+@param[in,out] vertices Vertex array to operate on
+@param interpolator     Functor or function pointer which interpolates
+    two adjacent vertices: `Vertex interpolator(Vertex a, Vertex b)`
+
+Similar to @ref subdivide(), but each edge shared by more faces is split only
+once, so no duplicate vertices are created and the output stays watertight if
+the input was. Thus there's no need to call @ref removeDuplicates() afterwards,
+which is considerably faster for e.g. subdividing a sphere:
+@code
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions;
+
+MeshTools::subdivideShared(indices, positions, [](const Vector3& a, const Vector3& b) {
+    return (a+b).normalized();
+});
+@endcode
+
+The faces are in the same order as with @ref subdivide(), new vertices are
+appended in order in which the edges are first encountered. Edges are
+identified by their vertex indices, so vertices which have the same data but
+different index are not treated as shared.
+@see @ref subdivideLoop()
+*/
+template<class Vertex, class Interpolator> void subdivideShared(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices, Interpolator interpolator) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::subdivideShared(): index count is not divisible by 3!", );
+
+    /* There's at most one new vertex per index */
+    Implementation::EdgeMap edges{indices.size()};
+    Implementation::splitFaces(indices, [&](std::size_t i) {
+        const UnsignedInt a = indices[i];
+        const UnsignedInt b = indices[i%3 == 2 ? i - 2 : i + 1];
+        const std::pair<UnsignedInt, bool> vertex = edges.insert(a, b, vertices.size());
+        if(vertex.second) {
+            Vertex interpolated = interpolator(vertices[a], vertices[b]);
+            vertices.push_back(std::move(interpolated));
+        }
+        return vertex.first;
+    });
+}
+
+/**
+@brief Subdivide the mesh using Loop subdivision
+@tparam Vertex          Vertex data type
+@param[in,out] indices  Index array to operate on
+@param[in,out] vertices Vertex array to operate on
+
+Subdivides each face into four new like @ref subdivideShared(), but instead of
+plain interpolation smooths the mesh using Loop subdivision rules. Vertex on
+an edge shared by two faces is calculated from the edge vertices @f$ a @f$,
+@f$ b @f$ and vertices @f$ c @f$, @f$ d @f$ opposite to the edge as @f[
+    \frac{3}{8}(a + b) + \frac{1}{8}(c + d)
+@f]
+
+Original vertex @f$ v @f$ with @f$ n @f$ neighbors @f$ v_i @f$ is moved to
+@f[
+    (1 - n\beta)v + \beta \sum_{i = 1}^n v_i, \quad \beta = \begin{cases}
+        \frac{3}{16}, & n = 3 \\
+        \frac{3}{8n}, & n > 3
+    \end{cases}
+@f]
+
+Edges belonging to just one face are treated as boundary --- the new vertex is
+placed in the middle and boundary vertices are moved to
+@f$ \frac{3}{4}v + \frac{1}{8}(v_1 + v_2) @f$ where @f$ v_1 @f$ and
+@f$ v_2 @f$ are its neighbors on the boundary. Vertices on non-manifold edges
+or with less than three neighbors are kept in place.
+
+The `Vertex` type is expected to support addition and multiplication with
+`Vertex::Type`, which is the case for all @ref Math::Vector types. The
+vertices need to be already de-duplicated, e.g. using @ref removeDuplicates(),
+otherwise the mesh will be torn apart on seams.
+*/
+template<class Vertex> void subdivideLoop(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::subdivideLoop(): index count is not divisible by 3!", );
+
+    typedef typename Vertex::Type T;
+    struct Edge {
+        UnsignedInt a, b;
+        UnsignedInt opposite[2];
+        UnsignedInt faceCount;
+    };
+
+    /* Gather unique edges with their opposite vertices */
+    const std::size_t indexCount = indices.size();
+    const UnsignedInt vertexCount = vertices.size();
+    Implementation::EdgeMap edgeMap{indexCount};
+    std::vector<Edge> edges;
+    edges.reserve(indexCount);
+    std::vector<UnsignedInt> faceEdges(indexCount);
+    for(std::size_t i = 0; i != indexCount; i += 3) for(std::size_t j = 0; j != 3; ++j) {
+        const UnsignedInt a = indices[i + j];
+        const UnsignedInt b = indices[i + (j + 1)%3];
+        const UnsignedInt c = indices[i + (j + 2)%3];
+        const std::pair<UnsignedInt, bool> edge = edgeMap.insert(a, b, edges.size());
+        if(edge.second) edges.push_back({a, b, {c, 0}, 1});
+        else {
+            Edge& existing = edges[edge.first];
+            if(existing.faceCount == 1) existing.opposite[1] = c;
+            ++existing.faceCount;
+        }
+        faceEdges[i + j] = edge.first;
+    }
+
+    /* Neighbor sums for all original vertices */
+    std::vector<Vertex> neighborSums(vertexCount), boundarySums(vertexCount);
+    std::vector<UnsignedInt> neighborCounts(vertexCount), boundaryCounts(vertexCount);
+    std::vector<bool> nonManifold(vertexCount);
+    for(const Edge& edge: edges) {
+        neighborSums[edge.a] = neighborSums[edge.a] + vertices[edge.b];
+        neighborSums[edge.b] = neighborSums[edge.b] + vertices[edge.a];
+        ++neighborCounts[edge.a];
+        ++neighborCounts[edge.b];
+
+        if(edge.faceCount == 1) {
+            boundarySums[edge.a] = boundarySums[edge.a] + vertices[edge.b];
+            boundarySums[edge.b] = boundarySums[edge.b] + vertices[edge.a];
+            ++boundaryCounts[edge.a];
+            ++boundaryCounts[edge.b];
+        } else if(edge.faceCount > 2)
+            nonManifold[edge.a] = nonManifold[edge.b] = true;
+    }
+
+    /* Reposition original vertices */
+    std::vector<Vertex> out;
+    out.reserve(vertexCount + edges.size());
+    for(UnsignedInt i = 0; i != vertexCount; ++i) {
+        const UnsignedInt n = neighborCounts[i];
+        if(nonManifold[i] || (!boundaryCounts[i] && n < 3) || (boundaryCounts[i] && boundaryCounts[i] != 2))
+            out.push_back(vertices[i]);
+        else if(boundaryCounts[i])
+            out.push_back(vertices[i]*T(3)/T(4) + boundarySums[i]/T(8));
+        else {
+            const T beta = n == 3 ? T(3)/T(16) : T(3)/(T(8)*n);
+            out.push_back(vertices[i]*(T(1) - n*beta) + neighborSums[i]*beta);
+        }
+    }
+
+    /* Add new vertices on the edges */
+    for(const Edge& edge: edges) {
+        if(edge.faceCount == 2)
+            out.push_back((vertices[edge.a] + vertices[edge.b])*T(3)/T(8) + (vertices[edge.opposite[0]] + vertices[edge.opposite[1]])/T(8));
+        else
+            out.push_back((vertices[edge.a] + vertices[edge.b])/T(2));
+    }
+
+    Implementation::splitFaces(indices, [&](std::size_t i) {
+        return vertexCount + faceEdges[i];
+    });
+    vertices = std::move(out);
+}
+
 namespace Implementation {
 
 template<class Vertex, class Interpolator> void Subdivide<Vertex, Interpolator>::operator()(Interpolator interpolator) {
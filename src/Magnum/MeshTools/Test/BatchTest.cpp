@@ -0,0 +1,178 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Batch.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct BatchTest: TestSuite::Tester {
+    explicit BatchTest();
+
+    void wrongTransformationCount();
+    void wrongPrimitive();
+    void differentAttributes();
+
+    void batch();
+    void batchTransformed();
+};
+
+BatchTest::BatchTest() {
+    addTests({&BatchTest::wrongTransformationCount,
+              &BatchTest::wrongPrimitive,
+              &BatchTest::differentAttributes,
+
+              &BatchTest::batch,
+              &BatchTest::batchTransformed});
+}
+
+void BatchTest::wrongTransformationCount() {
+    const Trade::MeshData3D a{MeshPrimitive::Triangles, {}, {{{}, {}, {}}}, {}, {}};
+
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    MeshTools::batch({a, a}, {Matrix4{}});
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::batch(): expected 2 transformations but got 1\n");
+}
+
+void BatchTest::wrongPrimitive() {
+    const Trade::MeshData3D a{MeshPrimitive::TriangleFan, {}, {{{}, {}, {}}}, {}, {}};
+
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    MeshTools::batch({a});
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::batch(): can't batch MeshPrimitive::TriangleFan\n");
+}
+
+void BatchTest::differentAttributes() {
+    const Trade::MeshData3D a{MeshPrimitive::Triangles, {}, {{{}, {}, {}}}, {}, {}};
+    const Trade::MeshData3D b{MeshPrimitive::Triangles, {}, {{{}, {}, {}}}, {{{}, {}, {}}}, {}};
+
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    MeshTools::batch({a, a, b});
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::batch(): mesh 2 has different primitive or attributes than the first one\n");
+}
+
+void BatchTest::batch() {
+    const Trade::MeshData3D a{MeshPrimitive::Triangles, {0, 1, 2, 0, 2, 3}, {{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}
+    }}, {std::vector<Vector3>(4, Vector3::zAxis())}, {{
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {1.0f, 1.0f},
+        {0.0f, 1.0f}
+    }}};
+
+    /* Non-indexed */
+    const Trade::MeshData3D b{MeshPrimitive::Triangles, {}, {{
+        {0.0f, 0.0f, 1.0f},
+        {1.0f, 0.0f, 1.0f},
+        {1.0f, 1.0f, 1.0f}
+    }}, {std::vector<Vector3>(3, Vector3::zAxis())}, {{
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {1.0f, 1.0f}
+    }}};
+
+    std::pair<Trade::MeshData3D, std::vector<BatchRange>> batched = MeshTools::batch({a, b, a});
+    const Trade::MeshData3D& mesh = batched.first;
+    const std::vector<BatchRange>& ranges = batched.second;
+
+    CORRADE_COMPARE(mesh.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(mesh.indices(), (std::vector<UnsignedInt>{
+        0, 1, 2, 0, 2, 3,
+        4, 5, 6,
+        7, 8, 9, 7, 9, 10}));
+    CORRADE_COMPARE(mesh.positions(0).size(), 11);
+    CORRADE_COMPARE(mesh.positions(0)[5], (Vector3{1.0f, 0.0f, 1.0f}));
+    CORRADE_COMPARE(mesh.positions(0)[9], (Vector3{1.0f, 1.0f, 0.0f}));
+    CORRADE_VERIFY(mesh.hasNormals());
+    CORRADE_COMPARE(mesh.normals(0), std::vector<Vector3>(11, Vector3::zAxis()));
+    CORRADE_VERIFY(mesh.hasTextureCoords2D());
+    CORRADE_COMPARE(mesh.textureCoords2D(0)[6], (Vector2{1.0f, 1.0f}));
+
+    CORRADE_COMPARE(ranges.size(), 3);
+    CORRADE_COMPARE(ranges[0].indexOffset, 0);
+    CORRADE_COMPARE(ranges[0].indexCount, 6);
+    CORRADE_COMPARE(ranges[0].indexStart, 0);
+    CORRADE_COMPARE(ranges[0].indexEnd, 3);
+    CORRADE_COMPARE(ranges[0].vertexOffset, 0);
+    CORRADE_COMPARE(ranges[0].vertexCount, 4);
+    CORRADE_COMPARE(ranges[1].indexOffset, 6);
+    CORRADE_COMPARE(ranges[1].indexCount, 3);
+    CORRADE_COMPARE(ranges[1].indexStart, 4);
+    CORRADE_COMPARE(ranges[1].indexEnd, 6);
+    CORRADE_COMPARE(ranges[1].vertexOffset, 4);
+    CORRADE_COMPARE(ranges[1].vertexCount, 3);
+    CORRADE_COMPARE(ranges[2].indexOffset, 9);
+    CORRADE_COMPARE(ranges[2].indexCount, 6);
+    CORRADE_COMPARE(ranges[2].indexStart, 7);
+    CORRADE_COMPARE(ranges[2].indexEnd, 10);
+    CORRADE_COMPARE(ranges[2].vertexOffset, 7);
+    CORRADE_COMPARE(ranges[2].vertexCount, 4);
+}
+
+void BatchTest::batchTransformed() {
+    const Trade::MeshData3D a{MeshPrimitive::Points, {}, {{
+        {1.0f, 1.0f, 0.0f}
+    }}, {{
+        Vector3{1.0f, 1.0f, 0.0f}.normalized()
+    }}, {}};
+
+    std::pair<Trade::MeshData3D, std::vector<BatchRange>> batched = MeshTools::batch({a, a}, {
+        Matrix4{},
+        Matrix4::translation({0.0f, 0.0f, 3.0f})*Matrix4::scaling({2.0f, 1.0f, 1.0f})
+    });
+    const Trade::MeshData3D& mesh = batched.first;
+
+    CORRADE_COMPARE(mesh.primitive(), MeshPrimitive::Points);
+    CORRADE_COMPARE(mesh.indices(), (std::vector<UnsignedInt>{0, 1}));
+    CORRADE_COMPARE(mesh.positions(0), (std::vector<Vector3>{
+        {1.0f, 1.0f, 0.0f},
+        {2.0f, 1.0f, 3.0f}
+    }));
+
+    /* Normals are transformed with inverse transpose, not just scaled */
+    CORRADE_COMPARE(mesh.normals(0), (std::vector<Vector3>{
+        Vector3{1.0f, 1.0f, 0.0f}.normalized(),
+        Vector3{0.5f, 1.0f, 0.0f}.normalized()
+    }));
+    CORRADE_VERIFY(!mesh.hasTextureCoords2D());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::BatchTest)
@@ -0,0 +1,144 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/MeshTools/Bvh.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Test/BenchmarkTimer.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct BvhBenchmark: TestSuite::Tester {
+    explicit BvhBenchmark();
+
+    void build();
+    void buildMultithreaded();
+    void closestHit();
+    void anyHit();
+};
+
+namespace {
+
+/* 655362 vertices, 1310720 faces */
+constexpr UnsignedInt Subdivisions = 8;
+constexpr std::size_t Iterations = 3;
+
+/* Rays from a grid in front of the sphere */
+constexpr std::size_t RaysPerSide = 256;
+
+void rays(std::vector<Vector3>& origins, std::vector<Vector3>& directions) {
+    for(std::size_t y = 0; y != RaysPerSide; ++y) for(std::size_t x = 0; x != RaysPerSide; ++x) {
+        origins.emplace_back(Float(x)/RaysPerSide*3.0f - 1.5f, Float(y)/RaysPerSide*3.0f - 1.5f, 3.0f);
+        directions.push_back(-Vector3::zAxis());
+    }
+}
+
+}
+
+BvhBenchmark::BvhBenchmark() {
+    addTests({&BvhBenchmark::build,
+              &BvhBenchmark::buildMultithreaded,
+              &BvhBenchmark::closestHit,
+              &BvhBenchmark::anyHit});
+}
+
+void BvhBenchmark::build() {
+    const Trade::MeshData3D mesh = Primitives::Icosphere::solid(Subdivisions);
+
+    std::size_t nodeCount = 0;
+    Magnum::Test::BenchmarkTimer timer{Iterations};
+    timer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        nodeCount = Bvh{mesh}.nodeCount();
+    timer.stop();
+    const Double time = timer.milliseconds();
+
+    CORRADE_VERIFY(nodeCount);
+    Debug() << "   " << mesh.indices().size()/3 << "faces," << nodeCount << "nodes, build:" << time << "ms";
+}
+
+void BvhBenchmark::buildMultithreaded() {
+    const Trade::MeshData3D mesh = Primitives::Icosphere::solid(Subdivisions);
+
+    std::size_t nodeCount = 0;
+    Magnum::Test::BenchmarkTimer timer{Iterations};
+    timer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        nodeCount = Bvh{mesh, 0}.nodeCount();
+    timer.stop();
+    const Double time = timer.milliseconds();
+
+    CORRADE_VERIFY(nodeCount);
+    Debug() << "   " << mesh.indices().size()/3 << "faces, build with all threads:" << time << "ms";
+}
+
+void BvhBenchmark::closestHit() {
+    const Trade::MeshData3D mesh = Primitives::Icosphere::solid(Subdivisions);
+    const Bvh bvh{mesh};
+    std::vector<Vector3> origins, directions;
+    rays(origins, directions);
+    std::vector<BvhHit> hits(origins.size());
+
+    Magnum::Test::BenchmarkTimer timer{Iterations};
+    timer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        bvh.closestHitInto({origins.data(), origins.size()}, {directions.data(), directions.size()}, {hits.data(), hits.size()});
+    timer.stop();
+    const Double time = timer.milliseconds();
+
+    /* Roughly pi/(3*3) of the rays hit the unit sphere */
+    std::size_t hitCount = 0;
+    for(const BvhHit& hit: hits) if(hit) ++hitCount;
+    CORRADE_VERIFY(hitCount > origins.size()/4);
+    CORRADE_VERIFY(hitCount < origins.size()/2);
+    Debug() << "   " << origins.size() << "rays," << hitCount << "hits, closestHit():" << time << "ms," << origins.size()/(time*1000.0) << "M rays/s";
+}
+
+void BvhBenchmark::anyHit() {
+    const Trade::MeshData3D mesh = Primitives::Icosphere::solid(Subdivisions);
+    const Bvh bvh{mesh};
+    std::vector<Vector3> origins, directions;
+    rays(origins, directions);
+
+    std::size_t hitCount = 0;
+    Magnum::Test::BenchmarkTimer timer{Iterations};
+    timer.start();
+    for(std::size_t i = 0; i != Iterations; ++i) {
+        hitCount = 0;
+        for(std::size_t j = 0; j != origins.size(); ++j)
+            if(bvh.anyHit(origins[j], directions[j])) ++hitCount;
+    }
+    timer.stop();
+    const Double time = timer.milliseconds();
+
+    CORRADE_VERIFY(hitCount > origins.size()/4);
+    Debug() << "   " << origins.size() << "rays," << hitCount << "hits, anyHit():" << time << "ms," << origins.size()/(time*1000.0) << "M rays/s";
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::BvhBenchmark)
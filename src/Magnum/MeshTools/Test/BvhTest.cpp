@@ -0,0 +1,298 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <random>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Geometry/Intersection.h"
+#include "Magnum/MeshTools/Bvh.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct BvhTest: TestSuite::Tester {
+    explicit BvhTest();
+
+    void wrongIndexCount();
+    void wrongPrimitive();
+    void wrongArraySizes();
+    void empty();
+    void triangle();
+    void closestHit();
+    void anyHit();
+    void closestHitInto();
+    void meshData();
+    void threadCount();
+};
+
+BvhTest::BvhTest() {
+    addTests({&BvhTest::wrongIndexCount,
+              &BvhTest::wrongPrimitive,
+              &BvhTest::wrongArraySizes,
+              &BvhTest::empty,
+              &BvhTest::triangle,
+              &BvhTest::closestHit,
+              &BvhTest::anyHit,
+              &BvhTest::closestHitInto,
+              &BvhTest::meshData,
+              &BvhTest::threadCount});
+}
+
+namespace {
+
+/* Grid of size x size quads in XY plane at given depth */
+void grid(const UnsignedInt size, const Float z, std::vector<UnsignedInt>& indices, std::vector<Vector3>& positions) {
+    const UnsignedInt offset = positions.size();
+    for(UnsignedInt y = 0; y <= size; ++y) for(UnsignedInt x = 0; x <= size; ++x)
+        positions.emplace_back(Float(x)/size*2.0f - 1.0f, Float(y)/size*2.0f - 1.0f, z);
+
+    for(UnsignedInt y = 0; y != size; ++y) for(UnsignedInt x = 0; x != size; ++x) {
+        const UnsignedInt a = offset + y*(size + 1) + x;
+        indices.insert(indices.end(), {a, a + 1, a + size + 2, a, a + size + 2, a + size + 1});
+    }
+}
+
+/* Two parallel grids, a few thousand of small randomly placed triangles and
+   a handful of triangles with the same centroid */
+void scene(std::vector<UnsignedInt>& indices, std::vector<Vector3>& positions) {
+    grid(16, 0.5f, indices, positions);
+    grid(8, -0.5f, indices, positions);
+
+    std::mt19937 generator;
+    std::uniform_real_distribution<Float> distribution{-1.0f, 1.0f};
+    for(std::size_t i = 0; i != 2000; ++i) {
+        const Vector3 center{distribution(generator), distribution(generator), distribution(generator)};
+        for(std::size_t j = 0; j != 3; ++j) {
+            indices.push_back(positions.size());
+            positions.push_back(center + 0.1f*Vector3{distribution(generator), distribution(generator), distribution(generator)});
+        }
+    }
+
+    for(std::size_t i = 0; i != 32; ++i)
+        indices.insert(indices.end(), {0, 1, 17});
+}
+
+/* Reference implementation testing all triangles */
+BvhHit bruteForce(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const Vector3& origin, const Vector3& direction, const Float maxDistance) {
+    BvhHit hit{~UnsignedInt{}, Constants::inf(), {}};
+    Float closest = maxDistance;
+    for(std::size_t i = 0; i != indices.size()/3; ++i) {
+        const Vector3 tuv = Math::Geometry::Intersection::triangleLine(positions[indices[i*3]], positions[indices[i*3 + 1]], positions[indices[i*3 + 2]], origin, direction);
+        if(tuv.y() >= 0.0f && tuv.z() >= 0.0f && tuv.y() + tuv.z() <= 1.0f && tuv.x() >= 0.0f && tuv.x() < closest) {
+            closest = tuv.x();
+            hit = {UnsignedInt(i), tuv.x(), {tuv.y(), tuv.z()}};
+        }
+    }
+    return hit;
+}
+
+std::vector<std::pair<Vector3, Vector3>> rays() {
+    std::mt19937 generator{5};
+    std::uniform_real_distribution<Float> distribution{-1.0f, 1.0f};
+    std::vector<std::pair<Vector3, Vector3>> out;
+    for(std::size_t i = 0; i != 2000; ++i) {
+        const Vector3 origin = 2.0f*Vector3{distribution(generator), distribution(generator), distribution(generator)};
+        Vector3 direction{distribution(generator), distribution(generator), distribution(generator)};
+
+        /* Some rays going exactly along the axes */
+        if(i % 5 == 0) direction = direction.z() < 0.0f ? -Vector3::zAxis() : Vector3::zAxis();
+        out.emplace_back(origin, direction);
+    }
+    return out;
+}
+
+}
+
+void BvhTest::wrongIndexCount() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    const Bvh bvh{std::vector<UnsignedInt>{0, 1}, {{}, {}}};
+    const Bvh bvh2{std::vector<UnsignedInt>{0, 1, 3}, {{}, {}, {}}};
+
+    CORRADE_COMPARE(bvh.triangleCount(), 0);
+    CORRADE_COMPARE(bvh2.triangleCount(), 0);
+    CORRADE_COMPARE(ss.str(),
+        "MeshTools::Bvh::Bvh(): index count is not divisible by 3!\n"
+        "MeshTools::Bvh::Bvh(): index 3 out of bounds for 3 vertices\n");
+}
+
+void BvhTest::wrongPrimitive() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    const Bvh bvh{Trade::MeshData3D{MeshPrimitive::Lines, {0, 1}, {std::vector<Vector3>(2)}, {}, {}}};
+
+    CORRADE_COMPARE(bvh.triangleCount(), 0);
+    CORRADE_COMPARE(ss.str(), "MeshTools::Bvh::Bvh(): expected indexed triangle mesh\n");
+}
+
+void BvhTest::wrongArraySizes() {
+    const Bvh bvh{std::vector<UnsignedInt>{0, 1, 2}, {{}, Vector3::xAxis(), Vector3::yAxis()}};
+    const Vector3 origins[2];
+    const Vector3 directions[3];
+    BvhHit hits[2];
+
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    bvh.closestHitInto(origins, directions, hits);
+    CORRADE_COMPARE(ss.str(), "MeshTools::Bvh::closestHitInto(): array sizes don't match, got 2 3 and 2\n");
+}
+
+void BvhTest::empty() {
+    const Bvh bvh{std::vector<UnsignedInt>{}, {}};
+
+    CORRADE_COMPARE(bvh.triangleCount(), 0);
+    CORRADE_COMPARE(bvh.nodeCount(), 0);
+    CORRADE_COMPARE(bvh.bounds(), Range3D{});
+    CORRADE_VERIFY(!bvh.closestHit({}, Vector3::zAxis()));
+    CORRADE_VERIFY(!bvh.anyHit({}, Vector3::zAxis()));
+}
+
+void BvhTest::triangle() {
+    const Bvh bvh{std::vector<UnsignedInt>{0, 1, 2}, {{}, Vector3::xAxis(), Vector3::yAxis()}};
+    CORRADE_COMPARE(bvh.triangleCount(), 1);
+    CORRADE_COMPARE(bvh.nodeCount(), 1);
+    CORRADE_COMPARE(bvh.bounds(), (Range3D{{}, {1.0f, 1.0f, 0.0f}}));
+
+    const BvhHit hit = bvh.closestHit({0.25f, 0.5f, 1.0f}, {0.0f, 0.0f, -2.0f});
+    CORRADE_VERIFY(hit);
+    CORRADE_COMPARE(hit.triangle, 0);
+    CORRADE_COMPARE(hit.distance, 0.5f);
+    CORRADE_COMPARE(hit.barycentric, (Vector2{0.25f, 0.5f}));
+
+    /* Back face is hit too */
+    CORRADE_COMPARE(bvh.closestHit({0.25f, 0.5f, -1.0f}, Vector3::zAxis()).distance, 1.0f);
+
+    /* Line segment not reaching the triangle */
+    CORRADE_VERIFY(!bvh.closestHit({0.25f, 0.5f, 1.0f}, {0.0f, 0.0f, -0.5f}, 1.0f));
+    CORRADE_VERIFY(!bvh.anyHit({0.25f, 0.5f, 1.0f}, {0.0f, 0.0f, -0.5f}, 1.0f));
+
+    /* Pointing away, outside */
+    const BvhHit miss = bvh.closestHit({0.25f, 0.5f, 1.0f}, Vector3::zAxis());
+    CORRADE_VERIFY(!miss);
+    CORRADE_COMPARE(miss.triangle, 0xffffffffu);
+    CORRADE_COMPARE(miss.distance, Constants::inf());
+    CORRADE_VERIFY(!bvh.closestHit({1.0f, 1.0f, 1.0f}, -Vector3::zAxis()));
+}
+
+void BvhTest::closestHit() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    scene(indices, positions);
+    const Bvh bvh{indices, positions};
+    CORRADE_COMPARE(bvh.triangleCount(), indices.size()/3);
+
+    std::size_t hitCount = 0;
+    for(const auto& ray: rays()) for(const Float maxDistance: {Constants::inf(), 0.75f}) {
+        const BvhHit expected = bruteForce(indices, positions, ray.first, ray.second, maxDistance);
+        const BvhHit hit = bvh.closestHit(ray.first, ray.second, maxDistance);
+        CORRADE_COMPARE(bool(hit), bool(expected));
+        if(!hit) continue;
+
+        /* Triangles sharing an edge may be both hit at the same distance, so
+           the reported triangle may differ */
+        CORRADE_COMPARE(hit.distance, expected.distance);
+        CORRADE_VERIFY(hit.distance < maxDistance);
+        ++hitCount;
+    }
+
+    /* Make sure the test isn't testing only misses */
+    CORRADE_VERIFY(hitCount > 250);
+}
+
+void BvhTest::anyHit() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    scene(indices, positions);
+    const Bvh bvh{indices, positions};
+
+    for(const auto& ray: rays()) for(const Float maxDistance: {Constants::inf(), 0.75f})
+        CORRADE_COMPARE(bvh.anyHit(ray.first, ray.second, maxDistance), bool(bvh.closestHit(ray.first, ray.second, maxDistance)));
+}
+
+void BvhTest::closestHitInto() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    scene(indices, positions);
+    const Bvh bvh{indices, positions};
+
+    std::vector<Vector3> origins, directions;
+    for(const auto& ray: rays()) {
+        origins.push_back(ray.first);
+        directions.push_back(ray.second);
+    }
+    std::vector<BvhHit> hits(origins.size());
+    bvh.closestHitInto({origins.data(), origins.size()}, {directions.data(), directions.size()}, {hits.data(), hits.size()}, 3.0f, 4);
+
+    for(std::size_t i = 0; i != hits.size(); ++i) {
+        const BvhHit expected = bvh.closestHit(origins[i], directions[i], 3.0f);
+        CORRADE_COMPARE(hits[i].triangle, expected.triangle);
+        CORRADE_COMPARE(hits[i].distance, expected.distance);
+    }
+}
+
+void BvhTest::meshData() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    grid(4, 0.0f, indices, positions);
+    const Bvh bvh{Trade::MeshData3D{MeshPrimitive::Triangles, indices, {positions}, {}, {}}};
+
+    CORRADE_COMPARE(bvh.triangleCount(), 32);
+    CORRADE_COMPARE(bvh.bounds(), (Range3D{{-1.0f, -1.0f, 0.0f}, {1.0f, 1.0f, 0.0f}}));
+
+    /* Interpolating the positions gives back the hit point */
+    const BvhHit hit = bvh.closestHit({0.3f, -0.6f, 1.0f}, -Vector3::zAxis());
+    CORRADE_VERIFY(hit);
+    const Vector3 a = positions[indices[hit.triangle*3]];
+    const Vector3 b = positions[indices[hit.triangle*3 + 1]];
+    const Vector3 c = positions[indices[hit.triangle*3 + 2]];
+    CORRADE_COMPARE((1.0f - hit.barycentric.x() - hit.barycentric.y())*a + hit.barycentric.x()*b + hit.barycentric.y()*c, (Vector3{0.3f, -0.6f, 0.0f}));
+}
+
+void BvhTest::threadCount() {
+    /* Large enough to be split into parallel tasks */
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    grid(128, 0.0f, indices, positions);
+    scene(indices, positions);
+
+    const Bvh single{indices, positions, 1};
+    const Bvh multi{indices, positions, 4};
+
+    /* The tree is the same regardless of thread count */
+    CORRADE_COMPARE(multi.nodeCount(), single.nodeCount());
+    CORRADE_COMPARE(multi.bounds(), single.bounds());
+    for(const auto& ray: rays()) {
+        const BvhHit a = single.closestHit(ray.first, ray.second);
+        const BvhHit b = multi.closestHit(ray.first, ray.second);
+        CORRADE_COMPARE(a.triangle, b.triangle);
+        CORRADE_COMPARE(a.distance, b.distance);
+    }
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::BvhTest)
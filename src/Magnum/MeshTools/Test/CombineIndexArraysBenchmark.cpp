@@ -0,0 +1,173 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <unordered_map>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/MurmurHash2.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/CombineIndexedArrays.h"
+#include "Magnum/Test/BenchmarkTimer.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct CombineIndexArraysBenchmark: TestSuite::Tester {
+    explicit CombineIndexArraysBenchmark();
+
+    void unorderedMap();
+    void flat();
+    #ifdef MAGNUM_BUILD_MULTITHREADED
+    void flatParallel();
+    #endif
+};
+
+namespace {
+
+constexpr std::size_t CombinationCount = 4000000;
+constexpr UnsignedInt Stride = 3;
+constexpr std::size_t Iterations = 5;
+
+/* Position, normal and texture coordinate indices of a mesh with roughly
+   six occurences of each vertex */
+std::vector<UnsignedInt> indices() {
+    std::vector<UnsignedInt> out(CombinationCount*Stride);
+    for(std::size_t i = 0; i != CombinationCount; ++i) {
+        const UnsignedInt vertex = UnsignedInt((i*2654435761ull) % (CombinationCount/6));
+        out[i*Stride + 0] = vertex;
+        out[i*Stride + 1] = vertex/4;
+        out[i*Stride + 2] = vertex % 4096;
+    }
+    return out;
+}
+
+/* The original implementation using std::unordered_map, for comparison */
+class IndexHash {
+    public:
+        explicit IndexHash(const std::vector<UnsignedInt>& indices, UnsignedInt stride): indices(indices), stride(stride) {}
+
+        std::size_t operator()(UnsignedInt key) const {
+            return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2()(reinterpret_cast<const char*>(indices.data()+key*stride), sizeof(UnsignedInt)*stride).byteArray());
+        }
+
+    private:
+        const std::vector<UnsignedInt>& indices;
+        UnsignedInt stride;
+};
+
+class IndexEqual {
+    public:
+        explicit IndexEqual(const std::vector<UnsignedInt>& indices, UnsignedInt stride): indices(indices), stride(stride) {}
+
+        bool operator()(UnsignedInt a, UnsignedInt b) const {
+            return std::memcmp(indices.data()+a*stride, indices.data()+b*stride, sizeof(UnsignedInt)*stride) == 0;
+        }
+
+    private:
+        const std::vector<UnsignedInt>& indices;
+        UnsignedInt stride;
+};
+
+std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> combineIndexArraysUnorderedMap(const std::vector<UnsignedInt>& interleavedArrays, const UnsignedInt stride) {
+    std::unordered_map<UnsignedInt, UnsignedInt, IndexHash, IndexEqual> indexCombinations(
+        interleavedArrays.size()/stride,
+        IndexHash(interleavedArrays, stride),
+        IndexEqual(interleavedArrays, stride));
+
+    std::vector<UnsignedInt> combinedIndices;
+    std::vector<UnsignedInt> newInterleavedArrays;
+    combinedIndices.reserve(interleavedArrays.size()/stride);
+    for(std::size_t oldIndex = 0, end = interleavedArrays.size()/stride; oldIndex != end; ++oldIndex) {
+        const auto result = indexCombinations.emplace(oldIndex, indexCombinations.size());
+        combinedIndices.push_back(result.first->second);
+        if(result.second) newInterleavedArrays.insert(newInterleavedArrays.end(),
+            interleavedArrays.begin()+oldIndex*stride,
+            interleavedArrays.begin()+(oldIndex+1)*stride);
+    }
+
+    return {std::move(combinedIndices), std::move(newInterleavedArrays)};
+}
+
+}
+
+CombineIndexArraysBenchmark::CombineIndexArraysBenchmark() {
+    addTests({&CombineIndexArraysBenchmark::unorderedMap,
+              &CombineIndexArraysBenchmark::flat,
+              #ifdef MAGNUM_BUILD_MULTITHREADED
+              &CombineIndexArraysBenchmark::flatParallel
+              #endif
+              });
+}
+
+void CombineIndexArraysBenchmark::unorderedMap() {
+    const std::vector<UnsignedInt> data = indices();
+
+    std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> result;
+    Magnum::Test::BenchmarkTimer timer{Iterations};
+    timer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        result = combineIndexArraysUnorderedMap(data, Stride);
+    timer.stop();
+    const Double time = timer.milliseconds();
+
+    CORRADE_COMPARE(result.second.size(), Stride*(CombinationCount/6));
+    Debug() << "   " << CombinationCount << "combinations, std::unordered_map:" << time << "ms";
+}
+
+void CombineIndexArraysBenchmark::flat() {
+    const std::vector<UnsignedInt> data = indices();
+
+    std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> result;
+    Magnum::Test::BenchmarkTimer timer{Iterations};
+    timer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        result = MeshTools::combineIndexArrays(data, Stride);
+    timer.stop();
+    const Double time = timer.milliseconds();
+
+    CORRADE_VERIFY(result == combineIndexArraysUnorderedMap(data, Stride));
+    Debug() << "   " << CombinationCount << "combinations, flat hash table:" << time << "ms";
+}
+
+#ifdef MAGNUM_BUILD_MULTITHREADED
+void CombineIndexArraysBenchmark::flatParallel() {
+    const std::vector<UnsignedInt> data = indices();
+
+    std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> result;
+    Magnum::Test::BenchmarkTimer timer{Iterations};
+    timer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        result = MeshTools::combineIndexArrays(data, Stride, 0);
+    timer.stop();
+    const Double time = timer.milliseconds();
+
+    CORRADE_VERIFY(result == MeshTools::combineIndexArrays(data, Stride));
+    Debug() << "   " << CombinationCount << "combinations, flat hash table, all threads:" << time << "ms";
+}
+#endif
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CombineIndexArraysBenchmark)
@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
 #include <functional>
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
@@ -36,13 +37,19 @@ struct CombineIndexedArraysTest: TestSuite::Tester {
     explicit CombineIndexedArraysTest();
 
     void wrongIndexCount();
+    void wrongStride();
     void indexArrays();
+    void interleavedArrays();
+    void interleavedArraysLarge();
     void indexedArrays();
 };
 
 CombineIndexedArraysTest::CombineIndexedArraysTest() {
     addTests({&CombineIndexedArraysTest::wrongIndexCount,
+              &CombineIndexedArraysTest::wrongStride,
               &CombineIndexedArraysTest::indexArrays,
+              &CombineIndexedArraysTest::interleavedArrays,
+              &CombineIndexedArraysTest::interleavedArraysLarge,
               &CombineIndexedArraysTest::indexedArrays});
 }
 
@@ -56,6 +63,17 @@ void CombineIndexedArraysTest::wrongIndexCount() {
     CORRADE_COMPARE(ss.str(), "MeshTools::combineIndexArrays(): the arrays don't have the same size\n");
 }
 
+void CombineIndexedArraysTest::wrongStride() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    MeshTools::combineIndexArrays(std::vector<UnsignedInt>{0, 1, 0}, 0);
+    MeshTools::combineIndexArrays(std::vector<UnsignedInt>{0, 1, 0}, 2);
+
+    CORRADE_COMPARE(ss.str(),
+        "MeshTools::combineIndexArrays(): stride can't be zero\n"
+        "MeshTools::combineIndexArrays(): array size is not divisible by stride\n");
+}
+
 void CombineIndexedArraysTest::indexArrays() {
     std::vector<UnsignedInt> a{0, 1, 0};
     std::vector<UnsignedInt> b{3, 4, 3};
@@ -68,6 +86,52 @@ void CombineIndexedArraysTest::indexArrays() {
     CORRADE_COMPARE(c, (std::vector<UnsignedInt>{6, 7}));
 }
 
+void CombineIndexedArraysTest::interleavedArrays() {
+    std::vector<UnsignedInt> result;
+    std::vector<UnsignedInt> interleaved;
+    std::tie(result, interleaved) = MeshTools::combineIndexArrays(
+        std::vector<UnsignedInt>{0, 1, 2, 3, 5, 4, 0, 1, 0, 4, 1, 6, 3, 1, 2, 3, 2, 1}, 2);
+
+    CORRADE_COMPARE(result, (std::vector<UnsignedInt>{0, 1, 2, 0, 3, 4, 5, 1, 6}));
+    CORRADE_COMPARE(interleaved, (std::vector<UnsignedInt>{0, 1, 2, 3, 5, 4, 0, 4, 1, 6, 3, 1, 2, 1}));
+}
+
+void CombineIndexedArraysTest::interleavedArraysLarge() {
+    /* Large enough to go through the parallel path, if enabled. Many
+       duplicate combinations scattered through the whole array. */
+    std::vector<UnsignedInt> indices(3*200000);
+    for(UnsignedInt i = 0; i != indices.size()/3; ++i) {
+        indices[i*3 + 0] = (i*7919) % 1000;
+        indices[i*3 + 1] = (i*104729) % 300;
+        indices[i*3 + 2] = i % 5;
+    }
+
+    std::vector<UnsignedInt> result;
+    std::vector<UnsignedInt> interleaved;
+    std::tie(result, interleaved) = MeshTools::combineIndexArrays(indices, 3);
+
+    /* All combinations should be preserved */
+    CORRADE_COMPARE(result.size(), indices.size()/3);
+    for(std::size_t i = 0; i != result.size(); ++i) {
+        CORRADE_VERIFY(std::equal(interleaved.begin() + result[i]*3, interleaved.begin() + result[i]*3 + 3, indices.begin() + i*3));
+    }
+
+    /* And the combined ones should be unique, in order of first occurence */
+    UnsignedInt max = 0;
+    for(UnsignedInt i: result) {
+        CORRADE_VERIFY(i <= max);
+        if(i == max) ++max;
+    }
+    CORRADE_COMPARE(max, interleaved.size()/3);
+
+    /* Thread count should have no effect on the output */
+    std::vector<UnsignedInt> resultParallel;
+    std::vector<UnsignedInt> interleavedParallel;
+    std::tie(resultParallel, interleavedParallel) = MeshTools::combineIndexArrays(indices, 3, 4);
+    CORRADE_VERIFY(resultParallel == result);
+    CORRADE_VERIFY(interleavedParallel == interleaved);
+}
+
 void CombineIndexedArraysTest::indexedArrays() {
     std::vector<UnsignedInt> a{0, 1, 0};
     std::vector<UnsignedInt> b{3, 4, 3};
@@ -0,0 +1,183 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Compile.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct CompileTest: TestSuite::Tester {
+    explicit CompileTest();
+
+    void packVertices();
+    void packVerticesNotPresent();
+    void packVerticesNormalizedShort();
+    void packVerticesHalfNormalizedByte();
+    #ifndef MAGNUM_TARGET_GLES2
+    void packVerticesInt2101010Rev();
+    #endif
+};
+
+CompileTest::CompileTest() {
+    addTests({&CompileTest::packVertices,
+              &CompileTest::packVerticesNotPresent,
+              &CompileTest::packVerticesNormalizedShort,
+              &CompileTest::packVerticesHalfNormalizedByte,
+              #ifndef MAGNUM_TARGET_GLES2
+              &CompileTest::packVerticesInt2101010Rev
+              #endif
+              });
+}
+
+namespace {
+
+Trade::MeshData3D meshData() {
+    return Trade::MeshData3D{MeshPrimitive::Lines, {},
+        {{{-1.0f, 0.0f, 2.0f}, {3.0f, 4.0f, 2.0f}}},
+        {{{0.0f, 0.0f, 1.0f}, {0.6f, 0.8f, 0.0f}}},
+        {{{0.5f, 1.5f}, {0.0f, 0.25f}}}};
+}
+
+template<class T> T read(const Containers::Array<char>& data, const std::size_t offset) {
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+}
+
+void CompileTest::packVertices() {
+    Containers::Array<char> data;
+    UnsignedInt stride;
+    CompileQuantization quantization;
+    std::tie(data, stride, quantization) = MeshTools::packVertices(meshData(), {});
+
+    CORRADE_COMPARE(stride, 32);
+    CORRADE_COMPARE(data.size(), 64);
+    CORRADE_COMPARE(read<Vector3>(data, 32), (Vector3{3.0f, 4.0f, 2.0f}));
+    CORRADE_COMPARE(read<Vector3>(data, 32 + 12), (Vector3{0.6f, 0.8f, 0.0f}));
+    CORRADE_COMPARE(read<Vector2>(data, 32 + 24), (Vector2{0.0f, 0.25f}));
+
+    CORRADE_COMPARE(quantization.positionDequantization, Matrix4{});
+    CORRADE_COMPARE(quantization.positionError, 0.0f);
+    CORRADE_COMPARE(quantization.normalError, Rad{0.0f});
+    CORRADE_COMPARE(quantization.textureCoordinateError, 0.0f);
+}
+
+void CompileTest::packVerticesNotPresent() {
+    Containers::Array<char> data;
+    UnsignedInt stride;
+    CompileQuantization quantization;
+    std::tie(data, stride, quantization) = MeshTools::packVertices(
+        Trade::MeshData3D{MeshPrimitive::Points, {}, {{{1.0f, 2.0f, 3.0f}}}, {}, {}},
+        CompileFlag::NormalsNormalizedByte|CompileFlag::TextureCoordinatesHalf);
+
+    /* Flags for attributes that aren't present are ignored */
+    CORRADE_COMPARE(stride, 12);
+    CORRADE_COMPARE(read<Vector3>(data, 0), (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(quantization.normalError, Rad{0.0f});
+    CORRADE_COMPARE(quantization.textureCoordinateError, 0.0f);
+}
+
+void CompileTest::packVerticesNormalizedShort() {
+    Containers::Array<char> data;
+    UnsignedInt stride;
+    CompileQuantization quantization;
+    std::tie(data, stride, quantization) = MeshTools::packVertices(meshData(),
+        CompileFlag::PositionsNormalizedShort|CompileFlag::NormalsNormalizedShort|CompileFlag::TextureCoordinatesNormalizedUnsignedShort);
+
+    /* Positions and normals padded to 8 bytes */
+    CORRADE_COMPARE(stride, 8 + 8 + 4);
+    CORRADE_COMPARE(data.size(), 2*stride);
+
+    /* Positions relative to the bounding box, zero extent kept as is */
+    CORRADE_COMPARE(read<Math::Vector3<Short>>(data, 0), (Math::Vector3<Short>{-32767, -32767, 0}));
+    CORRADE_COMPARE(read<Math::Vector3<Short>>(data, stride), (Math::Vector3<Short>{32767, 32767, 0}));
+    CORRADE_COMPARE(quantization.positionDequantization, Matrix4::translation({1.0f, 2.0f, 2.0f})*Matrix4::scaling({2.0f, 2.0f, 1.0f}));
+    CORRADE_COMPARE(quantization.positionError, 0.0f);
+
+    CORRADE_COMPARE(read<Math::Vector3<Short>>(data, 8), (Math::Vector3<Short>{0, 0, 32767}));
+    CORRADE_COMPARE(read<Math::Vector3<Short>>(data, stride + 8), (Math::Vector3<Short>{19660, 26214, 0}));
+    CORRADE_VERIFY(quantization.normalError < Rad{Deg{0.01f}});
+
+    /* Texture coordinates outside of the range are clamped, which is
+       included in the error */
+    CORRADE_COMPARE(read<Math::Vector2<UnsignedShort>>(data, 16), (Math::Vector2<UnsignedShort>{32768, 65535}));
+    CORRADE_COMPARE(read<Math::Vector2<UnsignedShort>>(data, stride + 16), (Math::Vector2<UnsignedShort>{0, 16384}));
+    CORRADE_COMPARE(quantization.textureCoordinateError, 0.5f);
+}
+
+void CompileTest::packVerticesHalfNormalizedByte() {
+    Containers::Array<char> data;
+    UnsignedInt stride;
+    CompileQuantization quantization;
+    std::tie(data, stride, quantization) = MeshTools::packVertices(meshData(),
+        CompileFlag::PositionsHalf|CompileFlag::NormalsNormalizedByte|CompileFlag::TextureCoordinatesHalf);
+
+    /* Positions padded to 8 bytes, normals to 4 */
+    CORRADE_COMPARE(stride, 8 + 4 + 4);
+    CORRADE_COMPARE(data.size(), 2*stride);
+
+    CORRADE_COMPARE(read<Math::Vector3<UnsignedShort>>(data, 0), (Math::Vector3<UnsignedShort>{0xbc00, 0x0000, 0x4000}));
+    CORRADE_COMPARE(read<Math::Vector3<UnsignedShort>>(data, stride), (Math::Vector3<UnsignedShort>{0x4200, 0x4400, 0x4000}));
+    CORRADE_COMPARE(quantization.positionDequantization, Matrix4{});
+    CORRADE_COMPARE(quantization.positionError, 0.0f);
+
+    CORRADE_COMPARE(read<Math::Vector3<Byte>>(data, 8), (Math::Vector3<Byte>{0, 0, 127}));
+    CORRADE_COMPARE(read<Math::Vector3<Byte>>(data, stride + 8), (Math::Vector3<Byte>{76, 102, 0}));
+    CORRADE_VERIFY(quantization.normalError > Rad{0.0f});
+    CORRADE_VERIFY(quantization.normalError < Rad{Deg{1.0f}});
+
+    CORRADE_COMPARE(read<Math::Vector2<UnsignedShort>>(data, 12), (Math::Vector2<UnsignedShort>{0x3800, 0x3e00}));
+    CORRADE_COMPARE(read<Math::Vector2<UnsignedShort>>(data, stride + 12), (Math::Vector2<UnsignedShort>{0x0000, 0x3400}));
+    CORRADE_COMPARE(quantization.textureCoordinateError, 0.0f);
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void CompileTest::packVerticesInt2101010Rev() {
+    Containers::Array<char> data;
+    UnsignedInt stride;
+    CompileQuantization quantization;
+    std::tie(data, stride, quantization) = MeshTools::packVertices(meshData(),
+        CompileFlag::NormalsInt2101010Rev);
+
+    CORRADE_COMPARE(stride, 12 + 4 + 8);
+    CORRADE_COMPARE(read<UnsignedInt>(data, 12), 511 << 20);
+    CORRADE_COMPARE(read<UnsignedInt>(data, stride + 12), 307|(409 << 10));
+    CORRADE_VERIFY(quantization.normalError > Rad{0.0f});
+    CORRADE_VERIFY(quantization.normalError < Rad{Deg{0.2f}});
+    CORRADE_COMPARE(quantization.positionError, 0.0f);
+    CORRADE_COMPARE(quantization.textureCoordinateError, 0.0f);
+}
+#endif
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CompileTest)
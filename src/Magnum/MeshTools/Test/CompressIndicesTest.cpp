@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/Endianness.h>
@@ -37,12 +38,30 @@ struct CompressIndicesTest: TestSuite::Tester {
     void compressChar();
     void compressShort();
     void compressInt();
+    void compressEmpty();
+
+    void compressWithBaseVertex();
+
+    void compressChunked();
+    void compressChunkedTriangles();
+    void compressChunkedWrongPrimitive();
+    void compressChunkedWrongIndexCount();
+    void compressChunkedPrimitiveTooLarge();
 };
 
 CompressIndicesTest::CompressIndicesTest() {
     addTests({&CompressIndicesTest::compressChar,
               &CompressIndicesTest::compressShort,
-              &CompressIndicesTest::compressInt});
+              &CompressIndicesTest::compressInt,
+              &CompressIndicesTest::compressEmpty,
+
+              &CompressIndicesTest::compressWithBaseVertex,
+
+              &CompressIndicesTest::compressChunked,
+              &CompressIndicesTest::compressChunkedTriangles,
+              &CompressIndicesTest::compressChunkedWrongPrimitive,
+              &CompressIndicesTest::compressChunkedWrongIndexCount,
+              &CompressIndicesTest::compressChunkedPrimitiveTooLarge});
 }
 
 void CompressIndicesTest::compressChar() {
@@ -108,6 +127,107 @@ void CompressIndicesTest::compressInt() {
     }
 }
 
+void CompressIndicesTest::compressEmpty() {
+    Containers::Array<char> data;
+    Mesh::IndexType type;
+    UnsignedInt start, end;
+    std::tie(data, type, start, end) = MeshTools::compressIndices(std::vector<UnsignedInt>{});
+
+    CORRADE_COMPARE(start, 0);
+    CORRADE_COMPARE(end, 0);
+    CORRADE_COMPARE(type, Mesh::IndexType::UnsignedByte);
+    CORRADE_VERIFY(data.empty());
+}
+
+void CompressIndicesTest::compressWithBaseVertex() {
+    Containers::Array<char> data;
+    Mesh::IndexType type;
+    UnsignedInt start, end;
+    Int baseVertex;
+    std::tie(data, type, start, end, baseVertex) = MeshTools::compressIndicesWithBaseVertex(
+        std::vector<UnsignedInt>{70001, 70200, 70000, 70005});
+
+    /* Would be 32-bit without the rebasing */
+    CORRADE_COMPARE(start, 0);
+    CORRADE_COMPARE(end, 200);
+    CORRADE_COMPARE(baseVertex, 70000);
+    CORRADE_COMPARE(type, Mesh::IndexType::UnsignedByte);
+    CORRADE_COMPARE(std::vector<UnsignedByte>(data.begin(), data.end()),
+        (std::vector<UnsignedByte>{ 1, 200, 0, 5 }));
+}
+
+void CompressIndicesTest::compressChunked() {
+    Containers::Array<char> data;
+    std::vector<IndexChunk> chunks;
+    std::tie(data, chunks) = MeshTools::compressIndicesChunked(
+        std::vector<UnsignedInt>{3, 65538, 100000, 100002, 40000, 5}, MeshPrimitive::Points);
+
+    /* 3 and 65538 still fit into one chunk, 100000 doesn't */
+    CORRADE_COMPARE(chunks.size(), 3);
+    CORRADE_COMPARE(chunks[0].indexOffset, 0);
+    CORRADE_COMPARE(chunks[0].indexCount, 2);
+    CORRADE_COMPARE(chunks[0].indexStart, 0);
+    CORRADE_COMPARE(chunks[0].indexEnd, 65535);
+    CORRADE_COMPARE(chunks[0].baseVertex, 3);
+    CORRADE_COMPARE(chunks[1].indexOffset, 2);
+    CORRADE_COMPARE(chunks[1].indexCount, 3);
+    CORRADE_COMPARE(chunks[1].indexStart, 0);
+    CORRADE_COMPARE(chunks[1].indexEnd, 60002);
+    CORRADE_COMPARE(chunks[1].baseVertex, 40000);
+    CORRADE_COMPARE(chunks[2].indexOffset, 5);
+    CORRADE_COMPARE(chunks[2].indexCount, 1);
+    CORRADE_COMPARE(chunks[2].indexStart, 0);
+    CORRADE_COMPARE(chunks[2].indexEnd, 0);
+    CORRADE_COMPARE(chunks[2].baseVertex, 5);
+
+    CORRADE_COMPARE(data.size(), 6*sizeof(UnsignedShort));
+    const UnsignedShort* indices = reinterpret_cast<const UnsignedShort*>(data.begin());
+    CORRADE_COMPARE(std::vector<UnsignedShort>(indices, indices + 6),
+        (std::vector<UnsignedShort>{ 0, 65535, 60000, 60002, 0, 0 }));
+}
+
+void CompressIndicesTest::compressChunkedTriangles() {
+    Containers::Array<char> data;
+    std::vector<IndexChunk> chunks;
+    std::tie(data, chunks) = MeshTools::compressIndicesChunked(
+        std::vector<UnsignedInt>{0, 1, 2, 30000, 90000, 30001, 150000, 150001, 150002});
+
+    /* The second triangle can't be in either chunk, but isn't split */
+    CORRADE_COMPARE(chunks.size(), 3);
+    CORRADE_COMPARE(chunks[0].indexCount, 3);
+    CORRADE_COMPARE(chunks[1].indexOffset, 3);
+    CORRADE_COMPARE(chunks[1].indexCount, 3);
+    CORRADE_COMPARE(chunks[1].baseVertex, 30000);
+    CORRADE_COMPARE(chunks[1].indexEnd, 60000);
+    CORRADE_COMPARE(chunks[2].indexOffset, 6);
+    CORRADE_COMPARE(chunks[2].baseVertex, 150000);
+    CORRADE_COMPARE(chunks[2].indexEnd, 2);
+}
+
+void CompressIndicesTest::compressChunkedWrongPrimitive() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    MeshTools::compressIndicesChunked({0, 1, 2}, MeshPrimitive::TriangleStrip);
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::compressIndicesChunked(): can't split MeshPrimitive::TriangleStrip into chunks\n");
+}
+
+void CompressIndicesTest::compressChunkedWrongIndexCount() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    MeshTools::compressIndicesChunked({0, 1}, MeshPrimitive::Triangles);
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::compressIndicesChunked(): index count is not divisible by 3\n");
+}
+
+void CompressIndicesTest::compressChunkedPrimitiveTooLarge() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    MeshTools::compressIndicesChunked({0, 1, 2, 3, 70000, 5}, MeshPrimitive::Triangles);
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::compressIndicesChunked(): primitive 1 spans more than 65536 vertices\n");
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CompressIndicesTest)
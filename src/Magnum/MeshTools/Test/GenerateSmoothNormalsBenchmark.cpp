@@ -0,0 +1,151 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/GenerateFlatNormals.h"
+#include "Magnum/MeshTools/GenerateSmoothNormals.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Test/BenchmarkTimer.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct GenerateSmoothNormalsBenchmark: TestSuite::Tester {
+    explicit GenerateSmoothNormalsBenchmark();
+
+    void flat();
+    void smoothArea();
+    void smoothAngle();
+    void smoothCrease();
+    #ifdef MAGNUM_BUILD_MULTITHREADED
+    void smoothAngleParallel();
+    void smoothCreaseParallel();
+    #endif
+};
+
+namespace {
+
+/* 163842 vertices, 327680 faces */
+constexpr UnsignedInt Subdivisions = 7;
+constexpr std::size_t Iterations = 5;
+
+Double benchmark(const Trade::MeshData3D& mesh, NormalWeighting weighting, Rad creaseAngle, UnsignedInt threadCount, std::vector<Vector3>& normals) {
+    std::vector<UnsignedInt> normalIndices;
+    Magnum::Test::BenchmarkTimer timer{Iterations};
+    timer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        std::tie(normalIndices, normals) = MeshTools::generateSmoothNormals(mesh.indices(), mesh.positions(0), weighting, creaseAngle, threadCount);
+    timer.stop();
+    return timer.milliseconds();
+}
+
+}
+
+GenerateSmoothNormalsBenchmark::GenerateSmoothNormalsBenchmark() {
+    addTests({&GenerateSmoothNormalsBenchmark::flat,
+              &GenerateSmoothNormalsBenchmark::smoothArea,
+              &GenerateSmoothNormalsBenchmark::smoothAngle,
+              &GenerateSmoothNormalsBenchmark::smoothCrease,
+              #ifdef MAGNUM_BUILD_MULTITHREADED
+              &GenerateSmoothNormalsBenchmark::smoothAngleParallel,
+              &GenerateSmoothNormalsBenchmark::smoothCreaseParallel
+              #endif
+              });
+}
+
+void GenerateSmoothNormalsBenchmark::flat() {
+    const Trade::MeshData3D mesh = Primitives::Icosphere::solid(Subdivisions);
+
+    std::vector<UnsignedInt> normalIndices;
+    std::vector<Vector3> normals;
+    Magnum::Test::BenchmarkTimer timer{Iterations};
+    timer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        std::tie(normalIndices, normals) = MeshTools::generateFlatNormals(mesh.indices(), mesh.positions(0));
+    timer.stop();
+    const Double time = timer.milliseconds();
+
+    CORRADE_COMPARE(normalIndices.size(), mesh.indices().size());
+    Debug() << "   " << mesh.indices().size()/3 << "faces, generateFlatNormals():" << time << "ms";
+}
+
+void GenerateSmoothNormalsBenchmark::smoothArea() {
+    const Trade::MeshData3D mesh = Primitives::Icosphere::solid(Subdivisions);
+
+    std::vector<Vector3> normals;
+    const Double time = benchmark(mesh, NormalWeighting::Area, Deg(180.0f), 1, normals);
+
+    CORRADE_COMPARE(normals.size(), mesh.positions(0).size());
+    Debug() << "   " << mesh.indices().size()/3 << "faces, area weighted:" << time << "ms";
+}
+
+void GenerateSmoothNormalsBenchmark::smoothAngle() {
+    const Trade::MeshData3D mesh = Primitives::Icosphere::solid(Subdivisions);
+
+    std::vector<Vector3> normals;
+    const Double time = benchmark(mesh, NormalWeighting::Angle, Deg(180.0f), 1, normals);
+
+    CORRADE_COMPARE(normals.size(), mesh.positions(0).size());
+    Debug() << "   " << mesh.indices().size()/3 << "faces, angle weighted:" << time << "ms";
+}
+
+void GenerateSmoothNormalsBenchmark::smoothCrease() {
+    const Trade::MeshData3D mesh = Primitives::Icosphere::solid(Subdivisions);
+
+    std::vector<Vector3> normals;
+    const Double time = benchmark(mesh, NormalWeighting::Angle, Deg(30.0f), 1, normals);
+
+    /* The sphere is smooth, so no vertex should get more than one normal */
+    CORRADE_COMPARE(normals.size(), mesh.positions(0).size());
+    Debug() << "   " << mesh.indices().size()/3 << "faces, angle weighted with crease threshold:" << time << "ms";
+}
+
+#ifdef MAGNUM_BUILD_MULTITHREADED
+void GenerateSmoothNormalsBenchmark::smoothAngleParallel() {
+    const Trade::MeshData3D mesh = Primitives::Icosphere::solid(Subdivisions);
+
+    std::vector<Vector3> normals;
+    const Double time = benchmark(mesh, NormalWeighting::Angle, Deg(180.0f), 0, normals);
+
+    CORRADE_COMPARE(normals.size(), mesh.positions(0).size());
+    Debug() << "   " << mesh.indices().size()/3 << "faces, angle weighted, all threads:" << time << "ms";
+}
+
+void GenerateSmoothNormalsBenchmark::smoothCreaseParallel() {
+    const Trade::MeshData3D mesh = Primitives::Icosphere::solid(Subdivisions);
+
+    std::vector<Vector3> normals;
+    const Double time = benchmark(mesh, NormalWeighting::Angle, Deg(30.0f), 0, normals);
+
+    CORRADE_COMPARE(normals.size(), mesh.positions(0).size());
+    Debug() << "   " << mesh.indices().size()/3 << "faces, angle weighted with crease threshold, all threads:" << time << "ms";
+}
+#endif
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateSmoothNormalsBenchmark)
@@ -0,0 +1,208 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/GenerateSmoothNormals.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct GenerateSmoothNormalsTest: TestSuite::Tester {
+    explicit GenerateSmoothNormalsTest();
+
+    void wrongIndexCount();
+    void indexOutOfBounds();
+    void generateAngleWeighted();
+    void generateAreaWeighted();
+    void generateCrease();
+    void generateDegenerate();
+    void generateParallel();
+    void debugWeighting();
+};
+
+GenerateSmoothNormalsTest::GenerateSmoothNormalsTest() {
+    addTests({&GenerateSmoothNormalsTest::wrongIndexCount,
+              &GenerateSmoothNormalsTest::indexOutOfBounds,
+              &GenerateSmoothNormalsTest::generateAngleWeighted,
+              &GenerateSmoothNormalsTest::generateAreaWeighted,
+              &GenerateSmoothNormalsTest::generateCrease,
+              &GenerateSmoothNormalsTest::generateDegenerate,
+              &GenerateSmoothNormalsTest::generateParallel,
+              &GenerateSmoothNormalsTest::debugWeighting});
+}
+
+namespace {
+
+/* Two faces sharing vertex 0, the first in XY plane, the second four times
+   larger in YZ plane. Both have right angle at vertex 0. */
+const std::vector<UnsignedInt> indices{
+    0, 1, 2,
+    0, 3, 4
+};
+const std::vector<Vector3> positions{
+    {0.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f},
+    {0.0f, 2.0f, 0.0f},
+    {0.0f, 0.0f, 2.0f}
+};
+
+}
+
+void GenerateSmoothNormalsTest::wrongIndexCount() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    std::vector<UnsignedInt> normalIndices;
+    std::vector<Vector3> normals;
+    std::tie(normalIndices, normals) = MeshTools::generateSmoothNormals({
+        0, 1
+    }, {});
+
+    CORRADE_COMPARE(normalIndices.size(), 0);
+    CORRADE_COMPARE(normals.size(), 0);
+    CORRADE_COMPARE(ss.str(), "MeshTools::generateSmoothNormals(): index count is not divisible by 3!\n");
+}
+
+void GenerateSmoothNormalsTest::indexOutOfBounds() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    MeshTools::generateSmoothNormals({0, 1, 3}, {{}, {}, {}});
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::generateSmoothNormals(): index 3 out of bounds for 3 vertices\n");
+}
+
+void GenerateSmoothNormalsTest::generateAngleWeighted() {
+    std::vector<UnsignedInt> normalIndices;
+    std::vector<Vector3> normals;
+    std::tie(normalIndices, normals) = MeshTools::generateSmoothNormals(indices, positions);
+
+    /* Without creases the indices are unchanged */
+    CORRADE_COMPARE(normalIndices, indices);
+    CORRADE_COMPARE(normals, (std::vector<Vector3>{
+        Vector3{1.0f, 0.0f, 1.0f}.normalized(),
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        Vector3::xAxis(),
+        Vector3::xAxis()
+    }));
+}
+
+void GenerateSmoothNormalsTest::generateAreaWeighted() {
+    std::vector<UnsignedInt> normalIndices;
+    std::vector<Vector3> normals;
+    std::tie(normalIndices, normals) = MeshTools::generateSmoothNormals(indices, positions, NormalWeighting::Area);
+
+    CORRADE_COMPARE(normalIndices, indices);
+    CORRADE_COMPARE(normals, (std::vector<Vector3>{
+        Vector3{4.0f, 0.0f, 1.0f}.normalized(),
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        Vector3::xAxis(),
+        Vector3::xAxis()
+    }));
+}
+
+void GenerateSmoothNormalsTest::generateCrease() {
+    std::vector<UnsignedInt> normalIndices;
+    std::vector<Vector3> normals;
+
+    /* The faces are at right angle, with threshold above it it's the same as
+       without creases, except for the indices being recalculated */
+    std::tie(normalIndices, normals) = MeshTools::generateSmoothNormals(indices, positions, NormalWeighting::Angle, Deg(100.0f));
+    CORRADE_COMPARE(normalIndices, indices);
+    CORRADE_COMPARE(normals.size(), 5);
+    CORRADE_COMPARE(normals[0], Vector3(1.0f, 0.0f, 1.0f).normalized());
+
+    /* Below the threshold the shared vertex has two normals */
+    std::tie(normalIndices, normals) = MeshTools::generateSmoothNormals(indices, positions, NormalWeighting::Angle, Deg(45.0f));
+    CORRADE_COMPARE(normalIndices, (std::vector<UnsignedInt>{
+        0, 2, 3,
+        1, 4, 5
+    }));
+    CORRADE_COMPARE(normals, (std::vector<Vector3>{
+        Vector3::zAxis(),
+        Vector3::xAxis(),
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        Vector3::xAxis(),
+        Vector3::xAxis()
+    }));
+}
+
+void GenerateSmoothNormalsTest::generateDegenerate() {
+    /* Degenerate face doesn't contribute, vertex 3 is unused */
+    std::vector<UnsignedInt> normalIndices;
+    std::vector<Vector3> normals;
+    std::tie(normalIndices, normals) = MeshTools::generateSmoothNormals({
+        0, 1, 2,
+        0, 1, 1
+    }, {
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {5.0f, 5.0f, 5.0f}
+    });
+
+    CORRADE_COMPARE(normals, (std::vector<Vector3>{
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        Vector3()
+    }));
+}
+
+void GenerateSmoothNormalsTest::generateParallel() {
+    /* Wavy grid, large enough to be split among the threads */
+    constexpr UnsignedInt size = 200;
+    std::vector<Vector3> gridPositions;
+    std::vector<UnsignedInt> gridIndices;
+    for(UnsignedInt y = 0; y != size; ++y) for(UnsignedInt x = 0; x != size; ++x) {
+        gridPositions.emplace_back(Float(x), Float(y), Float((x*7 + y*3)%5));
+        if(x + 1 == size || y + 1 == size) continue;
+        const UnsignedInt i = y*size + x;
+        gridIndices.insert(gridIndices.end(), {i, i + 1, i + size + 1, i, i + size + 1, i + size});
+    }
+
+    std::vector<UnsignedInt> normalIndices, normalIndicesParallel;
+    std::vector<Vector3> normals, normalsParallel;
+    std::tie(normalIndices, normals) = MeshTools::generateSmoothNormals(gridIndices, gridPositions, NormalWeighting::Angle, Deg(30.0f));
+    std::tie(normalIndicesParallel, normalsParallel) = MeshTools::generateSmoothNormals(gridIndices, gridPositions, NormalWeighting::Angle, Deg(30.0f), 4);
+
+    CORRADE_VERIFY(normals.size() > gridPositions.size());
+    CORRADE_VERIFY(normalIndicesParallel == normalIndices);
+    CORRADE_VERIFY(normalsParallel == normals);
+}
+
+void GenerateSmoothNormalsTest::debugWeighting() {
+    std::ostringstream o;
+    Debug(&o) << NormalWeighting::Area << NormalWeighting(0xde);
+    CORRADE_COMPARE(o.str(), "MeshTools::NormalWeighting::Area MeshTools::NormalWeighting::(invalid)\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateSmoothNormalsTest)
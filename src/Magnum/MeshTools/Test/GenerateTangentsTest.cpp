@@ -0,0 +1,241 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/MeshTools/GenerateTangents.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct GenerateTangentsTest: TestSuite::Tester {
+    explicit GenerateTangentsTest();
+
+    void wrongIndexCount();
+    void wrongAttributeCount();
+    void generate();
+    void generateMirrored();
+    void generateDegenerate();
+    void generateParallel();
+
+    void meshData();
+    void meshDataMirrored();
+    void meshDataNotIndexed();
+    void meshDataNoTextureCoordinates();
+};
+
+GenerateTangentsTest::GenerateTangentsTest() {
+    addTests({&GenerateTangentsTest::wrongIndexCount,
+              &GenerateTangentsTest::wrongAttributeCount,
+              &GenerateTangentsTest::generate,
+              &GenerateTangentsTest::generateMirrored,
+              &GenerateTangentsTest::generateDegenerate,
+              &GenerateTangentsTest::generateParallel,
+
+              &GenerateTangentsTest::meshData,
+              &GenerateTangentsTest::meshDataMirrored,
+              &GenerateTangentsTest::meshDataNotIndexed,
+              &GenerateTangentsTest::meshDataNoTextureCoordinates});
+}
+
+namespace {
+
+/* Two quads in XY plane sharing vertices 1 and 2, texture mapping of the
+   second one is mirrored */
+const std::vector<UnsignedInt> indices{
+    0, 1, 2, 0, 2, 3,
+    1, 4, 5, 1, 5, 2
+};
+const std::vector<Vector3> positions{
+    {0.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {1.0f, 1.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f},
+    {2.0f, 0.0f, 0.0f},
+    {2.0f, 1.0f, 0.0f}
+};
+const std::vector<Vector3> normals(6, Vector3::zAxis());
+const std::vector<Vector2> textureCoordinates{
+    {0.0f, 0.0f},
+    {1.0f, 0.0f},
+    {1.0f, 1.0f},
+    {0.0f, 1.0f},
+    {0.0f, 0.0f},
+    {0.0f, 1.0f}
+};
+
+}
+
+void GenerateTangentsTest::wrongIndexCount() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    std::vector<UnsignedInt> tangentIndices;
+    std::vector<Vector4> tangents;
+    std::tie(tangentIndices, tangents) = MeshTools::generateTangents({0, 1}, {}, {}, {});
+
+    CORRADE_COMPARE(tangentIndices.size(), 0);
+    CORRADE_COMPARE(tangents.size(), 0);
+    CORRADE_COMPARE(ss.str(), "MeshTools::generateTangents(): index count is not divisible by 3!\n");
+}
+
+void GenerateTangentsTest::wrongAttributeCount() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    MeshTools::generateTangents(indices, positions, normals, {{}, {}});
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::generateTangents(): expected 6 normals and texture coordinates but got 6 and 2\n");
+}
+
+void GenerateTangentsTest::generate() {
+    /* Just the first quad */
+    std::vector<UnsignedInt> tangentIndices;
+    std::vector<Vector4> tangents;
+    std::tie(tangentIndices, tangents) = MeshTools::generateTangents(
+        {0, 1, 2, 0, 2, 3}, positions, normals, textureCoordinates);
+
+    CORRADE_COMPARE(tangentIndices, (std::vector<UnsignedInt>{0, 1, 2, 0, 2, 3}));
+    CORRADE_COMPARE(tangents, std::vector<Vector4>(4, {1.0f, 0.0f, 0.0f, 1.0f}));
+}
+
+void GenerateTangentsTest::generateMirrored() {
+    std::vector<UnsignedInt> tangentIndices;
+    std::vector<Vector4> tangents;
+    std::tie(tangentIndices, tangents) = MeshTools::generateTangents(indices, positions, normals, textureCoordinates);
+
+    /* The shared vertices have two tangents */
+    CORRADE_COMPARE(tangentIndices, (std::vector<UnsignedInt>{
+        0, 1, 3, 0, 3, 5,
+        2, 6, 7, 2, 7, 4
+    }));
+    CORRADE_COMPARE(tangents, (std::vector<Vector4>{
+        {1.0f, 0.0f, 0.0f, 1.0f},
+        {1.0f, 0.0f, 0.0f, 1.0f},
+        {-1.0f, 0.0f, 0.0f, -1.0f},
+        {1.0f, 0.0f, 0.0f, 1.0f},
+        {-1.0f, 0.0f, 0.0f, -1.0f},
+        {1.0f, 0.0f, 0.0f, 1.0f},
+        {-1.0f, 0.0f, 0.0f, -1.0f},
+        {-1.0f, 0.0f, 0.0f, -1.0f}
+    }));
+}
+
+void GenerateTangentsTest::generateDegenerate() {
+    /* No texture mapping, the tangent is arbitrary but perpendicular to
+       the normal */
+    std::vector<UnsignedInt> tangentIndices;
+    std::vector<Vector4> tangents;
+    std::tie(tangentIndices, tangents) = MeshTools::generateTangents(
+        {0, 1, 2}, {{}, Vector3::xAxis(), Vector3::yAxis()},
+        std::vector<Vector3>(3, Vector3::zAxis()), std::vector<Vector2>(3));
+
+    CORRADE_COMPARE(tangentIndices, (std::vector<UnsignedInt>{0, 1, 2}));
+    CORRADE_COMPARE(tangents, std::vector<Vector4>(3, {1.0f, 0.0f, 0.0f, 1.0f}));
+}
+
+void GenerateTangentsTest::generateParallel() {
+    /* Wavy grid with every other column mirrored, large enough to be split
+       among the threads */
+    constexpr UnsignedInt size = 200;
+    std::vector<Vector3> gridPositions, gridNormals;
+    std::vector<Vector2> gridTextureCoordinates;
+    std::vector<UnsignedInt> gridIndices;
+    for(UnsignedInt y = 0; y != size; ++y) for(UnsignedInt x = 0; x != size; ++x) {
+        gridPositions.emplace_back(Float(x), Float(y), Float((x*7 + y*3)%5));
+        gridNormals.push_back(Vector3{Float(x%3), Float(y%2), 1.0f}.normalized());
+        gridTextureCoordinates.emplace_back(Float(x%2), Float(y));
+        if(x + 1 == size || y + 1 == size) continue;
+        const UnsignedInt i = y*size + x;
+        gridIndices.insert(gridIndices.end(), {i, i + 1, i + size + 1, i, i + size + 1, i + size});
+    }
+
+    std::vector<UnsignedInt> tangentIndices, tangentIndicesParallel;
+    std::vector<Vector4> tangents, tangentsParallel;
+    std::tie(tangentIndices, tangents) = MeshTools::generateTangents(gridIndices, gridPositions, gridNormals, gridTextureCoordinates);
+    std::tie(tangentIndicesParallel, tangentsParallel) = MeshTools::generateTangents(gridIndices, gridPositions, gridNormals, gridTextureCoordinates, 4);
+
+    CORRADE_VERIFY(tangents.size() > gridPositions.size());
+    CORRADE_VERIFY(tangentIndicesParallel == tangentIndices);
+    CORRADE_VERIFY(tangentsParallel == tangents);
+}
+
+void GenerateTangentsTest::meshData() {
+    Trade::MeshData3D data{MeshPrimitive::Triangles,
+        {0, 1, 2, 0, 2, 3}, {{positions.begin(), positions.begin() + 4}},
+        {{normals.begin(), normals.begin() + 4}},
+        {{textureCoordinates.begin(), textureCoordinates.begin() + 4}}};
+
+    /* Nothing needs to be split, data are unchanged */
+    const std::vector<Vector4> tangents = MeshTools::generateTangents(data);
+    CORRADE_COMPARE(data.indices(), (std::vector<UnsignedInt>{0, 1, 2, 0, 2, 3}));
+    CORRADE_COMPARE(data.positions(0).size(), 4);
+    CORRADE_COMPARE(tangents, std::vector<Vector4>(4, {1.0f, 0.0f, 0.0f, 1.0f}));
+}
+
+void GenerateTangentsTest::meshDataMirrored() {
+    Trade::MeshData3D data{MeshPrimitive::Triangles,
+        indices, {positions}, {normals}, {textureCoordinates}};
+
+    /* The two shared vertices are split */
+    const std::vector<Vector4> tangents = MeshTools::generateTangents(data);
+    CORRADE_COMPARE(data.indices().size(), 12);
+    CORRADE_COMPARE(data.positions(0).size(), 8);
+    CORRADE_COMPARE(data.normals(0).size(), 8);
+    CORRADE_COMPARE(data.textureCoords2D(0).size(), 8);
+    CORRADE_COMPARE(tangents.size(), 8);
+
+    /* Position and texture coordinates of each corner stay the same, tangents
+       of the first quad point in the other direction than of the second */
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        CORRADE_COMPARE(data.positions(0)[data.indices()[i]], positions[indices[i]]);
+        CORRADE_COMPARE(data.textureCoords2D(0)[data.indices()[i]], textureCoordinates[indices[i]]);
+        CORRADE_COMPARE(tangents[data.indices()[i]], (i < 6 ?
+            Vector4{1.0f, 0.0f, 0.0f, 1.0f} : Vector4{-1.0f, 0.0f, 0.0f, -1.0f}));
+    }
+}
+
+void GenerateTangentsTest::meshDataNotIndexed() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    Trade::MeshData3D data{MeshPrimitive::Triangles, {}, {positions}, {normals}, {textureCoordinates}};
+    MeshTools::generateTangents(data);
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::generateTangents(): expected indexed triangle mesh\n");
+}
+
+void GenerateTangentsTest::meshDataNoTextureCoordinates() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    Trade::MeshData3D data{MeshPrimitive::Triangles, indices, {positions}, {normals}, {}};
+    MeshTools::generateTangents(data);
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::generateTangents(): the mesh has no normals or texture coordinates\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateTangentsTest)
@@ -0,0 +1,289 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/MeshTools/InterleaveStrided.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct InterleaveStridedTest: TestSuite::Tester {
+    explicit InterleaveStridedTest();
+
+    void stride();
+    void interleave();
+    void interleaveStridedSource();
+    void interleaveContiguous();
+    void interleaveOnlyGaps();
+    void convertHalf();
+    void convertNormalized();
+    void convertNormalizedLarge();
+    void convert2101010();
+    void wrongCount();
+    void wrongConversionSize();
+    void wrong2101010ComponentCount();
+    void bufferTooSmall();
+    void debugConversion();
+};
+
+InterleaveStridedTest::InterleaveStridedTest() {
+    addTests({&InterleaveStridedTest::stride,
+              &InterleaveStridedTest::interleave,
+              &InterleaveStridedTest::interleaveStridedSource,
+              &InterleaveStridedTest::interleaveContiguous,
+              &InterleaveStridedTest::interleaveOnlyGaps,
+              &InterleaveStridedTest::convertHalf,
+              &InterleaveStridedTest::convertNormalized,
+              &InterleaveStridedTest::convertNormalizedLarge,
+              &InterleaveStridedTest::convert2101010,
+              &InterleaveStridedTest::wrongCount,
+              &InterleaveStridedTest::wrongConversionSize,
+              &InterleaveStridedTest::wrong2101010ComponentCount,
+              &InterleaveStridedTest::bufferTooSmall,
+              &InterleaveStridedTest::debugConversion});
+}
+
+void InterleaveStridedTest::stride() {
+    const std::vector<Vector3> a;
+    const std::vector<Short> b;
+    CORRADE_COMPARE(interleavedStride({a, 2, b}), 16);
+    CORRADE_COMPARE(interleavedStride({{a, AttributeConversion::Half}, b}), 8);
+    CORRADE_COMPARE(interleavedStride({{a, AttributeConversion::NormalizedByte}, 1}), 4);
+    CORRADE_COMPARE(interleavedStride({{a, AttributeConversion::NormalizedUnsignedShort}}), 6);
+}
+
+void InterleaveStridedTest::interleave() {
+    const std::vector<Byte> a{0, 1, 2};
+    const std::vector<Short> b{3, 4, 5};
+    const std::vector<Int> c{6, 7, 8};
+
+    /* Gaps are left untouched */
+    char data[3*(1 + 2 + 2 + 4)];
+    std::fill_n(data, sizeof(data), '\x7f');
+    interleaveInto(data, {a, b, 2, c});
+
+    const std::vector<char> expected = [&]() {
+        std::vector<char> out(sizeof(data), '\x7f');
+        for(std::size_t i = 0; i != 3; ++i) {
+            std::memcpy(out.data() + i*9 + 0, &a[i], 1);
+            std::memcpy(out.data() + i*9 + 1, &b[i], 2);
+            std::memcpy(out.data() + i*9 + 5, &c[i], 4);
+        }
+        return out;
+    }();
+    CORRADE_COMPARE(std::vector<char>(data, data + sizeof(data)), expected);
+}
+
+void InterleaveStridedTest::interleaveStridedSource() {
+    struct Vertex {
+        Vector3 position;
+        Int id;
+    };
+    const Vertex vertices[]{
+        {{1.0f, 2.0f, 3.0f}, 15},
+        {{4.0f, 5.0f, 6.0f}, 16}
+    };
+
+    /* Reordering the fields of interleaved input */
+    char data[2*16];
+    interleaveInto(data, {
+        {&vertices[0].id, 2, sizeof(Vertex), sizeof(Int)},
+        {&vertices[0].position, 2, sizeof(Vertex), sizeof(Vector3)}});
+
+    Int id;
+    Vector3 position;
+    std::memcpy(&id, data + 16, sizeof(Int));
+    std::memcpy(&position, data + 20, sizeof(Vector3));
+    CORRADE_COMPARE(id, 16);
+    CORRADE_COMPARE(position, (Vector3{4.0f, 5.0f, 6.0f}));
+}
+
+void InterleaveStridedTest::interleaveContiguous() {
+    const std::vector<Vector3> a{{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}};
+
+    Vector3 data[2];
+    interleaveInto({reinterpret_cast<char*>(data), sizeof(data)}, {a});
+    CORRADE_COMPARE(data[0], (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(data[1], (Vector3{4.0f, 5.0f, 6.0f}));
+}
+
+void InterleaveStridedTest::interleaveOnlyGaps() {
+    char data[4]{1, 2, 3, 4};
+    interleaveInto(data, {1, 3});
+    CORRADE_COMPARE(std::vector<char>(data, data + 4), (std::vector<char>{1, 2, 3, 4}));
+}
+
+void InterleaveStridedTest::convertHalf() {
+    const std::vector<Float> a{0.0f, -0.0f, 1.0f, -2.5f, 65504.0f, 65520.0f,
+        1.0e-7f, 5.96046448e-8f, 2.98023224e-8f, 1.0f + 1.0f/2048.0f,
+        Constants::inf()};
+
+    UnsignedShort data[11];
+    interleaveInto({reinterpret_cast<char*>(data), sizeof(data)}, {{a, AttributeConversion::Half}});
+    CORRADE_COMPARE(data[0], 0x0000);
+    CORRADE_COMPARE(data[1], 0x8000);
+    CORRADE_COMPARE(data[2], 0x3c00);
+    CORRADE_COMPARE(data[3], 0xc100);
+    /* Largest representable, overflow */
+    CORRADE_COMPARE(data[4], 0x7bff);
+    CORRADE_COMPARE(data[5], 0x7c00);
+    /* Denormals, smallest denormal, tie rounded to even zero */
+    CORRADE_COMPARE(data[6], 0x0002);
+    CORRADE_COMPARE(data[7], 0x0001);
+    CORRADE_COMPARE(data[8], 0x0000);
+    /* Tie rounded to even */
+    CORRADE_COMPARE(data[9], 0x3c00);
+    CORRADE_COMPARE(data[10], 0x7c00);
+}
+
+void InterleaveStridedTest::convertNormalized() {
+    const std::vector<Vector3> a{{1.0f, -1.0f, 0.0f}, {2.0f, -0.5f, 0.5f}};
+
+    struct Vertex {
+        Byte b[3];
+        UnsignedByte ub[3];
+        Short s[3];
+        UnsignedShort us[3];
+    } data[2];
+    static_assert(sizeof(Vertex) == 18, "unexpected padding");
+
+    interleaveInto({reinterpret_cast<char*>(data), sizeof(data)}, {
+        {a, AttributeConversion::NormalizedByte},
+        {a, AttributeConversion::NormalizedUnsignedByte},
+        {a, AttributeConversion::NormalizedShort},
+        {a, AttributeConversion::NormalizedUnsignedShort}});
+
+    CORRADE_COMPARE(data[0].b[0], 127);
+    CORRADE_COMPARE(data[0].b[1], -127);
+    CORRADE_COMPARE(data[0].b[2], 0);
+    CORRADE_COMPARE(data[0].ub[0], 255);
+    CORRADE_COMPARE(data[0].ub[1], 0);
+    CORRADE_COMPARE(data[0].s[1], -32767);
+    CORRADE_COMPARE(data[0].us[0], 65535);
+
+    /* Clamped, rounded to nearest even */
+    CORRADE_COMPARE(data[1].b[0], 127);
+    CORRADE_COMPARE(data[1].b[1], -64);
+    CORRADE_COMPARE(data[1].ub[1], 0);
+    CORRADE_COMPARE(data[1].ub[2], 128);
+    CORRADE_COMPARE(data[1].s[0], 32767);
+    CORRADE_COMPARE(data[1].us[2], 32768);
+}
+
+void InterleaveStridedTest::convertNormalizedLarge() {
+    /* More components than fit into one batch, with the batch boundary in
+       the middle of a vertex */
+    std::vector<Vector3> a(200);
+    for(std::size_t i = 0; i != a.size(); ++i)
+        a[i] = Vector3{Float(i), Float(i) + 0.25f, Float(i) + 0.5f}/200.0f;
+
+    std::vector<Short> expected;
+    for(const Vector3& v: a) for(std::size_t i = 0; i != 3; ++i)
+        expected.push_back(Math::pack<Short>(v[i]));
+
+    /* Contiguous, packed at once */
+    std::vector<Short> contiguous(600);
+    interleaveInto({reinterpret_cast<char*>(contiguous.data()), contiguous.size()*sizeof(Short)}, {
+        {a, AttributeConversion::NormalizedShort}});
+    CORRADE_COMPARE(contiguous, expected);
+
+    /* Interleaved with a gap, packed in batches */
+    std::vector<Short> interleaved(800);
+    interleaveInto({reinterpret_cast<char*>(interleaved.data()), interleaved.size()*sizeof(Short)}, {
+        {a, AttributeConversion::NormalizedShort}, 2});
+    std::vector<Short> deinterleaved;
+    for(std::size_t i = 0; i != a.size(); ++i)
+        deinterleaved.insert(deinterleaved.end(), interleaved.begin() + i*4, interleaved.begin() + i*4 + 3);
+    CORRADE_COMPARE(deinterleaved, expected);
+}
+
+void InterleaveStridedTest::convert2101010() {
+    const std::vector<Vector3> a{{1.0f, -1.0f, 0.0f}, {2.0f, -0.5f, 0.5f}};
+    const std::vector<Vector4> b{{0.0f, 0.0f, 1.0f, -1.0f}};
+
+    UnsignedInt data[3];
+    interleaveInto({reinterpret_cast<char*>(data), 2*sizeof(UnsignedInt)}, {
+        {a, AttributeConversion::NormalizedInt2101010Rev}});
+    interleaveInto({reinterpret_cast<char*>(data + 2), sizeof(UnsignedInt)}, {
+        {b, AttributeConversion::NormalizedInt2101010Rev}});
+
+    /* 511, -511 (two's complement), 0, W zero */
+    CORRADE_COMPARE(data[0], 0x1ff | (0x201 << 10));
+    /* Clamped 511, rounded -256, 256 */
+    CORRADE_COMPARE(data[1], 0x1ff | (0x300 << 10) | (0x100 << 20));
+    /* Z 511, W -1 */
+    CORRADE_COMPARE(data[2], (0x1ffu << 20) | (0x3u << 30));
+}
+
+void InterleaveStridedTest::wrongCount() {
+    std::stringstream out;
+    Error::setOutput(&out);
+
+    char data[32];
+    interleaveInto(data, {std::vector<Int>{1, 2}, 2, std::vector<Short>{3, 4, 5}});
+    CORRADE_COMPARE(out.str(), "MeshTools::interleaveInto(): attribute arrays don't have the same length, expected 2 but got 3\n");
+}
+
+void InterleaveStridedTest::wrongConversionSize() {
+    std::stringstream out;
+    Error::setOutput(&out);
+
+    char data[32];
+    interleaveInto(data, {{std::vector<Short>{1, 2}, AttributeConversion::Half}});
+    CORRADE_COMPARE(out.str(), "MeshTools::interleaveInto(): expected attribute size to be multiple of 4 for MeshTools::AttributeConversion::Half but got 2\n");
+}
+
+void InterleaveStridedTest::wrong2101010ComponentCount() {
+    std::stringstream out;
+    Error::setOutput(&out);
+
+    char data[32];
+    interleaveInto(data, {{std::vector<Vector2>{{}, {}}, AttributeConversion::NormalizedInt2101010Rev}});
+    CORRADE_COMPARE(out.str(), "MeshTools::interleaveInto(): expected three or four components for MeshTools::AttributeConversion::NormalizedInt2101010Rev but got 2\n");
+}
+
+void InterleaveStridedTest::bufferTooSmall() {
+    std::stringstream out;
+    Error::setOutput(&out);
+
+    char data[15];
+    interleaveInto(data, {std::vector<Int>{1, 2}, 4});
+    CORRADE_COMPARE(out.str(), "MeshTools::interleaveInto(): the data buffer is too small, expected 16 but got 15\n");
+}
+
+void InterleaveStridedTest::debugConversion() {
+    std::ostringstream o;
+    Debug(&o) << AttributeConversion::NormalizedShort << AttributeConversion(0xde);
+    CORRADE_COMPARE(o.str(), "MeshTools::AttributeConversion::NormalizedShort MeshTools::AttributeConversion::(invalid)\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::InterleaveStridedTest)
@@ -0,0 +1,120 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Meshlets.h"
+#include "Magnum/MeshTools/Tipsify.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Test/BenchmarkTimer.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct MeshletsBenchmark: TestSuite::Tester {
+    explicit MeshletsBenchmark();
+
+    void tipsify();
+    void build();
+    void cull();
+};
+
+namespace {
+
+/* 163842 vertices, 327680 faces */
+constexpr UnsignedInt Subdivisions = 7;
+constexpr std::size_t Iterations = 5;
+
+}
+
+MeshletsBenchmark::MeshletsBenchmark() {
+    addTests({&MeshletsBenchmark::tipsify,
+              &MeshletsBenchmark::build,
+              &MeshletsBenchmark::cull});
+}
+
+void MeshletsBenchmark::tipsify() {
+    const Trade::MeshData3D mesh = Primitives::Icosphere::solid(Subdivisions);
+
+    /* For comparison with other adjacency-based index reordering */
+    std::vector<UnsignedInt> indices;
+    Magnum::Test::BenchmarkTimer timer{Iterations};
+    timer.start();
+    for(std::size_t i = 0; i != Iterations; ++i) {
+        indices = mesh.indices();
+        MeshTools::tipsify(indices, mesh.positions(0).size(), 24);
+    }
+    timer.stop();
+    const Double time = timer.milliseconds();
+
+    CORRADE_COMPARE(indices.size(), mesh.indices().size());
+    Debug() << "   " << mesh.indices().size()/3 << "faces, tipsify():" << time << "ms";
+}
+
+void MeshletsBenchmark::build() {
+    const Trade::MeshData3D mesh = Primitives::Icosphere::solid(Subdivisions);
+
+    std::vector<UnsignedInt> indices;
+    std::vector<Meshlet> meshlets;
+    Magnum::Test::BenchmarkTimer timer{Iterations};
+    timer.start();
+    for(std::size_t i = 0; i != Iterations; ++i) {
+        indices = mesh.indices();
+        meshlets = MeshTools::buildMeshlets(indices, mesh.positions(0));
+    }
+    timer.stop();
+    const Double time = timer.milliseconds();
+
+    CORRADE_COMPARE(indices.size(), mesh.indices().size());
+    Debug() << "   " << mesh.indices().size()/3 << "faces," << meshlets.size() << "clusters, average" << Float(indices.size())/(3*meshlets.size()) << "faces per cluster, buildMeshlets():" << time << "ms";
+}
+
+void MeshletsBenchmark::cull() {
+    const Trade::MeshData3D mesh = Primitives::Icosphere::solid(Subdivisions);
+    std::vector<UnsignedInt> indices = mesh.indices();
+    const std::vector<Meshlet> meshlets = MeshTools::buildMeshlets(indices, mesh.positions(0));
+
+    /* Camera close to the sphere surface, looking at it */
+    const Matrix4 transformationProjectionMatrix =
+        Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.01f, 100.0f)*
+        Matrix4::lookAt({0.0f, 0.0f, 1.5f}, {}, Vector3::yAxis()).inverted();
+
+    std::vector<UnsignedInt> visible;
+    Magnum::Test::BenchmarkTimer timer{Iterations};
+    timer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        visible = MeshTools::cullMeshlets(meshlets, transformationProjectionMatrix, {0.0f, 0.0f, 1.5f});
+    timer.stop();
+    const Double time = timer.milliseconds();
+
+    /* The back half is always culled */
+    CORRADE_VERIFY(visible.size() < meshlets.size()/2 + meshlets.size()/10);
+    Debug() << "   " << visible.size() << "of" << meshlets.size() << "clusters visible, cullMeshlets():" << time << "ms";
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::MeshletsBenchmark)
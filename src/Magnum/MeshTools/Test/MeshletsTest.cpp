@@ -0,0 +1,181 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <array>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Meshlets.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct MeshletsTest: TestSuite::Tester {
+    explicit MeshletsTest();
+
+    void wrongIndexCount();
+    void wrongLimits();
+    void build();
+    void buildDisconnected();
+    void cull();
+};
+
+MeshletsTest::MeshletsTest() {
+    addTests({&MeshletsTest::wrongIndexCount,
+              &MeshletsTest::wrongLimits,
+              &MeshletsTest::build,
+              &MeshletsTest::buildDisconnected,
+              &MeshletsTest::cull});
+}
+
+namespace {
+
+/* Grid of size x size quads in XY plane */
+void grid(const UnsignedInt size, std::vector<UnsignedInt>& indices, std::vector<Vector3>& positions) {
+    for(UnsignedInt y = 0; y <= size; ++y) for(UnsignedInt x = 0; x <= size; ++x)
+        positions.emplace_back(Float(x), Float(y), 0.0f);
+
+    for(UnsignedInt y = 0; y != size; ++y) for(UnsignedInt x = 0; x != size; ++x) {
+        const UnsignedInt a = y*(size + 1) + x;
+        indices.insert(indices.end(), {a, a + 1, a + size + 2, a, a + size + 2, a + size + 1});
+    }
+}
+
+std::vector<std::array<UnsignedInt, 3>> sortedTriangles(const std::vector<UnsignedInt>& indices) {
+    std::vector<std::array<UnsignedInt, 3>> triangles;
+    for(std::size_t i = 0; i != indices.size(); i += 3)
+        triangles.push_back({{indices[i], indices[i + 1], indices[i + 2]}});
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+}
+
+void MeshletsTest::wrongIndexCount() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    std::vector<UnsignedInt> indices{0, 1};
+    const std::vector<Meshlet> meshlets = MeshTools::buildMeshlets(indices, {{}, {}});
+
+    CORRADE_VERIFY(meshlets.empty());
+    CORRADE_COMPARE(ss.str(), "MeshTools::buildMeshlets(): index count is not divisible by 3!\n");
+}
+
+void MeshletsTest::wrongLimits() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    std::vector<UnsignedInt> indices{0, 1, 2};
+    MeshTools::buildMeshlets(indices, {{}, {}, {}}, 2, 1);
+    MeshTools::buildMeshlets(indices, {{}, {}, {}}, 3, 0);
+
+    CORRADE_COMPARE(ss.str(),
+        "MeshTools::buildMeshlets(): expected at least 3 vertices and 1 triangle per cluster but got 2 and 1\n"
+        "MeshTools::buildMeshlets(): expected at least 3 vertices and 1 triangle per cluster but got 3 and 0\n");
+}
+
+void MeshletsTest::build() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    grid(8, indices, positions);
+    const std::vector<UnsignedInt> original = indices;
+
+    const std::vector<Meshlet> meshlets = MeshTools::buildMeshlets(indices, positions, 16, 16);
+
+    /* Only reordered, no triangle lost */
+    CORRADE_VERIFY(sortedTriangles(indices) == sortedTriangles(original));
+
+    /* 128 triangles, at most 16 in each cluster */
+    CORRADE_VERIFY(meshlets.size() >= 8);
+
+    std::size_t offset = 0;
+    for(const Meshlet& meshlet: meshlets) {
+        /* Clusters are contiguous and within limits */
+        CORRADE_COMPARE(meshlet.indexOffset, offset);
+        CORRADE_VERIFY(meshlet.indexCount <= 16*3);
+        offset += meshlet.indexCount;
+
+        std::vector<UnsignedInt> vertices{indices.begin() + meshlet.indexOffset, indices.begin() + meshlet.indexOffset + meshlet.indexCount};
+        std::sort(vertices.begin(), vertices.end());
+        vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+        CORRADE_VERIFY(vertices.size() <= 16);
+        CORRADE_COMPARE(meshlet.indexStart, vertices.front());
+        CORRADE_COMPARE(meshlet.indexEnd, vertices.back());
+
+        /* Bounding sphere contains all vertices */
+        for(const UnsignedInt vertex: vertices)
+            CORRADE_VERIFY((positions[vertex] - meshlet.center).length() <= meshlet.radius + 1.0e-5f);
+
+        /* Planar grid, all normals are the same */
+        CORRADE_COMPARE(meshlet.coneAxis, Vector3::zAxis());
+        CORRADE_COMPARE(meshlet.coneCutoff, 0.0f);
+    }
+    CORRADE_COMPARE(offset, indices.size());
+}
+
+void MeshletsTest::buildDisconnected() {
+    std::vector<UnsignedInt> indices{0, 1, 2, 3, 4, 5};
+    const std::vector<Vector3> positions{
+        {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f},
+        {5.0f, 0.0f, 0.0f}, {5.0f, 0.0f, 1.0f}, {5.0f, 1.0f, 0.0f}
+    };
+
+    const std::vector<Meshlet> meshlets = MeshTools::buildMeshlets(indices, positions);
+
+    /* Each triangle gets its own cluster even though both would fit into
+       one */
+    CORRADE_COMPARE(meshlets.size(), 2);
+    CORRADE_COMPARE(meshlets[0].indexCount, 3);
+    CORRADE_COMPARE(meshlets[0].center, (Vector3{0.5f, 0.5f, 0.0f}));
+    CORRADE_COMPARE(meshlets[0].coneAxis, Vector3::zAxis());
+    CORRADE_COMPARE(meshlets[1].indexOffset, 3);
+    CORRADE_COMPARE(meshlets[1].center, (Vector3{5.0f, 0.5f, 0.5f}));
+    CORRADE_COMPARE(meshlets[1].coneAxis, -Vector3::xAxis());
+}
+
+void MeshletsTest::cull() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    grid(8, indices, positions);
+    const std::vector<Meshlet> meshlets = MeshTools::buildMeshlets(indices, positions, 16, 16);
+
+    /* Identity projection is a [-1, 1] cube, only clusters around origin are
+       visible */
+    const std::vector<UnsignedInt> visible = MeshTools::cullMeshlets(meshlets, Matrix4{}, {0.0f, 0.0f, 10.0f});
+    CORRADE_VERIFY(!visible.empty());
+    CORRADE_VERIFY(visible.size() < meshlets.size());
+    for(const UnsignedInt i: visible)
+        CORRADE_VERIFY((meshlets[i].center - Vector3{}).length() <= meshlets[i].radius + Constants::sqrt3());
+
+    /* Looking from below, all clusters are backfacing */
+    CORRADE_VERIFY(MeshTools::cullMeshlets(meshlets, Matrix4{}, {0.0f, 0.0f, -10.0f}).empty());
+
+    /* Moved out of the frustum */
+    CORRADE_VERIFY(MeshTools::cullMeshlets(meshlets, Matrix4::translation({20.0f, 0.0f, 0.0f}), {0.0f, 0.0f, 10.0f}).empty());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::MeshletsTest)
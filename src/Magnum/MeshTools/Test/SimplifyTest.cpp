@@ -0,0 +1,172 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cmath>
+#include <sstream>
+#include <tuple>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Simplify.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct SimplifyTest: TestSuite::Tester {
+    explicit SimplifyTest();
+
+    void wrongIndexCount();
+    void wrongRatios();
+    void planar();
+    void lodChain();
+    void seam();
+};
+
+SimplifyTest::SimplifyTest() {
+    addTests({&SimplifyTest::wrongIndexCount,
+              &SimplifyTest::wrongRatios,
+              &SimplifyTest::planar,
+              &SimplifyTest::lodChain,
+              &SimplifyTest::seam});
+}
+
+namespace {
+
+/* Grid of size x size quads in XY plane, optionally displaced in Z. If seam
+   column is specified, vertices in it are duplicated for the quads on the
+   right, as if they had different texture coordinates. */
+void grid(const Int size, std::vector<UnsignedInt>& indices, std::vector<Vector3>& positions, const bool displaced, const Int seamColumn = -1) {
+    for(Int y = 0; y <= size; ++y) for(Int x = 0; x <= size; ++x)
+        positions.emplace_back(Float(x), Float(y), displaced ? std::sin(x*0.7f)*std::cos(y*0.5f) : 0.0f);
+
+    const UnsignedInt seamBase = positions.size();
+    if(seamColumn != -1) for(Int y = 0; y <= size; ++y)
+        positions.push_back(positions[y*(size + 1) + seamColumn]);
+
+    for(Int y = 0; y != size; ++y) for(Int x = 0; x != size; ++x) {
+        const bool right = seamColumn != -1 && x >= seamColumn;
+        const auto vertex = [&](Int vx, Int vy) -> UnsignedInt {
+            return right && vx == seamColumn ? seamBase + vy : vy*(size + 1) + vx;
+        };
+
+        const UnsignedInt a = vertex(x, y), b = vertex(x + 1, y),
+            c = vertex(x + 1, y + 1), d = vertex(x, y + 1);
+        indices.insert(indices.end(), {a, b, c, a, c, d});
+    }
+}
+
+/* Signed area of the faces projected to XY plane */
+Float area(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions) {
+    Float area = 0.0f;
+    for(std::size_t i = 0; i != indices.size(); i += 3)
+        area += Math::cross(positions[indices[i + 1]] - positions[indices[i]],
+                            positions[indices[i + 2]] - positions[indices[i]]).z()*0.5f;
+    return area;
+}
+
+}
+
+void SimplifyTest::wrongIndexCount() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    const std::pair<std::vector<UnsignedInt>, Float> result = MeshTools::simplify({0, 1}, {{}, {}}, 0);
+
+    CORRADE_VERIFY(result.first.empty());
+    CORRADE_COMPARE(ss.str(), "MeshTools::simplify(): index count is not divisible by 3!\n");
+}
+
+void SimplifyTest::wrongRatios() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    MeshTools::simplifyLodChain({}, {}, {1.0f, 0.5f, 0.7f});
+    MeshTools::simplifyLodChain({}, {}, {1.5f});
+
+    CORRADE_COMPARE(ss.str(),
+        "MeshTools::simplifyLodChain(): expected non-increasing ratios in range [0, 1] but got 0.7 at position 2\n"
+        "MeshTools::simplifyLodChain(): expected non-increasing ratios in range [0, 1] but got 1.5 at position 0\n");
+}
+
+void SimplifyTest::planar() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    grid(10, indices, positions, false);
+
+    std::vector<UnsignedInt> simplified;
+    Float error;
+    std::tie(simplified, error) = MeshTools::simplify(indices, positions, 12);
+
+    /* Planar mesh can be simplified without any error and without changing
+       the border */
+    CORRADE_VERIFY(simplified.size() <= 12);
+    CORRADE_COMPARE(error, 0.0f);
+    CORRADE_COMPARE(area(simplified, positions), 100.0f);
+}
+
+void SimplifyTest::lodChain() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    grid(16, indices, positions, true);
+
+    const std::vector<std::pair<std::vector<UnsignedInt>, Float>> levels =
+        MeshTools::simplifyLodChain(indices, positions, {1.0f, 0.5f, 0.25f, 0.1f});
+
+    CORRADE_COMPARE(levels.size(), 4);
+    CORRADE_VERIFY(levels[0].first == indices);
+    CORRADE_COMPARE(levels[0].second, 0.0f);
+    CORRADE_VERIFY(levels[1].first.size() <= 768);
+    CORRADE_VERIFY(levels[2].first.size() <= 384);
+    CORRADE_VERIFY(levels[3].first.size() <= 153);
+
+    /* Error grows with each level */
+    for(std::size_t i = 1; i != levels.size(); ++i) {
+        CORRADE_VERIFY(levels[i].second > 0.0f);
+        CORRADE_VERIFY(levels[i].second >= levels[i - 1].second);
+    }
+}
+
+void SimplifyTest::seam() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    grid(10, indices, positions, false, 5);
+
+    std::vector<UnsignedInt> simplified;
+    Float error;
+    std::tie(simplified, error) = MeshTools::simplify(indices, positions, 300);
+
+    CORRADE_VERIFY(simplified.size() <= 300);
+    CORRADE_COMPARE(error, 0.0f);
+    CORRADE_COMPARE(area(simplified, positions), 100.0f);
+
+    /* Vertices on both sides of the seam are kept */
+    std::vector<bool> used(positions.size(), false);
+    for(const UnsignedInt index: simplified) used[index] = true;
+    for(UnsignedInt y = 0; y <= 10; ++y) {
+        CORRADE_VERIFY(used[y*11 + 5]);
+        CORRADE_VERIFY(used[121 + y]);
+    }
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SimplifyTest)
@@ -0,0 +1,139 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/MeshTools/Skin.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct SkinTest: TestSuite::Tester {
+    explicit SkinTest();
+
+    void wrongCount();
+    void wrongNormalCount();
+    void indexOutOfBounds();
+
+    void singleJoint();
+    void blend();
+    void blendOppositeHemisphere();
+};
+
+SkinTest::SkinTest() {
+    addTests({&SkinTest::wrongCount,
+              &SkinTest::wrongNormalCount,
+              &SkinTest::indexOutOfBounds,
+
+              &SkinTest::singleJoint,
+              &SkinTest::blend,
+              &SkinTest::blendOppositeHemisphere});
+}
+
+void SkinTest::wrongCount() {
+    std::vector<Vector3> positions(3);
+
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    MeshTools::skinInPlace({DualQuaternion{}}, std::vector<Vector4ui>(3), std::vector<Vector4>(2), positions);
+    CORRADE_COMPARE(ss.str(), "MeshTools::skinInPlace(): expected 3 joint indices and weights but got 3 and 2\n");
+}
+
+void SkinTest::wrongNormalCount() {
+    std::vector<Vector3> positions(3);
+    std::vector<Vector3> normals(2);
+
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    MeshTools::skinInPlace({DualQuaternion{}}, std::vector<Vector4ui>(3), std::vector<Vector4>(3), positions, normals);
+    CORRADE_COMPARE(ss.str(), "MeshTools::skinInPlace(): expected 3 normals but got 2\n");
+}
+
+void SkinTest::indexOutOfBounds() {
+    std::vector<Vector3> positions(2);
+
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    MeshTools::skinInPlace({DualQuaternion{}, DualQuaternion{}},
+        {Vector4ui{0, 1, 0, 0}, Vector4ui{1, 0, 2, 0}},
+        {Vector4{1.0f, 0.0f, 0.0f, 0.0f}, Vector4{1.0f, 0.0f, 0.0f, 0.0f}}, positions);
+    CORRADE_COMPARE(ss.str(), "MeshTools::skinInPlace(): joint index 2 out of bounds for 2 joints\n");
+}
+
+void SkinTest::singleJoint() {
+    std::vector<Vector3> positions{{1.0f, 0.0f, 0.0f}, {0.0f, 2.0f, 0.0f}};
+    std::vector<Vector3> normals{Vector3::xAxis(), Vector3::yAxis()};
+
+    /* Second vertex is fully influenced by the second joint */
+    MeshTools::skinInPlace({
+        DualQuaternion::translation({0.0f, 0.0f, 3.0f}),
+        DualQuaternion::translation({1.0f, 0.0f, 0.0f})*DualQuaternion::rotation(Deg(90.0f), Vector3::zAxis())},
+        {Vector4ui{0, 0, 0, 0}, Vector4ui{1, 0, 0, 0}},
+        {Vector4{1.0f, 0.0f, 0.0f, 0.0f}, Vector4{1.0f, 0.0f, 0.0f, 0.0f}},
+        positions, normals);
+
+    CORRADE_COMPARE(positions[0], (Vector3{1.0f, 0.0f, 3.0f}));
+    CORRADE_COMPARE(positions[1], (Vector3{-1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(normals[0], Vector3::xAxis());
+    CORRADE_COMPARE(normals[1], -Vector3::xAxis());
+}
+
+void SkinTest::blend() {
+    std::vector<Vector3> positions{{1.0f, 0.0f, 0.0f}};
+    std::vector<Vector3> normals{Vector3::xAxis()};
+
+    /* Half-way between identity and 90° rotation is 45°, the point stays on
+       the unit circle unlike with linear matrix blending */
+    MeshTools::skinInPlace({
+        DualQuaternion{},
+        DualQuaternion::rotation(Deg(90.0f), Vector3::zAxis())},
+        {Vector4ui{0, 1, 0, 0}},
+        {Vector4{0.5f, 0.5f, 0.0f, 0.0f}},
+        positions, normals);
+
+    CORRADE_COMPARE(positions[0], (Vector3{Constants::sqrt2()*0.5f, Constants::sqrt2()*0.5f, 0.0f}));
+    CORRADE_COMPARE(normals[0], (Vector3{Constants::sqrt2()*0.5f, Constants::sqrt2()*0.5f, 0.0f}));
+}
+
+void SkinTest::blendOppositeHemisphere() {
+    std::vector<Vector3> positions{{1.0f, 0.0f, 0.0f}};
+
+    /* The negated rotation represents the same transformation, the result
+       should be the same as above */
+    const DualQuaternion rotation = DualQuaternion::rotation(Deg(90.0f), Vector3::zAxis());
+    MeshTools::skinInPlace({
+        DualQuaternion{},
+        DualQuaternion{-rotation.real(), -rotation.dual()}},
+        {Vector4ui{0, 1, 0, 0}},
+        {Vector4{0.5f, 0.5f, 0.0f, 0.0f}},
+        positions);
+
+    CORRADE_COMPARE(positions[0], (Vector3{Constants::sqrt2()*0.5f, Constants::sqrt2()*0.5f, 0.0f}));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SkinTest)
@@ -23,62 +23,159 @@
     DEALINGS IN THE SOFTWARE.
 */
 
-#include "SubdivideRemoveDuplicatesBenchmark.h"
+#include <Corrade/TestSuite/Tester.h>
 
-#include <QtTest/QTest>
-
-#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Duplicate.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/MeshTools/Subdivide.h"
-
-QTEST_APPLESS_MAIN(Magnum::MeshTools::Test::SubdivideRemoveDuplicatesBenchmark)
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Test/BenchmarkTimer.h"
+#include "Magnum/Trade/MeshData3D.h"
 
 namespace Magnum { namespace MeshTools { namespace Test {
 
+struct SubdivideRemoveDuplicatesBenchmark: TestSuite::Tester {
+    explicit SubdivideRemoveDuplicatesBenchmark();
+
+    void subdivide();
+    void subdivideAndRemoveDuplicatesMeshAfter();
+    void subdivideAndRemoveDuplicatesMeshBetween();
+    void subdivideShared();
+    void subdivideLoop();
+};
+
+namespace {
+
+constexpr std::size_t Subdivisions = 5;
+constexpr std::size_t Iterations = 10;
+
+/* Vertex count of an icosphere with five subdivisions */
+constexpr std::size_t UniqueVertexCount = 10242;
+
+Vector3 interpolator(const Vector3& a, const Vector3& b) {
+    return (a+b).normalized();
+}
+
+}
+
+SubdivideRemoveDuplicatesBenchmark::SubdivideRemoveDuplicatesBenchmark() {
+    addTests({&SubdivideRemoveDuplicatesBenchmark::subdivide,
+              &SubdivideRemoveDuplicatesBenchmark::subdivideAndRemoveDuplicatesMeshAfter,
+              &SubdivideRemoveDuplicatesBenchmark::subdivideAndRemoveDuplicatesMeshBetween,
+              &SubdivideRemoveDuplicatesBenchmark::subdivideShared,
+              &SubdivideRemoveDuplicatesBenchmark::subdivideLoop});
+}
+
 void SubdivideRemoveDuplicatesBenchmark::subdivide() {
-    QBENCHMARK {
-        Primitives::Icosphere<0> icosphere;
-
-        /* Subdivide 5 times */
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
+    /* Icosahedron */
+    const Trade::MeshData3D icosahedron = Primitives::Icosphere::solid(0);
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+
+    Magnum::Test::BenchmarkTimer timer{Iterations};
+    timer.start();
+    for(std::size_t i = 0; i != Iterations; ++i) {
+        indices = icosahedron.indices();
+        positions = icosahedron.positions(0);
+
+        for(std::size_t j = 0; j != Subdivisions; ++j)
+            MeshTools::subdivide(indices, positions, interpolator);
     }
+    timer.stop();
+    const Double time = timer.milliseconds();
+
+    CORRADE_VERIFY(positions.size() > UniqueVertexCount);
+    Debug() << "    subdivide():" << time << "ms," << positions.size() << "vertices";
 }
 
 void SubdivideRemoveDuplicatesBenchmark::subdivideAndRemoveDuplicatesMeshAfter() {
-    QBENCHMARK {
-        Primitives::Icosphere<0> icosphere;
+    const Trade::MeshData3D icosahedron = Primitives::Icosphere::solid(0);
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+
+    Magnum::Test::BenchmarkTimer timer{Iterations};
+    timer.start();
+    for(std::size_t i = 0; i != Iterations; ++i) {
+        indices = icosahedron.indices();
+        positions = icosahedron.positions(0);
+
+        for(std::size_t j = 0; j != Subdivisions; ++j)
+            MeshTools::subdivide(indices, positions, interpolator);
+        indices = MeshTools::duplicate(indices, MeshTools::removeDuplicates(positions));
+    }
+    timer.stop();
+    const Double time = timer.milliseconds();
 
-        /* Subdivide 5 times */
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
+    CORRADE_COMPARE(positions.size(), UniqueVertexCount);
+    Debug() << "    subdivide(), removeDuplicates() after:" << time << "ms";
+}
 
-        MeshTools::removeDuplicates(*icosphere.indices(), *icosphere.positions(0));
+void SubdivideRemoveDuplicatesBenchmark::subdivideAndRemoveDuplicatesMeshBetween() {
+    const Trade::MeshData3D icosahedron = Primitives::Icosphere::solid(0);
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+
+    Magnum::Test::BenchmarkTimer timer{Iterations};
+    timer.start();
+    for(std::size_t i = 0; i != Iterations; ++i) {
+        indices = icosahedron.indices();
+        positions = icosahedron.positions(0);
+
+        for(std::size_t j = 0; j != Subdivisions; ++j) {
+            MeshTools::subdivide(indices, positions, interpolator);
+            indices = MeshTools::duplicate(indices, MeshTools::removeDuplicates(positions));
+        }
     }
+    timer.stop();
+    const Double time = timer.milliseconds();
+
+    CORRADE_COMPARE(positions.size(), UniqueVertexCount);
+    Debug() << "    subdivide(), removeDuplicates() between:" << time << "ms";
 }
 
-void SubdivideRemoveDuplicatesBenchmark::subdivideAndRemoveDuplicatesMeshBetween() {
-    QBENCHMARK {
-        Primitives::Icosphere<0> icosphere;
-
-        /* Subdivide 5 times */
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::removeDuplicates(*icosphere.indices(), *icosphere.positions(0));
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::removeDuplicates(*icosphere.indices(), *icosphere.positions(0));
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::removeDuplicates(*icosphere.indices(), *icosphere.positions(0));
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::removeDuplicates(*icosphere.indices(), *icosphere.positions(0));
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::removeDuplicates(*icosphere.indices(), *icosphere.positions(0));
+void SubdivideRemoveDuplicatesBenchmark::subdivideShared() {
+    const Trade::MeshData3D icosahedron = Primitives::Icosphere::solid(0);
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+
+    Magnum::Test::BenchmarkTimer timer{Iterations};
+    timer.start();
+    for(std::size_t i = 0; i != Iterations; ++i) {
+        indices = icosahedron.indices();
+        positions = icosahedron.positions(0);
+
+        for(std::size_t j = 0; j != Subdivisions; ++j)
+            MeshTools::subdivideShared(indices, positions, interpolator);
     }
+    timer.stop();
+    const Double time = timer.milliseconds();
+
+    CORRADE_COMPARE(positions.size(), UniqueVertexCount);
+    Debug() << "    subdivideShared():" << time << "ms";
+}
+
+void SubdivideRemoveDuplicatesBenchmark::subdivideLoop() {
+    const Trade::MeshData3D icosahedron = Primitives::Icosphere::solid(0);
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+
+    Magnum::Test::BenchmarkTimer timer{Iterations};
+    timer.start();
+    for(std::size_t i = 0; i != Iterations; ++i) {
+        indices = icosahedron.indices();
+        positions = icosahedron.positions(0);
+
+        for(std::size_t j = 0; j != Subdivisions; ++j)
+            MeshTools::subdivideLoop(indices, positions);
+    }
+    timer.stop();
+    const Double time = timer.milliseconds();
+
+    CORRADE_COMPARE(positions.size(), UniqueVertexCount);
+    Debug() << "    subdivideLoop():" << time << "ms";
 }
 
 }}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SubdivideRemoveDuplicatesBenchmark)
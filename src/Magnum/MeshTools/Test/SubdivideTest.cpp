@@ -26,6 +26,7 @@
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 
+#include "Magnum/Math/Vector3.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/MeshTools/Subdivide.h"
 
@@ -36,6 +37,9 @@ struct SubdivideTest: TestSuite::Tester {
 
     void wrongIndexCount();
     void subdivide();
+    void subdivideShared();
+    void subdivideLoop();
+    void subdivideLoopClosed();
 };
 
 namespace {
@@ -48,7 +52,10 @@ inline Vector1 interpolator(Vector1 a, Vector1 b) { return (a[0]+b[0])/2; }
 
 SubdivideTest::SubdivideTest() {
     addTests({&SubdivideTest::wrongIndexCount,
-              &SubdivideTest::subdivide});
+              &SubdivideTest::subdivide,
+              &SubdivideTest::subdivideShared,
+              &SubdivideTest::subdivideLoop,
+              &SubdivideTest::subdivideLoopClosed});
 }
 
 void SubdivideTest::wrongIndexCount() {
@@ -58,7 +65,13 @@ void SubdivideTest::wrongIndexCount() {
     std::vector<Vector1> positions;
     std::vector<UnsignedInt> indices{0, 1};
     MeshTools::subdivide(indices, positions, interpolator);
-    CORRADE_COMPARE(ss.str(), "MeshTools::subdivide(): index count is not divisible by 3!\n");
+    MeshTools::subdivideShared(indices, positions, interpolator);
+    std::vector<Vector2> loopPositions;
+    MeshTools::subdivideLoop(indices, loopPositions);
+    CORRADE_COMPARE(ss.str(),
+        "MeshTools::subdivide(): index count is not divisible by 3!\n"
+        "MeshTools::subdivideShared(): index count is not divisible by 3!\n"
+        "MeshTools::subdivideLoop(): index count is not divisible by 3!\n");
 }
 
 void SubdivideTest::subdivide() {
@@ -72,6 +85,53 @@ void SubdivideTest::subdivide() {
     CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{4, 5, 6, 7, 8, 9, 0, 4, 6, 4, 1, 5, 6, 5, 2, 1, 7, 9, 7, 2, 8, 9, 8, 3}));
 }
 
+void SubdivideTest::subdivideShared() {
+    std::vector<Vector1> positions{0, 2, 6, 8};
+    std::vector<UnsignedInt> indices{0, 1, 2, 1, 2, 3};
+    MeshTools::subdivideShared(indices, positions, interpolator);
+
+    /* The shared edge is split just once */
+    CORRADE_VERIFY(positions == (std::vector<Vector1>{0, 2, 6, 8, 1, 4, 3, 7, 5}));
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{4, 5, 6, 5, 7, 8, 0, 4, 6, 4, 1, 5, 6, 5, 2, 1, 5, 8, 5, 2, 7, 8, 7, 3}));
+}
+
+void SubdivideTest::subdivideLoop() {
+    /* Square made of two triangles, everything except the diagonal is
+       boundary */
+    std::vector<Vector2> positions{{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}};
+    std::vector<UnsignedInt> indices{0, 1, 2, 0, 2, 3};
+    MeshTools::subdivideLoop(indices, positions);
+
+    CORRADE_COMPARE(positions.size(), 9);
+    CORRADE_COMPARE(positions[0], (Vector2{0.125f, 0.125f}));
+    CORRADE_COMPARE(positions[1], (Vector2{0.875f, 0.125f}));
+    CORRADE_COMPARE(positions[2], (Vector2{0.875f, 0.875f}));
+    CORRADE_COMPARE(positions[3], (Vector2{0.125f, 0.875f}));
+    CORRADE_COMPARE(positions[4], (Vector2{0.5f, 0.0f}));
+    CORRADE_COMPARE(positions[5], (Vector2{1.0f, 0.5f}));
+    /* Interior edge */
+    CORRADE_COMPARE(positions[6], (Vector2{0.5f, 0.5f}));
+    CORRADE_COMPARE(positions[7], (Vector2{0.5f, 1.0f}));
+    CORRADE_COMPARE(positions[8], (Vector2{0.0f, 0.5f}));
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{4, 5, 6, 6, 7, 8, 0, 4, 6, 4, 1, 5, 6, 5, 2, 0, 6, 8, 6, 2, 7, 8, 7, 3}));
+}
+
+void SubdivideTest::subdivideLoopClosed() {
+    /* Octahedron, each vertex has four neighbors */
+    std::vector<Vector3> positions{
+        Vector3::xAxis(), Vector3::yAxis(), Vector3::zAxis(),
+        -Vector3::xAxis(), -Vector3::yAxis(), -Vector3::zAxis()};
+    std::vector<UnsignedInt> indices{
+        0, 1, 2, 1, 3, 2, 3, 4, 2, 4, 0, 2,
+        1, 0, 5, 3, 1, 5, 4, 3, 5, 0, 4, 5};
+    MeshTools::subdivideLoop(indices, positions);
+
+    CORRADE_COMPARE(positions.size(), 18);
+    CORRADE_COMPARE(indices.size(), 96);
+    CORRADE_COMPARE(positions[0], (Vector3{0.625f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(positions[6], (Vector3{0.375f, 0.375f, 0.0f}));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SubdivideTest)
@@ -38,13 +38,16 @@
 namespace Magnum {
 
 void MeshView::draw(AbstractShaderProgram& shader, std::initializer_list<std::reference_wrapper<MeshView>> meshes) {
-    /* Why std::initializer_list doesn't have empty()? */
+    draw(shader, Containers::ArrayView<const std::reference_wrapper<MeshView>>{meshes.begin(), meshes.size()});
+}
+
+void MeshView::draw(AbstractShaderProgram& shader, Containers::ArrayView<const std::reference_wrapper<MeshView>> meshes) {
     if(!meshes.size()) return;
 
     shader.use();
 
     #ifndef CORRADE_NO_ASSERT
-    const Mesh* original = &meshes.begin()->get()._original.get();
+    const Mesh* original = &meshes[0].get()._original.get();
     for(MeshView& mesh: meshes)
         CORRADE_ASSERT(&mesh._original.get() == original, "MeshView::draw(): all meshes must be views of the same original mesh", );
     #endif
@@ -57,12 +60,12 @@ void MeshView::draw(AbstractShaderProgram& shader, std::initializer_list<std::re
 }
 
 #ifndef MAGNUM_TARGET_WEBGL
-void MeshView::multiDrawImplementationDefault(std::initializer_list<std::reference_wrapper<MeshView>> meshes) {
+void MeshView::multiDrawImplementationDefault(Containers::ArrayView<const std::reference_wrapper<MeshView>> meshes) {
     CORRADE_INTERNAL_ASSERT(meshes.size());
 
     const Implementation::MeshState& state = *Context::current()->state().mesh;
 
-    Mesh& original = meshes.begin()->get()._original;
+    Mesh& original = meshes[0].get()._original;
     Containers::Array<GLsizei> count{meshes.size()};
     Containers::Array<GLvoid*> indices{meshes.size()};
     Containers::Array<GLint> baseVertex{meshes.size()};
@@ -128,7 +131,7 @@ void MeshView::multiDrawImplementationDefault(std::initializer_list<std::referen
 #endif
 
 #ifdef MAGNUM_TARGET_GLES
-void MeshView::multiDrawImplementationFallback(std::initializer_list<std::reference_wrapper<MeshView>> meshes) {
+void MeshView::multiDrawImplementationFallback(Containers::ArrayView<const std::reference_wrapper<MeshView>> meshes) {
     for(MeshView& mesh: meshes) {
         #ifndef MAGNUM_TARGET_GLES2
         mesh._original.get().drawInternal(mesh._count, mesh._baseVertex, mesh._instanceCount, mesh._indexOffset, mesh._indexStart, mesh._indexEnd);
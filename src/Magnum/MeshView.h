@@ -31,6 +31,7 @@
 
 #include <functional>
 #include <initializer_list>
+#include <Corrade/Containers/ArrayView.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/OpenGL.h"
@@ -87,6 +88,20 @@ class MAGNUM_EXPORT MeshView {
             draw(shader, meshes);
         }
 
+        /**
+         * @brief Draw multiple meshes at once
+         *
+         * Same as @ref draw(AbstractShaderProgram&, std::initializer_list<std::reference_wrapper<MeshView>>),
+         * but useful when the mesh count is known only at runtime, for
+         * example when drawing ranges produced by @ref MeshTools::batch().
+         */
+        static void draw(AbstractShaderProgram& shader, Containers::ArrayView<const std::reference_wrapper<MeshView>> meshes);
+
+        /** @overload */
+        static void draw(AbstractShaderProgram&& shader, Containers::ArrayView<const std::reference_wrapper<MeshView>> meshes) {
+            draw(shader, meshes);
+        }
+
         /**
          * @brief Constructor
          * @param original  Original, already configured mesh
@@ -210,9 +225,9 @@ class MAGNUM_EXPORT MeshView {
 
     private:
         #ifndef MAGNUM_TARGET_WEBGL
-        static MAGNUM_LOCAL void multiDrawImplementationDefault(std::initializer_list<std::reference_wrapper<MeshView>> meshes);
+        static MAGNUM_LOCAL void multiDrawImplementationDefault(Containers::ArrayView<const std::reference_wrapper<MeshView>> meshes);
         #endif
-        static MAGNUM_LOCAL void multiDrawImplementationFallback(std::initializer_list<std::reference_wrapper<MeshView>> meshes);
+        static MAGNUM_LOCAL void multiDrawImplementationFallback(Containers::ArrayView<const std::reference_wrapper<MeshView>> meshes);
 
         std::reference_wrapper<Mesh> _original;
 
@@ -201,7 +201,21 @@ template<UnsignedInt dimensions, class T> class AbstractObject
          *      when possible.
          */
         std::vector<MatrixType> transformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, const MatrixType& initialTransformationMatrix = MatrixType()) const {
-            return doTransformationMatrices(objects, initialTransformationMatrix);
+            std::vector<MatrixType> transformationMatrices;
+            doTransformationMatrices(objects, transformationMatrices, initialTransformationMatrix);
+            return transformationMatrices;
+        }
+
+        /**
+         * @brief Transformation matrices of given set of objects relative to this object into existing storage
+         *
+         * Same as above, but the matrices are written into
+         * @p transformationMatrices, which is resized to size of @p objects.
+         * Reusing the same vector avoids allocating new storage on every
+         * call.
+         */
+        void transformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, std::vector<MatrixType>& transformationMatrices, const MatrixType& initialTransformationMatrix = MatrixType()) const {
+            doTransformationMatrices(objects, transformationMatrices, initialTransformationMatrix);
         }
 
         /*@}*/
@@ -263,6 +277,18 @@ template<UnsignedInt dimensions, class T> class AbstractObject
          */
         void setClean() { doSetClean(); }
 
+        /**
+         * @brief Clean all dirty objects in the scene
+         * @return Count of cleaned objects
+         *
+         * Calls @ref Scene::cleanDirty() on the scene containing this
+         * object, which cleans all dirty objects in it at once. If the
+         * object is not part of any scene, it is cleaned using
+         * @ref setClean() and `1` is returned if it was dirty.
+         * @see @ref scene()
+         */
+        std::size_t cleanDirtyScene() { return doCleanDirtyScene(); }
+
         /*@}*/
 
     private:
@@ -271,12 +297,13 @@ template<UnsignedInt dimensions, class T> class AbstractObject
 
         virtual MatrixType doTransformationMatrix() const = 0;
         virtual MatrixType doAbsoluteTransformationMatrix() const = 0;
-        virtual std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, const MatrixType& initialTransformationMatrix) const = 0;
+        virtual void doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, std::vector<MatrixType>& transformationMatrices, const MatrixType& initialTransformationMatrix) const = 0;
 
         virtual bool doIsDirty() const = 0;
         virtual void doSetDirty() = 0;
         virtual void doSetClean() = 0;
         virtual void doSetClean(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects) = 0;
+        virtual std::size_t doCleanDirtyScene() = 0;
 };
 
 /**
@@ -123,13 +123,18 @@ void MyApplication::drawEvent() {
 }
 @endcode
 
-## Using multiple animable groups to improve performance
+## Performance considerations
 
-@ref AnimableGroup is optimized for case when no animation is running -- it
-just puts itself to rest and waits until some animation changes its state to
-@ref AnimationState::Running again. If you put animations which are not
-pernamently running into separate group, they will not be traversed every time
-the @ref AnimableGroup::step() gets called, saving precious frame time.
+@ref AnimableGroup keeps a list of animables which are running or have
+pending state change and @ref AnimableGroup::step() goes only through these,
+so stopped and paused animations don't cost anything, no matter how many of
+them are in the group.
+
+If @ref animationStep() implementation doesn't access any data shared with
+other animables (e.g. it only modifies transformation of its own object,
+which doesn't have any caching features), it can be marked as thread-safe
+using @ref setThreadSafe(). The group then calls it from multiple threads if
+enabled with @ref AnimableGroup::setThreadCount().
 
 ## Explicit template specializations
 
@@ -220,6 +225,13 @@ template<UnsignedInt dimensions, class T> class Animable: public AbstractGrouped
             return *this;
         }
 
+        /**
+         * @brief Whether the animation step is thread-safe
+         *
+         * @see @ref setThreadSafe()
+         */
+        bool isThreadSafe() const { return _threadSafe; }
+
         /**
          * @brief Group containing this animable
          *
@@ -242,6 +254,23 @@ template<UnsignedInt dimensions, class T> class Animable: public AbstractGrouped
             return *this;
         }
 
+        /**
+         * @brief Mark the animation step as thread-safe
+         * @return Reference to self (for method chaining)
+         *
+         * If set to `true`, @ref animationStep() can be called from another
+         * thread concurrently with other thread-safe animables in the same
+         * group, see @ref AnimableGroup::setThreadCount(). State change
+         * callbacks are always called from the thread calling
+         * @ref AnimableGroup::step(). A thread-safe animation step must not
+         * add, remove or delete any animables. Default is `false`.
+         */
+        /* Protected so only animation implementer can change it */
+        Animable<dimensions, T>& setThreadSafe(bool threadSafe) {
+            _threadSafe = threadSafe;
+            return *this;
+        }
+
         /**
          * @brief Perform animation step
          * @param time      Time from start of the animation
@@ -314,13 +343,17 @@ template<UnsignedInt dimensions, class T> class Animable: public AbstractGrouped
         virtual void animationStopped() {}
 
     private:
+        void MAGNUM_SCENEGRAPH_LOCAL removeFromActiveList();
+
         Float _duration;
         Float startTime, pauseTime;
         AnimationState previousState;
         AnimationState currentState;
-        bool _repeated;
+        bool _repeated, _threadSafe;
         UnsignedShort _repeatCount;
         UnsignedShort repeats;
+        AnimableGroup<dimensions, T>* activeGroup;
+        std::size_t activeIndex;
 };
 
 /**
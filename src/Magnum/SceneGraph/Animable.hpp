@@ -30,15 +30,24 @@
  */
 
 #include "Magnum/Timeline.h"
+#include "Magnum/Implementation/parallelFor.h"
 #include "Magnum/Math/Constants.h"
 #include "Magnum/SceneGraph/AnimableGroup.h"
 #include "Magnum/SceneGraph/Animable.h"
 
 namespace Magnum { namespace SceneGraph {
 
-template<UnsignedInt dimensions, class T> Animable<dimensions, T>::Animable(AbstractObject<dimensions, T>& object, AnimableGroup<dimensions, T>* group): AbstractGroupedFeature<dimensions, Animable<dimensions, T>, T>(object, group), _duration(0.0f), startTime(Constants::inf()), pauseTime(-Constants::inf()), previousState(AnimationState::Stopped), currentState(AnimationState::Stopped), _repeated(false), _repeatCount(0), repeats(0) {}
+template<UnsignedInt dimensions, class T> Animable<dimensions, T>::Animable(AbstractObject<dimensions, T>& object, AnimableGroup<dimensions, T>* group): AbstractGroupedFeature<dimensions, Animable<dimensions, T>, T>(object, nullptr), _duration(0.0f), startTime(Constants::inf()), pauseTime(-Constants::inf()), previousState(AnimationState::Stopped), currentState(AnimationState::Stopped), _repeated(false), _threadSafe(false), _repeatCount(0), repeats(0), activeGroup(nullptr), activeIndex(0) {
+    /* Adding to the group only after all members are initialized, as the
+       group bookkeeping needs them */
+    if(group) group->add(*this);
+}
 
-template<UnsignedInt dimensions, class T> Animable<dimensions, T>::~Animable() {}
+template<UnsignedInt dimensions, class T> Animable<dimensions, T>::~Animable() {
+    /* Removing from the group while the animable is still complete, so the
+       group can update its bookkeeping */
+    if(animables()) animables()->remove(*this);
+}
 
 template<UnsignedInt dimensions, class T> Animable<dimensions, T>& Animable<dimensions, T>::setState(AnimationState state) {
     if(currentState == state) return *this;
@@ -47,9 +56,9 @@ template<UnsignedInt dimensions, class T> Animable<dimensions, T>& Animable<dime
     if(previousState == AnimationState::Stopped && state == AnimationState::Paused)
         return *this;
 
-    /* Wake up the group in case no animations are running */
-    animables()->wakeUp = true;
+    /* Make sure the group processes the state change in next step */
     currentState = state;
+    if(animables()) animables()->addToActiveList(*this);
     return *this;
 }
 
@@ -61,79 +70,187 @@ template<UnsignedInt dimensions, class T> const AnimableGroup<dimensions, T>* An
     return static_cast<const AnimableGroup<dimensions, T>*>(AbstractGroupedFeature<dimensions, Animable<dimensions, T>, T>::group());
 }
 
+template<UnsignedInt dimensions, class T> void Animable<dimensions, T>::removeFromActiveList() {
+    if(!activeGroup) return;
+    activeGroup->_active[activeIndex] = nullptr;
+    activeGroup = nullptr;
+}
+
+template<UnsignedInt dimensions, class T> AnimableGroup<dimensions, T>::AnimableGroup(): _runningCount(0), _threadCount(1) {}
+
+template<UnsignedInt dimensions, class T> AnimableGroup<dimensions, T>::~AnimableGroup() {
+    for(Animable<dimensions, T>* animable: _active)
+        if(animable) animable->activeGroup = nullptr;
+}
+
+template<UnsignedInt dimensions, class T> AnimableGroup<dimensions, T>& AnimableGroup<dimensions, T>::setThreadCount(const UnsignedInt count) {
+    #ifdef MAGNUM_BUILD_MULTITHREADED
+    /* The pool gets recreated with the new count on next parallel step */
+    if(count != _threadCount) _workerPool = nullptr;
+    #endif
+    _threadCount = count;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::featureAdded(Animable<dimensions, T>& animable) {
+    if(animable.previousState == AnimationState::Running) ++_runningCount;
+
+    /* Running animation or animation with pending state change */
+    if(animable.currentState == AnimationState::Running || animable.previousState != animable.currentState)
+        addToActiveList(animable);
+}
+
+template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::featureRemoved(Animable<dimensions, T>& animable) {
+    if(animable.previousState == AnimationState::Running) --_runningCount;
+    animable.removeFromActiveList();
+
+    /* The animable might be removed or deleted from a callback in step()
+       after its thread-safe step was deferred, don't execute it */
+    for(std::pair<Animable<dimensions, T>*, Float>& parallelStep: _parallelSteps)
+        if(parallelStep.first == &animable) parallelStep.first = nullptr;
+}
+
+template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::addToActiveList(Animable<dimensions, T>& animable) {
+    /* Already there */
+    if(animable.activeGroup == this) return;
+
+    animable.removeFromActiveList();
+    animable.activeGroup = this;
+    animable.activeIndex = _active.size();
+    _active.push_back(&animable);
+}
+
 template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::step(const Float time, const Float delta) {
-    if(!_runningCount && !wakeUp) return;
-    wakeUp = false;
+    /* Nothing is running and nothing changed state */
+    if(_active.empty()) return;
 
-    for(std::size_t i = 0; i != AnimableGroup<dimensions, T>::size(); ++i) {
-        Animable<dimensions, T>& animable = (*this)[i];
+    /* Go through the active list and compact it in place. Animables added
+       to the list in callbacks are appended after the original range and
+       processed only in the next step, so an animable which was removed and
+       added back after it was already processed isn't stepped twice. */
+    const std::size_t count = _active.size();
+    std::size_t out = 0;
+    for(std::size_t i = 0; i != count; ++i) {
+        Animable<dimensions, T>* const animable = _active[i];
 
-        /* The animation was stopped recently, just decrease count of running
-           animations if the animation was running before */
-        if(animable.previousState != AnimationState::Stopped && animable.currentState == AnimationState::Stopped) {
-            if(animable.previousState == AnimationState::Running)
-                --_runningCount;
-            animable.previousState = AnimationState::Stopped;
-            animable.animationStopped();
+        /* Removed from the list */
+        if(!animable) continue;
+
+        stepInternal(*animable, time, delta);
+
+        /* The animable was removed or deleted in a state change callback */
+        if(!_active[i]) continue;
+
+        /* The animable is not running and its state wasn't changed in any
+           callback, remove it from the list */
+        if(animable->currentState != AnimationState::Running && animable->previousState == animable->currentState) {
+            animable->activeGroup = nullptr;
             continue;
+        }
+
+        animable->activeIndex = out;
+        _active[out++] = animable;
+    }
+
+    /* Move the animables added during the step after the compacted ones */
+    for(std::size_t i = count; i != _active.size(); ++i) {
+        Animable<dimensions, T>* const animable = _active[i];
+        if(!animable) continue;
+
+        animable->activeIndex = out;
+        _active[out++] = animable;
+    }
+    _active.resize(out);
+
+    /* Perform deferred thread-safe animation steps. Animables removed from
+       the group in the meantime have their entries set to null. */
+    if(!_parallelSteps.empty()) {
+        auto parallelStep = [this, delta](std::size_t begin, std::size_t end) {
+            for(std::size_t i = begin; i != end; ++i)
+                if(_parallelSteps[i].first)
+                    _parallelSteps[i].first->animationStep(_parallelSteps[i].second, delta);
+        };
+
+        #ifdef MAGNUM_BUILD_MULTITHREADED
+        if(!_workerPool) _workerPool.reset(new Magnum::Implementation::WorkerPool{_threadCount});
+        _workerPool->run(_parallelSteps.size(), parallelStep);
+        #else
+        parallelStep(0, _parallelSteps.size());
+        #endif
+        _parallelSteps.clear();
+    }
+
+    CORRADE_INTERNAL_ASSERT((_runningCount <= AnimableGroup<dimensions, T>::size()));
+}
 
-        /* The animation was paused recently, set pause time to previous frame time */
-        } else if(animable.previousState == AnimationState::Running && animable.currentState == AnimationState::Paused) {
-            animable.previousState = AnimationState::Paused;
-            animable.pauseTime = time;
+template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::stepInternal(Animable<dimensions, T>& animable, const Float time, const Float delta) {
+    /* The animation was stopped recently, just decrease count of running
+       animations if the animation was running before */
+    if(animable.previousState != AnimationState::Stopped && animable.currentState == AnimationState::Stopped) {
+        if(animable.previousState == AnimationState::Running)
             --_runningCount;
-            animable.animationPaused();
-            continue;
+        animable.previousState = AnimationState::Stopped;
+        animable.animationStopped();
+        return;
 
-        /* Skip the rest for not running animations */
-        } else if(animable.currentState != AnimationState::Running) {
-            CORRADE_INTERNAL_ASSERT(animable.previousState == animable.currentState);
-            continue;
+    /* The animation was paused recently, set pause time to previous frame time */
+    } else if(animable.previousState == AnimationState::Running && animable.currentState == AnimationState::Paused) {
+        animable.previousState = AnimationState::Paused;
+        animable.pauseTime = time;
+        --_runningCount;
+        animable.animationPaused();
+        return;
 
-        /* The animation was started recently, set start time to previous frame
-           time, reset repeat count */
-        } else if(animable.previousState == AnimationState::Stopped) {
-            animable.previousState = AnimationState::Running;
-            animable.startTime = time;
-            animable.repeats = 0;
-            ++_runningCount;
-            animable.animationStarted();
-
-        /* The animation was resumed recently, add pause duration to start time */
-        } else if(animable.previousState == AnimationState::Paused) {
-            animable.previousState = AnimationState::Running;
-            animable.startTime += time - animable.pauseTime;
-            ++_runningCount;
-            animable.animationResumed();
-        }
+    /* Skip the rest for not running animations */
+    } else if(animable.currentState != AnimationState::Running) {
+        CORRADE_INTERNAL_ASSERT(animable.previousState == animable.currentState);
+        return;
+
+    /* The animation was started recently, set start time to previous frame
+       time, reset repeat count */
+    } else if(animable.previousState == AnimationState::Stopped) {
+        animable.previousState = AnimationState::Running;
+        animable.startTime = time;
+        animable.repeats = 0;
+        ++_runningCount;
+        animable.animationStarted();
+
+    /* The animation was resumed recently, add pause duration to start time */
+    } else if(animable.previousState == AnimationState::Paused) {
+        animable.previousState = AnimationState::Running;
+        animable.startTime += time - animable.pauseTime;
+        ++_runningCount;
+        animable.animationResumed();
+    }
 
-        CORRADE_INTERNAL_ASSERT(animable.previousState == AnimationState::Running);
-
-        /* Animation time exceeded duration */
-        if(animable._duration != 0.0f && time-animable.startTime > animable._duration) {
-            /* Not repeated or repeat count exceeded, stop */
-            if(!animable._repeated || animable.repeats+1 == animable._repeatCount) {
-                animable.previousState = AnimationState::Stopped;
-                animable.currentState = AnimationState::Stopped;
-                --_runningCount;
-                animable.animationStopped();
-                continue;
-            }
-
-            /* Increase repeat count and add duration to startTime */
-            ++animable.repeats;
-            animable.startTime += animable._duration;
+    CORRADE_INTERNAL_ASSERT(animable.previousState == AnimationState::Running);
+
+    /* Animation time exceeded duration */
+    if(animable._duration != 0.0f && time-animable.startTime > animable._duration) {
+        /* Not repeated or repeat count exceeded, stop */
+        if(!animable._repeated || animable.repeats+1 == animable._repeatCount) {
+            animable.previousState = AnimationState::Stopped;
+            animable.currentState = AnimationState::Stopped;
+            --_runningCount;
+            animable.animationStopped();
+            return;
         }
 
-        /* Animation is still running, perform animation step */
-        CORRADE_ASSERT(time-animable.startTime >= 0.0f,
-            "SceneGraph::AnimableGroup::step(): animation was started in future - probably wrong time passed", );
-        CORRADE_ASSERT(delta >= 0.0f,
-            "SceneGraph::AnimableGroup::step(): negative delta passed", );
-        animable.animationStep(time - animable.startTime, delta);
+        /* Increase repeat count and add duration to startTime */
+        ++animable.repeats;
+        animable.startTime += animable._duration;
     }
 
-    CORRADE_INTERNAL_ASSERT((_runningCount <= AnimableGroup<dimensions, T>::size()));
+    /* Animation is still running, perform animation step */
+    CORRADE_ASSERT(time-animable.startTime >= 0.0f,
+        "SceneGraph::AnimableGroup::step(): animation was started in future - probably wrong time passed", );
+    CORRADE_ASSERT(delta >= 0.0f,
+        "SceneGraph::AnimableGroup::step(): negative delta passed", );
+
+    /* Defer thread-safe steps if running in parallel */
+    if(_threadCount != 1 && animable._threadSafe)
+        _parallelSteps.emplace_back(&animable, time - animable.startTime);
+    else animable.animationStep(time - animable.startTime, delta);
 }
 
 }}
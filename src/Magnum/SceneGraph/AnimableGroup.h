@@ -29,10 +29,19 @@
  * @brief Class @ref Magnum::SceneGraph::AnimableGroup, alias @ref Magnum::SceneGraph::BasicAnimableGroup2D, @ref Magnum::SceneGraph::BasicAnimableGroup3D, typedef @ref Magnum::SceneGraph::AnimableGroup2D, @ref Magnum::SceneGraph::AnimableGroup3D
  */
 
+#include <memory>
+#include <utility>
+
 #include "Magnum/SceneGraph/FeatureGroup.h"
 #include "Magnum/SceneGraph/visibility.h"
 
-namespace Magnum { namespace SceneGraph {
+namespace Magnum {
+
+#ifdef MAGNUM_BUILD_MULTITHREADED
+namespace Implementation { class WorkerPool; }
+#endif
+
+namespace SceneGraph {
 
 /**
 @brief Group of animables
@@ -48,7 +57,15 @@ template<UnsignedInt dimensions, class T> class AnimableGroup: public FeatureGro
         /**
          * @brief Constructor
          */
-        explicit AnimableGroup(): _runningCount(0), wakeUp(false) {}
+        explicit AnimableGroup();
+
+        /**
+         * @brief Destructor
+         *
+         * Removes all animables belonging to this group, but not deletes
+         * them.
+         */
+        ~AnimableGroup();
 
         /**
          * @brief Count of running animations
@@ -57,19 +74,56 @@ template<UnsignedInt dimensions, class T> class AnimableGroup: public FeatureGro
          */
         std::size_t runningCount() const { return _runningCount; }
 
+        /**
+         * @brief Thread count
+         *
+         * @see @ref setThreadCount()
+         */
+        UnsignedInt threadCount() const { return _threadCount; }
+
+        /**
+         * @brief Set thread count for parallel animation steps
+         * @return Reference to self (for method chaining)
+         *
+         * If set to value other than `1`, @ref Animable::animationStep() of
+         * all running animables marked with @ref Animable::setThreadSafe()
+         * is called from up to @p count threads after all other animables
+         * in the group are processed. `0` means thread count equal to
+         * hardware concurrency. The worker threads are created on first
+         * parallel step and kept alive until the thread count is changed or
+         * the group is destroyed. Has no effect if Magnum is built without
+         * multithreading support. Default is `1`.
+         */
+        AnimableGroup<dimensions, T>& setThreadCount(UnsignedInt count);
+
         /**
          * @brief Perform animation step
          * @param time      Absolute time (e.g. @ref Timeline::previousFrameTime())
          * @param delta     Time delta for current frame (e.g. @ref Timeline::previousFrameDuration())
          *
-         * If there are no running animations the function does nothing.
-         * @see @ref runningCount()
+         * Goes only through animables which are running or have their state
+         * changed since last step. If there are no such animations, the
+         * function does nothing. Animables added to the group or changing
+         * state from callbacks called during the step are processed in the
+         * next step.
+         * @see @ref runningCount(), @ref setThreadCount()
          */
         void step(Float time, Float delta);
 
     private:
+        void featureAdded(Animable<dimensions, T>& animable) override;
+        void featureRemoved(Animable<dimensions, T>& animable) override;
+
+        void MAGNUM_SCENEGRAPH_LOCAL addToActiveList(Animable<dimensions, T>& animable);
+        void MAGNUM_SCENEGRAPH_LOCAL stepInternal(Animable<dimensions, T>& animable, Float time, Float delta);
+
         std::size_t _runningCount;
-        bool wakeUp;
+        UnsignedInt _threadCount;
+        std::vector<Animable<dimensions, T>*> _active;
+        std::vector<std::pair<Animable<dimensions, T>*, Float>> _parallelSteps;
+        #ifdef MAGNUM_BUILD_MULTITHREADED
+        std::unique_ptr<Magnum::Implementation::WorkerPool> _workerPool;
+        #endif
 };
 
 /**
@@ -0,0 +1,180 @@
+#ifndef Magnum_SceneGraph_Bounds_h
+#define Magnum_SceneGraph_Bounds_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::Bounds, alias @ref Magnum::SceneGraph::BasicBounds2D, @ref Magnum::SceneGraph::BasicBounds3D, typedef @ref Magnum::SceneGraph::Bounds2D, @ref Magnum::SceneGraph::Bounds3D
+ */
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/AbstractGroupedFeature.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Object bounds
+
+Axis-aligned bounding box of an object, used for spatial queries in
+@ref SpatialIndex. The bounds are specified relative to the object and the
+feature caches the axis-aligned box enclosing them in absolute
+transformation. Every time the object transformation changes, the feature
+notifies the index it belongs to, which then updates its structure on next
+query.
+@code
+SceneGraph::SpatialIndex3D index;
+
+Object3D* object = new Object3D{&scene};
+new SceneGraph::Bounds3D{*object, {{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}}, &index};
+
+std::vector<SceneGraph::Bounds3D*> near = index.nearest({}, 5);
+@endcode
+
+@anchor SceneGraph-Bounds-explicit-specializations
+## Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref Bounds.hpp implementation file to avoid linker
+errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref Bounds2D
+-   @ref Bounds3D
+
+@see @ref scenegraph, @ref BasicBounds2D, @ref BasicBounds3D, @ref Bounds2D,
+    @ref Bounds3D, @ref SpatialIndex
+*/
+template<UnsignedInt dimensions, class T> class Bounds: public AbstractGroupedFeature<dimensions, Bounds<dimensions, T>, T> {
+    friend SpatialIndex<dimensions, T>;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param object    Object this bounds belong to
+         * @param bounds    Bounds relative to the object
+         * @param index     Spatial index these bounds belong to
+         *
+         * Adds the feature to the object and also to the index, if
+         * specified. Otherwise you can use @ref FeatureGroup::add().
+         */
+        explicit Bounds(AbstractObject<dimensions, T>& object, const RangeTypeFor<dimensions, T>& bounds, SpatialIndex<dimensions, T>* index = nullptr);
+
+        /**
+         * @brief Destructor
+         *
+         * Removes the bounds from the index.
+         */
+        ~Bounds();
+
+        /**
+         * @brief Spatial index containing these bounds
+         *
+         * If the bounds don't belong to any index, returns `nullptr`.
+         */
+        SpatialIndex<dimensions, T>* index() {
+            return static_cast<SpatialIndex<dimensions, T>*>(AbstractGroupedFeature<dimensions, Bounds<dimensions, T>, T>::group());
+        }
+
+        /** @overload */
+        const SpatialIndex<dimensions, T>* index() const {
+            return static_cast<const SpatialIndex<dimensions, T>*>(AbstractGroupedFeature<dimensions, Bounds<dimensions, T>, T>::group());
+        }
+
+        /** @brief Bounds relative to the object */
+        RangeTypeFor<dimensions, T> bounds() const { return _bounds; }
+
+        /**
+         * @brief Set bounds relative to the object
+         * @return Reference to self (for method chaining)
+         *
+         * The object is not marked as dirty, only the index is notified to
+         * update the bounds on next query.
+         */
+        Bounds<dimensions, T>& setBounds(const RangeTypeFor<dimensions, T>& bounds);
+
+        /**
+         * @brief Absolute bounds
+         *
+         * Axis-aligned box enclosing the bounds in absolute transformation.
+         * Cleans the object before returning the bounds.
+         */
+        RangeTypeFor<dimensions, T> absoluteBounds();
+
+    protected:
+        /** Notifies the index about the change */
+        void markDirty() override;
+
+        /** Computes absolute bounds */
+        void clean(const MatrixTypeFor<dimensions, T>& absoluteTransformationMatrix) override;
+
+    private:
+        RangeTypeFor<dimensions, T> _bounds, _absoluteBounds;
+        Int _leaf;
+        std::size_t _dirtyIndex;
+        bool _dirtyListed, _absoluteBoundsDirty;
+};
+
+/**
+@brief Bounds for two-dimensional scenes
+
+Convenience alternative to `Bounds<2, T>`. See @ref Bounds for more
+information.
+@see @ref Bounds2D, @ref BasicBounds3D
+*/
+template<class T> using BasicBounds2D = Bounds<2, T>;
+
+/**
+@brief Bounds for two-dimensional float scenes
+
+@see @ref Bounds3D
+*/
+typedef BasicBounds2D<Float> Bounds2D;
+
+/**
+@brief Bounds for three-dimensional scenes
+
+Convenience alternative to `Bounds<3, T>`. See @ref Bounds for more
+information.
+@see @ref Bounds3D, @ref BasicBounds2D
+*/
+template<class T> using BasicBounds3D = Bounds<3, T>;
+
+/**
+@brief Bounds for three-dimensional float scenes
+
+@see @ref Bounds2D
+*/
+typedef BasicBounds3D<Float> Bounds3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT Bounds<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT Bounds<3, Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef Magnum_SceneGraph_Bounds_hpp
+#define Magnum_SceneGraph_Bounds_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Bounds.h
+ */
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/SceneGraph/AbstractObject.h"
+#include "Magnum/SceneGraph/Bounds.h"
+#include "Magnum/SceneGraph/SpatialIndex.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<UnsignedInt dimensions, class T> Bounds<dimensions, T>::Bounds(AbstractObject<dimensions, T>& object, const RangeTypeFor<dimensions, T>& bounds, SpatialIndex<dimensions, T>* index): AbstractGroupedFeature<dimensions, Bounds<dimensions, T>, T>(object, nullptr), _bounds(bounds), _leaf(-1), _dirtyIndex(0), _dirtyListed(false), _absoluteBoundsDirty(true) {
+    AbstractFeature<dimensions, T>::setCachedTransformations(CachedTransformation::Absolute);
+
+    /* Adding to the index only after all members are initialized, as the
+       index schedules the leaf insertion using them */
+    if(index) index->add(*this);
+}
+
+template<UnsignedInt dimensions, class T> Bounds<dimensions, T>::~Bounds() {
+    /* Removing from the index while the bounds are still complete, so the
+       index can remove the leaf */
+    if(index()) index()->remove(*this);
+}
+
+template<UnsignedInt dimensions, class T> Bounds<dimensions, T>& Bounds<dimensions, T>::setBounds(const RangeTypeFor<dimensions, T>& bounds) {
+    _bounds = bounds;
+
+    /* The object transformation didn't change, so not dirtying it. The index
+       computes the absolute bounds from the clean transformation. */
+    _absoluteBoundsDirty = true;
+    if(index()) index()->addToDirtyList(*this);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> RangeTypeFor<dimensions, T> Bounds<dimensions, T>::absoluteBounds() {
+    this->object().setClean();
+
+    /* The object might have been already clean */
+    if(_absoluteBoundsDirty) clean(this->object().absoluteTransformationMatrix());
+    return _absoluteBounds;
+}
+
+template<UnsignedInt dimensions, class T> void Bounds<dimensions, T>::markDirty() {
+    _absoluteBoundsDirty = true;
+    if(index()) index()->addToDirtyList(*this);
+}
+
+template<UnsignedInt dimensions, class T> void Bounds<dimensions, T>::clean(const MatrixTypeFor<dimensions, T>& absoluteTransformationMatrix) {
+    /* Transform all corners of the box and take the box enclosing them */
+    VectorTypeFor<dimensions, T> min{Math::Constants<T>::inf()};
+    VectorTypeFor<dimensions, T> max{-Math::Constants<T>::inf()};
+    for(UnsignedInt i = 0; i != 1 << dimensions; ++i) {
+        VectorTypeFor<dimensions, T> corner;
+        for(UnsignedInt j = 0; j != dimensions; ++j)
+            corner[j] = (i & (1 << j)) ? _bounds.max()[j] : _bounds.min()[j];
+
+        const VectorTypeFor<dimensions, T> transformed = absoluteTransformationMatrix.transformPoint(corner);
+        min = Math::min(min, transformed);
+        max = Math::max(max, transformed);
+    }
+
+    _absoluteBounds = {min, max};
+    _absoluteBoundsDirty = false;
+}
+
+}}
+
+#endif
@@ -219,7 +219,9 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
         /**
          * @brief Draw
          *
-         * Draws given group of drawables.
+         * Cleans all dirty objects in the scene using
+         * @ref Scene::cleanDirty() and draws given group of drawables.
+         * Expects that the camera is part of some scene.
          */
         virtual void draw(DrawableGroup<dimensions, T>& group);
 
@@ -86,8 +86,9 @@ template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(Drawa
     AbstractObject<dimensions, T>* scene = AbstractFeature<dimensions, T>::object().scene();
     CORRADE_ASSERT(scene, "Camera::draw(): cannot draw when camera is not part of any scene", );
 
-    /* Compute camera matrix */
-    AbstractFeature<dimensions, T>::object().setClean();
+    /* Clean all dirty objects in the scene at once, which computes also the
+       camera matrix */
+    AbstractFeature<dimensions, T>::object().cleanDirtyScene();
 
     /* Compute transformations of all objects in the group relative to the camera */
     std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
@@ -0,0 +1,255 @@
+#ifndef Magnum_SceneGraph_DrawableSnapshot_h
+#define Magnum_SceneGraph_DrawableSnapshot_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::DrawableSnapshot, alias @ref Magnum::SceneGraph::BasicDrawableSnapshot2D, @ref Magnum::SceneGraph::BasicDrawableSnapshot3D, typedef @ref Magnum::SceneGraph::DrawableSnapshot2D, @ref Magnum::SceneGraph::DrawableSnapshot3D
+ */
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include "Magnum/SceneGraph/Drawable.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Triple-buffered snapshot of drawable transformations
+
+Allows the scene to be rendered on another thread while the simulation
+already mutates it for the next frame. At the end of each frame the simulation
+thread calls @ref capture(), which computes absolute transformations of all
+drawables in given group in one batch using
+@ref Object::transformationMatrices() and stores them together with camera
+matrix into back buffer. The back buffer is then published by atomically
+swapping it with a middle buffer. The render thread takes the latest published
+buffer in @ref acquire() by swapping its front buffer with the middle one and
+reads it until @ref release(). Neither thread ever waits for the other, if the
+simulation is faster than rendering, the frames which weren't acquired are
+skipped.
+
+## Usage
+
+@code
+Scene3D scene;
+SceneGraph::DrawableGroup3D drawables;
+SceneGraph::Camera3D camera{cameraObject};
+SceneGraph::DrawableSnapshot3D snapshot;
+
+// simulation thread
+for(;;) {
+    // update the scene ...
+    snapshot.capture(drawables, camera);
+}
+
+// render thread
+for(;;) {
+    snapshot.acquire();
+    snapshot.draw(camera);
+    snapshot.release();
+}
+@endcode
+
+The @ref draw() function doesn't access any object transformation, so it is
+safe to call it while the scene is being modified. However, the drawables
+themselves are still accessed in @ref Drawable::draw(), thus they must not be
+destroyed while a snapshot referencing them is being drawn and their drawing
+state must be synchronized by other means.
+
+@anchor SceneGraph-DrawableSnapshot-explicit-specializations
+## Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref DrawableSnapshot.hpp implementation file to avoid
+linker errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref DrawableSnapshot2D
+-   @ref DrawableSnapshot3D
+
+@see @ref scenegraph, @ref BasicDrawableSnapshot2D,
+    @ref BasicDrawableSnapshot3D, @ref DrawableSnapshot2D,
+    @ref DrawableSnapshot3D
+*/
+template<UnsignedInt dimensions, class T> class DrawableSnapshot {
+    public:
+        /** @brief Constructor */
+        explicit DrawableSnapshot();
+
+        /** @brief Copying is not allowed */
+        DrawableSnapshot(const DrawableSnapshot<dimensions, T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        DrawableSnapshot(DrawableSnapshot<dimensions, T>&&) = delete;
+
+        ~DrawableSnapshot();
+
+        /** @brief Copying is not allowed */
+        DrawableSnapshot<dimensions, T>& operator=(const DrawableSnapshot<dimensions, T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        DrawableSnapshot<dimensions, T>& operator=(DrawableSnapshot<dimensions, T>&&) = delete;
+
+        /**
+         * @brief Capture transformations of given group of drawables
+         *
+         * Computes absolute transformations of all drawables in the group
+         * and stores them together with camera matrix of @p camera into back
+         * buffer, then publishes it for @ref acquire(). Never waits for the
+         * render thread. Expects that the camera is part of some scene.
+         *
+         * The back buffer keeps its capacity from previous frames, but
+         * @ref Object::transformationMatrices() still allocates temporary
+         * storage internally, so the capture is not allocation-free.
+         */
+        void capture(DrawableGroup<dimensions, T>& group, Camera<dimensions, T>& camera);
+
+        /**
+         * @brief Acquire the front buffer for reading
+         * @return `true` if new snapshot was captured since last call,
+         *      `false` otherwise
+         *
+         * Takes the latest buffer published by @ref capture(), if any.
+         * Until @ref release() is called, the front buffer is not changed.
+         * Expects that the buffer is not already acquired.
+         */
+        bool acquire();
+
+        /**
+         * @brief Release the front buffer
+         *
+         * Expects that the buffer is acquired.
+         * @see @ref acquire()
+         */
+        void release();
+
+        /**
+         * @brief Count of drawables in front buffer
+         *
+         * Can be called only between @ref acquire() and @ref release().
+         */
+        std::size_t size() const { return _front->drawables.size(); }
+
+        /**
+         * @brief Drawable in front buffer
+         *
+         * Can be called only between @ref acquire() and @ref release().
+         */
+        Drawable<dimensions, T>& drawable(std::size_t i) {
+            return *_front->drawables[i];
+        }
+
+        /**
+         * @brief Absolute transformation matrix of drawable in front buffer
+         *
+         * Can be called only between @ref acquire() and @ref release().
+         */
+        const MatrixTypeFor<dimensions, T>& absoluteTransformationMatrix(std::size_t i) const {
+            return _front->transformations[i];
+        }
+
+        /**
+         * @brief Camera matrix in front buffer
+         *
+         * Can be called only between @ref acquire() and @ref release().
+         */
+        const MatrixTypeFor<dimensions, T>& cameraMatrix() const {
+            return _front->cameraMatrix;
+        }
+
+        /**
+         * @brief Draw the front buffer
+         *
+         * Calls @ref Drawable::draw() on all drawables in front buffer with
+         * their transformation relative to captured camera matrix. Expects
+         * that the front buffer is acquired.
+         * @see @ref Camera::draw()
+         */
+        void draw(Camera<dimensions, T>& camera);
+
+    private:
+        struct Buffer {
+            MatrixTypeFor<dimensions, T> cameraMatrix;
+            std::vector<Drawable<dimensions, T>*> drawables;
+            std::vector<MatrixTypeFor<dimensions, T>> transformations;
+        };
+
+        /* Index of the middle buffer in lower bits, Fresh bit is set if it
+           was published by capture() and not acquired yet */
+        enum: UnsignedByte { IndexMask = 0x03, Fresh = 0x04 };
+
+        Buffer _buffers[3];
+        /* Owned by capture() */
+        Buffer* _back;
+        std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> _objects;
+        /* Owned by acquire(), release() and draw() */
+        Buffer* _front;
+        bool _acquired;
+        /* Shared */
+        std::atomic<UnsignedByte> _middle;
+};
+
+/**
+@brief Drawable snapshot for two-dimensional scenes
+
+Convenience alternative to `DrawableSnapshot<2, T>`. See
+@ref DrawableSnapshot for more information.
+@see @ref DrawableSnapshot2D, @ref BasicDrawableSnapshot3D
+*/
+template<class T> using BasicDrawableSnapshot2D = DrawableSnapshot<2, T>;
+
+/**
+@brief Drawable snapshot for two-dimensional float scenes
+
+@see @ref DrawableSnapshot3D
+*/
+typedef BasicDrawableSnapshot2D<Float> DrawableSnapshot2D;
+
+/**
+@brief Drawable snapshot for three-dimensional scenes
+
+Convenience alternative to `DrawableSnapshot<3, T>`. See
+@ref DrawableSnapshot for more information.
+@see @ref DrawableSnapshot3D, @ref BasicDrawableSnapshot2D
+*/
+template<class T> using BasicDrawableSnapshot3D = DrawableSnapshot<3, T>;
+
+/**
+@brief Drawable snapshot for three-dimensional float scenes
+
+@see @ref DrawableSnapshot2D
+*/
+typedef BasicDrawableSnapshot3D<Float> DrawableSnapshot3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT DrawableSnapshot<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT DrawableSnapshot<3, Float>;
+#endif
+
+}}
+
+#endif
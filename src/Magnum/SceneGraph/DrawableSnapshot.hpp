@@ -0,0 +1,93 @@
+#ifndef Magnum_SceneGraph_DrawableSnapshot_hpp
+#define Magnum_SceneGraph_DrawableSnapshot_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref DrawableSnapshot.h
+ */
+
+#include "Magnum/SceneGraph/AbstractObject.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/DrawableSnapshot.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<UnsignedInt dimensions, class T> DrawableSnapshot<dimensions, T>::DrawableSnapshot(): _back(_buffers + 2), _front(_buffers), _acquired(false), _middle(1) {}
+
+template<UnsignedInt dimensions, class T> DrawableSnapshot<dimensions, T>::~DrawableSnapshot() = default;
+
+template<UnsignedInt dimensions, class T> void DrawableSnapshot<dimensions, T>::capture(DrawableGroup<dimensions, T>& group, Camera<dimensions, T>& camera) {
+    AbstractObject<dimensions, T>* scene = camera.object().scene();
+    CORRADE_ASSERT(scene, "SceneGraph::DrawableSnapshot::capture(): camera is not part of any scene", );
+
+    /* Fill the back buffer. It is never touched by the reader, so no
+       synchronization is needed. The vectors keep their capacity, but
+       transformationMatrices() allocates its own temporaries. */
+    _back->cameraMatrix = camera.cameraMatrix();
+    _back->drawables.clear();
+    _objects.clear();
+    for(std::size_t i = 0; i != group.size(); ++i) {
+        _back->drawables.push_back(&group[i]);
+        _objects.push_back(group[i].object());
+    }
+    scene->transformationMatrices(_objects, _back->transformations);
+
+    /* Publish the back buffer and continue with the previous middle one,
+       which is either a frame the reader skipped or the buffer it read
+       before */
+    const UnsignedByte middle = _middle.exchange(UnsignedByte(_back - _buffers)|Fresh, std::memory_order_acq_rel);
+    _back = _buffers + (middle & IndexMask);
+}
+
+template<UnsignedInt dimensions, class T> bool DrawableSnapshot<dimensions, T>::acquire() {
+    CORRADE_ASSERT(!_acquired, "SceneGraph::DrawableSnapshot::acquire(): the snapshot is already acquired", false);
+    _acquired = true;
+
+    /* Nothing new was captured, keep the current front buffer. Only the
+       writer can change the middle buffer in the meantime and it always
+       marks it as fresh, so the exchange below can't take a stale one. */
+    if(!(_middle.load(std::memory_order_acquire) & Fresh)) return false;
+
+    const UnsignedByte middle = _middle.exchange(UnsignedByte(_front - _buffers), std::memory_order_acq_rel);
+    _front = _buffers + (middle & IndexMask);
+    return true;
+}
+
+template<UnsignedInt dimensions, class T> void DrawableSnapshot<dimensions, T>::release() {
+    CORRADE_ASSERT(_acquired, "SceneGraph::DrawableSnapshot::release(): the snapshot is not acquired", );
+    _acquired = false;
+}
+
+template<UnsignedInt dimensions, class T> void DrawableSnapshot<dimensions, T>::draw(Camera<dimensions, T>& camera) {
+    CORRADE_ASSERT(_acquired, "SceneGraph::DrawableSnapshot::draw(): the snapshot is not acquired", );
+
+    for(std::size_t i = 0; i != _front->drawables.size(); ++i)
+        _front->drawables[i]->draw(_front->cameraMatrix*_front->transformations[i], camera);
+}
+
+}}
+
+#endif
@@ -111,6 +111,36 @@ template<UnsignedInt dimensions, class Feature, class T> class FeatureGroup: pub
          * @see @ref add()
          */
         FeatureGroup<dimensions, Feature, T>& remove(Feature& feature);
+
+    #ifdef DOXYGEN_GENERATING_OUTPUT
+    protected:
+    #else
+    private:
+    #endif
+        /**
+         * @brief Feature was added to the group
+         *
+         * Called at the end of @ref add(), which is also used by
+         * @ref AbstractGroupedFeature::AbstractGroupedFeature(). Reimplement
+         * if the group needs to keep additional per-feature data.
+         *
+         * Default implementation does nothing.
+         * @see @ref featureRemoved()
+         */
+        virtual void featureAdded(Feature& feature);
+
+        /**
+         * @brief Feature is going to be removed from the group
+         *
+         * Called at the beginning of @ref remove(), which is also used by
+         * @ref AbstractGroupedFeature::~AbstractGroupedFeature() and when
+         * adding the feature to another group. Not called from the group
+         * destructor.
+         *
+         * Default implementation does nothing.
+         * @see @ref featureAdded()
+         */
+        virtual void featureRemoved(Feature& feature);
 };
 
 /**
@@ -161,6 +191,7 @@ template<UnsignedInt dimensions, class Feature, class T> FeatureGroup<dimensions
     /* Crossreference the feature and group together */
     AbstractFeatureGroup<dimensions, T>::add(feature);
     feature._group = this;
+    featureAdded(feature);
     return *this;
 }
 
@@ -168,11 +199,15 @@ template<UnsignedInt dimensions, class Feature, class T> FeatureGroup<dimensions
     CORRADE_ASSERT(feature._group == this,
         "SceneGraph::AbstractFeatureGroup::remove(): feature is not part of this group", *this);
 
+    featureRemoved(feature);
     AbstractFeatureGroup<dimensions, T>::remove(feature);
     feature._group = nullptr;
     return *this;
 }
 
+template<UnsignedInt dimensions, class Feature, class T> void FeatureGroup<dimensions, Feature, T>::featureAdded(Feature&) {}
+template<UnsignedInt dimensions, class Feature, class T> void FeatureGroup<dimensions, Feature, T>::featureRemoved(Feature&) {}
+
 #if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
 extern template class MAGNUM_SCENEGRAPH_EXPORT AbstractFeatureGroup<2, Float>;
 extern template class MAGNUM_SCENEGRAPH_EXPORT AbstractFeatureGroup<3, Float>;
@@ -0,0 +1,243 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "KeyframeAnimable.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Magnum/Math/BatchInterpolation.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/SceneGraph/AbstractTranslationRotationScaling3D.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace {
+    constexpr std::size_t NoChannel = ~std::size_t{};
+}
+
+KeyframeAnimable3D::KeyframeAnimable3D(AbstractObject3D& object, AnimableGroup3D* group): Animable3D{object, group} {}
+
+std::size_t KeyframeAnimable3D::addTrack(AbstractTranslationRotation3D& object) {
+    _tracks.push_back({&object, nullptr, NoChannel, NoChannel, NoChannel});
+    _translations.emplace_back();
+    _rotations.emplace_back();
+    _scalings.emplace_back(1.0f);
+    return _tracks.size() - 1;
+}
+
+std::size_t KeyframeAnimable3D::addTrack(AbstractTranslationRotationScaling3D& object) {
+    const std::size_t id = addTrack(static_cast<AbstractTranslationRotation3D&>(object));
+    _tracks.back().scalingObject = &object;
+    return id;
+}
+
+std::size_t KeyframeAnimable3D::addChannel(const Containers::ArrayView<const Float> times, const std::size_t values) {
+    _channels.push_back({_times.size(), values, times.size(), 0});
+    _times.insert(_times.end(), times.data(), times.data() + times.size());
+
+    /* Extend the animation to cover all keyframes */
+    if(times[times.size() - 1] > duration())
+        setDuration(times[times.size() - 1]);
+
+    return _channels.size() - 1;
+}
+
+KeyframeAnimable3D& KeyframeAnimable3D::setTranslationKeyframes(const std::size_t track, const Containers::ArrayView<const Float> times, const Containers::ArrayView<const Vector3> translations) {
+    CORRADE_ASSERT(track < _tracks.size(),
+        "SceneGraph::KeyframeAnimable3D::setTranslationKeyframes(): track" << track << "out of range for" << _tracks.size() << "tracks", *this);
+    CORRADE_ASSERT(!times.empty() && times.size() == translations.size(),
+        "SceneGraph::KeyframeAnimable3D::setTranslationKeyframes(): expected the same non-zero count of times and values, got" << times.size() << "and" << translations.size(), *this);
+    CORRADE_ASSERT(std::is_sorted(times.data(), times.data() + times.size()),
+        "SceneGraph::KeyframeAnimable3D::setTranslationKeyframes(): times are not sorted", *this);
+    CORRADE_ASSERT(_tracks[track].translation == NoChannel,
+        "SceneGraph::KeyframeAnimable3D::setTranslationKeyframes(): translation keyframes of track" << track << "already set", *this);
+
+    _tracks[track].translation = addChannel(times, _vectors.size());
+    _vectors.insert(_vectors.end(), translations.data(), translations.data() + translations.size());
+    return *this;
+}
+
+KeyframeAnimable3D& KeyframeAnimable3D::setRotationKeyframes(const std::size_t track, const Containers::ArrayView<const Float> times, const Containers::ArrayView<const Quaternion> rotations) {
+    CORRADE_ASSERT(track < _tracks.size(),
+        "SceneGraph::KeyframeAnimable3D::setRotationKeyframes(): track" << track << "out of range for" << _tracks.size() << "tracks", *this);
+    CORRADE_ASSERT(!times.empty() && times.size() == rotations.size(),
+        "SceneGraph::KeyframeAnimable3D::setRotationKeyframes(): expected the same non-zero count of times and values, got" << times.size() << "and" << rotations.size(), *this);
+    CORRADE_ASSERT(std::is_sorted(times.data(), times.data() + times.size()),
+        "SceneGraph::KeyframeAnimable3D::setRotationKeyframes(): times are not sorted", *this);
+    CORRADE_ASSERT(_tracks[track].rotation == NoChannel,
+        "SceneGraph::KeyframeAnimable3D::setRotationKeyframes(): rotation keyframes of track" << track << "already set", *this);
+    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
+    for(std::size_t i = 0; i != rotations.size(); ++i)
+        CORRADE_ASSERT(rotations[i].isNormalized(),
+            "SceneGraph::KeyframeAnimable3D::setRotationKeyframes(): rotation" << i << "is not normalized", *this);
+    #endif
+
+    _tracks[track].rotation = addChannel(times, _quaternions.size());
+    _quaternions.insert(_quaternions.end(), rotations.data(), rotations.data() + rotations.size());
+    return *this;
+}
+
+KeyframeAnimable3D& KeyframeAnimable3D::setScalingKeyframes(const std::size_t track, const Containers::ArrayView<const Float> times, const Containers::ArrayView<const Vector3> scalings) {
+    CORRADE_ASSERT(track < _tracks.size(),
+        "SceneGraph::KeyframeAnimable3D::setScalingKeyframes(): track" << track << "out of range for" << _tracks.size() << "tracks", *this);
+    CORRADE_ASSERT(_tracks[track].scalingObject,
+        "SceneGraph::KeyframeAnimable3D::setScalingKeyframes(): object of track" << track << "doesn't support scaling", *this);
+    CORRADE_ASSERT(!times.empty() && times.size() == scalings.size(),
+        "SceneGraph::KeyframeAnimable3D::setScalingKeyframes(): expected the same non-zero count of times and values, got" << times.size() << "and" << scalings.size(), *this);
+    CORRADE_ASSERT(std::is_sorted(times.data(), times.data() + times.size()),
+        "SceneGraph::KeyframeAnimable3D::setScalingKeyframes(): times are not sorted", *this);
+    CORRADE_ASSERT(_tracks[track].scaling == NoChannel,
+        "SceneGraph::KeyframeAnimable3D::setScalingKeyframes(): scaling keyframes of track" << track << "already set", *this);
+
+    _tracks[track].scaling = addChannel(times, _vectors.size());
+    _vectors.insert(_vectors.end(), scalings.data(), scalings.data() + scalings.size());
+    return *this;
+}
+
+Float KeyframeAnimable3D::advance(Channel& channel, const Float time) {
+    const Float* const times = _times.data() + channel.times;
+    std::size_t i = channel.cursor;
+
+    /* Time went backwards, binary search for the last keyframe not after
+       given time in the part before the cursor. If there's none, the time is
+       before the first keyframe. */
+    if(time < times[i]) {
+        i = std::upper_bound(times, times + i, time) - times;
+        if(i) --i;
+
+    /* Time went forward past the next keyframe, which is the usual case
+       during playback. If more than one keyframe was skipped, binary search
+       the rest. */
+    } else if(i + 1 < channel.size && times[i + 1] <= time) {
+        ++i;
+        if(i + 1 < channel.size && times[i + 1] <= time)
+            i = std::upper_bound(times + i + 1, times + channel.size, time) - times - 1;
+    }
+
+    channel.cursor = i;
+
+    /* Clamp before the first and after the last keyframe. The next keyframe
+       time is always larger than given time, so the division is safe. */
+    if(i + 1 == channel.size || time <= times[i]) return 0.0f;
+    return (time - times[i])/(times[i + 1] - times[i]);
+}
+
+void KeyframeAnimable3D::sample(const Float time) {
+    _rotationsA.clear();
+    _rotationsB.clear();
+    _rotationFactors.clear();
+    _rotationTracks.clear();
+
+    /* Interpolate translations and scalings directly, gather rotations for
+       batch interpolation */
+    for(std::size_t i = 0; i != _tracks.size(); ++i) {
+        const Track& track = _tracks[i];
+
+        if(track.translation != NoChannel) {
+            Channel& channel = _channels[track.translation];
+            const Float t = advance(channel, time);
+            const Vector3* const values = _vectors.data() + channel.values + channel.cursor;
+            _translations[i] = t == 0.0f ? values[0] : Math::lerp(values[0], values[1], t);
+        }
+
+        if(track.scaling != NoChannel) {
+            Channel& channel = _channels[track.scaling];
+            const Float t = advance(channel, time);
+            const Vector3* const values = _vectors.data() + channel.values + channel.cursor;
+            _scalings[i] = t == 0.0f ? values[0] : Math::lerp(values[0], values[1], t);
+        }
+
+        if(track.rotation != NoChannel) {
+            Channel& channel = _channels[track.rotation];
+            const Float t = advance(channel, time);
+            const Quaternion* const values = _quaternions.data() + channel.values + channel.cursor;
+            _rotationsA.push_back(values[0]);
+            _rotationsB.push_back(t == 0.0f ? values[0] : values[1]);
+            _rotationFactors.push_back(t);
+            _rotationTracks.push_back(i);
+        }
+    }
+
+    if(!_rotationTracks.empty()) {
+        _rotationsInterpolated.resize(_rotationTracks.size());
+        Math::slerpShortestPathInto(
+            {_rotationsA.data(), _rotationsA.size()},
+            {_rotationsB.data(), _rotationsB.size()},
+            {_rotationFactors.data(), _rotationFactors.size()},
+            {_rotationsInterpolated.data(), _rotationsInterpolated.size()});
+        for(std::size_t i = 0; i != _rotationTracks.size(); ++i)
+            _rotations[_rotationTracks[i]] = _rotationsInterpolated[i];
+    }
+
+    /* Write the result to the objects */
+    for(std::size_t i = 0; i != _tracks.size(); ++i) {
+        const Track& track = _tracks[i];
+
+        track.object->resetTransformation();
+
+        if(track.scaling != NoChannel)
+            track.scalingObject->scale(_scalings[i]);
+
+        if(track.rotation != NoChannel) {
+            /* Converting to angle and axis using atan2() instead of
+               Quaternion::angle() and Quaternion::axis(), which lose
+               precision for small angles and produce NaN axis for identity
+               rotation */
+            const Quaternion& rotation = _rotations[i];
+            const Float length = rotation.vector().length();
+            if(length != 0.0f)
+                track.object->rotate(Rad(2.0f*std::atan2(length, rotation.scalar())), rotation.vector()/length);
+        }
+
+        if(track.translation != NoChannel)
+            track.object->translate(_translations[i]);
+    }
+}
+
+Vector3 KeyframeAnimable3D::translation(const std::size_t track) const {
+    CORRADE_ASSERT(track < _tracks.size(),
+        "SceneGraph::KeyframeAnimable3D::translation(): track" << track << "out of range for" << _tracks.size() << "tracks", {});
+    return _translations[track];
+}
+
+Quaternion KeyframeAnimable3D::rotation(const std::size_t track) const {
+    CORRADE_ASSERT(track < _tracks.size(),
+        "SceneGraph::KeyframeAnimable3D::rotation(): track" << track << "out of range for" << _tracks.size() << "tracks", {});
+    return _rotations[track];
+}
+
+Vector3 KeyframeAnimable3D::scaling(const std::size_t track) const {
+    CORRADE_ASSERT(track < _tracks.size(),
+        "SceneGraph::KeyframeAnimable3D::scaling(): track" << track << "out of range for" << _tracks.size() << "tracks", {});
+    return _scalings[track];
+}
+
+void KeyframeAnimable3D::animationStep(const Float time, Float) {
+    sample(time);
+}
+
+}}
@@ -0,0 +1,228 @@
+#ifndef Magnum_SceneGraph_KeyframeAnimable_h
+#define Magnum_SceneGraph_KeyframeAnimable_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::KeyframeAnimable3D
+ */
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/SceneGraph/Animable.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Keyframe animation player
+
+Plays back translation, rotation and scaling keyframe tracks of many objects
+at once. Each track targets one object and has up to three channels, each
+with its own keyframe times. Keyframes of all tracks are stored in contiguous
+arrays, so one @ref animationStep() walks them linearly without any
+allocation.
+
+## Usage
+
+Add the feature to some object (e.g. root of the animated hierarchy), then
+add one track for each animated object and fill its channels. Duration of the
+animation is updated to the last keyframe time of all channels.
+@code
+Object3D root, arm{&root}, hand{&arm};
+SceneGraph::AnimableGroup3D animables;
+
+SceneGraph::KeyframeAnimable3D animation{root, &animables};
+const Float times[]{0.0f, 0.5f, 1.0f};
+const Quaternion rotations[]{...};
+animation.setRotationKeyframes(animation.addTrack(arm), times, rotations);
+// ...
+
+animation.setRepeated(true)
+    .setState(SceneGraph::AnimationState::Running);
+@endcode
+
+Channels that are not set use identity transformation, i.e. zero translation,
+identity rotation and unit scaling. Each sample resets the object
+transformation and then applies scaling, rotation and translation in this
+order. Translation and scaling is interpolated linearly, rotation with
+@ref Math::slerpShortestPathInto() for all tracks in one batch. Before the
+first keyframe and after the last keyframe the values are clamped.
+
+## Performance considerations
+
+Each channel caches index of the last sampled keyframe. When the time goes
+forward (i.e. during usual playback), the cursor is advanced from its
+previous position, so sampling a channel is amortized @f$ \mathcal{O}(1) @f$.
+When the time goes backwards (e.g. when the animation is repeated or after
+@ref sample() is called with an earlier time) or skips many keyframes
+forward, the keyframe is found using binary search.
+
+This class is available only for @ref Magnum::Float "Float" scenes.
+@see @ref scenegraph, @ref Animable, @ref AnimableGroup
+*/
+class MAGNUM_SCENEGRAPH_EXPORT KeyframeAnimable3D: public Animable3D {
+    public:
+        /**
+         * @brief Constructor
+         * @param object    Object this animable belongs to
+         * @param group     Group this animable belongs to
+         *
+         * Creates animation with no tracks.
+         * @see @ref Animable::Animable()
+         */
+        explicit KeyframeAnimable3D(AbstractObject3D& object, AnimableGroup3D* group = nullptr);
+
+        /** @brief Count of tracks */
+        std::size_t trackCount() const { return _tracks.size(); }
+
+        /**
+         * @brief Add track animating given object
+         * @return ID of the track
+         *
+         * The object must be alive as long as the track is played. Scaling
+         * keyframes can't be set for objects without scaling support.
+         * @see @ref setTranslationKeyframes(),
+         *      @ref setRotationKeyframes()
+         */
+        std::size_t addTrack(AbstractTranslationRotation3D& object);
+
+        /**
+         * @brief Add track animating given object with scaling support
+         * @return ID of the track
+         *
+         * The object must be alive as long as the track is played.
+         * @see @ref setTranslationKeyframes(),
+         *      @ref setRotationKeyframes(), @ref setScalingKeyframes()
+         */
+        std::size_t addTrack(AbstractTranslationRotationScaling3D& object);
+
+        /**
+         * @brief Set translation keyframes of given track
+         * @return Reference to self (for method chaining)
+         *
+         * The keyframe data are copied. Expects that @p times and
+         * @p translations have the same non-zero size, the times are sorted
+         * in ascending order and that translation keyframes of the track
+         * weren't set before.
+         */
+        KeyframeAnimable3D& setTranslationKeyframes(std::size_t track, Containers::ArrayView<const Float> times, Containers::ArrayView<const Vector3> translations);
+
+        /**
+         * @brief Set rotation keyframes of given track
+         * @return Reference to self (for method chaining)
+         *
+         * The keyframe data are copied. Expects that @p times and
+         * @p rotations have the same non-zero size, the times are sorted in
+         * ascending order, the rotations are normalized and that rotation
+         * keyframes of the track weren't set before.
+         */
+        KeyframeAnimable3D& setRotationKeyframes(std::size_t track, Containers::ArrayView<const Float> times, Containers::ArrayView<const Quaternion> rotations);
+
+        /**
+         * @brief Set scaling keyframes of given track
+         * @return Reference to self (for method chaining)
+         *
+         * The keyframe data are copied. Expects that the track was added
+         * with @ref addTrack(AbstractTranslationRotationScaling3D&),
+         * @p times and @p scalings have the same non-zero size, the times
+         * are sorted in ascending order and that scaling keyframes of the
+         * track weren't set before.
+         */
+        KeyframeAnimable3D& setScalingKeyframes(std::size_t track, Containers::ArrayView<const Float> times, Containers::ArrayView<const Vector3> scalings);
+
+        /**
+         * @brief Sample all tracks at given time
+         *
+         * Interpolates all tracks at given time and writes the result to
+         * target objects. Called from @ref animationStep(), but can be also
+         * used for seeking in stopped or paused animation.
+         */
+        void sample(Float time);
+
+        /**
+         * @brief Sampled translation of given track
+         *
+         * Value computed in last call to @ref sample().
+         */
+        Vector3 translation(std::size_t track) const;
+
+        /**
+         * @brief Sampled rotation of given track
+         *
+         * Value computed in last call to @ref sample().
+         */
+        Quaternion rotation(std::size_t track) const;
+
+        /**
+         * @brief Sampled scaling of given track
+         *
+         * Value computed in last call to @ref sample().
+         */
+        Vector3 scaling(std::size_t track) const;
+
+    protected:
+        /**
+         * @brief Perform animation step
+         *
+         * Calls @ref sample() with @p time.
+         */
+        void animationStep(Float time, Float) override;
+
+    private:
+        /* Offsets into _times and into _vectors or _quaternions */
+        struct Channel {
+            std::size_t times, values, size, cursor;
+        };
+
+        struct Track {
+            AbstractTranslationRotation3D* object;
+            AbstractTranslationRotationScaling3D* scalingObject;
+            std::size_t translation, rotation, scaling;
+        };
+
+        MAGNUM_SCENEGRAPH_LOCAL std::size_t addChannel(Containers::ArrayView<const Float> times, std::size_t values);
+        MAGNUM_SCENEGRAPH_LOCAL Float advance(Channel& channel, Float time);
+
+        std::vector<Track> _tracks;
+        std::vector<Channel> _channels;
+
+        /* Keyframe data of all channels */
+        std::vector<Float> _times;
+        std::vector<Vector3> _vectors;
+        std::vector<Quaternion> _quaternions;
+
+        /* Sampled values of all tracks and scratch space for batch rotation
+           interpolation */
+        std::vector<Vector3> _translations, _scalings;
+        std::vector<Quaternion> _rotations, _rotationsA, _rotationsB, _rotationsInterpolated;
+        std::vector<Float> _rotationFactors;
+        std::vector<std::size_t> _rotationTracks;
+};
+
+}}
+
+#endif
@@ -41,7 +41,8 @@ namespace Implementation {
     enum class ObjectFlag: UnsignedByte {
         Dirty = 1 << 0,
         Visited = 1 << 1,
-        Joint = 1 << 2
+        Joint = 1 << 2,
+        DirtyListed = 1 << 3
     };
 
     typedef Containers::EnumSet<ObjectFlag> ObjectFlags;
@@ -113,6 +114,7 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
 {
     friend Containers::LinkedList<Object<Transformation>>;
     friend Containers::LinkedListItem<Object<Transformation>, Object<Transformation>>;
+    friend Scene<Transformation>;
 
     public:
         /** @brief Matrix type */
@@ -295,11 +297,40 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
          */
         std::vector<MatrixType> transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixType& initialTransformationMatrix = MatrixType()) const;
 
+        /**
+         * @brief Transformation matrices of given set of objects relative to this object into existing storage
+         *
+         * Same as above, but the matrices are written into
+         * @p transformationMatrices, which is resized to size of @p objects.
+         * Reusing the same vector avoids allocating new storage on every
+         * call.
+         */
+        void transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, std::vector<MatrixType>& transformationMatrices, const MatrixType& initialTransformationMatrix = MatrixType()) const;
+
         /**
          * @brief Transformations of given group of objects relative to this object
          *
          * All transformations can be premultiplied with @p initialTransformation,
-         * if specified.
+         * if specified. The objects don't need to be descendants of this
+         * object, but they must be part of the same tree. If this object is
+         * an ancestor of all of them, the hierarchy is traversed only up to
+         * this object, otherwise the transformations are computed relative to
+         * nearest common ancestor and then multiplied with inverse of
+         * transformation of this object.
+         *
+         * Computing transformations relative to an object deeper in the
+         * hierarchy is useful e.g. for skinning, where joint transformations
+         * relative to skeleton root can be combined with inverse bind
+         * matrices directly, without going through world space:
+         * @code
+         * Object3D& skeleton;
+         * std::vector<std::reference_wrapper<Object3D>> joints;
+         * std::vector<Matrix4> inverseBindMatrices;
+         *
+         * std::vector<Matrix4> palette = skeleton.transformations(joints);
+         * for(std::size_t i = 0; i != palette.size(); ++i)
+         *     palette[i] = palette[i]*inverseBindMatrices[i];
+         * @endcode
          * @see @ref transformationMatrices()
          */
         /* `objects` passed by copy intentionally (to allow move from
@@ -326,7 +357,18 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         /** @copydoc AbstractObject::isDirty() */
         bool isDirty() const { return !!(flags & Flag::Dirty); }
 
-        /** @copydoc AbstractObject::setDirty() */
+        /**
+         * @brief Set object absolute transformation as dirty
+         *
+         * Calls @ref AbstractFeature::markDirty() on all object features and
+         * recursively calls @ref setDirty() on every child object which is not
+         * already dirty. If the object is already marked as dirty, the
+         * function does nothing. If the object is part of a scene, it is
+         * also put into the scene dirty list, so @ref Scene::cleanDirty() can
+         * clean it later without traversing the whole scene.
+         * @see @ref scenegraph-features-caching, @ref setClean(),
+         *      @ref isDirty()
+         */
         void setDirty();
 
         /**
@@ -364,21 +406,32 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
             return absoluteTransformationMatrix();
         }
 
-        std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, const MatrixType& initialTransformationMatrix) const override final;
+        void doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, std::vector<MatrixType>& transformationMatrices, const MatrixType& initialTransformationMatrix) const override final;
 
+        MAGNUM_SCENEGRAPH_LOCAL const Object<Transformation>* nearestCommonAncestor(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects) const;
+        std::vector<typename Transformation::DataType> MAGNUM_SCENEGRAPH_LOCAL descendantTransformations(std::vector<std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& initialTransformation) const;
         typename Transformation::DataType MAGNUM_SCENEGRAPH_LOCAL computeJointTransformation(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const std::size_t joint, const typename Transformation::DataType& initialTransformation) const;
 
         bool MAGNUM_SCENEGRAPH_LOCAL doIsDirty() const override final { return isDirty(); }
         void MAGNUM_SCENEGRAPH_LOCAL doSetDirty() override final { setDirty(); }
         void MAGNUM_SCENEGRAPH_LOCAL doSetClean() override final { setClean(); }
         void doSetClean(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects) override final;
+        std::size_t MAGNUM_SCENEGRAPH_LOCAL doCleanDirtyScene() override final;
 
+        void MAGNUM_SCENEGRAPH_LOCAL setDirtyInternal();
         void MAGNUM_SCENEGRAPH_LOCAL setCleanInternal(const typename Transformation::DataType& absoluteTransformation);
+        std::size_t MAGNUM_SCENEGRAPH_LOCAL setCleanSubtreeInternal(const typename Transformation::DataType& parentAbsoluteTransformation);
+
+        void MAGNUM_SCENEGRAPH_LOCAL addToDirtyList(Scene<Transformation>& scene);
+        void MAGNUM_SCENEGRAPH_LOCAL addDirtyChildrenToDirtyList(Scene<Transformation>& scene);
 
         typedef Implementation::ObjectFlag Flag;
         typedef Implementation::ObjectFlags Flags;
         UnsignedShort counter;
         Flags flags;
+        UnsignedInt dirtyListIndex;
+        Scene<Transformation>* dirtyListScene;
+        Scene<Transformation>* cachedScene;
 };
 
 }}
@@ -26,11 +26,12 @@
 */
 
 /** @file
- * @brief @ref compilation-speedup-hpp "Template implementation" for @ref AbstractObject.h, @ref AbstractTransformation.h and @ref Object.h
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref AbstractObject.h, @ref AbstractTransformation.h, @ref Object.h and @ref Scene.h
  */
 
 #include <algorithm>
 #include <stack>
+#include <utility>
 
 #include "Magnum/SceneGraph/AbstractTransformation.h"
 #include "Magnum/SceneGraph/Object.h"
@@ -43,22 +44,72 @@ template<UnsignedInt dimensions, class T> AbstractObject<dimensions, T>::~Abstra
 
 template<UnsignedInt dimensions, class T> AbstractTransformation<dimensions, T>::AbstractTransformation() {}
 
-template<class Transformation> Object<Transformation>::Object(Object<Transformation>* parent): counter(0xFFFFu), flags(Flag::Dirty) {
+template<class Transformation> Object<Transformation>::Object(Object<Transformation>* parent): counter(0xFFFFu), flags(Flag::Dirty), dirtyListIndex(0), dirtyListScene(nullptr), cachedScene(nullptr) {
     setParent(parent);
 }
 
-template<class Transformation> Object<Transformation>::~Object() = default;
+template<class Transformation> Object<Transformation>::~Object() {
+    /* Remove itself from the dirty list so the scene doesn't access dangling
+       pointer. Children are removed in their own destructors. */
+    if(flags & Flag::DirtyListed)
+        dirtyListScene->_dirtyObjects[dirtyListIndex] = nullptr;
+}
+
+template<class Transformation> Scene<Transformation>::Scene(): _cleanGeneration(0) {
+    this->cachedScene = this;
+
+    /* The scene is dirty on creation and so are all objects added to it,
+       put it into the dirty list to have them cleaned */
+    this->addToDirtyList(*this);
+}
+
+template<class Transformation> Scene<Transformation>::~Scene() {
+    /* The list is destroyed before the children, make sure they don't try to
+       remove themselves from it */
+    for(Object<Transformation>* o: _dirtyObjects)
+        if(o) o->flags &= ~Object<Transformation>::Flag::DirtyListed;
+}
+
+template<class Transformation> std::size_t Scene<Transformation>::cleanDirty() {
+    std::size_t count = 0;
+
+    /* Not using iterators, as the list might grow if any feature changes
+       transformation of some object in its clean() implementation */
+    for(std::size_t i = 0; i != _dirtyObjects.size(); ++i) {
+        Object<Transformation>* o = _dirtyObjects[i];
+        if(!o) continue;
+        o->flags &= ~Object<Transformation>::Flag::DirtyListed;
+
+        /* Already cleaned using setClean() */
+        if(!o->isDirty()) continue;
+
+        /* Find root of the dirty subtree (the object might have been listed
+           before its parent was marked as dirty) and first clean parent */
+        Object<Transformation>* root = o;
+        Object<Transformation>* cleanParent = o->parent();
+        while(cleanParent && cleanParent->isDirty()) {
+            root = cleanParent;
+            cleanParent = cleanParent->parent();
+        }
+
+        /* The object was moved out of this scene in the meantime */
+        if(root->cachedScene != this) continue;
+
+        count += root->setCleanSubtreeInternal(cleanParent ?
+            cleanParent->absoluteTransformation() : typename Transformation::DataType());
+    }
+
+    _dirtyObjects.clear();
+    if(count) ++_cleanGeneration;
+    return count;
+}
 
 template<class Transformation> Scene<Transformation>* Object<Transformation>::scene() {
-    Object<Transformation>* p(this);
-    while(p && !p->isScene()) p = p->parent();
-    return static_cast<Scene<Transformation>*>(p);
+    return cachedScene;
 }
 
 template<class Transformation> const Scene<Transformation>* Object<Transformation>::scene() const {
-    const Object<Transformation>* p(this);
-    while(p && !p->isScene()) p = p->parent();
-    return static_cast<const Scene<Transformation>*>(p);
+    return cachedScene;
 }
 
 template<class Transformation> Object<Transformation>* Object<Transformation>::doScene() {
@@ -88,7 +139,25 @@ template<class Transformation> Object<Transformation>& Object<Transformation>::s
     /* Add the object to list of new parent */
     if(parent) parent->Containers::LinkedList<Object<Transformation>>::insert(this);
 
-    setDirty();
+    /* Update cached scene of the whole subtree, if it changed */
+    Scene<Transformation>* const scene = parent ? parent->cachedScene : nullptr;
+    if(cachedScene != scene) {
+        std::stack<Object<Transformation>*> objects;
+        objects.push(this);
+        while(!objects.empty()) {
+            Object<Transformation>* o = objects.top();
+            objects.pop();
+            o->cachedScene = scene;
+            for(Object<Transformation>& child: o->children())
+                objects.push(&child);
+        }
+    }
+
+    /* Make the object dirty and, if it's root of dirty subtree now, put it
+       into dirty list of new scene (if any) */
+    if(!(flags & Flag::Dirty)) setDirtyInternal();
+    if(scene && !parent->isDirty()) addToDirtyList(*scene);
+
     return *this;
 }
 
@@ -113,18 +182,49 @@ template<class Transformation> void Object<Transformation>::setDirty() {
        nothing to do */
     if(flags & Flag::Dirty) return;
 
+    setDirtyInternal();
+
+    /* The parent is clean (otherwise this object would be dirty too), so
+       this object is root of dirty subtree. Put it into the dirty list. */
+    Scene<Transformation>* scene = this->scene();
+    if(scene) addToDirtyList(*scene);
+}
+
+template<class Transformation> void Object<Transformation>::setDirtyInternal() {
     /* Make all features dirty */
     for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>& feature: this->features())
         feature.markDirty();
 
     /* Make all children dirty */
     for(Object<Transformation>& child: children())
-        child.setDirty();
+        if(!(child.flags & Flag::Dirty)) child.setDirtyInternal();
 
     /* Mark object as dirty */
     flags |= Flag::Dirty;
 }
 
+template<class Transformation> void Object<Transformation>::addToDirtyList(Scene<Transformation>& scene) {
+    /* Already in the list */
+    if(flags & Flag::DirtyListed) {
+        if(dirtyListScene == &scene) return;
+
+        /* Listed in another scene, remove it from there */
+        dirtyListScene->_dirtyObjects[dirtyListIndex] = nullptr;
+    }
+
+    flags |= Flag::DirtyListed;
+    dirtyListScene = &scene;
+    dirtyListIndex = scene._dirtyObjects.size();
+    scene._dirtyObjects.push_back(this);
+}
+
+template<class Transformation> void Object<Transformation>::addDirtyChildrenToDirtyList(Scene<Transformation>& scene) {
+    /* Dirty children of a freshly cleaned object are roots of dirty subtrees
+       now and the scene wouldn't find them otherwise */
+    for(Object<Transformation>& child: children())
+        if(child.isDirty()) child.addToDirtyList(scene);
+}
+
 template<class Transformation> void Object<Transformation>::setClean() {
     /* The object (and all its parents) are already clean, nothing to do */
     if(!(flags & Flag::Dirty)) return;
@@ -150,6 +250,7 @@ template<class Transformation> void Object<Transformation>::setClean() {
     }
 
     /* Clean features on every collected object, going down from root object */
+    Object<Transformation>* top = objects.top();
     while(!objects.empty()) {
         Object<Transformation>* o = objects.top();
         objects.pop();
@@ -160,32 +261,53 @@ template<class Transformation> void Object<Transformation>::setClean() {
         o->setCleanInternal(absoluteTransformation);
         CORRADE_ASSERT(!o->isDirty(), "SceneGraph::Object::setClean(): original implementation was not called", );
     }
+
+    /* Put remaining dirty children of cleaned objects into the dirty list */
+    Scene<Transformation>* scene = this->scene();
+    if(scene) for(Object<Transformation>* o = this; ; o = o->parent()) {
+        o->addDirtyChildrenToDirtyList(*scene);
+        if(o == top) break;
+    }
 }
 
-template<class Transformation> auto Object<Transformation>::doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, const MatrixType& initialTransformationMatrix) const -> std::vector<MatrixType> {
+template<class Transformation> void Object<Transformation>::doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, std::vector<MatrixType>& transformationMatrices, const MatrixType& initialTransformationMatrix) const {
     std::vector<std::reference_wrapper<Object<Transformation>>> castObjects;
     castObjects.reserve(objects.size());
     /** @todo Ensure this doesn't crash, somehow */
     for(auto o: objects) castObjects.push_back(static_cast<Object<Transformation>&>(o.get()));
 
-    return transformationMatrices(std::move(castObjects), initialTransformationMatrix);
+    this->transformationMatrices(castObjects, transformationMatrices, initialTransformationMatrix);
 }
 
 template<class Transformation> auto Object<Transformation>::transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixType& initialTransformationMatrix) const -> std::vector<MatrixType> {
-    std::vector<typename Transformation::DataType> transformations = this->transformations(std::move(objects), Implementation::Transformation<Transformation>::fromMatrix(initialTransformationMatrix));
-    std::vector<MatrixType> transformationMatrices(transformations.size());
-    for(std::size_t i = 0; i != objects.size(); ++i)
-        transformationMatrices[i] = Implementation::Transformation<Transformation>::toMatrix(transformations[i]);
-
+    std::vector<MatrixType> transformationMatrices;
+    this->transformationMatrices(objects, transformationMatrices, initialTransformationMatrix);
     return transformationMatrices;
 }
 
-/*
-Computing absolute transformations for given list of objects
+template<class Transformation> void Object<Transformation>::transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, std::vector<MatrixType>& transformationMatrices, const MatrixType& initialTransformationMatrix) const {
+    const std::vector<typename Transformation::DataType> transformations = this->transformations(objects, Implementation::Transformation<Transformation>::fromMatrix(initialTransformationMatrix));
 
-The goal is to compute absolute transformation only once for each object
-involved. Objects contained in the subtree specified by `object` list are
-divided into two groups:
+    /* Resizing keeps the capacity, so no allocation happens if the vector
+       was already large enough */
+    transformationMatrices.resize(transformations.size());
+    for(std::size_t i = 0; i != transformations.size(); ++i)
+        transformationMatrices[i] = Implementation::Transformation<Transformation>::toMatrix(transformations[i]);
+}
+
+/*
+Computing transformations for given list of objects relative to this object
+
+If this object is not an ancestor of all objects in the list, nearest common
+ancestor of this object and all the objects is found first. The
+transformations are then computed relative to it together with transformation
+of this object, which is then inverted and used to make the transformations
+relative to this object. If this object is an ancestor of all of them, no
+inversion is needed.
+
+The goal is to compute transformation relative to this object only once for
+each object involved. Objects contained in the subtree specified by `object`
+list are divided into two groups:
  - "joints", which are either part of `object` list or they have more than one
    child in the subtree
  - "non-joints", i.e. paths between joints
@@ -197,6 +319,30 @@ joints which were originally in `object` list is then returned.
 template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::transformations(std::vector<std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& initialTransformation) const {
     CORRADE_ASSERT(objects.size() < 0xFFFFu, "SceneGraph::Object::transformations(): too large scene", {});
 
+    /* This is not a root object, find nearest common ancestor. If it is not
+       this object, compute the transformations relative to it and make them
+       relative to this object using inverse transformation of this object. */
+    if(parent()) {
+        const Object<Transformation>* const ancestor = nearestCommonAncestor(objects);
+        if(!ancestor) return {};
+
+        if(ancestor != this) {
+            objects.push_back(const_cast<Object<Transformation>&>(*this));
+            std::vector<typename Transformation::DataType> transformations = ancestor->descendantTransformations(std::move(objects), {});
+
+            const typename Transformation::DataType inverted = Implementation::Transformation<Transformation>::compose(initialTransformation, Implementation::Transformation<Transformation>::inverted(transformations.back()));
+            transformations.pop_back();
+            for(auto& transformation: transformations)
+                transformation = Implementation::Transformation<Transformation>::compose(inverted, transformation);
+
+            return transformations;
+        }
+    }
+
+    return descendantTransformations(std::move(objects), initialTransformation);
+}
+
+template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::descendantTransformations(std::vector<std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& initialTransformation) const {
     /* Remember object count for later */
     std::size_t objectCount = objects.size();
 
@@ -212,13 +358,7 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
     }
     std::vector<std::reference_wrapper<Object<Transformation>>> jointObjects(objects);
 
-    /* Scene object */
-    const Scene<Transformation>* scene = this->scene();
-
-    /* Nearest common ancestor not yet implemented - assert this is done on scene */
-    CORRADE_ASSERT(scene == this, "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", {});
-
-    /* Mark all objects up the hierarchy as visited */
+    /* Mark all objects up the hierarchy until this object as visited */
     auto it = objects.begin();
     while(!objects.empty()) {
         /* Already visited, remove and continue to next (duplicate occurence) */
@@ -232,11 +372,23 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
 
         Object<Transformation>* parent = it->get().parent();
 
-        /* If this is root object, remove from list */
-        if(!parent) {
-            CORRADE_ASSERT(&it->get() == scene, "SceneGraph::Object::transformations(): the objects are not part of the same tree", {});
+        /* If this is the object relative to which we compute the
+           transformations, remove from list */
+        if(&it->get() == this) {
             it = objects.erase(it);
 
+        /* If this is root object, the object is not a descendant of this
+           object */
+        } else if(!parent) {
+            /* Clean all marks so they don't confuse subsequent calls */
+            for(auto o: jointObjects) for(Object<Transformation>* i = &o.get(); i; i = i->parent()) {
+                i->flags &= ~(Flag::Visited|Flag::Joint);
+                i->counter = 0xFFFFu;
+            }
+
+            CORRADE_ASSERT(false, "SceneGraph::Object::transformations(): the objects are not part of the same tree", {});
+            return {};
+
         /* Parent is an joint or already visited - remove current from list */
         } else if(parent->flags & (Flag::Visited|Flag::Joint)) {
             it = objects.erase(it);
@@ -259,7 +411,7 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
         if(it == objects.end()) it = objects.begin();
     }
 
-    /* Array of absolute transformations in joints */
+    /* Array of joint transformations relative to this object */
     std::vector<typename Transformation::DataType> jointTransformations(jointObjects.size());
 
     /* Compute transformations for all joints */
@@ -287,6 +439,40 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
     return jointTransformations;
 }
 
+template<class Transformation> const Object<Transformation>* Object<Transformation>::nearestCommonAncestor(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects) const {
+    /* Mark the path from this object to root as visited */
+    std::vector<Object<Transformation>*> path;
+    for(Object<Transformation>* o = const_cast<Object<Transformation>*>(this); o; o = o->parent()) {
+        o->flags |= Flag::Visited;
+        path.push_back(o);
+    }
+
+    /* For each object go up until the path is reached, remember the
+       intersection nearest to root. Objects below the current nearest
+       intersection don't need to be searched for. */
+    std::size_t nearest = 0;
+    bool sameTree = true;
+    for(auto o: objects) {
+        Object<Transformation>* ancestor = &o.get();
+        while(ancestor && !(ancestor->flags & Flag::Visited))
+            ancestor = ancestor->parent();
+
+        if(!ancestor) {
+            sameTree = false;
+            break;
+        }
+
+        auto found = std::find(path.begin() + nearest, path.end(), ancestor);
+        if(found != path.end()) nearest = found - path.begin();
+    }
+
+    /* Clean the marks */
+    for(Object<Transformation>* o: path) o->flags &= ~Flag::Visited;
+
+    CORRADE_ASSERT(sameTree, "SceneGraph::Object::transformations(): the objects are not part of the same tree", nullptr);
+    return path[nearest];
+}
+
 template<class Transformation> typename Transformation::DataType Object<Transformation>::computeJointTransformation(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const std::size_t joint, const typename Transformation::DataType& initialTransformation) const {
     std::reference_wrapper<Object<Transformation>> o = jointObjects[joint];
 
@@ -294,28 +480,36 @@ template<class Transformation> typename Transformation::DataType Object<Transfor
        either due to recursion or duplicate object occurences), done */
     if(!(o.get().flags & Flag::Visited)) return jointTransformations[joint];
 
+    /* This object, the transformation is just the initial one */
+    if(&o.get() == this) {
+        o.get().flags &= ~Flag::Visited;
+        return (jointTransformations[joint] = initialTransformation);
+    }
+
     /* Initialize transformation */
     jointTransformations[joint] = o.get().transformation();
 
-    /* Go up until next joint or root */
+    /* Go up until next joint or this object */
     for(;;) {
         /* Clean visited mark */
         CORRADE_INTERNAL_ASSERT(o.get().flags & Flag::Visited);
         o.get().flags &= ~Flag::Visited;
 
         Object<Transformation>* parent = o.get().parent();
-
-        /* Root object, compose transformation with initial, done */
-        if(!parent) {
-            CORRADE_INTERNAL_ASSERT(o.get().isScene());
-            return (jointTransformations[joint] =
-                Implementation::Transformation<Transformation>::compose(initialTransformation, jointTransformations[joint]));
+        CORRADE_INTERNAL_ASSERT(parent);
 
         /* Joint object, compose transformation with the joint, done */
-        } else if(parent->flags & Flag::Joint) {
+        if(parent->flags & Flag::Joint) {
             return (jointTransformations[joint] =
                 Implementation::Transformation<Transformation>::compose(computeJointTransformation(jointObjects, jointTransformations, parent->counter, initialTransformation), jointTransformations[joint]));
 
+        /* This object, compose transformation with initial, done */
+        } else if(parent == this) {
+            CORRADE_INTERNAL_ASSERT(parent->flags & Flag::Visited);
+            parent->flags &= ~Flag::Visited;
+            return (jointTransformations[joint] =
+                Implementation::Transformation<Transformation>::compose(initialTransformation, jointTransformations[joint]));
+
         /* Else compose transformation with parent, go up the hierarchy */
         } else {
             jointTransformations[joint] = Implementation::Transformation<Transformation>::compose(parent->transformation(), jointTransformations[joint]);
@@ -333,6 +527,14 @@ template<class Transformation> void Object<Transformation>::doSetClean(const std
     setClean(std::move(castObjects));
 }
 
+template<class Transformation> std::size_t Object<Transformation>::doCleanDirtyScene() {
+    if(cachedScene) return cachedScene->cleanDirty();
+
+    if(!isDirty()) return 0;
+    setClean();
+    return 1;
+}
+
 template<class Transformation> void Object<Transformation>::setClean(std::vector<std::reference_wrapper<Object<Transformation>>> objects) {
     /* Remove all clean objects from the list */
     auto firstClean = std::remove_if(objects.begin(), objects.end(), [](Object<Transformation>& o) { return !o.isDirty(); });
@@ -370,6 +572,10 @@ template<class Transformation> void Object<Transformation>::setClean(std::vector
         objects[i].get().setCleanInternal(transformations[i]);
         CORRADE_ASSERT(!objects[i].get().isDirty(), "SceneGraph::Object::setClean(): original implementation was not called", );
     }
+
+    /* Put remaining dirty children of cleaned objects into the dirty list */
+    for(Object<Transformation>& o: objects)
+        o.addDirtyChildrenToDirtyList(*scene);
 }
 
 template<class Transformation> void Object<Transformation>::setCleanInternal(const typename Transformation::DataType& absoluteTransformation) {
@@ -407,6 +613,30 @@ template<class Transformation> void Object<Transformation>::setCleanInternal(con
     flags &= ~Flag::Dirty;
 }
 
+template<class Transformation> std::size_t Object<Transformation>::setCleanSubtreeInternal(const typename Transformation::DataType& parentAbsoluteTransformation) {
+    /* Explicit stack instead of recursion, so deep hierarchies don't
+       overflow the call stack */
+    std::stack<std::pair<Object<Transformation>*, typename Transformation::DataType>> objects;
+    objects.emplace(this, parentAbsoluteTransformation);
+
+    std::size_t count = 0;
+    while(!objects.empty()) {
+        Object<Transformation>* o = objects.top().first;
+        const typename Transformation::DataType absoluteTransformation = Implementation::Transformation<Transformation>::compose(objects.top().second, o->transformation());
+        objects.pop();
+
+        o->setCleanInternal(absoluteTransformation);
+        CORRADE_ASSERT(!o->isDirty(), "SceneGraph::Scene::cleanDirty(): original implementation was not called", count + 1);
+        ++count;
+
+        /* All children of dirty object are dirty too, but be defensive */
+        for(Object<Transformation>& child: o->children())
+            if(child.isDirty()) objects.emplace(&child, absoluteTransformation);
+    }
+
+    return count;
+}
+
 }}
 
 #endif
@@ -0,0 +1,295 @@
+#ifndef Magnum_SceneGraph_Pool_h
+#define Magnum_SceneGraph_Pool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::Pool, @ref Magnum::SceneGraph::PoolAllocated
+ */
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/SceneGraph/SceneGraph.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Chunked pool of fixed-size slots
+
+Storage for objects of type @p T allocated in chunks of @p chunkSize slots.
+The chunks are never moved or freed until the pool is destroyed, so the
+addresses are stable and once the pool has enough capacity, allocations and
+deallocations don't touch the system allocator at all. Freed slots are reused
+in LIFO order, which keeps recently used memory hot in cache.
+
+The pool is usually not used directly, but through @ref PoolAllocated. Use
+@ref reserve() to preallocate enough slots upfront and @ref chunkCount() to
+verify that no chunks (i.e. no system allocations) were added in a
+steady-state loop. @ref allocationCount() and @ref deallocationCount() count
+all slot allocations, which can be used to measure the allocation rate.
+
+Note that the pool covers only memory of the pooled instances themselves.
+Containers referencing them, such as feature groups or the dirty list in
+@ref Scene, still use the system allocator when they grow, so unchanged
+@ref chunkCount() doesn't mean that the whole loop is allocation-free.
+@attention The pool is not thread-safe.
+@see @ref scenegraph-pool
+*/
+template<class T, std::size_t chunkSize> class Pool {
+    static_assert(chunkSize != 0, "chunk size can't be zero");
+
+    public:
+        /** @brief Size of one chunk in slots */
+        static constexpr std::size_t ChunkSize = chunkSize;
+
+        /**
+         * @brief Constructor
+         *
+         * Creates empty pool, no memory is allocated.
+         */
+        explicit Pool(): _firstChunk(nullptr), _firstFree(nullptr), _chunkCount(0), _size(0), _allocationCount(0), _deallocationCount(0) {}
+
+        /** @brief Copying is not allowed */
+        Pool(const Pool<T, chunkSize>&) = delete;
+
+        /** @brief Moving is not allowed */
+        Pool(Pool<T, chunkSize>&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Frees all chunks. Objects still living in the pool are not
+         * destructed, the memory is freed from under them.
+         */
+        ~Pool() {
+            while(_firstChunk) {
+                Chunk* next = _firstChunk->next;
+                delete _firstChunk;
+                _firstChunk = next;
+            }
+        }
+
+        /** @brief Copying is not allowed */
+        Pool<T, chunkSize>& operator=(const Pool<T, chunkSize>&) = delete;
+
+        /** @brief Moving is not allowed */
+        Pool<T, chunkSize>& operator=(Pool<T, chunkSize>&&) = delete;
+
+        /** @brief Count of allocated slots */
+        std::size_t size() const { return _size; }
+
+        /**
+         * @brief Count of all slots
+         *
+         * @see @ref reserve()
+         */
+        std::size_t capacity() const { return _chunkCount*chunkSize; }
+
+        /**
+         * @brief Count of allocated chunks
+         *
+         * Equivalent to count of system allocations done by the pool.
+         */
+        std::size_t chunkCount() const { return _chunkCount; }
+
+        /**
+         * @brief Count of slot allocations
+         *
+         * Count of all @ref allocate() calls since the pool was created,
+         * including the ones which reused a freed slot.
+         * @see @ref deallocationCount(), @ref chunkCount()
+         */
+        std::size_t allocationCount() const { return _allocationCount; }
+
+        /**
+         * @brief Count of slot deallocations
+         *
+         * Count of all @ref deallocate() calls with non-null memory since
+         * the pool was created.
+         * @see @ref allocationCount()
+         */
+        std::size_t deallocationCount() const { return _deallocationCount; }
+
+        /**
+         * @brief Reserve memory for given count of slots
+         *
+         * Allocates new chunks so @ref capacity() is at least @p count. If
+         * the capacity is already large enough, does nothing.
+         */
+        void reserve(std::size_t count) {
+            while(capacity() < count) addChunk();
+        }
+
+        /**
+         * @brief Allocate one slot
+         *
+         * Returns uninitialized memory large enough for @p T. If there is no
+         * free slot, allocates new chunk.
+         */
+        void* allocate() {
+            if(!_firstFree) addChunk();
+
+            Slot* slot = _firstFree;
+            _firstFree = slot->next;
+            ++_size;
+            ++_allocationCount;
+            return slot;
+        }
+
+        /**
+         * @brief Deallocate one slot
+         *
+         * The @p memory must be allocated using @ref allocate() on the same
+         * pool. Does nothing if @p memory is `nullptr`.
+         */
+        void deallocate(void* memory) {
+            if(!memory) return;
+            CORRADE_ASSERT(_size, "SceneGraph::Pool::deallocate(): the pool is empty", );
+
+            Slot* slot = static_cast<Slot*>(memory);
+            slot->next = _firstFree;
+            _firstFree = slot;
+            --_size;
+            ++_deallocationCount;
+        }
+
+    private:
+        union Slot {
+            Slot* next;
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type data;
+        };
+
+        struct Chunk {
+            Chunk* next;
+            Slot slots[chunkSize];
+        };
+
+        void addChunk() {
+            Chunk* chunk = new Chunk;
+            chunk->next = _firstChunk;
+            _firstChunk = chunk;
+            ++_chunkCount;
+
+            /* Put the new slots to the front of the free list, in order */
+            for(std::size_t i = 0; i != chunkSize - 1; ++i)
+                chunk->slots[i].next = chunk->slots + i + 1;
+            chunk->slots[chunkSize - 1].next = _firstFree;
+            _firstFree = chunk->slots;
+        }
+
+        Chunk* _firstChunk;
+        Slot* _firstFree;
+        std::size_t _chunkCount, _size, _allocationCount, _deallocationCount;
+};
+
+template<class T, std::size_t chunkSize> constexpr std::size_t Pool<T, chunkSize>::ChunkSize;
+
+/**
+@brief Base for pool-allocated objects and features
+
+Overloads `operator new` and `operator delete` for given class so its
+instances are allocated from a @ref Pool shared by all instances of @p T
+instead of from the system allocator. Because @ref Object and
+@ref AbstractFeature have virtual destructors, the instances are correctly
+returned to the pool also when they are destroyed by their parent object or
+holder object, so destroying a whole subtree is done without any system
+deallocation. Usage via [CRTP](http://en.wikipedia.org/wiki/Curiously_recurring_template_pattern):
+@code
+class Entity: public Object3D, SceneGraph::Drawable3D, public SceneGraph::PoolAllocated<Entity> {
+    // ...
+};
+
+Entity::pool().reserve(10000);
+
+Entity* entity = new Entity{&scene, &drawables};
+// ...
+delete entity; // returns the entity and all its pooled children to the pools
+@endcode
+
+Instances of classes derived from @p T, which have different size, are
+allocated using the system allocator, see @ref systemAllocationCount(). The
+pool is not thread-safe and must
+not be destroyed before all instances (i.e. don't pool-allocate objects which
+are destroyed during static deinitialization).
+@see @ref scenegraph-pool
+*/
+template<class T, std::size_t chunkSize> class PoolAllocated {
+    public:
+        /** @brief Pool type */
+        typedef Pool<T, chunkSize> PoolType;
+
+        /** @brief Pool used for allocating instances of @p T */
+        static PoolType& pool() {
+            static PoolType pool;
+            return pool;
+        }
+
+        /**
+         * @brief Count of instances allocated using the system allocator
+         *
+         * Instances of classes derived from @p T which have different size
+         * can't be put into the pool. Together with @ref Pool::chunkCount()
+         * this is the count of system allocations done for @p T and its
+         * subclasses.
+         */
+        static std::size_t systemAllocationCount() {
+            return systemAllocationCounter();
+        }
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        static void* operator new(std::size_t size) {
+            if(size != sizeof(T)) {
+                ++systemAllocationCounter();
+                return ::operator new(size);
+            }
+            return pool().allocate();
+        }
+
+        static void operator delete(void* memory, std::size_t size) {
+            if(size != sizeof(T)) return ::operator delete(memory);
+            pool().deallocate(memory);
+        }
+
+        /* Declaring the above hides global placement new */
+        static void* operator new(std::size_t, void* memory) { return memory; }
+        static void operator delete(void*, void*) {}
+        #endif
+
+    protected:
+        ~PoolAllocated() = default;
+
+    private:
+        static std::size_t& systemAllocationCounter() {
+            static std::size_t count = 0;
+            return count;
+        }
+};
+
+}}
+
+#endif
@@ -38,13 +38,98 @@ namespace Magnum { namespace SceneGraph {
 
 Basically @ref Object which cannot have parent or non-default transformation.
 See @ref scenegraph for introduction.
+
+## Cleaning dirty objects
+
+The scene keeps a list of roots of dirty subtrees. Whenever an object in the
+scene is marked as dirty, it is put into the list, so it's possible to clean
+all dirty objects in the scene at once using @ref cleanDirty() without
+traversing the whole hierarchy. Calling it once per frame (e.g. before
+drawing) makes the cost of transformation caching proportional to the number
+of changed objects and not to the size of the scene:
+@code
+Scene3D scene;
+
+void MyApplication::drawEvent() {
+    // update the objects ...
+
+    scene.cleanDirty();
+
+    // draw ...
+}
+@endcode
+
+@ref cleanGeneration() is incremented every time @ref cleanDirty() cleaned
+anything, which can be used by external caches to detect changes in absolute
+transformations.
+
+## Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations you have to use @ref Object.hpp
+implementation file to avoid linker errors. See @ref compilation-speedup-hpp
+for more information.
+
+-   @ref DualComplexTransformation "Scene<DualComplexTransformation>"
+-   @ref DualQuaternionTransformation "Scene<DualQuaternionTransformation>"
+-   @ref MatrixTransformation2D "Scene<MatrixTransformation2D>"
+-   @ref MatrixTransformation3D "Scene<MatrixTransformation3D>"
+-   @ref RigidMatrixTransformation2D "Scene<RigidMatrixTransformation2D>"
+-   @ref RigidMatrixTransformation3D "Scene<RigidMatrixTransformation3D>"
+-   @ref TranslationTransformation2D "Scene<TranslationTransformation2D>"
+-   @ref TranslationTransformation3D "Scene<TranslationTransformation3D>"
 */
 template<class Transformation> class Scene: public Object<Transformation> {
+    friend Object<Transformation>;
+
     public:
-        explicit Scene() = default;
+        explicit Scene();
+
+        /**
+         * @brief Destructor
+         *
+         * Removes all objects from the dirty list, then destroys all
+         * children.
+         */
+        ~Scene();
+
+        /**
+         * @brief Count of objects in the dirty list
+         *
+         * Upper bound of the number of dirty subtree roots which will be
+         * processed by the next call to @ref cleanDirty().
+         */
+        std::size_t dirtyCount() const { return _dirtyObjects.size(); }
+
+        /**
+         * @brief Clean generation
+         *
+         * Incremented each time @ref cleanDirty() cleans at least one
+         * object. Initial value is `0`.
+         */
+        UnsignedInt cleanGeneration() const { return _cleanGeneration; }
+
+        /**
+         * @brief Clean all dirty objects in the scene
+         * @return Count of cleaned objects
+         *
+         * Goes through the dirty list, computes absolute transformation of
+         * every dirty subtree just once and calls
+         * @ref AbstractFeature::clean() and/or
+         * @ref AbstractFeature::cleanInverted() on all features in the
+         * subtree which have caching enabled. Objects which were already
+         * cleaned using @ref Object::setClean() or moved to another scene
+         * in the meantime are skipped. The dirty list is empty after calling
+         * this function.
+         * @see @ref scenegraph-features-caching, @ref cleanGeneration()
+         */
+        std::size_t cleanDirty();
 
     private:
         bool isScene() const override final { return true; }
+
+        std::vector<Object<Transformation>*> _dirtyObjects;
+        UnsignedInt _cleanGeneration;
 };
 
 }}
@@ -29,6 +29,8 @@
  * @brief Forward declarations for @ref Magnum::SceneGraph namespace
  */
 
+#include <cstddef>
+
 #include "Magnum/Types.h"
 
 #ifdef MAGNUM_BUILD_DEPRECATED
@@ -98,6 +100,14 @@ template<class T> using BasicAnimableGroup3D = AnimableGroup<3, T>;
 typedef BasicAnimableGroup2D<Float> AnimableGroup2D;
 typedef BasicAnimableGroup3D<Float> AnimableGroup3D;
 
+class KeyframeAnimable3D;
+
+template<UnsignedInt, class> class Bounds;
+template<class T> using BasicBounds2D = Bounds<2, T>;
+template<class T> using BasicBounds3D = Bounds<3, T>;
+typedef BasicBounds2D<Float> Bounds2D;
+typedef BasicBounds3D<Float> Bounds3D;
+
 template<UnsignedInt, class> class Camera;
 template<class T> using BasicCamera2D = Camera<2, T>;
 template<class T> using BasicCamera3D = Camera<3, T>;
@@ -118,6 +128,12 @@ template<class T> using BasicDrawable3D = Drawable<3, T>;
 typedef BasicDrawable2D<Float> Drawable2D;
 typedef BasicDrawable3D<Float> Drawable3D;
 
+template<UnsignedInt, class> class DrawableSnapshot;
+template<class T> using BasicDrawableSnapshot2D = DrawableSnapshot<2, T>;
+template<class T> using BasicDrawableSnapshot3D = DrawableSnapshot<3, T>;
+typedef BasicDrawableSnapshot2D<Float> DrawableSnapshot2D;
+typedef BasicDrawableSnapshot3D<Float> DrawableSnapshot3D;
+
 template<class> class BasicDualComplexTransformation;
 template<class> class BasicDualQuaternionTransformation;
 typedef BasicDualComplexTransformation<Float> DualComplexTransformation;
@@ -142,6 +158,9 @@ typedef BasicMatrixTransformation3D<Float> MatrixTransformation3D;
 
 template<class Transformation> class Object;
 
+template<class, std::size_t = 128> class Pool;
+template<class, std::size_t = 128> class PoolAllocated;
+
 template<class> class BasicRigidMatrixTransformation2D;
 template<class> class BasicRigidMatrixTransformation3D;
 typedef BasicRigidMatrixTransformation2D<Float> RigidMatrixTransformation2D;
@@ -149,6 +168,12 @@ typedef BasicRigidMatrixTransformation3D<Float> RigidMatrixTransformation3D;
 
 template<class Transformation> class Scene;
 
+template<UnsignedInt, class> class SpatialIndex;
+template<class T> using BasicSpatialIndex2D = SpatialIndex<2, T>;
+template<class T> using BasicSpatialIndex3D = SpatialIndex<3, T>;
+typedef BasicSpatialIndex2D<Float> SpatialIndex2D;
+typedef BasicSpatialIndex3D<Float> SpatialIndex3D;
+
 template<UnsignedInt, class T, class = T> class TranslationTransformation;
 template<class T, class TranslationType = T> using BasicTranslationTransformation2D = TranslationTransformation<2, T, TranslationType>;
 template<class T, class TranslationType = T> using BasicTranslationTransformation3D = TranslationTransformation<3, T, TranslationType>;
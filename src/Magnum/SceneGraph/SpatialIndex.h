@@ -0,0 +1,223 @@
+#ifndef Magnum_SceneGraph_SpatialIndex_h
+#define Magnum_SceneGraph_SpatialIndex_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::SpatialIndex, alias @ref Magnum::SceneGraph::BasicSpatialIndex2D, @ref Magnum::SceneGraph::BasicSpatialIndex3D, typedef @ref Magnum::SceneGraph::SpatialIndex2D, @ref Magnum::SceneGraph::SpatialIndex3D
+ */
+
+#include <utility>
+#include <vector>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/SceneGraph/Bounds.h"
+#include "Magnum/SceneGraph/FeatureGroup.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Spatial index
+
+Dynamic bounding volume hierarchy over @ref Bounds features, answering range,
+ray and nearest neighbor queries in logarithmic time. See @ref Bounds for
+usage example.
+
+## Updating the hierarchy
+
+The index doesn't need to be rebuilt when the objects move. Each leaf of the
+hierarchy stores the object bounds enlarged by a margin (see
+@ref setMargin()) and objects marked as dirty are collected in the index. On
+@ref setClean(), which is called implicitly by all queries, only the dirty
+objects are cleaned and their leaves reinserted only if they left the
+enlarged bounds. Objects which are not dirty are not touched at all.
+
+@anchor SceneGraph-SpatialIndex-explicit-specializations
+## Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref SpatialIndex.hpp implementation file to avoid
+linker errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref SpatialIndex2D
+-   @ref SpatialIndex3D
+
+@see @ref scenegraph, @ref BasicSpatialIndex2D, @ref BasicSpatialIndex3D,
+    @ref SpatialIndex2D, @ref SpatialIndex3D
+*/
+template<UnsignedInt dimensions, class T> class SpatialIndex: public FeatureGroup<dimensions, Bounds<dimensions, T>, T> {
+    friend Bounds<dimensions, T>;
+
+    public:
+        /**
+         * @brief Constructor
+         *
+         * The margin is set to `0.1`.
+         */
+        explicit SpatialIndex();
+
+        /**
+         * @brief Destructor
+         *
+         * Removes all bounds belonging to this index, but not deletes them.
+         */
+        ~SpatialIndex();
+
+        /** @brief Margin */
+        T margin() const { return _margin; }
+
+        /**
+         * @brief Set margin
+         * @return Reference to self (for method chaining)
+         *
+         * Leaves of the hierarchy are enlarged by given fraction of the
+         * bounds size on each side. Larger margin means that moving objects
+         * need to be reinserted less often, but the queries need to test
+         * more leaves. Affects only leaves inserted after this call.
+         */
+        SpatialIndex<dimensions, T>& setMargin(T margin) {
+            _margin = margin;
+            return *this;
+        }
+
+        /**
+         * @brief Update the hierarchy
+         *
+         * Cleans all objects whose bounds were marked as dirty and updates
+         * their leaves. The objects don't need to be part of the same scene.
+         * Called implicitly by all queries.
+         */
+        void setClean();
+
+        /**
+         * @brief Height of the hierarchy
+         *
+         * Zero if the index is empty, one if it contains just one leaf. The
+         * hierarchy is kept balanced, so the height is logarithmic in count
+         * of inserted bounds. Doesn't call @ref setClean().
+         */
+        std::size_t height() const {
+            return _root == -1 ? 0 : _nodes[_root].height + 1;
+        }
+
+        /**
+         * @brief Bounds intersecting given range
+         *
+         * Returns all bounds whose absolute bounds intersect the range.
+         */
+        std::vector<Bounds<dimensions, T>*> range(const RangeTypeFor<dimensions, T>& range);
+
+        /**
+         * @brief Bounds intersected by given ray
+         * @param origin        Ray origin
+         * @param direction     Ray direction
+         * @param maxDistance   Max distance along the ray, in multiples of
+         *      @p direction length
+         *
+         * Returns all bounds whose absolute bounds are intersected by the ray
+         * together with distance of the intersection along the ray, sorted
+         * from nearest to farthest. Bounds containing the origin have zero
+         * distance. Zero components of @p direction are treated as very
+         * small positive or negative values, depending on their sign.
+         */
+        std::vector<std::pair<Bounds<dimensions, T>*, T>> ray(const VectorTypeFor<dimensions, T>& origin, const VectorTypeFor<dimensions, T>& direction, T maxDistance = Math::Constants<T>::inf());
+
+        /**
+         * @brief Bounds nearest to given point
+         *
+         * Returns at most @p count bounds sorted by distance of their
+         * absolute bounds to @p point, nearest first. Bounds containing the
+         * point have zero distance.
+         */
+        std::vector<Bounds<dimensions, T>*> nearest(const VectorTypeFor<dimensions, T>& point, std::size_t count);
+
+    private:
+        struct Node {
+            RangeTypeFor<dimensions, T> bounds;
+            Int parent, left, right, height;
+            Bounds<dimensions, T>* leaf;
+        };
+
+        void featureAdded(Bounds<dimensions, T>& bounds) override;
+        void featureRemoved(Bounds<dimensions, T>& bounds) override;
+
+        void MAGNUM_SCENEGRAPH_LOCAL addToDirtyList(Bounds<dimensions, T>& bounds);
+        void MAGNUM_SCENEGRAPH_LOCAL removeFromDirtyList(Bounds<dimensions, T>& bounds);
+        void MAGNUM_SCENEGRAPH_LOCAL removeLeaf(Bounds<dimensions, T>& bounds);
+        void MAGNUM_SCENEGRAPH_LOCAL updateLeaf(Bounds<dimensions, T>& bounds);
+        Int MAGNUM_SCENEGRAPH_LOCAL allocateNode();
+        void MAGNUM_SCENEGRAPH_LOCAL freeNode(Int node);
+        void MAGNUM_SCENEGRAPH_LOCAL insertNode(Int leaf);
+        void MAGNUM_SCENEGRAPH_LOCAL removeNode(Int leaf);
+        void MAGNUM_SCENEGRAPH_LOCAL refit(Int node);
+        Int MAGNUM_SCENEGRAPH_LOCAL balance(Int node);
+
+        std::vector<Node> _nodes;
+        Int _root, _freeNode;
+        std::vector<Bounds<dimensions, T>*> _dirty;
+        T _margin;
+};
+
+/**
+@brief Spatial index for two-dimensional scenes
+
+Convenience alternative to `SpatialIndex<2, T>`. See @ref SpatialIndex for
+more information.
+@see @ref SpatialIndex2D, @ref BasicSpatialIndex3D
+*/
+template<class T> using BasicSpatialIndex2D = SpatialIndex<2, T>;
+
+/**
+@brief Spatial index for two-dimensional float scenes
+
+@see @ref SpatialIndex3D
+*/
+typedef BasicSpatialIndex2D<Float> SpatialIndex2D;
+
+/**
+@brief Spatial index for three-dimensional scenes
+
+Convenience alternative to `SpatialIndex<3, T>`. See @ref SpatialIndex for
+more information.
+@see @ref SpatialIndex3D, @ref BasicSpatialIndex2D
+*/
+template<class T> using BasicSpatialIndex3D = SpatialIndex<3, T>;
+
+/**
+@brief Spatial index for three-dimensional float scenes
+
+@see @ref SpatialIndex2D
+*/
+typedef BasicSpatialIndex3D<Float> SpatialIndex3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT SpatialIndex<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT SpatialIndex<3, Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,420 @@
+#ifndef Magnum_SceneGraph_SpatialIndex_hpp
+#define Magnum_SceneGraph_SpatialIndex_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref SpatialIndex.h
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/SceneGraph/AbstractObject.h"
+#include "Magnum/SceneGraph/SpatialIndex.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+template<UnsignedInt dimensions, class T> RangeTypeFor<dimensions, T> boundsJoin(const RangeTypeFor<dimensions, T>& a, const RangeTypeFor<dimensions, T>& b) {
+    return {Math::min(a.min(), b.min()), Math::max(a.max(), b.max())};
+}
+
+template<UnsignedInt dimensions, class T> bool boundsContain(const RangeTypeFor<dimensions, T>& a, const RangeTypeFor<dimensions, T>& b) {
+    return (a.min() <= b.min()).all() && (b.max() <= a.max()).all();
+}
+
+template<UnsignedInt dimensions, class T> bool boundsIntersect(const RangeTypeFor<dimensions, T>& a, const RangeTypeFor<dimensions, T>& b) {
+    return (a.min() <= b.max()).all() && (b.min() <= a.max()).all();
+}
+
+/* Sum of edge lengths, used as insertion cost (perimeter heuristic) */
+template<UnsignedInt dimensions, class T> T boundsMeasure(const RangeTypeFor<dimensions, T>& a) {
+    return a.size().sum();
+}
+
+template<UnsignedInt dimensions, class T> T boundsDistanceSquared(const RangeTypeFor<dimensions, T>& a, const VectorTypeFor<dimensions, T>& point) {
+    return VectorTypeFor<dimensions, T>{Math::max(Math::max(a.min() - point, point - a.max()), VectorTypeFor<dimensions, T>{T(0)})}.dot();
+}
+
+}
+
+template<UnsignedInt dimensions, class T> SpatialIndex<dimensions, T>::SpatialIndex(): _root(-1), _freeNode(-1), _margin(T(0.1)) {}
+
+template<UnsignedInt dimensions, class T> SpatialIndex<dimensions, T>::~SpatialIndex() {
+    for(std::size_t i = 0; i != this->size(); ++i) {
+        (*this)[i]._leaf = -1;
+        (*this)[i]._dirtyListed = false;
+    }
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::featureAdded(Bounds<dimensions, T>& bounds) {
+    /* The leaf is inserted on next setClean() */
+    addToDirtyList(bounds);
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::featureRemoved(Bounds<dimensions, T>& bounds) {
+    removeLeaf(bounds);
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::setClean() {
+    if(_dirty.empty()) return;
+
+    /* Clean the dirty objects in one batch per scene, as
+       AbstractObject::setClean() expects all objects to be from the same
+       scene. Objects which are not part of any scene are cleaned one by one.
+       Bounds::clean() computes new absolute bounds. */
+    std::vector<std::pair<AbstractObject<dimensions, T>*, std::reference_wrapper<AbstractObject<dimensions, T>>>> objects;
+    objects.reserve(_dirty.size());
+    for(Bounds<dimensions, T>* bounds: _dirty)
+        if(bounds) objects.emplace_back(bounds->object().scene(), bounds->object());
+    std::stable_sort(objects.begin(), objects.end(), [](const std::pair<AbstractObject<dimensions, T>*, std::reference_wrapper<AbstractObject<dimensions, T>>>& a, const std::pair<AbstractObject<dimensions, T>*, std::reference_wrapper<AbstractObject<dimensions, T>>>& b) {
+        return std::less<AbstractObject<dimensions, T>*>()(a.first, b.first);
+    });
+
+    std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> sceneObjects;
+    for(std::size_t begin = 0, end; begin != objects.size(); begin = end) {
+        AbstractObject<dimensions, T>* const scene = objects[begin].first;
+        end = begin + 1;
+        while(end != objects.size() && objects[end].first == scene) ++end;
+
+        if(!scene) {
+            for(std::size_t i = begin; i != end; ++i)
+                objects[i].second.get().setClean();
+            continue;
+        }
+
+        sceneObjects.clear();
+        for(std::size_t i = begin; i != end; ++i)
+            sceneObjects.push_back(objects[i].second);
+        AbstractObject<dimensions, T>::setClean(sceneObjects);
+    }
+
+    /* Update the leaves. Bounds of objects that weren't dirty (e.g. when the
+       bounds were just added) need to be computed explicitly. */
+    for(Bounds<dimensions, T>* bounds: _dirty) {
+        if(!bounds) continue;
+
+        bounds->_dirtyListed = false;
+        if(bounds->_absoluteBoundsDirty)
+            bounds->clean(bounds->object().absoluteTransformationMatrix());
+        updateLeaf(*bounds);
+    }
+
+    _dirty.clear();
+}
+
+template<UnsignedInt dimensions, class T> std::vector<Bounds<dimensions, T>*> SpatialIndex<dimensions, T>::range(const RangeTypeFor<dimensions, T>& range) {
+    setClean();
+
+    std::vector<Bounds<dimensions, T>*> out;
+    if(_root == -1) return out;
+
+    std::vector<Int> stack{_root};
+    while(!stack.empty()) {
+        const Node& node = _nodes[stack.back()];
+        stack.pop_back();
+
+        if(!Implementation::boundsIntersect<dimensions, T>(node.bounds, range))
+            continue;
+
+        if(node.leaf) {
+            if(Implementation::boundsIntersect<dimensions, T>(node.leaf->_absoluteBounds, range))
+                out.push_back(node.leaf);
+        } else {
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+        }
+    }
+
+    return out;
+}
+
+template<UnsignedInt dimensions, class T> std::vector<std::pair<Bounds<dimensions, T>*, T>> SpatialIndex<dimensions, T>::ray(const VectorTypeFor<dimensions, T>& origin, const VectorTypeFor<dimensions, T>& direction, const T maxDistance) {
+    setClean();
+
+    std::vector<std::pair<Bounds<dimensions, T>*, T>> out;
+    if(_root == -1) return out;
+
+    /* Slab test, returns distance of the intersection or infinity. Zero
+       direction components are clamped to avoid 0*inf = NaN for rays going
+       exactly along a box face. */
+    VectorTypeFor<dimensions, T> inverseDirection;
+    for(UnsignedInt i = 0; i != dimensions; ++i)
+        inverseDirection[i] = T(1)/(std::abs(direction[i]) < T(1.0e-30) ? std::copysign(T(1.0e-30), direction[i]) : direction[i]);
+    auto intersect = [&origin, &inverseDirection, maxDistance](const RangeTypeFor<dimensions, T>& bounds) {
+        const VectorTypeFor<dimensions, T> a = (bounds.min() - origin)*inverseDirection;
+        const VectorTypeFor<dimensions, T> b = (bounds.max() - origin)*inverseDirection;
+        const T begin = Math::max(Math::min(a, b).max(), T(0));
+        const T end = Math::max(a, b).min();
+        return begin <= end && begin <= maxDistance ? begin : Math::Constants<T>::inf();
+    };
+
+    std::vector<Int> stack{_root};
+    while(!stack.empty()) {
+        const Node& node = _nodes[stack.back()];
+        stack.pop_back();
+
+        if(intersect(node.bounds) == Math::Constants<T>::inf())
+            continue;
+
+        if(node.leaf) {
+            const T distance = intersect(node.leaf->_absoluteBounds);
+            if(distance != Math::Constants<T>::inf())
+                out.emplace_back(node.leaf, distance);
+        } else {
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+        }
+    }
+
+    std::sort(out.begin(), out.end(), [](const std::pair<Bounds<dimensions, T>*, T>& a, const std::pair<Bounds<dimensions, T>*, T>& b) {
+        return a.second < b.second;
+    });
+    return out;
+}
+
+template<UnsignedInt dimensions, class T> std::vector<Bounds<dimensions, T>*> SpatialIndex<dimensions, T>::nearest(const VectorTypeFor<dimensions, T>& point, const std::size_t count) {
+    setClean();
+
+    std::vector<Bounds<dimensions, T>*> out;
+    if(_root == -1 || !count) return out;
+
+    /* Best-first traversal. Internal nodes are queued with distance to their
+       bounds, leaves with distance to the actual object bounds, which is
+       never smaller. Thus when a leaf is at the top of the queue, nothing
+       nearer can be found in the rest of the hierarchy. */
+    auto distance = [this, &point](Int node) {
+        return Implementation::boundsDistanceSquared<dimensions, T>(_nodes[node].leaf ? _nodes[node].leaf->_absoluteBounds : _nodes[node].bounds, point);
+    };
+    std::priority_queue<std::pair<T, Int>, std::vector<std::pair<T, Int>>, std::greater<std::pair<T, Int>>> queue;
+    queue.emplace(distance(_root), _root);
+    while(!queue.empty()) {
+        const Node& node = _nodes[queue.top().second];
+        queue.pop();
+
+        if(node.leaf) {
+            out.push_back(node.leaf);
+            if(out.size() == count) break;
+        } else {
+            queue.emplace(distance(node.left), node.left);
+            queue.emplace(distance(node.right), node.right);
+        }
+    }
+
+    return out;
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::addToDirtyList(Bounds<dimensions, T>& bounds) {
+    if(bounds._dirtyListed) return;
+
+    bounds._dirtyListed = true;
+    bounds._dirtyIndex = _dirty.size();
+    _dirty.push_back(&bounds);
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::removeFromDirtyList(Bounds<dimensions, T>& bounds) {
+    if(!bounds._dirtyListed) return;
+
+    _dirty[bounds._dirtyIndex] = nullptr;
+    bounds._dirtyListed = false;
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::removeLeaf(Bounds<dimensions, T>& bounds) {
+    removeFromDirtyList(bounds);
+    if(bounds._leaf == -1) return;
+
+    removeNode(bounds._leaf);
+    freeNode(bounds._leaf);
+    bounds._leaf = -1;
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::updateLeaf(Bounds<dimensions, T>& bounds) {
+    /* Still inside the enlarged bounds, nothing to do */
+    if(bounds._leaf != -1) {
+        if(Implementation::boundsContain<dimensions, T>(_nodes[bounds._leaf].bounds, bounds._absoluteBounds))
+            return;
+
+        removeNode(bounds._leaf);
+
+    /* New leaf */
+    } else {
+        bounds._leaf = allocateNode();
+        _nodes[bounds._leaf].leaf = &bounds;
+    }
+
+    _nodes[bounds._leaf].bounds = bounds._absoluteBounds.padded(bounds._absoluteBounds.size()*_margin);
+    insertNode(bounds._leaf);
+}
+
+template<UnsignedInt dimensions, class T> Int SpatialIndex<dimensions, T>::allocateNode() {
+    Int node;
+    if(_freeNode != -1) {
+        node = _freeNode;
+        _freeNode = _nodes[node].parent;
+    } else {
+        node = Int(_nodes.size());
+        _nodes.emplace_back();
+    }
+
+    _nodes[node].parent = _nodes[node].left = _nodes[node].right = -1;
+    _nodes[node].height = 0;
+    _nodes[node].leaf = nullptr;
+    return node;
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::freeNode(const Int node) {
+    _nodes[node].parent = _freeNode;
+    _nodes[node].leaf = nullptr;
+    _freeNode = node;
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::insertNode(const Int leaf) {
+    _nodes[leaf].parent = -1;
+    if(_root == -1) {
+        _root = leaf;
+        return;
+    }
+
+    /* Find the best sibling for the new leaf, descending into the child
+       whose cost increases the least */
+    const RangeTypeFor<dimensions, T> leafBounds = _nodes[leaf].bounds;
+    Int sibling = _root;
+    while(!_nodes[sibling].leaf) {
+        const T measure = Implementation::boundsMeasure<dimensions, T>(_nodes[sibling].bounds);
+        const T joinedMeasure = Implementation::boundsMeasure<dimensions, T>(Implementation::boundsJoin<dimensions, T>(_nodes[sibling].bounds, leafBounds));
+
+        /* Cost of creating new parent for this node and the leaf and minimum
+           cost of pushing the leaf further down */
+        const T cost = T(2)*joinedMeasure;
+        const T inheritanceCost = T(2)*(joinedMeasure - measure);
+        auto childCost = [this, &leafBounds, inheritanceCost](Int child) {
+            const T joined = Implementation::boundsMeasure<dimensions, T>(Implementation::boundsJoin<dimensions, T>(_nodes[child].bounds, leafBounds));
+            return _nodes[child].leaf ? joined + inheritanceCost :
+                joined - Implementation::boundsMeasure<dimensions, T>(_nodes[child].bounds) + inheritanceCost;
+        };
+        const T leftCost = childCost(_nodes[sibling].left);
+        const T rightCost = childCost(_nodes[sibling].right);
+
+        if(cost < leftCost && cost < rightCost) break;
+        sibling = leftCost < rightCost ? _nodes[sibling].left : _nodes[sibling].right;
+    }
+
+    /* Create new parent for the sibling and the leaf */
+    const Int oldParent = _nodes[sibling].parent;
+    const Int parent = allocateNode();
+    _nodes[parent].parent = oldParent;
+    _nodes[parent].left = sibling;
+    _nodes[parent].right = leaf;
+    _nodes[parent].height = _nodes[sibling].height + 1;
+    _nodes[parent].bounds = Implementation::boundsJoin<dimensions, T>(_nodes[sibling].bounds, leafBounds);
+    _nodes[sibling].parent = parent;
+    _nodes[leaf].parent = parent;
+
+    if(oldParent == -1) _root = parent;
+    else if(_nodes[oldParent].left == sibling) _nodes[oldParent].left = parent;
+    else _nodes[oldParent].right = parent;
+
+    refit(oldParent);
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::removeNode(const Int leaf) {
+    if(leaf == _root) {
+        _root = -1;
+        return;
+    }
+
+    /* Replace the parent with the sibling */
+    const Int parent = _nodes[leaf].parent;
+    const Int grandParent = _nodes[parent].parent;
+    const Int sibling = _nodes[parent].left == leaf ? _nodes[parent].right : _nodes[parent].left;
+    _nodes[sibling].parent = grandParent;
+    if(grandParent == -1) _root = sibling;
+    else if(_nodes[grandParent].left == parent) _nodes[grandParent].left = sibling;
+    else _nodes[grandParent].right = sibling;
+
+    freeNode(parent);
+    refit(grandParent);
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::refit(Int node) {
+    while(node != -1) {
+        node = balance(node);
+
+        Node& n = _nodes[node];
+        n.height = std::max(_nodes[n.left].height, _nodes[n.right].height) + 1;
+        n.bounds = Implementation::boundsJoin<dimensions, T>(_nodes[n.left].bounds, _nodes[n.right].bounds);
+        node = n.parent;
+    }
+}
+
+/* Rotates the taller child up if the subtree is imbalanced, returns the new
+   subtree root */
+template<UnsignedInt dimensions, class T> Int SpatialIndex<dimensions, T>::balance(const Int a) {
+    if(_nodes[a].leaf || _nodes[a].height < 2) return a;
+
+    const Int b = _nodes[a].left;
+    const Int c = _nodes[a].right;
+    const Int difference = _nodes[c].height - _nodes[b].height;
+    if(difference >= -1 && difference <= 1) return a;
+
+    /* The taller child (up) takes place of a, a becomes its child, together
+       with the shorter grandchild (down). The other child of a (stays)
+       remains. */
+    const Int up = difference > 1 ? c : b;
+    const Int stays = difference > 1 ? b : c;
+    const Int upLeft = _nodes[up].left;
+    const Int upRight = _nodes[up].right;
+    const Int taller = _nodes[upLeft].height > _nodes[upRight].height ? upLeft : upRight;
+    const Int down = taller == upLeft ? upRight : upLeft;
+
+    /* Swap a and up */
+    _nodes[up].parent = _nodes[a].parent;
+    _nodes[a].parent = up;
+    if(_nodes[up].parent == -1) _root = up;
+    else if(_nodes[_nodes[up].parent].left == a) _nodes[_nodes[up].parent].left = up;
+    else _nodes[_nodes[up].parent].right = up;
+
+    /* The taller grandchild stays with up, the shorter goes down to a */
+    _nodes[up].left = a;
+    _nodes[up].right = taller;
+    if(difference > 1) _nodes[a].right = down;
+    else _nodes[a].left = down;
+    _nodes[down].parent = a;
+
+    _nodes[a].height = std::max(_nodes[stays].height, _nodes[down].height) + 1;
+    _nodes[a].bounds = Implementation::boundsJoin<dimensions, T>(_nodes[stays].bounds, _nodes[down].bounds);
+    _nodes[up].height = std::max(_nodes[a].height, _nodes[taller].height) + 1;
+    _nodes[up].bounds = Implementation::boundsJoin<dimensions, T>(_nodes[a].bounds, _nodes[taller].bounds);
+    return up;
+}
+
+}}
+
+#endif
@@ -23,7 +23,9 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <memory>
 #include <sstream>
+#include <vector>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/SceneGraph/Animable.h"
@@ -41,6 +43,12 @@ struct AnimableTest: TestSuite::Tester {
     void repeat();
     void stop();
     void pause();
+    void addRemove();
+    void addRemoveFeatureGroup();
+    void destroyRunning();
+    void addRemoveInStep();
+    void stepParallel();
+    void stepParallelDeleteDeferred();
 
     void debug();
 };
@@ -54,6 +62,12 @@ AnimableTest::AnimableTest() {
               &AnimableTest::repeat,
               &AnimableTest::stop,
               &AnimableTest::pause,
+              &AnimableTest::addRemove,
+              &AnimableTest::addRemoveFeatureGroup,
+              &AnimableTest::destroyRunning,
+              &AnimableTest::addRemoveInStep,
+              &AnimableTest::stepParallel,
+              &AnimableTest::stepParallelDeleteDeferred,
 
               &AnimableTest::debug});
 }
@@ -351,6 +365,223 @@ void AnimableTest::pause() {
     CORRADE_COMPARE(animable.time, 2.0f);
 }
 
+void AnimableTest::addRemove() {
+    Object3D object;
+    AnimableGroup3D group;
+    AnimableGroup3D another;
+    OneShotAnimable animable(object, &group);
+
+    group.step(1.0f, 0.5f);
+    CORRADE_COMPARE(group.runningCount(), 1);
+    CORRADE_COMPARE(animable.time, 0.0f);
+
+    /* Moving running animable to another group, it shouldn't be stepped by
+       the original group anymore */
+    another.add(animable);
+    CORRADE_VERIFY(group.isEmpty());
+    group.step(1.5f, 0.5f);
+    CORRADE_COMPARE(animable.time, 0.0f);
+    another.step(2.0f, 0.5f);
+    CORRADE_COMPARE(animable.time, 1.0f);
+
+    /* Removed animable is not stepped */
+    another.remove(animable);
+    another.step(2.5f, 0.5f);
+    CORRADE_COMPARE(animable.time, 1.0f);
+
+    /* Adding it back continues */
+    group.add(animable);
+    group.step(3.0f, 0.5f);
+    CORRADE_COMPARE(animable.time, 2.0f);
+}
+
+void AnimableTest::addRemoveFeatureGroup() {
+    Object3D object;
+    AnimableGroup3D group;
+    AnimableGroup3D another;
+    OneShotAnimable animable(object, &group);
+
+    group.step(1.0f, 0.5f);
+    CORRADE_COMPARE(group.runningCount(), 1);
+
+    /* Going through the base class interface should do the same
+       bookkeeping */
+    FeatureGroup3D<Animable3D>& base = another;
+    base.add(animable);
+    CORRADE_COMPARE(group.runningCount(), 0);
+    CORRADE_COMPARE(another.runningCount(), 1);
+    group.step(1.5f, 0.5f);
+    CORRADE_COMPARE(animable.time, 0.0f);
+    another.step(2.0f, 0.5f);
+    CORRADE_COMPARE(animable.time, 1.0f);
+
+    base.remove(animable);
+    CORRADE_COMPARE(another.runningCount(), 0);
+    another.step(2.5f, 0.5f);
+    CORRADE_COMPARE(animable.time, 1.0f);
+}
+
+void AnimableTest::destroyRunning() {
+    Object3D object;
+    AnimableGroup3D group;
+    OneShotAnimable* a = new OneShotAnimable(object, &group);
+    OneShotAnimable b(object, &group);
+    group.step(1.0f, 0.5f);
+    CORRADE_COMPARE(group.runningCount(), 2);
+
+    /* The destroyed animable shouldn't be accessed anymore */
+    delete a;
+    group.step(1.5f, 0.5f);
+    CORRADE_COMPARE(b.time, 0.5f);
+
+    /* Destroying the group before a running animable shouldn't crash */
+    {
+        AnimableGroup3D shortLived;
+        shortLived.add(b);
+        shortLived.step(2.0f, 0.5f);
+    }
+    CORRADE_VERIFY(!b.animables());
+}
+
+void AnimableTest::addRemoveInStep() {
+    class CountingAnimable: public SceneGraph::Animable3D {
+        public:
+            CountingAnimable(AbstractObject3D& object, AnimableGroup3D* group): SceneGraph::Animable3D(object, group), steps(0) {
+                setState(AnimationState::Running);
+            }
+
+            Int steps;
+
+        protected:
+            void animationStep(Float, Float) override { ++steps; }
+    };
+
+    class ReaddingAnimable: public SceneGraph::Animable3D {
+        public:
+            ReaddingAnimable(AbstractObject3D& object, AnimableGroup3D* group, CountingAnimable& victim): SceneGraph::Animable3D(object, group), victim(victim), done(false) {
+                setState(AnimationState::Running);
+            }
+
+            CountingAnimable& victim;
+            bool done;
+
+        protected:
+            void animationStep(Float, Float) override {
+                if(done) return;
+                done = true;
+
+                AnimableGroup3D* const group = victim.animables();
+                group->remove(victim);
+                group->add(victim);
+            }
+    };
+
+    Object3D object;
+    AnimableGroup3D group;
+
+    /* The victim is processed first, then removed and added back by the
+       second one. It shouldn't be stepped again in the same step. */
+    CountingAnimable victim{object, &group};
+    ReaddingAnimable readding{object, &group, victim};
+
+    group.step(1.0f, 0.5f);
+    CORRADE_COMPARE(victim.steps, 1);
+    CORRADE_COMPARE(group.runningCount(), 2);
+
+    /* But it's still in the active list for the next step */
+    group.step(1.5f, 0.5f);
+    CORRADE_COMPARE(victim.steps, 2);
+    CORRADE_COMPARE(group.runningCount(), 2);
+}
+
+void AnimableTest::stepParallel() {
+    class ThreadSafeAnimable: public SceneGraph::Animable3D {
+        public:
+            ThreadSafeAnimable(AbstractObject3D& object, AnimableGroup3D* group, bool threadSafe): SceneGraph::Animable3D(object, group), time(-1.0f), delta(0.0f) {
+                setThreadSafe(threadSafe);
+                setState(AnimationState::Running);
+            }
+
+            Float time, delta;
+
+        protected:
+            void animationStep(Float time, Float delta) override {
+                this->time = time;
+                this->delta = delta;
+            }
+    };
+
+    Object3D object;
+    AnimableGroup3D group;
+    CORRADE_COMPARE(group.threadCount(), 1);
+    group.setThreadCount(4);
+    CORRADE_COMPARE(group.threadCount(), 4);
+
+    std::vector<std::unique_ptr<ThreadSafeAnimable>> animables;
+    for(std::size_t i = 0; i != 37; ++i)
+        animables.emplace_back(new ThreadSafeAnimable{object, &group, i % 5 != 0});
+    CORRADE_VERIFY(animables[1]->isThreadSafe());
+    CORRADE_VERIFY(!animables[5]->isThreadSafe());
+
+    group.step(1.0f, 0.5f);
+    group.step(3.0f, 0.25f);
+    CORRADE_COMPARE(group.runningCount(), 37);
+    for(auto& animable: animables) {
+        CORRADE_COMPARE(animable->time, 2.0f);
+        CORRADE_COMPARE(animable->delta, 0.25f);
+    }
+}
+
+void AnimableTest::stepParallelDeleteDeferred() {
+    class DeferredAnimable: public SceneGraph::Animable3D {
+        public:
+            DeferredAnimable(AbstractObject3D& object, AnimableGroup3D* group): SceneGraph::Animable3D(object, group), steps(0) {
+                setThreadSafe(true);
+                setState(AnimationState::Running);
+            }
+
+            Int steps;
+
+        protected:
+            void animationStep(Float, Float) override { ++steps; }
+    };
+
+    class DeletingAnimable: public SceneGraph::Animable3D {
+        public:
+            DeletingAnimable(AbstractObject3D& object, AnimableGroup3D* group, DeferredAnimable*& victim): SceneGraph::Animable3D(object, group), victim(victim) {
+                setState(AnimationState::Running);
+            }
+
+            DeferredAnimable*& victim;
+
+        protected:
+            void animationStep(Float, Float) override {
+                delete victim;
+                victim = nullptr;
+            }
+    };
+
+    Object3D object;
+    AnimableGroup3D group;
+    group.setThreadCount(2);
+
+    /* The deferred animable is processed first, then deleted by the second
+       one before the deferred steps are executed */
+    DeferredAnimable* deferred = new DeferredAnimable{object, &group};
+    DeferredAnimable another{object, &group};
+    DeletingAnimable deleting{object, &group, deferred};
+
+    group.step(1.0f, 0.5f);
+    CORRADE_VERIFY(!deferred);
+    CORRADE_COMPARE(another.steps, 1);
+    CORRADE_COMPARE(group.runningCount(), 2);
+
+    /* Changing thread count recreates the workers */
+    group.setThreadCount(3);
+    group.step(1.5f, 0.5f);
+    CORRADE_COMPARE(another.steps, 2);
+}
+
 void AnimableTest::debug() {
     std::ostringstream o;
     Debug(&o) << AnimationState::Running;
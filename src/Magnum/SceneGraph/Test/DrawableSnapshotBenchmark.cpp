@@ -0,0 +1,208 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/DrawableSnapshot.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/Test/BenchmarkTimer.h"
+
+#ifdef MAGNUM_BUILD_MULTITHREADED
+#include <atomic>
+#include <thread>
+#endif
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct DrawableSnapshotBenchmark: TestSuite::Tester {
+    explicit DrawableSnapshotBenchmark();
+
+    void drawDirect();
+    void capture();
+    void flip();
+    #ifdef MAGNUM_BUILD_MULTITHREADED
+    void flipConcurrent();
+    #endif
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+namespace {
+
+constexpr std::size_t ObjectCount = 4096;
+constexpr std::size_t Iterations = 100;
+
+class Drawable: public SceneGraph::Drawable3D {
+    public:
+        Drawable(AbstractObject3D& object, DrawableGroup3D* group): SceneGraph::Drawable3D(object, group) {}
+
+        Matrix4 result;
+
+    protected:
+        void draw(const Matrix4& transformationMatrix, Camera3D&) override {
+            result = transformationMatrix;
+        }
+};
+
+/* Scene with a few levels of hierarchy, all objects are drawable. The
+   objects and drawables are owned by the scene. */
+struct BenchmarkScene {
+    BenchmarkScene(): cameraObject(&scene), camera(cameraObject) {
+        cameraObject.translate(Vector3::zAxis(10.0f));
+
+        objects.reserve(ObjectCount);
+        drawables.reserve(ObjectCount);
+        for(std::size_t i = 0; i != ObjectCount; ++i) {
+            Object3D* parent = i < 16 ? static_cast<Object3D*>(&scene) : objects[i/16 - 1];
+            objects.push_back(new Object3D(parent));
+            objects.back()->translate(Vector3::xAxis(Float(i%16)))
+                .rotateY(Deg(Float(i%360)));
+            drawables.push_back(new Drawable(*objects.back(), &group));
+        }
+    }
+
+    DrawableGroup3D group;
+    Scene3D scene;
+    Object3D cameraObject;
+    Camera3D camera;
+    std::vector<Object3D*> objects;
+    std::vector<Drawable*> drawables;
+};
+
+}
+
+DrawableSnapshotBenchmark::DrawableSnapshotBenchmark() {
+    addTests({&DrawableSnapshotBenchmark::drawDirect,
+              &DrawableSnapshotBenchmark::capture,
+              &DrawableSnapshotBenchmark::flip,
+              #ifdef MAGNUM_BUILD_MULTITHREADED
+              &DrawableSnapshotBenchmark::flipConcurrent
+              #endif
+              });
+}
+
+void DrawableSnapshotBenchmark::drawDirect() {
+    BenchmarkScene s;
+
+    /* Baseline: drawing directly, which needs the scene to be not modified
+       while drawing */
+    Magnum::Test::BenchmarkTimer timer{Iterations};
+    timer.start();
+    for(std::size_t i = 0; i != Iterations; ++i) {
+        s.objects[0]->translate(Vector3::yAxis(0.1f));
+        s.camera.draw(s.group);
+    }
+    timer.stop();
+
+    CORRADE_VERIFY(s.drawables.back()->result != Matrix4());
+    Debug() << "   " << ObjectCount << "drawables, Camera::draw():" << timer.microseconds() << "us per frame";
+}
+
+void DrawableSnapshotBenchmark::capture() {
+    BenchmarkScene s;
+    DrawableSnapshot3D snapshot;
+
+    Magnum::Test::BenchmarkTimer captureTimer{Iterations}, drawTimer{Iterations};
+    for(std::size_t i = 0; i != Iterations; ++i) {
+        s.objects[0]->translate(Vector3::yAxis(0.1f));
+
+        captureTimer.start();
+        snapshot.capture(s.group, s.camera);
+        captureTimer.stop();
+
+        drawTimer.start();
+        snapshot.acquire();
+        snapshot.draw(s.camera);
+        snapshot.release();
+        drawTimer.stop();
+    }
+
+    CORRADE_VERIFY(s.drawables.back()->result != Matrix4());
+    Debug() << "   " << ObjectCount << "drawables, capture():" << captureTimer.microseconds() << "us, draw():" << drawTimer.microseconds() << "us per frame";
+}
+
+void DrawableSnapshotBenchmark::flip() {
+    Scene3D scene;
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    DrawableGroup3D group;
+    DrawableSnapshot3D snapshot;
+
+    /* Empty group, measures just the synchronization and buffer swap */
+    Magnum::Test::BenchmarkTimer timer{Iterations};
+    timer.start();
+    for(std::size_t i = 0; i != Iterations; ++i) {
+        snapshot.capture(group, camera);
+        snapshot.acquire();
+        snapshot.release();
+    }
+    timer.stop();
+
+    CORRADE_VERIFY(!snapshot.acquire());
+    snapshot.release();
+    Debug() << "    uncontended flip:" << timer.microseconds() << "us per frame";
+}
+
+#ifdef MAGNUM_BUILD_MULTITHREADED
+void DrawableSnapshotBenchmark::flipConcurrent() {
+    BenchmarkScene s;
+    DrawableSnapshot3D snapshot;
+
+    /* Render thread continuously drawing the latest snapshot */
+    std::atomic<bool> done{false};
+    std::size_t frames = 0;
+    std::thread render{[&]() {
+        while(!done) {
+            if(snapshot.acquire()) {
+                snapshot.draw(s.camera);
+                ++frames;
+            }
+            snapshot.release();
+        }
+    }};
+
+    Magnum::Test::BenchmarkTimer timer{Iterations};
+    timer.start();
+    for(std::size_t i = 0; i != Iterations; ++i) {
+        s.objects[0]->translate(Vector3::yAxis(0.1f));
+        snapshot.capture(s.group, s.camera);
+    }
+    timer.stop();
+
+    done = true;
+    render.join();
+
+    CORRADE_VERIFY(frames <= Iterations);
+    Debug() << "   " << ObjectCount << "drawables, capture() with concurrent draw:" << timer.microseconds() << "us per frame," << frames << "frames drawn";
+}
+#endif
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::DrawableSnapshotBenchmark)
@@ -0,0 +1,208 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/DrawableSnapshot.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct DrawableSnapshotTest: TestSuite::Tester {
+    explicit DrawableSnapshotTest();
+
+    void capture();
+    void draw();
+    void acquireRelease();
+    void captureWhileAcquired();
+    void noScene();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+namespace {
+
+class Drawable: public SceneGraph::Drawable3D {
+    public:
+        Drawable(AbstractObject3D& object, DrawableGroup3D* group, Matrix4& result): SceneGraph::Drawable3D(object, group), result(result) {}
+
+    protected:
+        void draw(const Matrix4& transformationMatrix, Camera3D&) override {
+            result = transformationMatrix;
+        }
+
+    private:
+        Matrix4& result;
+};
+
+}
+
+DrawableSnapshotTest::DrawableSnapshotTest() {
+    addTests({&DrawableSnapshotTest::capture,
+              &DrawableSnapshotTest::draw,
+              &DrawableSnapshotTest::acquireRelease,
+              &DrawableSnapshotTest::captureWhileAcquired,
+              &DrawableSnapshotTest::noScene});
+}
+
+void DrawableSnapshotTest::capture() {
+    DrawableGroup3D group;
+    Scene3D scene;
+
+    Object3D first(&scene);
+    first.scale(Vector3(5.0f));
+    Matrix4 firstResult;
+    Drawable firstDrawable(first, &group, firstResult);
+
+    Object3D second(&first);
+    second.translate(Vector3::yAxis(3.0f));
+    Matrix4 secondResult;
+    Drawable secondDrawable(second, &group, secondResult);
+
+    Object3D cameraObject(&scene);
+    cameraObject.translate(Vector3::zAxis(2.0f));
+    Camera3D camera(cameraObject);
+
+    DrawableSnapshot3D snapshot;
+    snapshot.capture(group, camera);
+
+    /* Modifying the scene after capture doesn't affect the snapshot */
+    first.translate(Vector3::xAxis(1.0f));
+
+    CORRADE_VERIFY(snapshot.acquire());
+    CORRADE_COMPARE(snapshot.size(), 2);
+    CORRADE_COMPARE(&snapshot.drawable(0), &firstDrawable);
+    CORRADE_COMPARE(&snapshot.drawable(1), &secondDrawable);
+    CORRADE_COMPARE(snapshot.cameraMatrix(), Matrix4::translation(Vector3::zAxis(-2.0f)));
+    CORRADE_COMPARE(snapshot.absoluteTransformationMatrix(0), Matrix4::scaling(Vector3(5.0f)));
+    CORRADE_COMPARE(snapshot.absoluteTransformationMatrix(1), Matrix4::scaling(Vector3(5.0f))*Matrix4::translation(Vector3::yAxis(3.0f)));
+    snapshot.release();
+
+    /* Nothing new was captured */
+    CORRADE_VERIFY(!snapshot.acquire());
+    CORRADE_COMPARE(snapshot.absoluteTransformationMatrix(0), Matrix4::scaling(Vector3(5.0f)));
+    snapshot.release();
+
+    /* Capture the modified scene */
+    snapshot.capture(group, camera);
+    CORRADE_VERIFY(snapshot.acquire());
+    CORRADE_COMPARE(snapshot.absoluteTransformationMatrix(0), Matrix4::translation(Vector3::xAxis(1.0f))*Matrix4::scaling(Vector3(5.0f)));
+    snapshot.release();
+}
+
+void DrawableSnapshotTest::draw() {
+    DrawableGroup3D group;
+    Scene3D scene;
+
+    Object3D first(&scene);
+    first.scale(Vector3(5.0f));
+    Matrix4 firstResult;
+    Drawable firstDrawable(first, &group, firstResult);
+
+    Object3D cameraObject(&scene);
+    cameraObject.translate(Vector3::zAxis(2.0f));
+    Camera3D camera(cameraObject);
+
+    DrawableSnapshot3D snapshot;
+    snapshot.capture(group, camera);
+
+    /* Moving the camera after capture doesn't affect the snapshot */
+    cameraObject.translate(Vector3::zAxis(5.0f));
+
+    snapshot.acquire();
+    snapshot.draw(camera);
+    snapshot.release();
+
+    /* Should give the same result as drawing directly */
+    Matrix4 expected = Matrix4::translation(Vector3::zAxis(-2.0f))*Matrix4::scaling(Vector3(5.0f));
+    CORRADE_COMPARE(firstResult, expected);
+}
+
+void DrawableSnapshotTest::acquireRelease() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    DrawableSnapshot3D snapshot;
+    snapshot.release();
+    CORRADE_VERIFY(!snapshot.acquire());
+    snapshot.acquire();
+
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::DrawableSnapshot::release(): the snapshot is not acquired\n"
+        "SceneGraph::DrawableSnapshot::acquire(): the snapshot is already acquired\n");
+}
+
+void DrawableSnapshotTest::captureWhileAcquired() {
+    DrawableGroup3D group;
+    Scene3D scene;
+
+    Object3D object(&scene);
+    Matrix4 result;
+    Drawable drawable(object, &group, result);
+
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+
+    DrawableSnapshot3D snapshot;
+    snapshot.capture(group, camera);
+    CORRADE_VERIFY(snapshot.acquire());
+
+    /* Capturing while the front buffer is acquired doesn't wait and doesn't
+       affect the acquired buffer */
+    for(Int i = 1; i != 4; ++i) {
+        object.resetTransformation().translate(Vector3::xAxis(Float(i)));
+        snapshot.capture(group, camera);
+        CORRADE_COMPARE(snapshot.absoluteTransformationMatrix(0), Matrix4());
+    }
+    snapshot.release();
+
+    /* Only the latest capture is acquired, the others are skipped */
+    CORRADE_VERIFY(snapshot.acquire());
+    CORRADE_COMPARE(snapshot.absoluteTransformationMatrix(0), Matrix4::translation(Vector3::xAxis(3.0f)));
+    snapshot.release();
+    CORRADE_VERIFY(!snapshot.acquire());
+    snapshot.release();
+}
+
+void DrawableSnapshotTest::noScene() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    DrawableGroup3D group;
+    Object3D cameraObject;
+    Camera3D camera(cameraObject);
+
+    DrawableSnapshot3D snapshot;
+    snapshot.capture(group, camera);
+    CORRADE_COMPARE(out.str(), "SceneGraph::DrawableSnapshot::capture(): camera is not part of any scene\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::DrawableSnapshotTest)
@@ -0,0 +1,243 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/AnimableGroup.h"
+#include "Magnum/SceneGraph/KeyframeAnimable.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/RigidMatrixTransformation3D.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct KeyframeAnimableTest: TestSuite::Tester {
+    explicit KeyframeAnimableTest();
+
+    void sample();
+    void clamp();
+    void seek();
+    void noChannels();
+    void noScaling();
+    void step();
+
+    void invalidTrack();
+    void invalidKeyframes();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Object<SceneGraph::RigidMatrixTransformation3D> RigidObject3D;
+
+KeyframeAnimableTest::KeyframeAnimableTest() {
+    addTests({&KeyframeAnimableTest::sample,
+              &KeyframeAnimableTest::clamp,
+              &KeyframeAnimableTest::seek,
+              &KeyframeAnimableTest::noChannels,
+              &KeyframeAnimableTest::noScaling,
+              &KeyframeAnimableTest::step,
+
+              &KeyframeAnimableTest::invalidTrack,
+              &KeyframeAnimableTest::invalidKeyframes});
+}
+
+namespace {
+    constexpr Float TranslationTimes[]{0.0f, 1.0f, 3.0f};
+    const Vector3 Translations[]{{}, {1.0f, 0.0f, 0.0f}, {1.0f, 2.0f, 0.0f}};
+
+    constexpr Float RotationTimes[]{0.0f, 2.0f};
+    const Quaternion Rotations[]{{}, Quaternion::rotation(Deg(90.0f), Vector3::zAxis())};
+
+    constexpr Float ScalingTimes[]{0.5f, 1.5f};
+    const Vector3 Scalings[]{Vector3(1.0f), Vector3(3.0f)};
+
+    void addTracks(KeyframeAnimable3D& animation, Object3D& object) {
+        const std::size_t track = animation.addTrack(object);
+        animation.setTranslationKeyframes(track, TranslationTimes, Translations)
+            .setRotationKeyframes(track, RotationTimes, Rotations)
+            .setScalingKeyframes(track, ScalingTimes, Scalings);
+    }
+}
+
+void KeyframeAnimableTest::sample() {
+    Object3D root, object{&root};
+    KeyframeAnimable3D animation{root};
+    addTracks(animation, object);
+    CORRADE_COMPARE(animation.trackCount(), 1);
+    CORRADE_COMPARE(animation.duration(), 3.0f);
+
+    animation.sample(1.0f);
+    CORRADE_COMPARE(animation.translation(0), (Vector3{1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(animation.rotation(0), Quaternion::rotation(Deg(45.0f), Vector3::zAxis()));
+    CORRADE_COMPARE(animation.scaling(0), Vector3(2.0f));
+    CORRADE_COMPARE(object.transformationMatrix(),
+        Matrix4::translation({1.0f, 0.0f, 0.0f})*
+        Matrix4::rotationZ(Deg(45.0f))*
+        Matrix4::scaling(Vector3(2.0f)));
+
+    animation.sample(2.0f);
+    CORRADE_COMPARE(animation.translation(0), (Vector3{1.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(animation.rotation(0), Quaternion::rotation(Deg(90.0f), Vector3::zAxis()));
+    CORRADE_COMPARE(animation.scaling(0), Vector3(3.0f));
+}
+
+void KeyframeAnimableTest::clamp() {
+    Object3D root, object{&root};
+    KeyframeAnimable3D animation{root};
+    addTracks(animation, object);
+
+    animation.sample(-1.0f);
+    CORRADE_COMPARE(animation.translation(0), Vector3{});
+    CORRADE_COMPARE(animation.rotation(0), Quaternion{});
+    CORRADE_COMPARE(animation.scaling(0), Vector3(1.0f));
+    CORRADE_COMPARE(object.transformationMatrix(), Matrix4{});
+
+    animation.sample(10.0f);
+    CORRADE_COMPARE(animation.translation(0), (Vector3{1.0f, 2.0f, 0.0f}));
+    CORRADE_COMPARE(animation.rotation(0), Quaternion::rotation(Deg(90.0f), Vector3::zAxis()));
+    CORRADE_COMPARE(animation.scaling(0), Vector3(3.0f));
+}
+
+void KeyframeAnimableTest::seek() {
+    Object3D root, object{&root};
+    KeyframeAnimable3D animation{root};
+    addTracks(animation, object);
+
+    /* Sequential playback followed by jumps in both directions should give
+       the same result as sampling a fresh animation */
+    for(Float time: {0.0f, 0.1f, 0.2f, 0.7f, 1.2f, 1.9f, 2.6f, 2.9f, 0.3f, 1.4f, 2.8f, 0.0f, 3.0f}) {
+        Object3D freshObject{&root};
+        KeyframeAnimable3D fresh{root};
+        addTracks(fresh, freshObject);
+
+        animation.sample(time);
+        fresh.sample(time);
+        CORRADE_COMPARE(animation.translation(0), fresh.translation(0));
+        CORRADE_COMPARE(animation.rotation(0), fresh.rotation(0));
+        CORRADE_COMPARE(animation.scaling(0), fresh.scaling(0));
+    }
+}
+
+void KeyframeAnimableTest::noChannels() {
+    Object3D root, object{&root};
+    object.translate({1.0f, 2.0f, 3.0f});
+
+    KeyframeAnimable3D animation{root};
+    animation.addTrack(object);
+    CORRADE_COMPARE(animation.duration(), 0.0f);
+
+    /* Track without channels resets the object to identity */
+    animation.sample(0.5f);
+    CORRADE_COMPARE(animation.translation(0), Vector3{});
+    CORRADE_COMPARE(animation.rotation(0), Quaternion{});
+    CORRADE_COMPARE(animation.scaling(0), Vector3(1.0f));
+    CORRADE_COMPARE(object.transformationMatrix(), Matrix4{});
+}
+
+void KeyframeAnimableTest::noScaling() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    RigidObject3D root, object{&root};
+    KeyframeAnimable3D animation{root};
+    const std::size_t track = animation.addTrack(object);
+    animation.setRotationKeyframes(track, RotationTimes, Rotations)
+        .setTranslationKeyframes(track, TranslationTimes, Translations)
+        .setScalingKeyframes(track, ScalingTimes, Scalings);
+    CORRADE_COMPARE(out.str(), "SceneGraph::KeyframeAnimable3D::setScalingKeyframes(): object of track 0 doesn't support scaling\n");
+
+    animation.sample(1.0f);
+    CORRADE_COMPARE(object.transformationMatrix(),
+        Matrix4::translation({1.0f, 0.0f, 0.0f})*
+        Matrix4::rotationZ(Deg(45.0f)));
+}
+
+void KeyframeAnimableTest::step() {
+    Object3D root, object{&root};
+    AnimableGroup3D group;
+    KeyframeAnimable3D animation{root, &group};
+    addTracks(animation, object);
+    animation.setState(AnimationState::Running);
+
+    /* First step starts the animation */
+    group.step(1.0f, 0.5f);
+    CORRADE_COMPARE(animation.translation(0), Vector3{});
+
+    group.step(2.5f, 1.5f);
+    CORRADE_COMPARE(animation.translation(0), (Vector3{1.0f, 0.5f, 0.0f}));
+    CORRADE_COMPARE(object.transformationMatrix().translation(), (Vector3{1.0f, 0.5f, 0.0f}));
+
+    /* Duration exceeded, the animation is stopped */
+    group.step(4.5f, 2.0f);
+    CORRADE_COMPARE(animation.state(), AnimationState::Stopped);
+}
+
+void KeyframeAnimableTest::invalidTrack() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    Object3D root;
+    KeyframeAnimable3D animation{root};
+    animation.setTranslationKeyframes(0, TranslationTimes, Translations)
+        .setRotationKeyframes(0, RotationTimes, Rotations)
+        .setScalingKeyframes(0, ScalingTimes, Scalings);
+    animation.translation(0);
+    animation.rotation(0);
+    animation.scaling(0);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::KeyframeAnimable3D::setTranslationKeyframes(): track 0 out of range for 0 tracks\n"
+        "SceneGraph::KeyframeAnimable3D::setRotationKeyframes(): track 0 out of range for 0 tracks\n"
+        "SceneGraph::KeyframeAnimable3D::setScalingKeyframes(): track 0 out of range for 0 tracks\n"
+        "SceneGraph::KeyframeAnimable3D::translation(): track 0 out of range for 0 tracks\n"
+        "SceneGraph::KeyframeAnimable3D::rotation(): track 0 out of range for 0 tracks\n"
+        "SceneGraph::KeyframeAnimable3D::scaling(): track 0 out of range for 0 tracks\n");
+}
+
+void KeyframeAnimableTest::invalidKeyframes() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    Object3D root, object{&root};
+    KeyframeAnimable3D animation{root};
+    const std::size_t track = animation.addTrack(object);
+
+    const Float unsorted[]{0.0f, 2.0f, 1.0f};
+    const Quaternion notNormalized[]{{}, Quaternion{{1.0f, 0.0f, 0.0f}, 1.0f}};
+    animation.setTranslationKeyframes(track, RotationTimes, Translations)
+        .setTranslationKeyframes(track, unsorted, Translations)
+        .setTranslationKeyframes(track, TranslationTimes, Translations)
+        .setTranslationKeyframes(track, TranslationTimes, Translations)
+        .setRotationKeyframes(track, RotationTimes, notNormalized)
+        .setScalingKeyframes(track, nullptr, nullptr);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::KeyframeAnimable3D::setTranslationKeyframes(): expected the same non-zero count of times and values, got 2 and 3\n"
+        "SceneGraph::KeyframeAnimable3D::setTranslationKeyframes(): times are not sorted\n"
+        "SceneGraph::KeyframeAnimable3D::setTranslationKeyframes(): translation keyframes of track 0 already set\n"
+        "SceneGraph::KeyframeAnimable3D::setRotationKeyframes(): rotation 1 is not normalized\n"
+        "SceneGraph::KeyframeAnimable3D::setScalingKeyframes(): expected the same non-zero count of times and values, got 0 and 0\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::KeyframeAnimableTest)
@@ -158,6 +158,18 @@ void ObjectTest::scene() {
 
     CORRADE_VERIFY(childTwo->scene() == &scene);
     CORRADE_VERIFY(childOfOrphan->scene() == nullptr);
+
+    /* Reparenting updates the scene of whole subtree */
+    Object3D* subtree = new Object3D;
+    Object3D* childOfSubtree = new Object3D(subtree);
+    subtree->setParent(childTwo);
+    CORRADE_VERIFY(subtree->scene() == &scene);
+    CORRADE_VERIFY(childOfSubtree->scene() == &scene);
+
+    childOne->setParent(nullptr);
+    CORRADE_VERIFY(childOne->scene() == nullptr);
+    CORRADE_VERIFY(childOfSubtree->scene() == nullptr);
+    delete childOne;
 }
 
 void ObjectTest::setParentKeepTransformation() {
@@ -248,8 +260,6 @@ void ObjectTest::transformations() {
 }
 
 void ObjectTest::transformationsRelative() {
-    CORRADE_EXPECT_FAIL("Transformations not relative to scene are not yet implemented.");
-
     Scene3D s;
     Object3D first(&s);
     first.rotateZ(Deg(30.0f));
@@ -263,6 +273,27 @@ void ObjectTest::transformationsRelative() {
         Matrix4::scaling(Vector3(0.5f)).inverted()*Matrix4::translation(Vector3::xAxis(5.0f))
     });
 
+    /* Transformations relative to ancestor object */
+    Object3D fourth(&third);
+    fourth.rotateX(Deg(15.0f));
+    CORRADE_COMPARE(first.transformations({fourth, second, first}), (std::vector<Matrix4>{
+        Matrix4::translation(Vector3::xAxis(5.0f))*Matrix4::rotationX(Deg(15.0f)),
+        Matrix4::scaling(Vector3(0.5f)),
+        Matrix4()
+    }));
+
+    /* Transformation relative to another object with initial transformation */
+    Matrix4 initial = Matrix4::rotationY(Deg(45.0f));
+    CORRADE_COMPARE(fourth.transformations({second}, initial), std::vector<Matrix4>{
+        initial*Matrix4::rotationX(Deg(15.0f)).inverted()*Matrix4::translation(Vector3::xAxis(5.0f)).inverted()*Matrix4::scaling(Vector3(0.5f))
+    });
+
+    /* Transformation relative to descendant object */
+    CORRADE_COMPARE(fourth.transformations({first, s}), (std::vector<Matrix4>{
+        (Matrix4::translation(Vector3::xAxis(5.0f))*Matrix4::rotationX(Deg(15.0f))).inverted(),
+        (Matrix4::rotationZ(Deg(30.0f))*Matrix4::translation(Vector3::xAxis(5.0f))*Matrix4::rotationX(Deg(15.0f))).inverted()
+    }));
+
     /* Transformation relative to another object, not part of any scene (but should work) */
     Object3D orphanParent1;
     orphanParent1.rotate(Deg(31.0f), Vector3(1.0f).normalized());
@@ -285,6 +316,13 @@ void ObjectTest::transformationsOrphan() {
     Object3D orphan;
     CORRADE_COMPARE(s.transformations({orphan}), std::vector<Matrix4>());
     CORRADE_COMPARE(o.str(), "SceneGraph::Object::transformations(): the objects are not part of the same tree\n");
+
+    /* Transformation of objects not part of the same tree, relative to
+       non-root object */
+    o.str({});
+    Object3D child(&s);
+    CORRADE_COMPARE(child.transformations({orphan}), std::vector<Matrix4>());
+    CORRADE_COMPARE(o.str(), "SceneGraph::Object::transformations(): the objects are not part of the same tree\n");
 }
 
 void ObjectTest::transformationsDuplicate() {
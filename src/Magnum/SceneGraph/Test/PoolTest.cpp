@@ -0,0 +1,207 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Pool.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct PoolTest: TestSuite::Tester {
+    explicit PoolTest();
+
+    void allocate();
+    void reserve();
+    void objects();
+    void features();
+    void derivedDifferentSize();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+PoolTest::PoolTest() {
+    addTests({&PoolTest::allocate,
+              &PoolTest::reserve,
+              &PoolTest::objects,
+              &PoolTest::features,
+              &PoolTest::derivedDifferentSize});
+}
+
+void PoolTest::allocate() {
+    Pool<Vector3, 4> pool;
+    CORRADE_COMPARE(pool.size(), 0);
+    CORRADE_COMPARE(pool.capacity(), 0);
+    CORRADE_COMPARE(pool.chunkCount(), 0);
+    CORRADE_COMPARE(pool.allocationCount(), 0);
+    CORRADE_COMPARE(pool.deallocationCount(), 0);
+
+    void* a = pool.allocate();
+    void* b = pool.allocate();
+    CORRADE_VERIFY(a != b);
+    CORRADE_COMPARE(pool.size(), 2);
+    CORRADE_COMPARE(pool.capacity(), 4);
+    CORRADE_COMPARE(pool.chunkCount(), 1);
+
+    /* Freed slot is reused first */
+    pool.deallocate(a);
+    CORRADE_COMPARE(pool.size(), 1);
+    CORRADE_COMPARE(pool.allocate(), a);
+
+    /* Allocating more than chunk size adds a new chunk */
+    void* c = pool.allocate();
+    void* d = pool.allocate();
+    void* e = pool.allocate();
+    CORRADE_COMPARE(pool.size(), 5);
+    CORRADE_COMPARE(pool.chunkCount(), 2);
+
+    for(void* i: {a, b, c, d, e}) pool.deallocate(i);
+    pool.deallocate(nullptr);
+    CORRADE_COMPARE(pool.size(), 0);
+    CORRADE_COMPARE(pool.chunkCount(), 2);
+
+    /* Reused slots are counted too, null deallocation isn't */
+    CORRADE_COMPARE(pool.allocationCount(), 6);
+    CORRADE_COMPARE(pool.deallocationCount(), 6);
+}
+
+void PoolTest::reserve() {
+    Pool<Vector3, 4> pool;
+    pool.reserve(9);
+    CORRADE_COMPARE(pool.capacity(), 12);
+    CORRADE_COMPARE(pool.chunkCount(), 3);
+
+    /* Already large enough */
+    pool.reserve(5);
+    CORRADE_COMPARE(pool.chunkCount(), 3);
+
+    /* No new chunks needed */
+    void* memory[12];
+    for(void*& i: memory) i = pool.allocate();
+    CORRADE_COMPARE(pool.chunkCount(), 3);
+    for(void* i: memory) pool.deallocate(i);
+}
+
+class PooledObject: public Object3D, public PoolAllocated<PooledObject, 16> {
+    public:
+        explicit PooledObject(Object3D* parent): Object3D{parent} {}
+};
+
+void PoolTest::objects() {
+    auto& pool = PooledObject::pool();
+    CORRADE_COMPARE(pool.size(), 0);
+
+    Scene3D scene;
+    PooledObject* a = new PooledObject{&scene};
+    PooledObject* b = new PooledObject{a};
+    new PooledObject{b};
+    new PooledObject{a};
+    CORRADE_COMPARE(pool.size(), 4);
+    CORRADE_COMPARE(pool.chunkCount(), 1);
+
+    /* Deleting a subtree returns all objects to the pool */
+    delete a;
+    CORRADE_COMPARE(pool.size(), 0);
+
+    /* Steady state doesn't allocate new chunks */
+    for(std::size_t i = 0; i != 100; ++i) {
+        PooledObject* o = new PooledObject{&scene};
+        new PooledObject{o};
+        new PooledObject{o};
+        delete o;
+    }
+    CORRADE_COMPARE(pool.size(), 0);
+    CORRADE_COMPARE(pool.chunkCount(), 1);
+    CORRADE_COMPARE(pool.allocationCount(), 304);
+    CORRADE_COMPARE(PooledObject::systemAllocationCount(), 0);
+
+    /* Objects destroyed with the scene are returned too */
+    new PooledObject{&scene};
+    new PooledObject{&scene};
+    CORRADE_COMPARE(pool.size(), 2);
+    scene.children().clear();
+    CORRADE_COMPARE(pool.size(), 0);
+}
+
+class PooledDrawable: public Drawable3D, public PoolAllocated<PooledDrawable, 16> {
+    public:
+        explicit PooledDrawable(AbstractObject3D& object, DrawableGroup3D* group): Drawable3D{object, group} {}
+
+    private:
+        void draw(const Matrix4&, Camera3D&) override {}
+};
+
+void PoolTest::features() {
+    auto& pool = PooledDrawable::pool();
+
+    DrawableGroup3D group;
+    {
+        Scene3D scene;
+        Object3D* o = new Object3D{&scene};
+        new PooledDrawable{*o, &group};
+        new PooledDrawable{*o, &group};
+        CORRADE_COMPARE(pool.size(), 2);
+        CORRADE_COMPARE(group.size(), 2);
+    }
+
+    /* Features are returned to the pool with the object */
+    CORRADE_COMPARE(pool.size(), 0);
+    CORRADE_VERIFY(group.isEmpty());
+}
+
+class PooledBase: public Object3D, public PoolAllocated<PooledBase, 16> {
+    public:
+        explicit PooledBase(Object3D* parent): Object3D{parent} {}
+};
+
+class LargerDerived: public PooledBase {
+    public:
+        explicit LargerDerived(Object3D* parent): PooledBase{parent} {}
+
+    private:
+        Matrix4 _data;
+};
+
+void PoolTest::derivedDifferentSize() {
+    auto& pool = PooledBase::pool();
+
+    Scene3D scene;
+    new PooledBase{&scene};
+    new LargerDerived{&scene};
+
+    /* Only the base is in the pool, the other is allocated from the system */
+    CORRADE_COMPARE(pool.size(), 1);
+    CORRADE_COMPARE(PooledBase::systemAllocationCount(), 1);
+
+    scene.children().clear();
+    CORRADE_COMPARE(pool.size(), 0);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::PoolTest)
@@ -35,6 +35,13 @@ struct SceneTest: TestSuite::Tester {
 
     void transformation();
     void parent();
+
+    void cleanDirty();
+    void cleanDirtyPartiallyClean();
+    void cleanDirtyReparented();
+    void cleanDirtyDestroyed();
+    void cleanDirtyDeepHierarchy();
+    void cleanDirtyScene();
 };
 
 typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
@@ -42,7 +49,34 @@ typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
 
 SceneTest::SceneTest() {
     addTests({&SceneTest::transformation,
-              &SceneTest::parent});
+              &SceneTest::parent,
+
+              &SceneTest::cleanDirty,
+              &SceneTest::cleanDirtyPartiallyClean,
+              &SceneTest::cleanDirtyReparented,
+              &SceneTest::cleanDirtyDestroyed,
+              &SceneTest::cleanDirtyDeepHierarchy,
+              &SceneTest::cleanDirtyScene});
+}
+
+namespace {
+
+class CachingObject: public Object3D, AbstractFeature3D {
+    public:
+        CachingObject(Object3D* parent = nullptr): Object3D(parent), AbstractFeature3D(*this), cleanCount(0) {
+            setCachedTransformations(CachedTransformation::Absolute);
+        }
+
+        Matrix4 cleanedAbsoluteTransformation;
+        Int cleanCount;
+
+    protected:
+        void clean(const Matrix4& absoluteTransformation) override {
+            cleanedAbsoluteTransformation = absoluteTransformation;
+            ++cleanCount;
+        }
+};
+
 }
 
 void SceneTest::transformation() {
@@ -65,6 +99,168 @@ void SceneTest::parent() {
     CORRADE_VERIFY(object.children().isEmpty());
 }
 
+void SceneTest::cleanDirty() {
+    Scene3D scene;
+    CachingObject a(&scene);
+    a.translate(Vector3::xAxis(1.0f));
+    CachingObject b(&a);
+    b.scale(Vector3(2.0f));
+    CachingObject c(&scene);
+    c.translate(Vector3::yAxis(3.0f));
+
+    /* Everything is dirty initially, only the scene is in the list */
+    CORRADE_COMPARE(scene.dirtyCount(), 1);
+    CORRADE_COMPARE(scene.cleanGeneration(), 0);
+    CORRADE_COMPARE(scene.cleanDirty(), 4);
+    CORRADE_VERIFY(!scene.isDirty());
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_VERIFY(!c.isDirty());
+    CORRADE_COMPARE(scene.dirtyCount(), 0);
+    CORRADE_COMPARE(scene.cleanGeneration(), 1);
+    CORRADE_COMPARE(b.cleanedAbsoluteTransformation, b.absoluteTransformationMatrix());
+    CORRADE_COMPARE(c.cleanedAbsoluteTransformation, c.absoluteTransformationMatrix());
+
+    /* Nothing to do, generation is not changed */
+    CORRADE_COMPARE(scene.cleanDirty(), 0);
+    CORRADE_COMPARE(scene.cleanGeneration(), 1);
+
+    /* Move one subtree, only that subtree gets cleaned */
+    a.translate(Vector3::zAxis(-1.0f));
+    CORRADE_COMPARE(scene.dirtyCount(), 1);
+    CORRADE_COMPARE(scene.cleanDirty(), 2);
+    CORRADE_COMPARE(a.cleanCount, 2);
+    CORRADE_COMPARE(b.cleanCount, 2);
+    CORRADE_COMPARE(c.cleanCount, 1);
+    CORRADE_COMPARE(b.cleanedAbsoluteTransformation, b.absoluteTransformationMatrix());
+    CORRADE_COMPARE(scene.cleanGeneration(), 2);
+
+    /* Child marked dirty before parent -- the subtree is cleaned only once */
+    b.rotateX(Deg(35.0f));
+    a.rotateY(Deg(15.0f));
+    CORRADE_COMPARE(scene.dirtyCount(), 2);
+    CORRADE_COMPARE(scene.cleanDirty(), 2);
+    CORRADE_COMPARE(a.cleanCount, 3);
+    CORRADE_COMPARE(b.cleanCount, 3);
+    CORRADE_COMPARE(b.cleanedAbsoluteTransformation, b.absoluteTransformationMatrix());
+}
+
+void SceneTest::cleanDirtyPartiallyClean() {
+    Scene3D scene;
+    CachingObject a(&scene);
+    a.translate(Vector3::xAxis(1.0f));
+    CachingObject b(&a);
+    b.scale(Vector3(2.0f));
+    CachingObject c(&a);
+    c.translate(Vector3::yAxis(3.0f));
+
+    /* Cleaning one object makes its dirty siblings roots of dirty subtrees */
+    b.setClean();
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(c.isDirty());
+    CORRADE_COMPARE(scene.cleanDirty(), 1);
+    CORRADE_VERIFY(!c.isDirty());
+    CORRADE_COMPARE(a.cleanCount, 1);
+    CORRADE_COMPARE(b.cleanCount, 1);
+    CORRADE_COMPARE(c.cleanCount, 1);
+    CORRADE_COMPARE(c.cleanedAbsoluteTransformation, c.absoluteTransformationMatrix());
+
+    /* Cleaning all listed objects manually */
+    a.translate(Vector3::xAxis(1.0f));
+    Object3D::setClean({b});
+    CORRADE_VERIFY(c.isDirty());
+    CORRADE_COMPARE(scene.cleanDirty(), 1);
+    CORRADE_VERIFY(!c.isDirty());
+    CORRADE_COMPARE(c.cleanedAbsoluteTransformation, c.absoluteTransformationMatrix());
+}
+
+void SceneTest::cleanDirtyReparented() {
+    Scene3D scene;
+    Scene3D another;
+    CachingObject a(&scene);
+    a.translate(Vector3::xAxis(1.0f));
+    CORRADE_COMPARE(scene.cleanDirty(), 2);
+    CORRADE_COMPARE(another.cleanDirty(), 1);
+
+    /* Object added to clean scene is put into the list */
+    CachingObject b(&scene);
+    b.translate(Vector3::yAxis(1.0f));
+    CORRADE_COMPARE(scene.dirtyCount(), 1);
+
+    /* Moving it to another scene removes it from the original list */
+    b.setParent(&another);
+    CORRADE_COMPARE(scene.cleanDirty(), 0);
+    CORRADE_VERIFY(b.isDirty());
+    CORRADE_COMPARE(another.cleanDirty(), 1);
+    CORRADE_VERIFY(!b.isDirty());
+
+    /* Orphaned object is not cleaned by the original scene */
+    a.translate(Vector3::zAxis(1.0f));
+    a.setParent(nullptr);
+    CORRADE_COMPARE(scene.cleanDirty(), 0);
+    CORRADE_VERIFY(a.isDirty());
+}
+
+void SceneTest::cleanDirtyDestroyed() {
+    Scene3D scene;
+    CORRADE_COMPARE(scene.cleanDirty(), 1);
+
+    Object3D* a = new Object3D(&scene);
+    new Object3D(a);
+    Object3D* c = new Object3D(&scene);
+    CORRADE_COMPARE(scene.dirtyCount(), 2);
+
+    /* Destroyed objects are removed from the list */
+    delete a;
+    delete c;
+    CORRADE_COMPARE(scene.dirtyCount(), 2);
+    CORRADE_COMPARE(scene.cleanDirty(), 0);
+
+    /* Destroying the scene with non-empty list shouldn't crash */
+    new Object3D(&scene);
+}
+
+void SceneTest::cleanDirtyDeepHierarchy() {
+    Scene3D scene;
+    CORRADE_COMPARE(scene.cleanDirty(), 1);
+
+    /* Long chain of objects is cleaned without recursion */
+    Object3D* root = new Object3D(&scene);
+    CachingObject* last = nullptr;
+    Object3D* parent = root;
+    for(std::size_t i = 0; i != 10000; ++i) {
+        parent->translate(Vector3::xAxis(1.0f));
+        parent = last = new CachingObject(parent);
+    }
+
+    CORRADE_COMPARE(scene.cleanDirty(), 10001);
+    CORRADE_COMPARE(last->cleanCount, 1);
+    CORRADE_COMPARE(last->cleanedAbsoluteTransformation, Matrix4::translation(Vector3::xAxis(10000.0f)));
+}
+
+void SceneTest::cleanDirtyScene() {
+    Scene3D scene;
+    CachingObject a(&scene);
+    CachingObject b(&scene);
+    CachingObject c;
+    CachingObject d(&c);
+
+    /* Cleaning through any object cleans the whole scene */
+    AbstractObject3D& abstractA = a;
+    CORRADE_COMPARE(abstractA.cleanDirtyScene(), 3);
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_COMPARE(b.cleanCount, 1);
+    CORRADE_COMPARE(scene.cleanGeneration(), 1);
+
+    /* Objects outside of any scene are cleaned alone */
+    AbstractObject3D& abstractD = d;
+    CORRADE_COMPARE(abstractD.cleanDirtyScene(), 1);
+    CORRADE_VERIFY(!c.isDirty());
+    CORRADE_VERIFY(!d.isDirty());
+    CORRADE_COMPARE(d.cleanCount, 1);
+    CORRADE_COMPARE(abstractD.cleanDirtyScene(), 0);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::SceneTest)
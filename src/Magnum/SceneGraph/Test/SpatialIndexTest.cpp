@@ -0,0 +1,286 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/SpatialIndex.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct SpatialIndexTest: TestSuite::Tester {
+    explicit SpatialIndexTest();
+
+    void absoluteBounds();
+    void range();
+    void ray();
+    void rayAlongFace();
+    void nearest();
+    void move();
+    void setBounds();
+    void remove();
+    void multipleScenes();
+    void balanced();
+    void twoDimensions();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+SpatialIndexTest::SpatialIndexTest() {
+    addTests({&SpatialIndexTest::absoluteBounds,
+              &SpatialIndexTest::range,
+              &SpatialIndexTest::ray,
+              &SpatialIndexTest::rayAlongFace,
+              &SpatialIndexTest::nearest,
+              &SpatialIndexTest::move,
+              &SpatialIndexTest::setBounds,
+              &SpatialIndexTest::remove,
+              &SpatialIndexTest::multipleScenes,
+              &SpatialIndexTest::balanced,
+              &SpatialIndexTest::twoDimensions});
+}
+
+namespace {
+    /* Unit cubes on a line along X, 3 units apart */
+    struct Row {
+        explicit Row(std::size_t count) {
+            for(std::size_t i = 0; i != count; ++i) {
+                Object3D* object = new Object3D{&scene};
+                object->translate(Vector3::xAxis(Float(i)*3.0f));
+                bounds.push_back(new Bounds3D{*object, {Vector3{-0.5f}, Vector3{0.5f}}, &index});
+            }
+        }
+
+        SpatialIndex3D index;
+        Scene3D scene;
+        std::vector<Bounds3D*> bounds;
+    };
+
+    template<class T> std::vector<T> sorted(std::vector<T> v) {
+        std::sort(v.begin(), v.end());
+        return v;
+    }
+}
+
+void SpatialIndexTest::absoluteBounds() {
+    Scene3D scene;
+    Object3D parent{&scene};
+    parent.translate(Vector3::yAxis(2.0f));
+    Object3D object{&parent};
+    object.scale({2.0f, 1.0f, 1.0f})
+        .rotateZ(Deg(90.0f));
+
+    Bounds3D bounds{object, {{0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}}};
+    CORRADE_COMPARE(bounds.absoluteBounds(), (Range3D{{-1.0f, 2.0f, 0.0f}, {0.0f, 4.0f, 1.0f}}));
+
+    /* Changing the parent transformation updates the bounds */
+    parent.translate(Vector3::zAxis(1.0f));
+    CORRADE_COMPARE(bounds.absoluteBounds(), (Range3D{{-1.0f, 2.0f, 1.0f}, {0.0f, 4.0f, 2.0f}}));
+}
+
+void SpatialIndexTest::range() {
+    Row row{10};
+    CORRADE_COMPARE(row.index.size(), 10);
+
+    CORRADE_COMPARE(row.index.range({{-10.0f, 5.0f, -10.0f}, {10.0f, 10.0f, 10.0f}}), std::vector<Bounds3D*>{});
+    CORRADE_COMPARE(sorted(row.index.range({{2.0f, -1.0f, -1.0f}, {6.6f, 1.0f, 1.0f}})), sorted(std::vector<Bounds3D*>{row.bounds[1], row.bounds[2]}));
+    CORRADE_COMPARE(row.index.range({{-100.0f, -1.0f, -1.0f}, {100.0f, 1.0f, 1.0f}}).size(), 10);
+}
+
+void SpatialIndexTest::ray() {
+    Row row{10};
+
+    /* Ray along the row, from the middle of the second cube */
+    auto hits = row.index.ray({3.0f, 0.0f, 0.0f}, Vector3::xAxis(), 10.0f);
+    CORRADE_COMPARE(hits.size(), 4);
+    CORRADE_COMPARE(hits[0].first, row.bounds[1]);
+    CORRADE_COMPARE(hits[0].second, 0.0f);
+    CORRADE_COMPARE(hits[1].first, row.bounds[2]);
+    CORRADE_COMPARE(hits[1].second, 2.5f);
+    CORRADE_COMPARE(hits[2].first, row.bounds[3]);
+    CORRADE_COMPARE(hits[2].second, 5.5f);
+    CORRADE_COMPARE(hits[3].first, row.bounds[4]);
+    CORRADE_COMPARE(hits[3].second, 8.5f);
+
+    /* Ray from above, hitting only one */
+    hits = row.index.ray({6.0f, 10.0f, 0.1f}, -Vector3::yAxis());
+    CORRADE_COMPARE(hits.size(), 1);
+    CORRADE_COMPARE(hits[0].first, row.bounds[2]);
+    CORRADE_COMPARE(hits[0].second, 9.5f);
+
+    /* Ray pointing away */
+    CORRADE_VERIFY(row.index.ray({-5.0f, 0.0f, 0.0f}, -Vector3::xAxis()).empty());
+}
+
+void SpatialIndexTest::rayAlongFace() {
+    Row row{3};
+
+    /* Axis-aligned ray going exactly along the bottom faces and edges of the
+       cubes, zero direction components shouldn't produce NaNs */
+    auto hits = row.index.ray({-5.0f, -0.5f, -0.5f}, Vector3::xAxis());
+    CORRADE_COMPARE(hits.size(), 3);
+    CORRADE_COMPARE(hits[0].first, row.bounds[0]);
+    CORRADE_COMPARE(hits[0].second, 4.5f);
+    CORRADE_COMPARE(hits[1].first, row.bounds[1]);
+    CORRADE_COMPARE(hits[1].second, 7.5f);
+    CORRADE_COMPARE(hits[2].first, row.bounds[2]);
+    CORRADE_COMPARE(hits[2].second, 10.5f);
+
+    /* Parallel to the faces but outside */
+    CORRADE_VERIFY(row.index.ray({-5.0f, -0.6f, 0.0f}, Vector3::xAxis()).empty());
+}
+
+void SpatialIndexTest::nearest() {
+    Row row{10};
+
+    CORRADE_COMPARE(row.index.nearest({10.0f, 1.0f, 0.0f}, 3), (std::vector<Bounds3D*>{
+        row.bounds[3], row.bounds[4], row.bounds[2]}));
+    CORRADE_COMPARE(row.index.nearest({}, 0), std::vector<Bounds3D*>{});
+    CORRADE_COMPARE(row.index.nearest({}, 20).size(), 10);
+}
+
+void SpatialIndexTest::move() {
+    Row row{10};
+    CORRADE_COMPARE(row.index.nearest({100.0f, 0.0f, 0.0f}, 1), std::vector<Bounds3D*>{row.bounds[9]});
+
+    /* Moving an object is reflected in the queries */
+    static_cast<Object3D&>(row.bounds[0]->object()).translate(Vector3::xAxis(200.0f));
+    CORRADE_COMPARE(row.index.nearest({300.0f, 0.0f, 0.0f}, 1), std::vector<Bounds3D*>{row.bounds[0]});
+    CORRADE_COMPARE(row.index.range({{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}}), std::vector<Bounds3D*>{});
+
+    /* Small move within the margin */
+    static_cast<Object3D&>(row.bounds[1]->object()).translate(Vector3::xAxis(0.05f));
+    CORRADE_COMPARE(row.index.ray({3.0f, 10.0f, 0.0f}, -Vector3::yAxis()).size(), 1);
+    CORRADE_COMPARE(row.bounds[1]->absoluteBounds(), (Range3D{{2.55f, -0.5f, -0.5f}, {3.55f, 0.5f, 0.5f}}));
+}
+
+void SpatialIndexTest::setBounds() {
+    Row row{3};
+    CORRADE_COMPARE(row.index.range({{2.0f, 2.0f, -1.0f}, {4.0f, 4.0f, 1.0f}}), std::vector<Bounds3D*>{});
+
+    /* The object transformation is not affected */
+    row.bounds[1]->setBounds({Vector3{-3.0f}, Vector3{3.0f}});
+    CORRADE_VERIFY(!row.bounds[1]->object().isDirty());
+    CORRADE_COMPARE(row.index.range({{2.0f, 2.0f, -1.0f}, {4.0f, 4.0f, 1.0f}}), std::vector<Bounds3D*>{row.bounds[1]});
+}
+
+void SpatialIndexTest::remove() {
+    Row row{5};
+
+    /* Removed from the index */
+    row.index.remove(*row.bounds[1]);
+    CORRADE_VERIFY(!row.bounds[1]->index());
+    CORRADE_COMPARE(row.index.range({{2.0f, -1.0f, -1.0f}, {4.0f, 1.0f, 1.0f}}), std::vector<Bounds3D*>{});
+
+    /* Moved to another index */
+    SpatialIndex3D another;
+    another.add(*row.bounds[2]);
+    CORRADE_COMPARE(row.index.size(), 3);
+    CORRADE_COMPARE(row.index.range({{5.0f, -1.0f, -1.0f}, {7.0f, 1.0f, 1.0f}}), std::vector<Bounds3D*>{});
+    CORRADE_COMPARE(another.range({{5.0f, -1.0f, -1.0f}, {7.0f, 1.0f, 1.0f}}), std::vector<Bounds3D*>{row.bounds[2]});
+
+    /* Destroyed while dirty */
+    static_cast<Object3D&>(row.bounds[3]->object()).translate(Vector3::yAxis(1.0f));
+    delete &row.bounds[3]->object();
+    CORRADE_COMPARE(sorted(row.index.range({{-100.0f, -100.0f, -100.0f}, {100.0f, 100.0f, 100.0f}})), sorted(std::vector<Bounds3D*>{row.bounds[0], row.bounds[4]}));
+
+    /* Index destroyed before the bounds */
+    {
+        SpatialIndex3D shortLived;
+        shortLived.add(*row.bounds[4]);
+        CORRADE_COMPARE(shortLived.nearest({}, 1), std::vector<Bounds3D*>{row.bounds[4]});
+    }
+    CORRADE_VERIFY(!row.bounds[4]->index());
+}
+
+void SpatialIndexTest::multipleScenes() {
+    SpatialIndex3D index;
+    Scene3D scene;
+    Scene3D another;
+    Object3D a{&scene};
+    a.translate(Vector3::xAxis(5.0f));
+    Object3D b{&another};
+    b.translate(Vector3::xAxis(-5.0f));
+    Object3D orphan;
+    orphan.translate(Vector3::yAxis(5.0f));
+    Bounds3D boundsA{a, {Vector3{-1.0f}, Vector3{1.0f}}, &index};
+    Bounds3D boundsB{b, {Vector3{-1.0f}, Vector3{1.0f}}, &index};
+    Bounds3D boundsOrphan{orphan, {Vector3{-1.0f}, Vector3{1.0f}}, &index};
+
+    /* Objects from different scenes and without a scene are cleaned
+       separately */
+    CORRADE_COMPARE(index.nearest({6.0f, 0.0f, 0.0f}, 1), std::vector<Bounds3D*>{&boundsA});
+    CORRADE_COMPARE(index.nearest({-6.0f, 0.0f, 0.0f}, 1), std::vector<Bounds3D*>{&boundsB});
+    CORRADE_COMPARE(index.nearest({0.0f, 6.0f, 0.0f}, 1), std::vector<Bounds3D*>{&boundsOrphan});
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_VERIFY(!orphan.isDirty());
+
+    /* Moving all of them again */
+    a.translate(Vector3::yAxis(-10.0f));
+    b.translate(Vector3::yAxis(-10.0f));
+    orphan.translate(Vector3::yAxis(-10.0f));
+    CORRADE_COMPARE(sorted(index.range({{-10.0f, -11.0f, -1.0f}, {10.0f, -9.0f, 1.0f}})), sorted(std::vector<Bounds3D*>{&boundsA, &boundsB}));
+    CORRADE_COMPARE(index.range({{-1.0f, -6.0f, -1.0f}, {1.0f, -4.0f, 1.0f}}), std::vector<Bounds3D*>{&boundsOrphan});
+}
+
+void SpatialIndexTest::balanced() {
+    /* Objects inserted in sorted order would make a degenerate hierarchy
+       without balancing */
+    Row row{1024};
+    row.index.setClean();
+    CORRADE_VERIFY(row.index.height() >= 11);
+    CORRADE_VERIFY(row.index.height() <= 22);
+
+    CORRADE_COMPARE(row.index.nearest({1500.0f, 0.0f, 0.0f}, 1), std::vector<Bounds3D*>{row.bounds[500]});
+}
+
+void SpatialIndexTest::twoDimensions() {
+    SpatialIndex2D index;
+    Scene2D scene;
+    Object2D a{&scene};
+    a.translate({5.0f, 5.0f});
+    Object2D b{&scene};
+    b.translate({-5.0f, 5.0f});
+    Bounds2D boundsA{a, {Vector2{-1.0f}, Vector2{1.0f}}, &index};
+    Bounds2D boundsB{b, {Vector2{-1.0f}, Vector2{1.0f}}, &index};
+
+    CORRADE_COMPARE(index.range({{0.0f, 0.0f}, {10.0f, 10.0f}}), std::vector<Bounds2D*>{&boundsA});
+    CORRADE_COMPARE(index.nearest({-3.0f, 0.0f}, 1), std::vector<Bounds2D*>{&boundsB});
+    auto hits = index.ray({-10.0f, 5.0f}, Vector2::xAxis());
+    CORRADE_COMPARE(hits.size(), 2);
+    CORRADE_COMPARE(hits[0].first, &boundsB);
+    CORRADE_COMPARE(hits[0].second, 4.0f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::SpatialIndexTest)
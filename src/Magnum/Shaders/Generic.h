@@ -66,6 +66,16 @@ template<UnsignedInt dimensions> struct Generic {
      * @ref Vector3, defined only in 3D.
      */
     typedef Attribute<2, Vector3> Normal;
+
+    /**
+     * @brief Vertex tangent
+     *
+     * @ref Vector4, defined only in 3D. The XYZ components contain the
+     * tangent direction, W component is sign of the bitangent, which is then
+     * calculated as `cross(normal, tangent.xyz)*tangent.w`.
+     * @see @ref MeshTools::generateTangents()
+     */
+    typedef Attribute<4, Vector4> Tangent;
 };
 #endif
 
@@ -87,6 +97,7 @@ template<> struct Generic<2>: BaseGeneric {
 template<> struct Generic<3>: BaseGeneric {
     typedef Attribute<0, Vector3> Position;
     typedef Attribute<2, Vector3> Normal;
+    typedef Attribute<4, Vector4> Tangent;
 };
 #endif
 
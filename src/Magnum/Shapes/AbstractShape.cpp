@@ -33,8 +33,18 @@
 
 namespace Magnum { namespace Shapes {
 
-template<UnsignedInt dimensions> AbstractShape<dimensions>::AbstractShape(SceneGraph::AbstractObject<dimensions, Float>& object, ShapeGroup<dimensions>* group): SceneGraph::AbstractGroupedFeature<dimensions, AbstractShape<dimensions>, Float>(object, group) {
+template<UnsignedInt dimensions> AbstractShape<dimensions>::AbstractShape(SceneGraph::AbstractObject<dimensions, Float>& object, ShapeGroup<dimensions>* group): SceneGraph::AbstractGroupedFeature<dimensions, AbstractShape<dimensions>, Float>(object, nullptr), _bounds(nullptr), _dirtyIndex(0), _dirtyListed(false) {
     SceneGraph::AbstractFeature<dimensions, Float>::setCachedTransformations(SceneGraph::CachedTransformation::Absolute);
+
+    /* Adding to the group only after all members are initialized, as the
+       group schedules the bounds update using them */
+    if(group) group->add(*this);
+}
+
+template<UnsignedInt dimensions> AbstractShape<dimensions>::~AbstractShape() {
+    /* Removing from the group while the members are still alive, so the
+       group can delete the bounds */
+    if(group()) group()->remove(*this);
 }
 
 template<UnsignedInt dimensions> ShapeGroup<dimensions>* AbstractShape<dimensions>::group() {
@@ -57,8 +67,20 @@ template<UnsignedInt dimensions> Collision<dimensions> AbstractShape<dimensions>
     return Implementation::collision(abstractTransformedShape(), other.abstractTransformedShape());
 }
 
+template<UnsignedInt dimensions> Float AbstractShape<dimensions>::timeOfImpact(const AbstractShape<dimensions>& other, const MatrixTypeFor<dimensions, Float>& previousTransformation) const {
+    return Implementation::timeOfImpact(Implementation::sweep(abstractShape(), previousTransformation, abstractTransformedShape()), other.abstractTransformedShape());
+}
+
 template<UnsignedInt dimensions> void AbstractShape<dimensions>::markDirty() {
-    if(group()) group()->setDirty();
+    if(!group()) return;
+
+    /* The bounds in the group index follow the object on their own */
+    group()->setDirty();
+}
+
+template<UnsignedInt dimensions> void AbstractShape<dimensions>::markShapeDirty() {
+    /* Bounds of the shape need to be recomputed for firstImpact() */
+    if(group()) group()->addToDirtyList(*this);
 }
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
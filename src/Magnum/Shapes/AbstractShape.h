@@ -52,6 +52,7 @@ This class is not directly instantiable, use @ref Shape instead. See
 */
 template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT AbstractShape: public SceneGraph::AbstractGroupedFeature<dimensions, AbstractShape<dimensions>, Float> {
     friend const Implementation::AbstractShape<dimensions>& Implementation::getAbstractShape<>(const AbstractShape<dimensions>&);
+    friend ShapeGroup<dimensions>;
 
     public:
         enum: UnsignedInt {
@@ -69,7 +70,8 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT AbstractShape: publi
             AxisAlignedBox, /**< @ref AxisAlignedBox "Axis aligned box" */
             Box,            /**< Box */
             Composition,    /**< @ref Composition "Shape group" */
-            Plane           /**< Plane (3D only) */
+            Plane,          /**< Plane (3D only) */
+            ConvexHull      /**< @ref ConvexHull "Convex hull" (3D only) */
         };
         #else
         typedef typename Implementation::ShapeDimensionTraits<dimensions>::Type Type;
@@ -82,6 +84,13 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT AbstractShape: publi
          */
         explicit AbstractShape(SceneGraph::AbstractObject<dimensions, Float>& object, ShapeGroup<dimensions>* group = nullptr);
 
+        /**
+         * @brief Destructor
+         *
+         * Removes the shape from its group.
+         */
+        ~AbstractShape();
+
         /**
          * @brief Shape group containing this shape
          *
@@ -107,12 +116,54 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT AbstractShape: publi
          */
         Collision<dimensions> collision(const AbstractShape<dimensions>& other) const;
 
+        /**
+         * @brief Time of impact with other shape
+         * @param other                     Static shape
+         * @param previousTransformation    Absolute transformation of the
+         *      object at the beginning of the motion
+         *
+         * Sweeps this shape linearly from @p previousTransformation to
+         * current absolute transformation and returns fraction of the motion
+         * at which it first touches @p other, or infinity if it doesn't
+         * touch it at all. If the shapes overlap already at the beginning,
+         * returns `0.0f`. Unlike @ref collides() this detects also
+         * collisions in between, thus fast moving shapes don't tunnel
+         * through thin obstacles. Rotation during the motion is
+         * approximated linearly.
+         *
+         * Only spheres and capsules can be swept, in 2D only spheres. In 3D
+         * the impact is computed with all bounded convex shapes (see
+         * @ref shapes-collisions) and planes, in 2D only with points and
+         * spheres. Pairs with other shapes have no impact. The result is
+         * exact for sphere and sphere or point pairs and for planes,
+         * otherwise it's computed iteratively and can be slightly before
+         * the actual contact. Shapes passing by closer than approximately
+         * one thousandth of the motion length are then considered
+         * touching.
+         * @see @ref ShapeGroup::firstImpact()
+         */
+        Float timeOfImpact(const AbstractShape<dimensions>& other, const MatrixTypeFor<dimensions, Float>& previousTransformation) const;
+
     protected:
         /** Marks also the group as dirty */
         void markDirty() override;
 
+        /**
+         * @brief Mark the shape as changed
+         *
+         * Schedules recomputation of the shape bounds in the group. Called
+         * from @ref Shape::setShape(), object transformation changes don't
+         * need it.
+         */
+        void markShapeDirty();
+
     private:
+        virtual const Implementation::AbstractShape<dimensions> MAGNUM_SHAPES_LOCAL & abstractShape() const = 0;
         virtual const Implementation::AbstractShape<dimensions> MAGNUM_SHAPES_LOCAL & abstractTransformedShape() const = 0;
+
+        SceneGraph::Bounds<dimensions, Float>* _bounds;
+        std::size_t _dirtyIndex;
+        bool _dirtyListed;
 };
 
 /** @brief Base class for two-dimensional object shapes */
@@ -0,0 +1,380 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BoundingVolume.h"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Algorithms/Decomposition3x3.h"
+#include "Magnum/Math/Implementation/lanes.h"
+
+namespace Magnum { namespace Shapes {
+
+namespace {
+
+using Math::Implementation::Lanes;
+
+/* Double-precision types are not available in Magnum namespace on ES */
+typedef Math::Vector3<Double> Vector3d;
+typedef Math::Matrix3x3<Double> Matrix3x3d;
+
+/* Transposed load of four points reads one float past the fourth one, so the
+   vectorized loops stop before the last point */
+inline bool canLoadTransposed(const std::size_t i, const std::size_t count) {
+    return i + 4 < count;
+}
+
+Float maxDistanceSquared(const Containers::ArrayView<const Vector3> points, const Vector3& center) {
+    const Float* const data = points.data()->data();
+    const Lanes centerX{center.x()}, centerY{center.y()}, centerZ{center.z()};
+    Lanes distances{0.0f};
+    std::size_t i = 0;
+    for(; canLoadTransposed(i, points.size()); i += 4) {
+        Lanes p[4];
+        Math::Implementation::loadTransposed(data + 3*i, 3, p);
+        const Lanes x = p[0] - centerX, y = p[1] - centerY, z = p[2] - centerZ;
+        distances = Math::Implementation::max(x*x + y*y + z*z, distances);
+    }
+
+    Float values[4];
+    Math::Implementation::storeLanes(distances, values);
+    Float out = std::max(std::max(values[0], values[1]), std::max(values[2], values[3]));
+    for(; i != points.size(); ++i) out = std::max(out, (points[i] - center).dot());
+    return out;
+}
+
+/* The extents are known from the axis-aligned box, so it's enough to look for
+   points having any of the extremal coordinates. That's rare, so the
+   vectorized comparison only rarely falls back to checking the points one by
+   one. */
+void extremalPoints(const Containers::ArrayView<const Vector3> points, Vector3(&minPoints)[3], Vector3(&maxPoints)[3]) {
+    const AxisAlignedBox3D box = boundingAxisAlignedBox(points);
+    const Vector3 min = box.min();
+    const Vector3 max = box.max();
+    const auto check = [&](const Vector3& point) {
+        for(std::size_t j = 0; j != 3; ++j) {
+            if(point[j] == min[j]) minPoints[j] = point;
+            if(point[j] == max[j]) maxPoints[j] = point;
+        }
+    };
+
+    /* Same layout as in boundingAxisAlignedBox() */
+    std::size_t i = 0;
+    {
+        const Float* const data = points.data()->data();
+        Float minValues[12], maxValues[12];
+        for(std::size_t j = 0; j != 12; ++j) {
+            minValues[j] = min[j%3];
+            maxValues[j] = max[j%3];
+        }
+        const Lanes min0 = Math::Implementation::loadLanes(minValues);
+        const Lanes min1 = Math::Implementation::loadLanes(minValues + 4);
+        const Lanes min2 = Math::Implementation::loadLanes(minValues + 8);
+        const Lanes max0 = Math::Implementation::loadLanes(maxValues);
+        const Lanes max1 = Math::Implementation::loadLanes(maxValues + 4);
+        const Lanes max2 = Math::Implementation::loadLanes(maxValues + 8);
+        for(; i + 4 <= points.size(); i += 4) {
+            const Lanes a = Math::Implementation::loadLanes(data + 3*i);
+            const Lanes b = Math::Implementation::loadLanes(data + 3*i + 4);
+            const Lanes c = Math::Implementation::loadLanes(data + 3*i + 8);
+            if(!(Math::Implementation::lessEqualMask(a, min0)|
+                 Math::Implementation::lessEqualMask(b, min1)|
+                 Math::Implementation::lessEqualMask(c, min2)|
+                 Math::Implementation::lessEqualMask(max0, a)|
+                 Math::Implementation::lessEqualMask(max1, b)|
+                 Math::Implementation::lessEqualMask(max2, c))) continue;
+
+            for(std::size_t j = i; j != i + 4; ++j) check(points[j]);
+        }
+    }
+    for(; i != points.size(); ++i) check(points[i]);
+}
+
+/* Sphere in the Welzl algorithm */
+struct Ball {
+    Vector3d center;
+    Double radiusSquared;
+};
+
+/* Points on the boundary may end up slightly outside due to rounding, which
+   would make the algorithm recompute the ball over and over */
+constexpr Double Tolerance = 1.0e-10;
+
+inline bool contains(const Ball& ball, const Vector3d& point) {
+    return (point - ball.center).dot() <= ball.radiusSquared*(1.0 + Tolerance) + Tolerance;
+}
+
+inline Ball ball(const Vector3d& a) { return {a, 0.0}; }
+
+inline Ball ball(const Vector3d& a, const Vector3d& b) {
+    return {(a + b)*0.5, (b - a).dot()*0.25};
+}
+
+/* Circumscribed sphere of a triangle, centered in its plane */
+Ball ball(const Vector3d& a, const Vector3d& b, const Vector3d& c) {
+    const Vector3d ab = b - a;
+    const Vector3d ac = c - a;
+    const Vector3d n = Math::cross(ab, ac);
+    const Double nn = n.dot();
+
+    /* Collinear points, the ball is spanned by the most distant pair */
+    if(nn <= Tolerance*ab.dot()*ac.dot()) {
+        const Ball candidates[]{ball(a, b), ball(a, c), ball(b, c)};
+        return *std::max_element(candidates, candidates + 3, [](const Ball& first, const Ball& second) {
+            return first.radiusSquared < second.radiusSquared;
+        });
+    }
+
+    const Vector3d offset = (Math::cross(n, ab)*ac.dot() + Math::cross(ac, n)*ab.dot())/(2.0*nn);
+    return {a + offset, offset.dot()};
+}
+
+/* Circumscribed sphere of a tetrahedron */
+Ball ball(const Vector3d& a, const Vector3d& b, const Vector3d& c, const Vector3d& d) {
+    const Vector3d ab = b - a;
+    const Vector3d ac = c - a;
+    const Vector3d ad = d - a;
+    const Double determinant = Math::dot(ab, Math::cross(ac, ad));
+
+    /* Coplanar points, take the smallest ball around three of them that
+       contains the fourth */
+    if(determinant*determinant <= Tolerance*ab.dot()*ac.dot()*ad.dot()) {
+        const Ball candidates[]{ball(a, b, c), ball(a, b, d), ball(a, c, d), ball(b, c, d)};
+        const Vector3d* const remaining[]{&d, &c, &b, &a};
+        const Ball* out = nullptr;
+        for(std::size_t i = 0; i != 4; ++i)
+            if(contains(candidates[i], *remaining[i]) && (!out || candidates[i].radiusSquared < out->radiusSquared))
+                out = candidates + i;
+        return out ? *out : candidates[0];
+    }
+
+    const Vector3d offset = (Math::cross(ac, ad)*ab.dot() + Math::cross(ad, ab)*ac.dot() + Math::cross(ab, ac)*ad.dot())/(2.0*determinant);
+    return {a + offset, offset.dot()};
+}
+
+}
+
+AxisAlignedBox3D boundingAxisAlignedBox(const Containers::ArrayView<const Vector3> points) {
+    if(points.empty()) return {};
+
+    Vector3 min = points[0];
+    Vector3 max = points[0];
+    std::size_t i = 0;
+
+    /* Four consecutive points are exactly three lanes, with components in
+       order xyzx, yzxy and zxyz, so they can be loaded directly without any
+       shuffling and the components get sorted out only at the end */
+    if(points.size() >= 4) {
+        const Float* const data = points.data()->data();
+        Lanes min0 = Math::Implementation::loadLanes(data);
+        Lanes min1 = Math::Implementation::loadLanes(data + 4);
+        Lanes min2 = Math::Implementation::loadLanes(data + 8);
+        Lanes max0 = min0, max1 = min1, max2 = min2;
+        for(i = 4; i + 4 <= points.size(); i += 4) {
+            const Lanes a = Math::Implementation::loadLanes(data + 3*i);
+            const Lanes b = Math::Implementation::loadLanes(data + 3*i + 4);
+            const Lanes c = Math::Implementation::loadLanes(data + 3*i + 8);
+            min0 = Math::Implementation::min(a, min0);
+            min1 = Math::Implementation::min(b, min1);
+            min2 = Math::Implementation::min(c, min2);
+            max0 = Math::Implementation::max(a, max0);
+            max1 = Math::Implementation::max(b, max1);
+            max2 = Math::Implementation::max(c, max2);
+        }
+
+        Float minValues[12], maxValues[12];
+        Math::Implementation::storeLanes(min0, minValues);
+        Math::Implementation::storeLanes(min1, minValues + 4);
+        Math::Implementation::storeLanes(min2, minValues + 8);
+        Math::Implementation::storeLanes(max0, maxValues);
+        Math::Implementation::storeLanes(max1, maxValues + 4);
+        Math::Implementation::storeLanes(max2, maxValues + 8);
+        for(std::size_t j = 0; j != 12; ++j) {
+            min[j%3] = std::min(min[j%3], minValues[j]);
+            max[j%3] = std::max(max[j%3], maxValues[j]);
+        }
+    }
+
+    for(; i != points.size(); ++i) {
+        min = Math::min(min, points[i]);
+        max = Math::max(max, points[i]);
+    }
+
+    return {min, max};
+}
+
+Sphere3D boundingSphere(const Containers::ArrayView<const Vector3> points) {
+    if(points.empty()) return {};
+
+    /* Extremal points along coordinate axes */
+    Vector3 minPoints[3], maxPoints[3];
+    extremalPoints(points, minPoints, maxPoints);
+
+    /* Initial sphere spanned by the most distant pair of them */
+    std::size_t axis = 0;
+    for(std::size_t j = 1; j != 3; ++j)
+        if((maxPoints[j] - minPoints[j]).dot() > (maxPoints[axis] - minPoints[axis]).dot())
+            axis = j;
+    Vector3 center = (minPoints[axis] + maxPoints[axis])*0.5f;
+    Float radius = (maxPoints[axis] - minPoints[axis]).length()*0.5f;
+    Float radiusSquared = radius*radius;
+
+    /* Grow the sphere to contain points outside, keeping the opposite side
+       in place */
+    for(const Vector3& point: points) {
+        const Float distanceSquared = (point - center).dot();
+        if(distanceSquared <= radiusSquared) continue;
+
+        const Float distance = std::sqrt(distanceSquared);
+        const Float newRadius = (radius + distance)*0.5f;
+        center += (point - center)*((newRadius - radius)/distance);
+        radius = newRadius;
+        radiusSquared = radius*radius;
+    }
+
+    /* Moving the center accumulates rounding errors, which could leave some
+       of the points slightly outside */
+    return {center, std::max(radius, std::sqrt(maxDistanceSquared(points, center)))};
+}
+
+Sphere3D minimalBoundingSphere(const Containers::ArrayView<const Vector3> points) {
+    if(points.empty()) return {};
+
+    /* Randomized order makes the expected number of recomputations small,
+       fixed seed makes the result reproducible */
+    std::vector<Vector3d> p;
+    p.reserve(points.size());
+    for(const Vector3& point: points) p.push_back(Vector3d{point});
+    std::shuffle(p.begin(), p.end(), std::minstd_rand{});
+
+    /* Each level fixes one more point on the boundary. Points that end up
+       outside on the top level are moved to the front, as they are likely to
+       define the final ball. */
+    Ball out = ball(p[0]);
+    for(std::size_t i = 1; i != p.size(); ++i) {
+        if(contains(out, p[i])) continue;
+
+        out = ball(p[i]);
+        for(std::size_t j = 0; j != i; ++j) {
+            if(contains(out, p[j])) continue;
+
+            out = ball(p[i], p[j]);
+            for(std::size_t k = 0; k != j; ++k) {
+                if(contains(out, p[k])) continue;
+
+                out = ball(p[i], p[j], p[k]);
+                for(std::size_t l = 0; l != k; ++l) {
+                    if(contains(out, p[l])) continue;
+
+                    out = ball(p[i], p[j], p[k], p[l]);
+                }
+            }
+        }
+
+        std::rotate(p.begin(), p.begin() + i, p.begin() + i + 1);
+    }
+
+    const Vector3 center{out.center};
+    return {center, std::max(Float(std::sqrt(out.radiusSquared)), std::sqrt(maxDistanceSquared(points, center)))};
+}
+
+Box3D orientedBoundingBox(const Containers::ArrayView<const Vector3> points) {
+    if(points.empty()) return {};
+
+    /* Covariance in double precision and in two passes to avoid catastrophic
+       cancellation on large point sets far from origin */
+    Vector3d mean;
+    for(const Vector3& point: points) mean += Vector3d{point};
+    mean /= Double(points.size());
+
+    Matrix3x3d covariance{Math::ZeroInit};
+    for(const Vector3& point: points) {
+        const Vector3d d = Vector3d{point} - mean;
+        for(std::size_t col = 0; col != 3; ++col)
+            for(std::size_t row = col; row != 3; ++row)
+                covariance[col][row] += d[col]*d[row];
+    }
+
+    /* Principal axes, projection of the points on them gives the extents */
+    const Matrix3x3 axes{Math::Algorithms::symmetricEigen3x3(covariance).first};
+    Vector3 min{Constants::inf()};
+    Vector3 max{-Constants::inf()};
+    std::size_t i = 0;
+    {
+        const Float* const data = points.data()->data();
+        Lanes axisLanes[3][3];
+        for(std::size_t j = 0; j != 3; ++j)
+            for(std::size_t k = 0; k != 3; ++k)
+                axisLanes[j][k] = Lanes{axes[j][k]};
+        Lanes minLanes[3], maxLanes[3];
+        for(std::size_t j = 0; j != 3; ++j) {
+            minLanes[j] = Lanes{Constants::inf()};
+            maxLanes[j] = Lanes{-Constants::inf()};
+        }
+
+        for(; canLoadTransposed(i, points.size()); i += 4) {
+            Lanes p[4];
+            Math::Implementation::loadTransposed(data + 3*i, 3, p);
+            for(std::size_t j = 0; j != 3; ++j) {
+                const Lanes projected = p[0]*axisLanes[j][0] + p[1]*axisLanes[j][1] + p[2]*axisLanes[j][2];
+                minLanes[j] = Math::Implementation::min(projected, minLanes[j]);
+                maxLanes[j] = Math::Implementation::max(projected, maxLanes[j]);
+            }
+        }
+
+        for(std::size_t j = 0; j != 3; ++j) {
+            Float minValues[4], maxValues[4];
+            Math::Implementation::storeLanes(minLanes[j], minValues);
+            Math::Implementation::storeLanes(maxLanes[j], maxValues);
+            min[j] = std::min(std::min(minValues[0], minValues[1]), std::min(minValues[2], minValues[3]));
+            max[j] = std::max(std::max(maxValues[0], maxValues[1]), std::max(maxValues[2], maxValues[3]));
+        }
+    }
+    for(; i != points.size(); ++i) {
+        const Vector3 projected = axes.transposed()*points[i];
+        min = Math::min(min, projected);
+        max = Math::max(max, projected);
+    }
+
+    /* Prefer the axis-aligned box if it's tighter, compare by surface area
+       for flat point sets */
+    const auto measure = [](const Vector3& halfExtents) {
+        return std::make_pair(halfExtents.product(), halfExtents.x()*halfExtents.y() + halfExtents.y()*halfExtents.z() + halfExtents.z()*halfExtents.x());
+    };
+    const Vector3 halfExtents = (max - min)*0.5f;
+    const AxisAlignedBox3D aabb = boundingAxisAlignedBox(points);
+    const Vector3 aabbHalfExtents = (aabb.max() - aabb.min())*0.5f;
+    if(measure(aabbHalfExtents) <= measure(halfExtents))
+        return Box3D{Matrix4::translation((aabb.min() + aabb.max())*0.5f)*Matrix4::scaling(aabbHalfExtents)};
+
+    return Box3D{Matrix4::from(Matrix3x3{axes[0]*halfExtents[0], axes[1]*halfExtents[1], axes[2]*halfExtents[2]}, axes*((min + max)*0.5f))};
+}
+
+}}
@@ -0,0 +1,107 @@
+#ifndef Magnum_Shapes_BoundingVolume_h
+#define Magnum_Shapes_BoundingVolume_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Shapes::boundingAxisAlignedBox(), @ref Magnum::Shapes::boundingSphere(), @ref Magnum::Shapes::minimalBoundingSphere(), @ref Magnum::Shapes::orientedBoundingBox()
+ */
+
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Box.h"
+#include "Magnum/Shapes/Sphere.h"
+#include "Magnum/Shapes/visibility.h"
+
+namespace Magnum { namespace Shapes {
+
+/**
+@{ @name Bounding volume fitting
+
+Functions for computing tight bounding volumes of point sets, e.g. of mesh
+positions:
+@code
+Trade::MeshData3D data;
+const std::vector<Vector3>& positions = data.positions(0);
+Shapes::Sphere3D sphere = Shapes::minimalBoundingSphere({positions.data(), positions.size()});
+@endcode
+
+All functions return default-constructed (zero-sized at origin) shape if
+the point set is empty.
+*/
+
+/**
+@brief Bounding axis-aligned box
+
+The points are processed four at a time with SSE2 if the library is compiled
+with it enabled.
+*/
+AxisAlignedBox3D MAGNUM_SHAPES_EXPORT boundingAxisAlignedBox(Containers::ArrayView<const Vector3> points);
+
+/**
+@brief Approximate bounding sphere
+
+Uses the algorithm from *Ritter, J. (1990). "An Efficient Bounding Sphere"*
+with the initial sphere spanned by the most distant pair of extremal points
+along coordinate axes. The result is usually a few percent larger than the
+@ref minimalBoundingSphere() "minimal one", but the computation is
+considerably faster.
+*/
+Sphere3D MAGNUM_SHAPES_EXPORT boundingSphere(Containers::ArrayView<const Vector3> points);
+
+/**
+@brief Minimal bounding sphere
+
+Uses the move-to-front variant of the algorithm from *Welzl, E. (1991).
+"Smallest enclosing disks (balls and ellipsoids)"*, which runs in expected
+linear time. The points are processed in a pseudo-random but deterministic
+order, the sphere is computed in double precision and the radius is enlarged
+at the end to contain all points even after rounding to single precision.
+@see @ref boundingSphere()
+*/
+Sphere3D MAGNUM_SHAPES_EXPORT minimalBoundingSphere(Containers::ArrayView<const Vector3> points);
+
+/**
+@brief Oriented bounding box
+
+Box axes are eigenvectors of the point covariance matrix, computed using
+@ref Math::Algorithms::symmetricEigen3x3(). The returned box transformation
+is rotation scaled with half extents along the axes, translated to the box
+center. If the axis-aligned box is smaller than the one aligned with the
+principal axes (which can happen as the covariance is affected by point
+distribution, not only by the shape), it's returned instead. If all points
+lie in a plane or on a line, the box has zero scale in the remaining
+directions.
+@see @ref boundingAxisAlignedBox()
+*/
+Box3D MAGNUM_SHAPES_EXPORT orientedBoundingBox(Containers::ArrayView<const Vector3> points);
+
+/*@}*/
+
+}}
+
+#endif
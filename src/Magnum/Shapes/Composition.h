@@ -86,7 +86,8 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Composition {
             Capsule,        /**< Capsule */
             AxisAlignedBox, /**< @ref AxisAlignedBox "Axis aligned box" */
             Box,            /**< Box */
-            Plane           /**< Plane (3D only) */
+            Plane,          /**< Plane (3D only) */
+            ConvexHull      /**< @ref ConvexHull "Convex hull" (3D only) */
         };
         #else
         typedef typename Implementation::ShapeDimensionTraits<dimensions>::Type Type;
@@ -0,0 +1,532 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ConvexHull.h"
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Box.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/LineSegment.h"
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/Sphere.h"
+#include "Magnum/Shapes/Implementation/Gjk.h"
+
+namespace Magnum { namespace Shapes {
+
+ConvexHull::ConvexHull(std::vector<Vector3> vertices, std::vector<UnsignedInt> indices, const Matrix4& transformation): _vertices(std::move(vertices)), _indices(std::move(indices)), _transformation(transformation) {
+    CORRADE_ASSERT(_indices.size() % 3 == 0,
+        "Shapes::ConvexHull::ConvexHull(): index count" << _indices.size() << "is not divisible by 3", );
+
+    _planes.reserve(_indices.size()/3);
+    for(std::size_t i = 0; i + 2 < _indices.size(); i += 3) {
+        const Vector3 a = _vertices[_indices[i]];
+        const Vector3 normal = Math::cross(_vertices[_indices[i + 1]] - a, _vertices[_indices[i + 2]] - a).normalized();
+        _planes.push_back({normal, -Math::dot(normal, a)});
+    }
+
+    /* A hull with no volume is a two-sided polygon, so its face planes
+       contain every point of the polygon plane. Add planes perpendicular to
+       the polygon boundary so the half-space test rejects coplanar points
+       outside of it. */
+    if(_planes.empty() || !std::all_of(_planes.begin(), _planes.end(), [this](const Vector4& plane) {
+        return Math::abs(Math::dot(plane.xyz(), _planes[0].xyz())) > 1.0f - Math::TypeTraits<Float>::epsilon();
+    })) return;
+
+    /* Boundary edges of faces facing the same direction as the first one are
+       the edges without their reverse counterpart */
+    const Vector3 normal = _planes[0].xyz();
+    std::vector<std::pair<UnsignedInt, UnsignedInt>> edges;
+    for(std::size_t i = 0; i + 2 < _indices.size(); i += 3) {
+        if(Math::dot(_planes[i/3].xyz(), normal) < 0.0f) continue;
+        for(std::size_t j = 0; j != 3; ++j)
+            edges.emplace_back(_indices[i + j], _indices[i + (j + 1)%3]);
+    }
+    for(const std::pair<UnsignedInt, UnsignedInt>& edge: edges) {
+        if(std::find(edges.begin(), edges.end(), std::make_pair(edge.second, edge.first)) != edges.end())
+            continue;
+
+        const Vector3 a = _vertices[edge.first];
+        const Vector3 outside = Math::cross(_vertices[edge.second] - a, normal).normalized();
+        _planes.push_back({outside, -Math::dot(outside, a)});
+    }
+}
+
+ConvexHull ConvexHull::transformed(const Matrix4& matrix) const {
+    ConvexHull out(*this);
+    out._transformation = matrix*_transformation;
+    return out;
+}
+
+Vector3 ConvexHull::support(const Vector3& direction) const {
+    /* Farthest vertex in the untransformed direction, transformed back. Works
+       for non-uniform scaling as well. */
+    const Vector3 localDirection = _transformation.rotationScaling().transposed()*direction;
+    std::size_t farthest = 0;
+    Float farthestDistance = Math::dot(_vertices[0], localDirection);
+    for(std::size_t i = 1; i != _vertices.size(); ++i) {
+        const Float distance = Math::dot(_vertices[i], localDirection);
+        if(distance > farthestDistance) {
+            farthest = i;
+            farthestDistance = distance;
+        }
+    }
+
+    return _transformation.transformPoint(_vertices[farthest]);
+}
+
+namespace {
+
+/* Support function of the hull, for GJK */
+struct ConvexHullSupport {
+    Vector3 operator()(const Vector3& direction) const {
+        return hull.support(direction);
+    }
+
+    const ConvexHull& hull;
+};
+
+}
+
+bool ConvexHull::operator%(const Point3D& other) const {
+    if(_vertices.empty()) return false;
+
+    /* Hulls with no faces are not solid, do it the hard way */
+    if(_planes.empty()) {
+        Implementation::Simplex simplex;
+        return Implementation::gjk(ConvexHullSupport{*this}, Implementation::PointSupport{other.position()}, simplex, 0.0f) == 0.0f;
+    }
+
+    const Vector4 point{_transformation.inverted().transformPoint(other.position()), 1.0f};
+    for(const Vector4& plane: _planes)
+        if(Math::dot(plane, point) > 0.0f) return false;
+    return true;
+}
+
+bool ConvexHull::operator%(const LineSegment3D& other) const {
+    if(_vertices.empty()) return false;
+
+    Implementation::Simplex simplex;
+    return Implementation::gjk(ConvexHullSupport{*this}, Implementation::LineSegmentSupport{other.a(), other.b()}, simplex, 0.0f) == 0.0f;
+}
+
+bool ConvexHull::operator%(const Sphere3D& other) const {
+    if(_vertices.empty()) return false;
+
+    Implementation::Simplex simplex;
+    return Implementation::gjk(ConvexHullSupport{*this}, Implementation::PointSupport{other.position()}, simplex, other.radius()) <= other.radius();
+}
+
+bool ConvexHull::operator%(const Capsule3D& other) const {
+    if(_vertices.empty()) return false;
+
+    Implementation::Simplex simplex;
+    return Implementation::gjk(ConvexHullSupport{*this}, Implementation::LineSegmentSupport{other.a(), other.b()}, simplex, other.radius()) <= other.radius();
+}
+
+bool ConvexHull::operator%(const AxisAlignedBox3D& other) const {
+    if(_vertices.empty()) return false;
+
+    Implementation::Simplex simplex;
+    return Implementation::gjk(ConvexHullSupport{*this}, Implementation::AxisAlignedBoxSupport{other.min(), other.max()}, simplex, 0.0f) == 0.0f;
+}
+
+bool ConvexHull::operator%(const Box3D& other) const {
+    if(_vertices.empty()) return false;
+
+    Implementation::Simplex simplex;
+    return Implementation::gjk(ConvexHullSupport{*this}, Implementation::BoxSupport{other.transformation()}, simplex, 0.0f) == 0.0f;
+}
+
+bool ConvexHull::operator%(const ConvexHull& other) const {
+    if(_vertices.empty() || other._vertices.empty()) return false;
+
+    Implementation::Simplex simplex;
+    return Implementation::gjk(ConvexHullSupport{*this}, ConvexHullSupport{other}, simplex, 0.0f) == 0.0f;
+}
+
+namespace {
+
+/* Computations are done in double precision, otherwise nearly coplanar faces
+   could make the visibility tests inconsistent */
+typedef Math::Vector3<Double> Vector3d;
+
+constexpr UnsignedInt None = ~UnsignedInt{};
+
+/* Triangle face. Edge i goes from vertex i to vertex i + 1 and the neighbor i
+   is the face on the other side of it. Points outside are kept in a linked
+   list. */
+struct Face {
+    UnsignedInt vertices[3];
+    UnsignedInt neighbors[3];
+    Vector3d normal;
+    Double distance;
+    UnsignedInt outside;
+    UnsignedInt farthest;
+    Double farthestDistance;
+    bool deleted;
+};
+
+class Quickhull {
+    public:
+        explicit Quickhull(Containers::ArrayView<const Vector3> points);
+
+        /* Returns false if the points are flat */
+        bool initialize(UnsignedInt (&extremes)[4]);
+
+        void run(UnsignedInt maxVertexCount);
+
+        ConvexHull hull() const;
+
+    private:
+        Double distance(const Face& face, UnsignedInt point) const {
+            return Math::dot(face.normal, _points[point]) - face.distance;
+        }
+
+        UnsignedInt addFace(UnsignedInt a, UnsignedInt b, UnsignedInt c);
+        void assign(UnsignedInt point, UnsignedInt firstFace, UnsignedInt faceEnd);
+        void link(UnsignedInt face, UnsignedInt a, UnsignedInt b, UnsignedInt neighbor);
+        void horizon(UnsignedInt point, UnsignedInt face, UnsignedInt edge);
+
+        std::vector<Vector3d> _points;
+        std::vector<UnsignedInt> _next;
+        std::vector<Face> _faces;
+        std::vector<UnsignedInt> _visible;
+        std::vector<std::pair<UnsignedInt, UnsignedInt>> _horizon;
+        Double _tolerance;
+};
+
+Quickhull::Quickhull(const Containers::ArrayView<const Vector3> points): _next(points.size(), None) {
+    _points.reserve(points.size());
+    Vector3d max;
+    for(const Vector3& point: points) {
+        _points.push_back(Vector3d{point});
+        max = Math::max(max, Math::abs(_points.back()));
+    }
+
+    /* Tolerance based on precision of the input, as in Lloyd, J. E. (2004).
+       "QuickHull3D" */
+    _tolerance = 3.0*Double(std::numeric_limits<Float>::epsilon())*(max.x() + max.y() + max.z());
+}
+
+bool Quickhull::initialize(UnsignedInt (&extremes)[4]) {
+    /* Two most distant extremal points along coordinate axes */
+    UnsignedInt minIds[3]{}, maxIds[3]{};
+    for(UnsignedInt i = 1; i != _points.size(); ++i) for(std::size_t j = 0; j != 3; ++j) {
+        if(_points[i][j] < _points[minIds[j]][j]) minIds[j] = i;
+        if(_points[i][j] > _points[maxIds[j]][j]) maxIds[j] = i;
+    }
+    std::size_t axis = 0;
+    for(std::size_t j = 1; j != 3; ++j)
+        if(_points[maxIds[j]][j] - _points[minIds[j]][j] > _points[maxIds[axis]][axis] - _points[minIds[axis]][axis])
+            axis = j;
+    extremes[0] = minIds[axis];
+    extremes[1] = maxIds[axis];
+    extremes[2] = extremes[3] = None;
+    if(_points[extremes[1]][axis] - _points[extremes[0]][axis] <= _tolerance) {
+        extremes[1] = extremes[0];
+        return false;
+    }
+
+    /* Point farthest from the line */
+    const Vector3d direction = (_points[extremes[1]] - _points[extremes[0]]).normalized();
+    Double maxDistance = 0.0;
+    for(UnsignedInt i = 0; i != _points.size(); ++i) {
+        const Double distance = Math::cross(_points[i] - _points[extremes[0]], direction).dot();
+        if(distance > maxDistance) {
+            maxDistance = distance;
+            extremes[2] = i;
+        }
+    }
+    if(maxDistance <= _tolerance*_tolerance) {
+        extremes[2] = None;
+        return false;
+    }
+
+    /* Point farthest from the plane */
+    const Vector3d normal = Math::cross(_points[extremes[1]] - _points[extremes[0]], _points[extremes[2]] - _points[extremes[0]]).normalized();
+    maxDistance = 0.0;
+    for(UnsignedInt i = 0; i != _points.size(); ++i) {
+        const Double distance = std::abs(Math::dot(_points[i] - _points[extremes[0]], normal));
+        if(distance > maxDistance) {
+            maxDistance = distance;
+            extremes[3] = i;
+        }
+    }
+    if(maxDistance <= _tolerance) return false;
+
+    /* Tetrahedron with faces pointing outside */
+    UnsignedInt a = extremes[0], b = extremes[1], c = extremes[2];
+    const UnsignedInt d = extremes[3];
+    if(Math::dot(_points[d] - _points[a], normal) > 0.0) std::swap(b, c);
+    const UnsignedInt faces[]{
+        addFace(a, b, c),
+        addFace(a, d, b),
+        addFace(b, d, c),
+        addFace(c, d, a)};
+    for(UnsignedInt face: faces) for(UnsignedInt other: faces) {
+        if(face == other) continue;
+        for(std::size_t i = 0; i != 3; ++i)
+            link(face, _faces[other].vertices[(i + 1)%3], _faces[other].vertices[i], other);
+    }
+
+    for(UnsignedInt i = 0; i != _points.size(); ++i)
+        if(i != a && i != b && i != c && i != d) assign(i, 0, 4);
+
+    return true;
+}
+
+UnsignedInt Quickhull::addFace(const UnsignedInt a, const UnsignedInt b, const UnsignedInt c) {
+    Face face;
+    face.vertices[0] = a;
+    face.vertices[1] = b;
+    face.vertices[2] = c;
+    face.neighbors[0] = face.neighbors[1] = face.neighbors[2] = None;
+    face.normal = Math::cross(_points[b] - _points[a], _points[c] - _points[a]);
+    const Double length = face.normal.length();
+    if(length > 0.0) face.normal /= length;
+    face.distance = Math::dot(face.normal, _points[a]);
+    face.outside = None;
+    face.farthest = None;
+    face.farthestDistance = 0.0;
+    face.deleted = false;
+    _faces.push_back(face);
+    return _faces.size() - 1;
+}
+
+/* Sets neighbor of the face across edge from a to b, if it has such edge */
+void Quickhull::link(const UnsignedInt face, const UnsignedInt a, const UnsignedInt b, const UnsignedInt neighbor) {
+    Face& f = _faces[face];
+    for(std::size_t i = 0; i != 3; ++i)
+        if(f.vertices[i] == a && f.vertices[(i + 1)%3] == b)
+            f.neighbors[i] = neighbor;
+}
+
+/* Adds the point to outside set of the face it's farthest from, if any */
+void Quickhull::assign(const UnsignedInt point, const UnsignedInt faceBegin, const UnsignedInt faceEnd) {
+    UnsignedInt best = None;
+    Double bestDistance = _tolerance;
+    for(UnsignedInt i = faceBegin; i != faceEnd; ++i) {
+        const Double d = distance(_faces[i], point);
+        if(d > bestDistance) {
+            best = i;
+            bestDistance = d;
+        }
+    }
+    if(best == None) return;
+
+    Face& face = _faces[best];
+    _next[point] = face.outside;
+    face.outside = point;
+    if(bestDistance > face.farthestDistance) {
+        face.farthest = point;
+        face.farthestDistance = bestDistance;
+    }
+}
+
+/* Marks faces visible from the point as deleted and collects the horizon
+   edges in counterclockwise order. The face was entered across given edge,
+   the recursion continues with the remaining ones. Unlike with assignment of
+   outside points, the visibility is tested without tolerance, as keeping a
+   nearly coplanar face would make the new faces slightly concave and the
+   error accumulates over the iterations. */
+void Quickhull::horizon(const UnsignedInt point, const UnsignedInt face, const UnsignedInt edge) {
+    _faces[face].deleted = true;
+    _visible.push_back(face);
+
+    const std::size_t begin = edge == None ? 0 : edge + 1;
+    const std::size_t count = edge == None ? 3 : 2;
+    for(std::size_t i = 0; i != count; ++i) {
+        const UnsignedInt e = (begin + i)%3;
+        const UnsignedInt neighbor = _faces[face].neighbors[e];
+        if(_faces[neighbor].deleted) continue;
+
+        if(distance(_faces[neighbor], point) > 0.0) {
+            const UnsignedInt a = _faces[face].vertices[e];
+            UnsignedInt neighborEdge = 0;
+            while(_faces[neighbor].vertices[neighborEdge] != a) ++neighborEdge;
+            horizon(point, neighbor, (neighborEdge + 2)%3);
+        } else _horizon.emplace_back(face, e);
+    }
+}
+
+void Quickhull::run(const UnsignedInt maxVertexCount) {
+    /* Faces ordered by distance of their farthest point, processing the
+       globally farthest point first gives the best approximation if the
+       vertex count is limited */
+    std::priority_queue<std::pair<Double, UnsignedInt>> queue;
+    for(UnsignedInt i = 0; i != _faces.size(); ++i)
+        if(_faces[i].outside != None) queue.emplace(_faces[i].farthestDistance, i);
+
+    std::size_t vertexCount = 4;
+    std::vector<UnsignedInt> unassigned;
+    while(!queue.empty() && (!maxVertexCount || vertexCount < maxVertexCount)) {
+        const UnsignedInt face = queue.top().second;
+        queue.pop();
+        if(_faces[face].deleted) continue;
+
+        /* Remove the farthest point from the outside set, it becomes a hull
+           vertex */
+        const UnsignedInt eye = _faces[face].farthest;
+
+        _visible.clear();
+        _horizon.clear();
+        horizon(eye, face, None);
+
+        /* Outside points of all deleted faces need to be reassigned */
+        unassigned.clear();
+        for(UnsignedInt visible: _visible)
+            for(UnsignedInt i = _faces[visible].outside; i != None; i = _next[i])
+                if(i != eye) unassigned.push_back(i);
+
+        /* Cone of new faces from the horizon to the eye point. Consecutive
+           horizon edges share a vertex, so consecutive faces are neighbors. */
+        const UnsignedInt firstFace = _faces.size();
+        for(const std::pair<UnsignedInt, UnsignedInt>& edge: _horizon) {
+            const Face& visible = _faces[edge.first];
+            const UnsignedInt a = visible.vertices[edge.second];
+            const UnsignedInt b = visible.vertices[(edge.second + 1)%3];
+            const UnsignedInt opposite = visible.neighbors[edge.second];
+            const UnsignedInt created = addFace(a, b, eye);
+            _faces[created].neighbors[0] = opposite;
+            link(opposite, b, a, created);
+        }
+        const UnsignedInt faceCount = _horizon.size();
+        for(UnsignedInt i = 0; i != faceCount; ++i) {
+            Face& created = _faces[firstFace + i];
+            Face& next = _faces[firstFace + (i + 1)%faceCount];
+            CORRADE_INTERNAL_ASSERT(created.vertices[1] == next.vertices[0]);
+            created.neighbors[1] = firstFace + (i + 1)%faceCount;
+            next.neighbors[2] = firstFace + i;
+        }
+
+        for(UnsignedInt point: unassigned) assign(point, firstFace, _faces.size());
+        for(UnsignedInt i = firstFace; i != _faces.size(); ++i)
+            if(_faces[i].outside != None) queue.emplace(_faces[i].farthestDistance, i);
+
+        ++vertexCount;
+    }
+}
+
+ConvexHull Quickhull::hull() const {
+    std::vector<UnsignedInt> remap(_points.size(), None);
+    std::vector<Vector3> vertices;
+    std::vector<UnsignedInt> indices;
+    for(const Face& face: _faces) {
+        if(face.deleted) continue;
+
+        for(UnsignedInt vertex: face.vertices) {
+            if(remap[vertex] == None) {
+                remap[vertex] = vertices.size();
+                vertices.push_back(Vector3{_points[vertex]});
+            }
+            indices.push_back(remap[vertex]);
+        }
+    }
+
+    return ConvexHull{std::move(vertices), std::move(indices)};
+}
+
+/* Hull of points lying in a plane, computed with the monotone chain
+   algorithm in plane coordinates. The polygon is simplified by removing
+   vertices spanning the smallest triangle with their neighbors. */
+ConvexHull flatHull(const Containers::ArrayView<const Vector3> points, const UnsignedInt (&extremes)[4], const UnsignedInt maxVertexCount) {
+    const Vector3 origin = points[extremes[0]];
+    const Vector3 x = (points[extremes[1]] - origin).normalized();
+    const Vector3 normal = Math::cross(x, points[extremes[2]] - origin).normalized();
+    const Vector3 y = Math::cross(normal, x);
+
+    std::vector<std::pair<Vector2, UnsignedInt>> projected;
+    projected.reserve(points.size());
+    for(UnsignedInt i = 0; i != points.size(); ++i)
+        projected.emplace_back(Vector2{Math::dot(points[i] - origin, x), Math::dot(points[i] - origin, y)}, i);
+    std::sort(projected.begin(), projected.end(), [](const std::pair<Vector2, UnsignedInt>& a, const std::pair<Vector2, UnsignedInt>& b) {
+        return a.first.x() < b.first.x() || (a.first.x() == b.first.x() && a.first.y() < b.first.y());
+    });
+
+    /* Lower and upper chain, counterclockwise */
+    const auto turn = [](const Vector2& a, const Vector2& b, const Vector2& c) {
+        return Math::cross(b - a, c - a);
+    };
+    std::vector<std::pair<Vector2, UnsignedInt>> polygon;
+    for(std::size_t pass = 0; pass != 2; ++pass) {
+        const std::size_t chainBegin = polygon.size();
+        for(std::size_t i = 0; i != projected.size(); ++i) {
+            const std::pair<Vector2, UnsignedInt>& point = projected[pass ? projected.size() - i - 1 : i];
+            while(polygon.size() >= chainBegin + 2 && turn(polygon[polygon.size() - 2].first, polygon.back().first, point.first) <= 0.0f)
+                polygon.pop_back();
+            polygon.push_back(point);
+        }
+        /* The last point is the first one of the other chain */
+        polygon.pop_back();
+    }
+
+    const auto area = [&polygon, &turn](std::size_t i) {
+        const std::size_t size = polygon.size();
+        return turn(polygon[(i + size - 1)%size].first, polygon[i].first, polygon[(i + 1)%size].first);
+    };
+    while(maxVertexCount && polygon.size() > Math::max(maxVertexCount, 3u)) {
+        std::size_t smallest = 0;
+        for(std::size_t i = 1; i != polygon.size(); ++i)
+            if(area(i) < area(smallest)) smallest = i;
+        polygon.erase(polygon.begin() + smallest);
+    }
+
+    /* Fan in both directions */
+    std::vector<Vector3> vertices;
+    std::vector<UnsignedInt> indices;
+    for(const std::pair<Vector2, UnsignedInt>& vertex: polygon)
+        vertices.push_back(points[vertex.second]);
+    for(UnsignedInt i = 2; i < vertices.size(); ++i)
+        indices.insert(indices.end(), {0, i - 1, i, 0, i, i - 1});
+
+    return ConvexHull{std::move(vertices), std::move(indices)};
+}
+
+}
+
+ConvexHull convexHull(const Containers::ArrayView<const Vector3> points, const UnsignedInt maxVertexCount) {
+    if(points.empty()) return {};
+
+    Quickhull quickhull{points};
+    UnsignedInt extremes[4];
+    if(!quickhull.initialize(extremes)) {
+        if(extremes[2] != None) return flatHull(points, extremes, maxVertexCount);
+        if(extremes[0] != extremes[1])
+            return ConvexHull{{points[extremes[0]], points[extremes[1]]}, {}};
+        return ConvexHull{{points[extremes[0]]}, {}};
+    }
+
+    quickhull.run(Math::max(maxVertexCount, maxVertexCount ? 4u : 0u));
+    return quickhull.hull();
+}
+
+}}
@@ -0,0 +1,192 @@
+#ifndef Magnum_Shapes_ConvexHull_h
+#define Magnum_Shapes_ConvexHull_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shapes::ConvexHull, function @ref Magnum::Shapes::convexHull()
+ */
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/Shapes/Shapes.h"
+#include "Magnum/Shapes/visibility.h"
+
+namespace Magnum { namespace Shapes {
+
+/**
+@brief Convex hull with assigned transformation matrix (3D only)
+
+Defined by vertices and triangle faces, usually created from mesh positions
+using @ref convexHull(). Similarly to @ref Box, the vertex data are kept
+untransformed and the transformation is applied only during collision
+detection. When the hull is used in @ref Shape, updating the object
+transformation only updates the matrix and doesn't copy the data.
+Collision occurence with other shapes is detected using the GJK algorithm,
+which needs only a support function of each shape. It's much cheaper than a
+deep @ref Composition of simple shapes approximating the same volume. See
+@ref shapes for brief introduction.
+*/
+class MAGNUM_SHAPES_EXPORT ConvexHull {
+    public:
+        enum: UnsignedInt {
+            Dimensions = 3 /**< Dimension count */
+        };
+
+        /**
+         * @brief Default constructor
+         *
+         * Creates empty hull with no vertices, which doesn't collide with
+         * anything.
+         */
+        /*implicit*/ ConvexHull() {}
+
+        /**
+         * @brief Constructor
+         * @param vertices          Hull vertices
+         * @param indices           Triangle faces, counterclockwise when
+         *      looking from the outside
+         * @param transformation    Hull transformation
+         *
+         * Face planes are computed from the data. The index count is
+         * expected to be divisible by three.
+         */
+        explicit ConvexHull(std::vector<Vector3> vertices, std::vector<UnsignedInt> indices, const Matrix4& transformation = {});
+
+        /** @brief Transformed shape */
+        ConvexHull transformed(const Matrix4& matrix) const;
+
+        /** @brief Transformation */
+        Matrix4 transformation() const { return _transformation; }
+
+        /** @brief Set transformation */
+        void setTransformation(const Matrix4& transformation) {
+            _transformation = transformation;
+        }
+
+        /** @brief Untransformed vertices */
+        const std::vector<Vector3>& vertices() const { return _vertices; }
+
+        /** @brief Triangle face indices */
+        const std::vector<UnsignedInt>& indices() const { return _indices; }
+
+        /**
+         * @brief Untransformed face planes
+         *
+         * One plane for each face, with unit normal in the first three
+         * components, pointing outside, and negative distance from origin in
+         * the last component. Dot product of the plane with a point inside
+         * the hull (with `1` in the last component) is not positive. If the
+         * hull is flat, the face planes are followed by one plane for each
+         * boundary edge, perpendicular to the polygon.
+         */
+        const std::vector<Vector4>& planes() const { return _planes; }
+
+        /**
+         * @brief Support point
+         *
+         * Returns the transformed vertex farthest in given direction. Expects
+         * that the hull is not empty.
+         */
+        Vector3 support(const Vector3& direction) const;
+
+        /** @brief Collision occurence with point */
+        bool operator%(const Point3D& other) const;
+
+        /** @brief Collision occurence with line segment */
+        bool operator%(const LineSegment3D& other) const;
+
+        /** @brief Collision occurence with sphere */
+        bool operator%(const Sphere3D& other) const;
+
+        /** @brief Collision occurence with capsule */
+        bool operator%(const Capsule3D& other) const;
+
+        /** @brief Collision occurence with axis-aligned box */
+        bool operator%(const AxisAlignedBox3D& other) const;
+
+        /** @brief Collision occurence with box */
+        bool operator%(const Box3D& other) const;
+
+        /** @brief Collision occurence with another convex hull */
+        bool operator%(const ConvexHull& other) const;
+
+    private:
+        std::vector<Vector3> _vertices;
+        std::vector<UnsignedInt> _indices;
+        std::vector<Vector4> _planes;
+        Matrix4 _transformation;
+};
+
+/** @collisionoccurenceoperator{Point,ConvexHull} */
+inline bool operator%(const Point3D& a, const ConvexHull& b) { return b % a; }
+
+/** @collisionoccurenceoperator{LineSegment,ConvexHull} */
+inline bool operator%(const LineSegment3D& a, const ConvexHull& b) { return b % a; }
+
+/** @collisionoccurenceoperator{Sphere,ConvexHull} */
+inline bool operator%(const Sphere3D& a, const ConvexHull& b) { return b % a; }
+
+/** @collisionoccurenceoperator{Capsule,ConvexHull} */
+inline bool operator%(const Capsule3D& a, const ConvexHull& b) { return b % a; }
+
+/** @collisionoccurenceoperator{AxisAlignedBox,ConvexHull} */
+inline bool operator%(const AxisAlignedBox3D& a, const ConvexHull& b) { return b % a; }
+
+/** @collisionoccurenceoperator{Box,ConvexHull} */
+inline bool operator%(const Box3D& a, const ConvexHull& b) { return b % a; }
+
+/**
+@brief Convex hull of a point set
+@param points           Points, e.g. mesh positions
+@param maxVertexCount   Max vertex count of the hull or `0` for no limit
+
+Uses the Quickhull algorithm from *Barber, C. B.; Dobkin, D. P.; Huhdanpaa,
+H. (1996). "The Quickhull Algorithm for Convex Hulls"*. Points closer to a
+face than a tolerance derived from their magnitude are treated as coplanar
+with it, which keeps flat regions of the mesh from creating a lot of
+degenerate faces.
+
+The hull always grows by the point farthest outside of it, so if
+@p maxVertexCount is not `0`, the algorithm stops after the hull has given
+count of vertices and the remaining points are as close to the hull as
+possible. The simplified hull is then contained in the full one, it's thus
+not guaranteed to enclose all points. Value less than `4` is treated as
+`4`.
+
+If all points lie in a plane, the returned hull is a polygon with faces in
+both directions. If they lie on a line or all points are the same, the hull
+has just the two end vertices or one vertex and no faces. Empty point set
+results in an empty hull.
+*/
+ConvexHull MAGNUM_SHAPES_EXPORT convexHull(Containers::ArrayView<const Vector3> points, UnsignedInt maxVertexCount = 0);
+
+}}
+
+#endif
@@ -25,15 +25,19 @@
 
 #include "CollisionDispatch.h"
 
+#include <Corrade/Utility/Debug.h>
+
 #include "Magnum/Shapes/AxisAlignedBox.h"
 #include "Magnum/Shapes/Box.h"
 #include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/ConvexHull.h"
 #include "Magnum/Shapes/Cylinder.h"
 #include "Magnum/Shapes/LineSegment.h"
 #include "Magnum/Shapes/Plane.h"
 #include "Magnum/Shapes/Point.h"
 #include "Magnum/Shapes/Sphere.h"
 #include "Magnum/Shapes/shapeImplementation.h"
+#include "Magnum/Shapes/Implementation/Gjk.h"
 
 namespace Magnum { namespace Shapes { namespace Implementation {
 
@@ -66,7 +70,7 @@ template<> bool collides(const AbstractShape<2>& a, const AbstractShape<2>& b) {
 }
 
 template<> Collision<2> collision(const AbstractShape<2>& a, const AbstractShape<2>& b) {
-    if(a.type() < b.type()) return collision(b, a);
+    if(a.type() < b.type()) return collision(b, a).flipped();
 
     switch(UnsignedInt(a.type())*UnsignedInt(b.type())) {
         #define _c(aType, aClass, bType, bClass) \
@@ -80,6 +84,106 @@ template<> Collision<2> collision(const AbstractShape<2>& a, const AbstractShape
     return {};
 }
 
+namespace {
+
+/* Support function of a bounded convex shape, returns false for other
+   shapes. Cylinder is handled in convexPair(). */
+bool convexSupport(const AbstractShape<3>& shape, ShapeSupport& out) {
+    out.margin = 0.0f;
+    switch(shape.type()) {
+        case ShapeDimensionTraits<3>::Type::Point:
+            out.type = ShapeSupport::Type::Point;
+            out.a = static_cast<const Shape<Point3D>&>(shape).shape.position();
+            return true;
+        case ShapeDimensionTraits<3>::Type::LineSegment: {
+            const LineSegment3D& segment = static_cast<const Shape<LineSegment3D>&>(shape).shape;
+            out.type = ShapeSupport::Type::LineSegment;
+            out.a = segment.a();
+            out.b = segment.b();
+        } return true;
+        case ShapeDimensionTraits<3>::Type::Sphere: {
+            const Sphere3D& sphere = static_cast<const Shape<Sphere3D>&>(shape).shape;
+            out.type = ShapeSupport::Type::Point;
+            out.a = sphere.position();
+            out.margin = sphere.radius();
+        } return true;
+        case ShapeDimensionTraits<3>::Type::Capsule: {
+            const Capsule3D& capsule = static_cast<const Shape<Capsule3D>&>(shape).shape;
+            out.type = ShapeSupport::Type::LineSegment;
+            out.a = capsule.a();
+            out.b = capsule.b();
+            out.margin = capsule.radius();
+        } return true;
+        case ShapeDimensionTraits<3>::Type::AxisAlignedBox: {
+            const AxisAlignedBox3D& box = static_cast<const Shape<AxisAlignedBox3D>&>(shape).shape;
+            out.type = ShapeSupport::Type::AxisAlignedBox;
+            out.a = box.min();
+            out.b = box.max();
+        } return true;
+        case ShapeDimensionTraits<3>::Type::Box:
+            out.type = ShapeSupport::Type::Box;
+            out.transformation = static_cast<const Shape<Box3D>&>(shape).shape.transformation();
+            return true;
+        case ShapeDimensionTraits<3>::Type::ConvexHull:
+            out.type = ShapeSupport::Type::ConvexHull;
+            out.hull = &static_cast<const Shape<ConvexHull>&>(shape).shape;
+            return !out.hull->vertices().empty();
+
+        default: return false;
+    }
+}
+
+/* The infinite cylinder is clipped to a capsule covering extent of the other
+   shape along the axis, which doesn't change the intersection. The capsule
+   is further extended by size of the other shape so separating it along the
+   axis is never shorter than sideways. */
+void clippedCylinder(const Cylinder3D& cylinder, const ShapeSupport& other, ShapeSupport& out) {
+    const Vector3 axis = (cylinder.b() - cylinder.a()).normalized();
+    const Float min = Math::dot(other(-axis), axis) - other.margin;
+    const Float max = Math::dot(other(axis), axis) + other.margin;
+
+    const Vector3 absolute = Math::abs(axis);
+    const Vector3 perpendicular = Math::cross(axis,
+        absolute.x() <= absolute.y() && absolute.x() <= absolute.z() ? Vector3::xAxis() :
+        absolute.y() <= absolute.z() ? Vector3::yAxis() : Vector3::zAxis()).normalized();
+    const Vector3 perpendicular2 = Math::cross(axis, perpendicular);
+    const Float size = Math::sqrt(Math::pow<2>(max - min) +
+        Math::pow<2>(Math::dot(other(perpendicular) - other(-perpendicular), perpendicular) + 2.0f*other.margin) +
+        Math::pow<2>(Math::dot(other(perpendicular2) - other(-perpendicular2), perpendicular2) + 2.0f*other.margin));
+
+    const Vector3 origin = cylinder.a() - axis*Math::dot(cylinder.a(), axis);
+    out.type = ShapeSupport::Type::LineSegment;
+    out.a = origin + axis*(min - size);
+    out.b = origin + axis*(max + size);
+    out.margin = cylinder.radius();
+}
+
+/* Support functions for generic collision detection of given pair. Returns
+   false if the pair is not supported, i.e. one of the shapes is unbounded or
+   not convex. Pairs without volume, such as point and line segment, are not
+   supported either, because of numerical instability. */
+bool convexPair(const AbstractShape<3>& a, const AbstractShape<3>& b, ShapeSupport& supportA, ShapeSupport& supportB) {
+    const bool cylinderA = a.type() == ShapeDimensionTraits<3>::Type::Cylinder;
+    const bool cylinderB = b.type() == ShapeDimensionTraits<3>::Type::Cylinder;
+    if(cylinderA && cylinderB) return false;
+
+    if(!cylinderA && !convexSupport(a, supportA)) return false;
+    if(!cylinderB && !convexSupport(b, supportB)) return false;
+
+    if(cylinderA)
+        clippedCylinder(static_cast<const Shape<Cylinder3D>&>(a).shape, supportB, supportA);
+    else if(cylinderB)
+        clippedCylinder(static_cast<const Shape<Cylinder3D>&>(b).shape, supportA, supportB);
+    else if(supportA.margin == 0.0f && supportB.margin == 0.0f &&
+        (supportA.type == ShapeSupport::Type::Point || supportA.type == ShapeSupport::Type::LineSegment) &&
+        (supportB.type == ShapeSupport::Type::Point || supportB.type == ShapeSupport::Type::LineSegment))
+        return false;
+
+    return true;
+}
+
+}
+
 template<> bool collides(const AbstractShape<3>& a, const AbstractShape<3>& b) {
     if(a.type() < b.type()) return collides(b, a);
 
@@ -105,14 +209,28 @@ template<> bool collides(const AbstractShape<3>& a, const AbstractShape<3>& b) {
 
         _c(Plane, Plane, Line, Line3D)
         _c(Plane, Plane, LineSegment, LineSegment3D)
+
+        _c(ConvexHull, ConvexHull, Point, Point3D)
+        _c(ConvexHull, ConvexHull, LineSegment, LineSegment3D)
+        _c(ConvexHull, ConvexHull, Sphere, Sphere3D)
+        _c(ConvexHull, ConvexHull, Capsule, Capsule3D)
+        _c(ConvexHull, ConvexHull, AxisAlignedBox, AxisAlignedBox3D)
+        _c(ConvexHull, ConvexHull, Box, Box3D)
+        _c(ConvexHull, ConvexHull, ConvexHull, ConvexHull)
         #undef _c
     }
 
-    return false;
+    /* Generic GJK path for pairs without specialized implementation */
+    ShapeSupport supportA, supportB;
+    if(!convexPair(a, b, supportA, supportB)) return false;
+
+    Simplex simplex;
+    const Float margin = supportA.margin + supportB.margin;
+    return gjk(supportA, supportB, simplex, margin) <= margin;
 }
 
 template<> Collision<3> collision(const AbstractShape<3>& a, const AbstractShape<3>& b) {
-    if(a.type() < b.type()) return collision(b, a);
+    if(a.type() < b.type()) return collision(b, a).flipped();
 
     switch(UnsignedInt(a.type())*UnsignedInt(b.type())) {
         #define _c(aType, aClass, bType, bClass) \
@@ -123,7 +241,183 @@ template<> Collision<3> collision(const AbstractShape<3>& a, const AbstractShape
         #undef _c
     }
 
-    return {};
+    /* Generic GJK and EPA path for pairs without specialized implementation */
+    ShapeSupport supportA, supportB;
+    if(!convexPair(a, b, supportA, supportB)) return {};
+
+    Simplex simplex;
+    const Float margin = supportA.margin + supportB.margin;
+    const Float distance = gjk(supportA, supportB, simplex, margin);
+    if(distance > margin) return {};
+
+    /* Only the margins overlap, the contact is given by closest points of
+       the shape cores */
+    if(distance > 0.0f) {
+        const Vector3 normal = (simplex.pointA() - simplex.pointB())/distance;
+        return Collision3D{simplex.pointB() + normal*supportB.margin, normal, margin - distance};
+    }
+
+    /* The cores overlap, compute the penetration depth */
+    Vector3 normal, pointA, pointB;
+    const Float depth = epa(supportA, supportB, simplex, normal, pointA, pointB);
+    if(depth == 0.0f) return {};
+    return Collision3D{pointB, normal, depth};
+}
+
+template<> Sweep<2> sweep(const AbstractShape<2>& shape, const Matrix3& previousTransformation, const AbstractShape<2>& transformedShape) {
+    CORRADE_ASSERT(shape.type() == ShapeDimensionTraits<2>::Type::Sphere,
+        "Shapes::AbstractShape::timeOfImpact(): only spheres can be swept in 2D, got" << shape.type(), {});
+
+    const Sphere2D from = static_cast<const Shape<Sphere2D>&>(shape).shape.transformed(previousTransformation);
+    const Sphere2D& to = static_cast<const Shape<Sphere2D>&>(transformedShape).shape;
+    return {{from.position(), to.position()}, {from.position(), to.position()}, Math::max(from.radius(), to.radius())};
+}
+
+template<> Sweep<3> sweep(const AbstractShape<3>& shape, const Matrix4& previousTransformation, const AbstractShape<3>& transformedShape) {
+    if(shape.type() == ShapeDimensionTraits<3>::Type::Sphere) {
+        const Sphere3D from = static_cast<const Shape<Sphere3D>&>(shape).shape.transformed(previousTransformation);
+        const Sphere3D& to = static_cast<const Shape<Sphere3D>&>(transformedShape).shape;
+        return {{from.position(), to.position()}, {from.position(), to.position()}, Math::max(from.radius(), to.radius())};
+    }
+
+    CORRADE_ASSERT(shape.type() == ShapeDimensionTraits<3>::Type::Capsule,
+        "Shapes::AbstractShape::timeOfImpact(): only spheres and capsules can be swept, got" << shape.type(), {});
+
+    const Capsule3D from = static_cast<const Shape<Capsule3D>&>(shape).shape.transformed(previousTransformation);
+    const Capsule3D& to = static_cast<const Shape<Capsule3D>&>(transformedShape).shape;
+    return {{from.a(), to.a()}, {from.b(), to.b()}, Math::max(from.radius(), to.radius())};
+}
+
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> bounds(const Sweep<dimensions>& sweep) {
+    return {Math::min(Math::min(sweep.a[0], sweep.a[1]), Math::min(sweep.b[0], sweep.b[1])) - VectorTypeFor<dimensions, Float>{sweep.radius},
+            Math::max(Math::max(sweep.a[0], sweep.a[1]), Math::max(sweep.b[0], sweep.b[1])) + VectorTypeFor<dimensions, Float>{sweep.radius}};
+}
+
+template RangeTypeFor<2, Float> bounds(const Sweep<2>&);
+template RangeTypeFor<3, Float> bounds(const Sweep<3>&);
+
+namespace {
+
+/* Swept sphere against a static sphere, the first root of quadratic
+   equation for the distance of their centers */
+template<UnsignedInt dimensions> Float sphereTimeOfImpact(const Sweep<dimensions>& sweep, const VectorTypeFor<dimensions, Float>& position, const Float radius) {
+    const VectorTypeFor<dimensions, Float> start = sweep.a[0] - position;
+    const VectorTypeFor<dimensions, Float> motion = sweep.a[1] - sweep.a[0];
+
+    /* Already overlapping */
+    const Float c = start.dot() - Math::pow<2>(sweep.radius + radius);
+    if(c <= 0.0f) return 0.0f;
+
+    /* Not approaching or missing */
+    const Float b = Math::dot(start, motion);
+    if(b >= 0.0f) return Constants::inf();
+    const Float discriminant = b*b - motion.dot()*c;
+    if(discriminant < 0.0f) return Constants::inf();
+
+    /* Numerically stable form of (-b - sqrt(discriminant))/a */
+    const Float time = c/(std::sqrt(discriminant) - b);
+    return time <= 1.0f ? time : Constants::inf();
+}
+
+/* Swept capsule against a plane, contact happens when the endpoint nearer
+   to the plane reaches it */
+Float planeTimeOfImpact(const Sweep<3>& sweep, const Plane& plane) {
+    const Vector3 normal = plane.normal().normalized();
+    Float start[]{Math::dot(sweep.a[0] - plane.position(), normal),
+                  Math::dot(sweep.b[0] - plane.position(), normal)};
+    Float end[]{Math::dot(sweep.a[1] - plane.position(), normal),
+                Math::dot(sweep.b[1] - plane.position(), normal)};
+
+    /* Already crossing or touching the plane */
+    if(start[0]*start[1] <= 0.0f || Math::min(std::abs(start[0]), std::abs(start[1])) <= sweep.radius)
+        return 0.0f;
+
+    /* Make the distances positive to avoid handling both sides */
+    if(start[0] < 0.0f) for(std::size_t i = 0; i != 2; ++i) {
+        start[i] = -start[i];
+        end[i] = -end[i];
+    }
+
+    Float time = Constants::inf();
+    for(std::size_t i = 0; i != 2; ++i)
+        if(end[i] <= sweep.radius)
+            time = Math::min(time, (start[i] - sweep.radius)/(start[i] - end[i]));
+    return time;
+}
+
+}
+
+template<> Float timeOfImpact(const Sweep<2>& sweep, const AbstractShape<2>& other) {
+    switch(other.type()) {
+        case ShapeDimensionTraits<2>::Type::Point:
+            return sphereTimeOfImpact(sweep, static_cast<const Shape<Point2D>&>(other).shape.position(), 0.0f);
+        case ShapeDimensionTraits<2>::Type::Sphere: {
+            const Sphere2D& sphere = static_cast<const Shape<Sphere2D>&>(other).shape;
+            return sphereTimeOfImpact(sweep, sphere.position(), sphere.radius());
+        }
+
+        default: return Constants::inf();
+    }
+}
+
+template<> Float timeOfImpact(const Sweep<3>& sweep, const AbstractShape<3>& other) {
+    const bool sphere = sweep.a[0] == sweep.b[0] && sweep.a[1] == sweep.b[1];
+
+    /* Closed-form solutions */
+    switch(other.type()) {
+        case ShapeDimensionTraits<3>::Type::Point:
+            if(!sphere) break;
+            return sphereTimeOfImpact(sweep, static_cast<const Shape<Point3D>&>(other).shape.position(), 0.0f);
+        case ShapeDimensionTraits<3>::Type::Sphere: {
+            if(!sphere) break;
+            const Sphere3D& otherSphere = static_cast<const Shape<Sphere3D>&>(other).shape;
+            return sphereTimeOfImpact(sweep, otherSphere.position(), otherSphere.radius());
+        }
+        case ShapeDimensionTraits<3>::Type::Plane:
+            return planeTimeOfImpact(sweep, static_cast<const Shape<Plane>&>(other).shape);
+
+        default: break;
+    }
+
+    /* Conservative advancement for other bounded convex shapes. The infinite
+       cylinder is clipped to bounds of the whole motion. */
+    ShapeSupport support;
+    if(other.type() == ShapeDimensionTraits<3>::Type::Cylinder) {
+        const Range3D range = bounds(sweep);
+        ShapeSupport swept;
+        swept.type = ShapeSupport::Type::AxisAlignedBox;
+        swept.a = range.min();
+        swept.b = range.max();
+        swept.margin = 0.0f;
+        clippedCylinder(static_cast<const Shape<Cylinder3D>&>(other).shape, swept, support);
+    } else if(!convexSupport(other, support)) return Constants::inf();
+
+    return conservativeAdvancement(sweep.a[0], sweep.b[0], sweep.a[1], sweep.b[1], sweep.radius, support);
+}
+
+template<> Range2D bounds(const AbstractShape<2>& shape) {
+    switch(shape.type()) {
+        case ShapeDimensionTraits<2>::Type::Point: {
+            const Vector2 position = static_cast<const Shape<Point2D>&>(shape).shape.position();
+            return {position, position};
+        }
+        case ShapeDimensionTraits<2>::Type::Sphere: {
+            const Sphere2D& sphere = static_cast<const Shape<Sphere2D>&>(shape).shape;
+            return {sphere.position() - Vector2{sphere.radius()}, sphere.position() + Vector2{sphere.radius()}};
+        }
+
+        default: return {Vector2{-Constants::inf()}, Vector2{Constants::inf()}};
+    }
+}
+
+template<> Range3D bounds(const AbstractShape<3>& shape) {
+    ShapeSupport support;
+    if(!convexSupport(shape, support))
+        return {Vector3{-Constants::inf()}, Vector3{Constants::inf()}};
+
+    const Vector3 margin{support.margin};
+    return {Vector3{support(-Vector3::xAxis()).x(), support(-Vector3::yAxis()).y(), support(-Vector3::zAxis()).z()} - margin,
+            Vector3{support(Vector3::xAxis()).x(), support(Vector3::yAxis()).y(), support(Vector3::zAxis()).z()} + margin};
 }
 
 }}}
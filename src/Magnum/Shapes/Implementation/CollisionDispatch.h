@@ -25,7 +25,9 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include "Magnum/DimensionTraits.h"
 #include "Magnum/Types.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/Shapes/Shapes.h"
 
 namespace Magnum { namespace Shapes { namespace Implementation {
@@ -46,6 +48,34 @@ template<UnsignedInt dimensions> bool collides(const AbstractShape<dimensions>&
 
 template<UnsignedInt dimensions> Collision<dimensions> collision(const AbstractShape<dimensions>& a, const AbstractShape<dimensions>& b);
 
+/*
+Swept shape time of impact:
+
+Sphere or capsule moving from previous to current absolute transformation is
+described by its core line segment (degenerated to a point for spheres) at
+both ends of the motion. The endpoints are interpolated linearly, rotation
+is thus approximated by the chord. The time of impact is a fraction of the
+motion, or infinity if there is no impact.
+*/
+
+template<UnsignedInt dimensions> struct Sweep {
+    VectorTypeFor<dimensions, Float> a[2], b[2];
+    Float radius;
+};
+
+/* The shape is untransformed, the transformed shape corresponds to the end
+   of the motion */
+template<UnsignedInt dimensions> Sweep<dimensions> sweep(const AbstractShape<dimensions>& shape, const MatrixTypeFor<dimensions, Float>& previousTransformation, const AbstractShape<dimensions>& transformedShape);
+
+template<UnsignedInt dimensions> Float timeOfImpact(const Sweep<dimensions>& sweep, const AbstractShape<dimensions>& other);
+
+/* Bounds of the swept shape over whole motion */
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> bounds(const Sweep<dimensions>& sweep);
+
+/* Bounds of a shape, infinite if the shape is unbounded or the bounds are
+   not implemented for it */
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> bounds(const AbstractShape<dimensions>& shape);
+
 }}}
 
 #endif
@@ -0,0 +1,501 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Gjk.h"
+
+#include <utility>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Shapes/ConvexHull.h"
+
+namespace Magnum { namespace Shapes { namespace Implementation {
+
+namespace {
+
+Vector3 vertex(const Simplex& in, const std::size_t i, Simplex& out) {
+    out.a[0] = in.a[i];
+    out.b[0] = in.b[i];
+    out.weights[0] = 1.0f;
+    out.size = 1;
+    return in.w(i);
+}
+
+Vector3 edge(const Simplex& in, const std::size_t i, const std::size_t j, const Float t, Simplex& out) {
+    out.a[0] = in.a[i];
+    out.b[0] = in.b[i];
+    out.a[1] = in.a[j];
+    out.b[1] = in.b[j];
+    out.weights[0] = 1.0f - t;
+    out.weights[1] = t;
+    out.size = 2;
+    return in.w(i)*(1.0f - t) + in.w(j)*t;
+}
+
+Vector3 segment(const Simplex& in, const std::size_t i, const std::size_t j, Simplex& out) {
+    const Vector3 a = in.w(i);
+    const Vector3 ab = in.w(j) - a;
+    const Float t = -Math::dot(a, ab);
+    if(t <= 0.0f) return vertex(in, i, out);
+
+    const Float length = ab.dot();
+    if(t >= length) return vertex(in, j, out);
+
+    return edge(in, i, j, t/length, out);
+}
+
+/* Region-based closest point on a triangle, as in Ericson, C. (2004).
+   "Real-Time Collision Detection", section 5.1.5 */
+Vector3 triangle(const Simplex& in, const std::size_t i, const std::size_t j, const std::size_t k, Simplex& out) {
+    const Vector3 a = in.w(i);
+    const Vector3 b = in.w(j);
+    const Vector3 c = in.w(k);
+    const Vector3 ab = b - a;
+    const Vector3 ac = c - a;
+
+    const Float d1 = -Math::dot(ab, a);
+    const Float d2 = -Math::dot(ac, a);
+    if(d1 <= 0.0f && d2 <= 0.0f) return vertex(in, i, out);
+
+    const Float d3 = -Math::dot(ab, b);
+    const Float d4 = -Math::dot(ac, b);
+    if(d3 >= 0.0f && d4 <= d3) return vertex(in, j, out);
+
+    const Float vc = d1*d4 - d3*d2;
+    if(vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+        return edge(in, i, j, d1/(d1 - d3), out);
+
+    const Float d5 = -Math::dot(ab, c);
+    const Float d6 = -Math::dot(ac, c);
+    if(d6 >= 0.0f && d5 <= d6) return vertex(in, k, out);
+
+    const Float vb = d5*d2 - d1*d6;
+    if(vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+        return edge(in, i, k, d2/(d2 - d6), out);
+
+    const Float va = d3*d6 - d5*d4;
+    if(va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f)
+        return edge(in, j, k, (d4 - d3)/((d4 - d3) + (d5 - d6)), out);
+
+    /* Degenerate triangle, the closest point is on one of the edges */
+    const Float sum = va + vb + vc;
+    if(sum <= 0.0f) {
+        Simplex candidate;
+        Vector3 closest = segment(in, i, j, out);
+        const Vector3 ik = segment(in, i, k, candidate);
+        if(ik.dot() < closest.dot()) {
+            closest = ik;
+            out = candidate;
+        }
+        const Vector3 jk = segment(in, j, k, candidate);
+        if(jk.dot() < closest.dot()) {
+            closest = jk;
+            out = candidate;
+        }
+        return closest;
+    }
+
+    const Float v = vb/sum;
+    const Float w = vc/sum;
+    out.a[0] = in.a[i];
+    out.b[0] = in.b[i];
+    out.a[1] = in.a[j];
+    out.b[1] = in.b[j];
+    out.a[2] = in.a[k];
+    out.b[2] = in.b[k];
+    out.weights[0] = 1.0f - v - w;
+    out.weights[1] = v;
+    out.weights[2] = w;
+    out.size = 3;
+    return a + ab*v + ac*w;
+}
+
+/* Whether origin is on the other side of the face than the remaining vertex.
+   Flat tetrahedron has origin outside of all faces. */
+bool outside(const Vector3& a, const Vector3& b, const Vector3& c, const Vector3& d) {
+    const Vector3 normal = Math::cross(b - a, c - a);
+    const Float signOrigin = -Math::dot(a, normal);
+    const Float signVertex = Math::dot(d - a, normal);
+    if(signVertex*signVertex <= GjkTolerance*GjkTolerance*normal.dot()*(d - a).dot())
+        return true;
+    return signOrigin*signVertex < 0.0f;
+}
+
+}
+
+Vector3 closestToOrigin(Simplex& simplex) {
+    const Simplex in = simplex;
+
+    if(in.size == 1) {
+        simplex.weights[0] = 1.0f;
+        return in.w(0);
+    }
+
+    if(in.size == 2) return segment(in, 0, 1, simplex);
+
+    if(in.size == 3) return triangle(in, 0, 1, 2, simplex);
+
+    /* Tetrahedron, check faces that have origin outside */
+    constexpr std::size_t faces[4][4]{
+        {0, 1, 2, 3},
+        {0, 1, 3, 2},
+        {0, 2, 3, 1},
+        {1, 2, 3, 0}};
+    bool inside = true;
+    Vector3 closest;
+    Float closestDistance = Constants::inf();
+    for(const auto& face: faces) {
+        if(!outside(in.w(face[0]), in.w(face[1]), in.w(face[2]), in.w(face[3])))
+            continue;
+
+        inside = false;
+        Simplex candidate;
+        const Vector3 point = triangle(in, face[0], face[1], face[2], candidate);
+        if(point.dot() < closestDistance) {
+            closest = point;
+            closestDistance = point.dot();
+            simplex = candidate;
+        }
+    }
+
+    return inside ? Vector3{} : closest;
+}
+
+Vector3 ShapeSupport::operator()(const Vector3& direction) const {
+    switch(type) {
+        case Type::Point: return a;
+        case Type::LineSegment: return LineSegmentSupport{a, b}(direction);
+        case Type::AxisAlignedBox: return AxisAlignedBoxSupport{a, b}(direction);
+        case Type::Box: return BoxSupport{transformation}(direction);
+        case Type::ConvexHull: return hull->support(direction);
+    }
+
+    CORRADE_ASSERT_UNREACHABLE();
+}
+
+namespace {
+
+/* Relative precision of the penetration depth. The shape cores are
+   polytopes, so the refinement converges in finite count of steps anyway. */
+constexpr Float EpaTolerance = 1.0e-5f;
+
+/* Polytope has at most 2V - 4 faces, some reserve for numerical issues */
+constexpr UnsignedInt EpaMaxFaces = 2*EpaMaxVertices + 8;
+
+/* Face oriented counterclockwise when looking from outside */
+struct EpaFace {
+    UnsignedInt vertices[3];
+    Vector3 normal;
+    Float distance;
+};
+
+class Polytope {
+    public:
+        explicit Polytope(const ShapeSupport& supportA, const ShapeSupport& supportB): _supportA(supportA), _supportB(supportB), _vertexCount{}, _faceCount{}, _size{} {}
+
+        UnsignedInt vertexCount() const { return _vertexCount; }
+
+        /* Adds support point in given direction, returns its index */
+        UnsignedInt add(const Vector3& direction) {
+            return add(_supportA(direction), _supportB(-direction));
+        }
+
+        UnsignedInt add(const Vector3& a, const Vector3& b) {
+            _a[_vertexCount] = a;
+            _b[_vertexCount] = b;
+            _w[_vertexCount] = a - b;
+            _size = Math::max(_size, _w[_vertexCount].length());
+            return _vertexCount++;
+        }
+
+        bool tetrahedron();
+        Vector3 flatNormal(const Vector3& centerDifference) const;
+        bool grow(Vector3& normal, Vector3& pointA, Vector3& pointB, Float& depth);
+
+    private:
+        /* Whether the last added point is farther than tolerance from given
+           one, otherwise removes it */
+        bool distinct(const Float distance) {
+            if(distance > EpaTolerance*_size) return true;
+            --_vertexCount;
+            return false;
+        }
+
+        void addFace(UnsignedInt i, UnsignedInt j, UnsignedInt k);
+
+        const ShapeSupport& _supportA;
+        const ShapeSupport& _supportB;
+        Vector3 _a[EpaMaxVertices], _b[EpaMaxVertices], _w[EpaMaxVertices];
+        EpaFace _faces[EpaMaxFaces];
+        UnsignedInt _vertexCount, _faceCount;
+        Float _size;
+};
+
+/* GJK ends with a smaller simplex if origin is (numerically) on its boundary,
+   grow it into a tetrahedron. If that's not possible, the Minkowski
+   difference is flat. */
+bool Polytope::tetrahedron() {
+    if(_vertexCount == 1) {
+        constexpr Float directions[][3]{
+            {1.0f, 0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f},
+            {0.0f, 1.0f, 0.0f}, {0.0f, -1.0f, 0.0f},
+            {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, -1.0f}};
+        for(const auto& direction: directions) {
+            const UnsignedInt i = add({direction[0], direction[1], direction[2]});
+            if(distinct((_w[i] - _w[0]).length())) break;
+        }
+        if(_vertexCount == 1) return false;
+    }
+
+    if(_vertexCount == 2) {
+        /* Search around the segment */
+        const Vector3 axis = (_w[1] - _w[0]).normalized();
+        const Vector3 absolute = Math::abs(axis);
+        const Vector3 perpendicular = Math::cross(axis,
+            absolute.x() <= absolute.y() && absolute.x() <= absolute.z() ? Vector3::xAxis() :
+            absolute.y() <= absolute.z() ? Vector3::yAxis() : Vector3::zAxis()).normalized();
+        const Vector3 perpendicular2 = Math::cross(axis, perpendicular);
+        for(Int step = 0; step != 6; ++step) {
+            const UnsignedInt i = add(perpendicular*Math::cos(Deg(step*60.0f)) + perpendicular2*Math::sin(Deg(step*60.0f)));
+            if(distinct(Math::cross(_w[i] - _w[0], axis).length())) break;
+        }
+        if(_vertexCount == 2) return false;
+    }
+
+    if(_vertexCount == 3) {
+        /* Search on both sides of the triangle */
+        const Vector3 normal = Math::cross(_w[1] - _w[0], _w[2] - _w[0]).normalized();
+        for(const Vector3& direction: {normal, -normal}) {
+            const UnsignedInt i = add(direction);
+            if(distinct(std::abs(Math::dot(_w[i] - _w[0], normal)))) break;
+        }
+        if(_vertexCount == 3) return false;
+    }
+
+    return true;
+}
+
+/* Normal of the flat Minkowski difference after tetrahedron() failed,
+   pointing in direction of given center difference. If the difference is a
+   point, the direction can't be decided, so it's up. */
+Vector3 Polytope::flatNormal(const Vector3& centerDifference) const {
+    Vector3 normal;
+    if(_vertexCount == 3) {
+        normal = Math::cross(_w[1] - _w[0], _w[2] - _w[0]).normalized();
+    } else if(_vertexCount == 2) {
+        const Vector3 axis = (_w[1] - _w[0]).normalized();
+        normal = centerDifference - axis*Math::dot(centerDifference, axis);
+        if(normal.dot() <= Math::pow<2>(EpaTolerance*_size)) {
+            const Vector3 absolute = Math::abs(axis);
+            normal = Math::cross(axis,
+                absolute.x() <= absolute.y() && absolute.x() <= absolute.z() ? Vector3::xAxis() :
+                absolute.y() <= absolute.z() ? Vector3::yAxis() : Vector3::zAxis());
+        }
+        normal = normal.normalized();
+    } else return Vector3::yAxis();
+
+    return Math::dot(normal, centerDifference) < 0.0f ? -normal : normal;
+}
+
+void Polytope::addFace(const UnsignedInt i, const UnsignedInt j, const UnsignedInt k) {
+    EpaFace& face = _faces[_faceCount++];
+    face.vertices[0] = i;
+    face.vertices[1] = j;
+    face.vertices[2] = k;
+    face.normal = Math::cross(_w[j] - _w[i], _w[k] - _w[i]);
+
+    /* Degenerate faces are never the closest and never visible */
+    const Float length = face.normal.length();
+    if(length == 0.0f) {
+        face.distance = Constants::inf();
+        return;
+    }
+
+    face.normal /= length;
+    face.distance = Math::dot(face.normal, _w[i]);
+}
+
+/* Builds a tetrahedron from the first four points and refines it until the
+   closest face is on the boundary of the Minkowski difference */
+bool Polytope::grow(Vector3& normal, Vector3& pointA, Vector3& pointB, Float& depth) {
+    /* Orient faces outwards */
+    constexpr UnsignedInt faces[4][4]{
+        {0, 1, 2, 3},
+        {0, 3, 1, 2},
+        {0, 2, 3, 1},
+        {1, 3, 2, 0}};
+    const bool flip = Math::dot(Math::cross(_w[1] - _w[0], _w[2] - _w[0]), _w[3] - _w[0]) > 0.0f;
+    for(const auto& face: faces) {
+        if(flip) addFace(face[0], face[2], face[1]);
+        else addFace(face[0], face[1], face[2]);
+    }
+
+    std::pair<UnsignedInt, UnsignedInt> horizon[3*EpaMaxFaces];
+    UnsignedInt closest;
+    for(;;) {
+        closest = 0;
+        for(UnsignedInt i = 1; i != _faceCount; ++i)
+            if(_faces[i].distance < _faces[closest].distance) closest = i;
+        if(_faces[closest].distance == Constants::inf()) return false;
+
+        /* Stop if there's no more space or the face is on the boundary */
+        if(_vertexCount == EpaMaxVertices) break;
+        const Vector3 direction = _faces[closest].normal;
+        const UnsignedInt eye = add(direction);
+        if(Math::dot(_w[eye], direction) - _faces[closest].distance <= EpaTolerance*_size) {
+            --_vertexCount;
+            break;
+        }
+
+        /* Remove faces visible from the new point, edges that were shared by
+           two removed faces cancel out and the rest forms the horizon */
+        UnsignedInt horizonSize = 0;
+        for(UnsignedInt i = _faceCount; i != 0; --i) {
+            const EpaFace& face = _faces[i - 1];
+            if(Math::dot(face.normal, _w[eye] - _w[face.vertices[0]]) <= 0.0f)
+                continue;
+
+            for(std::size_t j = 0; j != 3; ++j) {
+                const std::pair<UnsignedInt, UnsignedInt> edge{face.vertices[j], face.vertices[(j + 1)%3]};
+                std::size_t k = 0;
+                while(k != horizonSize && (horizon[k].first != edge.second || horizon[k].second != edge.first)) ++k;
+                if(k != horizonSize) horizon[k] = horizon[--horizonSize];
+                else horizon[horizonSize++] = edge;
+            }
+
+            _faces[i - 1] = _faces[--_faceCount];
+        }
+
+        if(_faceCount + horizonSize > EpaMaxFaces) return false;
+        for(UnsignedInt i = 0; i != horizonSize; ++i)
+            addFace(horizon[i].first, horizon[i].second, eye);
+    }
+
+    /* Barycentric coordinates of origin projected on the closest face give
+       the deepest points of both shapes */
+    const EpaFace& face = _faces[closest];
+    const UnsignedInt i = face.vertices[0], j = face.vertices[1], k = face.vertices[2];
+    const Vector3 v0 = _w[j] - _w[i];
+    const Vector3 v1 = _w[k] - _w[i];
+    const Vector3 v2 = face.normal*face.distance - _w[i];
+    const Float d00 = v0.dot();
+    const Float d01 = Math::dot(v0, v1);
+    const Float d11 = v1.dot();
+    const Float d20 = Math::dot(v2, v0);
+    const Float d21 = Math::dot(v2, v1);
+    const Float denominator = d00*d11 - d01*d01;
+    const Float v = (d11*d20 - d01*d21)/denominator;
+    const Float w = (d00*d21 - d01*d20)/denominator;
+    const Float u = 1.0f - v - w;
+
+    normal = -face.normal;
+    pointA = _a[i]*u + _a[j]*v + _a[k]*w;
+    pointB = _b[i]*u + _b[j]*v + _b[k]*w;
+    depth = Math::max(face.distance, 0.0f);
+    return true;
+}
+
+}
+
+Float epa(const ShapeSupport& supportA, const ShapeSupport& supportB, const Simplex& simplex, Vector3& normal, Vector3& pointA, Vector3& pointB) {
+    Polytope polytope{supportA, supportB};
+    for(std::size_t i = 0; i != simplex.size; ++i)
+        polytope.add(simplex.a[i], simplex.b[i]);
+
+    /* Penetration of the shape cores, margins are then simply added */
+    Float depth;
+    if(polytope.tetrahedron()) {
+        if(!polytope.grow(normal, pointA, pointB, depth)) {
+            normal = {};
+            return 0.0f;
+        }
+
+        pointA -= normal*supportA.margin;
+        pointB += normal*supportB.margin;
+        return depth + supportA.margin + supportB.margin;
+    }
+
+    /* The cores are just touching. If they have margins, their intersection
+       can be flat (e.g. two crossing segments of capsules). Origin is then
+       inside the flat Minkowski difference, so the margins need to be
+       separated along its normal. */
+    const Float margin = supportA.margin + supportB.margin;
+    if(margin == 0.0f) {
+        normal = {};
+        return 0.0f;
+    }
+
+    Vector3 centerDifference;
+    for(const Vector3& direction: {Vector3::xAxis(), Vector3::yAxis(), Vector3::zAxis()})
+        centerDifference += supportA(direction) + supportA(-direction) - supportB(direction) - supportB(-direction);
+    normal = polytope.flatNormal(centerDifference);
+
+    Vector3 corePointA, corePointB;
+    for(std::size_t i = 0; i != simplex.size; ++i) {
+        const Float weight = simplex.size == 4 ? 0.25f : simplex.weights[i];
+        corePointA += simplex.a[i]*weight;
+        corePointB += simplex.b[i]*weight;
+    }
+    pointA = corePointA - normal*supportA.margin;
+    pointB = corePointB + normal*supportB.margin;
+    return margin;
+}
+
+Float conservativeAdvancement(const Vector3& a0, const Vector3& b0, const Vector3& a1, const Vector3& b1, const Float margin, const ShapeSupport& other) {
+    const Vector3 motionA = a1 - a0;
+    const Vector3 motionB = b1 - b0;
+    const Float totalMargin = margin + other.margin;
+    const Float tolerance = ToiTolerance*(totalMargin + std::sqrt(Math::max(motionA.dot(), motionB.dot())));
+
+    ShapeSupport moving;
+    moving.type = ShapeSupport::Type::LineSegment;
+    moving.margin = 0.0f;
+
+    Float time = 0.0f;
+    for(UnsignedInt iteration = 0; iteration != ToiMaxIterations; ++iteration) {
+        moving.a = a0 + motionA*time;
+        moving.b = b0 + motionB*time;
+
+        Simplex simplex;
+        const Float distance = gjk(moving, other, simplex);
+        const Float gap = distance - totalMargin;
+        if(gap <= tolerance) return time;
+
+        /* Velocity of any point of the segment is a convex combination of
+           velocities of its endpoints, so the faster endpoint bounds the
+           approach speed along the separating direction. If neither
+           endpoint approaches, the separation can only grow. */
+        const Vector3 normal = (simplex.pointA() - simplex.pointB())/distance;
+        const Float speed = -Math::min(Math::dot(motionA, normal), Math::dot(motionB, normal));
+        if(speed <= 0.0f) return Constants::inf();
+
+        time += gap/speed;
+        if(time > 1.0f) return Constants::inf();
+    }
+
+    /* Not converged, but still no further than the contact */
+    return time;
+}
+
+}}}
@@ -0,0 +1,229 @@
+#ifndef Magnum_Shapes_Implementation_Gjk_h
+#define Magnum_Shapes_Implementation_Gjk_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shapes/Shapes.h"
+
+namespace Magnum { namespace Shapes { namespace Implementation {
+
+/*
+GJK distance algorithm:
+
+Both shapes are given by support functions returning the farthest point of
+the shape in given direction. The algorithm iteratively builds a simplex in
+their Minkowski difference, approaching the point closest to origin. If the
+origin ends up inside, the shapes overlap. Spheres and capsules are handled
+as points and line segments with a margin, which is faster and more precise
+than rounded support functions. See van den Bergen, G. (1999). "A Fast and
+Robust GJK Implementation for Collision Detection of Convex Objects".
+
+EPA penetration depth algorithm:
+
+If the shapes overlap, the final GJK simplex is expanded into a polytope
+inside the Minkowski difference and its face closest to origin is
+iteratively refined using the support functions. The closest face gives the
+penetration depth and normal. See van den Bergen, G. (2001). "Proximity
+Queries and Penetration Depth Computation on 3D Game Objects".
+
+Conservative advancement time of impact:
+
+The moving shape is advanced along its motion by the largest step for which
+it provably can't reach the other shape, computed from the GJK distance and
+the upper bound of the approach speed along the separating direction. The
+iteration converges to the time of first contact, never skipping past it.
+See Mirtich, B. (1996). "Impulse-based Dynamic Simulation of Rigid Body
+Systems", section 2.3.2.
+*/
+
+/* Simplex in the Minkowski difference. Support points of both shapes are
+   kept so the closest points can be reconstructed from barycentric weights
+   of the point closest to origin. */
+struct Simplex {
+    Vector3 w(std::size_t i) const { return a[i] - b[i]; }
+
+    Vector3 pointA() const {
+        Vector3 out;
+        for(std::size_t i = 0; i != size; ++i) out += a[i]*weights[i];
+        return out;
+    }
+
+    Vector3 pointB() const {
+        Vector3 out;
+        for(std::size_t i = 0; i != size; ++i) out += b[i]*weights[i];
+        return out;
+    }
+
+    Vector3 a[4], b[4];
+    Float weights[4];
+    UnsignedInt size;
+};
+
+/* Relative precision of the distance */
+constexpr Float GjkTolerance = 1.0e-6f;
+constexpr UnsignedInt GjkMaxIterations = 64;
+
+/* Reduces the simplex to the smallest subsimplex containing the point
+   closest to origin, updates the weights and returns the point. If the
+   simplex is a tetrahedron containing origin, it's left as is and zero
+   vector is returned. */
+Vector3 closestToOrigin(Simplex& simplex);
+
+/* Distance of two shapes given by support functions, zero if they overlap.
+   If the distance is larger than maxDistance, returns early with a lower
+   bound larger than maxDistance. */
+template<class A, class B> Float gjk(const A& supportA, const B& supportB, Simplex& simplex, const Float maxDistance = Constants::inf()) {
+    /* Start with an arbitrary point of the Minkowski difference */
+    simplex.a[0] = supportA(Vector3::xAxis());
+    simplex.b[0] = supportB(-Vector3::xAxis());
+    simplex.weights[0] = 1.0f;
+    simplex.size = 1;
+    Vector3 v = simplex.w(0);
+
+    for(UnsignedInt iteration = 0; iteration != GjkMaxIterations; ++iteration) {
+        const Vector3 a = supportA(-v);
+        const Vector3 b = supportB(v);
+        const Vector3 w = a - b;
+        const Float vv = v.dot();
+        const Float vw = Math::dot(v, w);
+
+        /* Separating axis, the distance is already known to be larger than
+           allowed */
+        if(vw > 0.0f && vw*vw > vv*maxDistance*maxDistance)
+            return vw/std::sqrt(vv);
+
+        /* No progress in the direction, v is the closest point */
+        if(vv - vw <= vv*GjkTolerance) break;
+
+        /* The point can be already in the simplex due to rounding errors */
+        bool duplicate = false;
+        for(std::size_t i = 0; i != simplex.size; ++i)
+            if(simplex.w(i) == w) duplicate = true;
+        if(duplicate) break;
+
+        simplex.a[simplex.size] = a;
+        simplex.b[simplex.size] = b;
+        ++simplex.size;
+        v = closestToOrigin(simplex);
+
+        /* Origin is inside the tetrahedron or (numerically) on the simplex
+           boundary */
+        if(simplex.size == 4) return 0.0f;
+        Float maxSize = 0.0f;
+        for(std::size_t i = 0; i != simplex.size; ++i)
+            maxSize = Math::max(maxSize, simplex.w(i).dot());
+        if(v.dot() <= GjkTolerance*GjkTolerance*maxSize) return 0.0f;
+    }
+
+    return v.length();
+}
+
+/* Support functions of the basic shapes */
+
+struct PointSupport {
+    Vector3 operator()(const Vector3&) const { return point; }
+
+    Vector3 point;
+};
+
+struct LineSegmentSupport {
+    Vector3 operator()(const Vector3& direction) const {
+        return Math::dot(direction, b - a) > 0.0f ? b : a;
+    }
+
+    Vector3 a, b;
+};
+
+struct AxisAlignedBoxSupport {
+    Vector3 operator()(const Vector3& direction) const {
+        return {direction.x() > 0.0f ? max.x() : min.x(),
+                direction.y() > 0.0f ? max.y() : min.y(),
+                direction.z() > 0.0f ? max.z() : min.z()};
+    }
+
+    Vector3 min, max;
+};
+
+/* Unit box with half extents 1 and given transformation */
+struct BoxSupport {
+    Vector3 operator()(const Vector3& direction) const {
+        Vector3 out = transformation.translation();
+        for(std::size_t i = 0; i != 3; ++i) {
+            const Vector3 axis = transformation[i].xyz();
+            out += Math::dot(axis, direction) > 0.0f ? axis : -axis;
+        }
+        return out;
+    }
+
+    Matrix4 transformation;
+};
+
+/* Support function of any bounded convex shape, used by the generic
+   collision path where the shape types are known only at runtime. Spheres
+   and capsules are a point and a line segment with a margin. */
+struct ShapeSupport {
+    enum class Type: UnsignedByte {
+        Point,
+        LineSegment,
+        AxisAlignedBox,
+        Box,
+        ConvexHull
+    };
+
+    Vector3 operator()(const Vector3& direction) const;
+
+    Type type;
+    Vector3 a, b;
+    Matrix4 transformation;
+    const ConvexHull* hull;
+    Float margin;
+};
+
+/* Max count of EPA polytope vertices, the refinement stops when reached */
+constexpr UnsignedInt EpaMaxVertices = 64;
+
+/* Penetration depth of two overlapping shapes including their margins,
+   with simplex from gjk() returning zero. Fills separation normal (in which
+   direction the first shape should be moved to separate them) and the
+   deepest points on surfaces of both shapes. If the shapes are just touching
+   or their overlap is flat, returns zero and the normal is zero. */
+Float epa(const ShapeSupport& supportA, const ShapeSupport& supportB, const Simplex& simplex, Vector3& normal, Vector3& pointA, Vector3& pointB);
+
+/* Precision of the time of impact relative to sum of the margins and the
+   motion length, the result is always before the actual contact */
+constexpr Float ToiTolerance = 1.0e-3f;
+constexpr UnsignedInt ToiMaxIterations = 32;
+
+/* Time of impact of a line segment with a margin, whose endpoints move
+   linearly from a0, b0 to a1, b1, with static shape. Returns value in range
+   [0, 1] or infinity if there is no impact during the motion. */
+Float conservativeAdvancement(const Vector3& a0, const Vector3& b0, const Vector3& a1, const Vector3& b1, Float margin, const ShapeSupport& other);
+
+}}}
+
+#endif
@@ -26,6 +26,7 @@
 #include "Shape.h"
 
 #include "Magnum/Shapes/Composition.h"
+#include "Magnum/Shapes/ConvexHull.h"
 
 namespace Magnum { namespace Shapes { namespace Implementation {
 
@@ -46,4 +47,17 @@ template<UnsignedInt dimensions> void ShapeHelper<Composition<dimensions>>::tran
 template struct MAGNUM_SHAPES_EXPORT ShapeHelper<Composition<2>>;
 template struct MAGNUM_SHAPES_EXPORT ShapeHelper<Composition<3>>;
 
+void ShapeHelper<ConvexHull>::set(Shapes::Shape<ConvexHull>& shape, const ConvexHull& hull) {
+    shape._transformedShape.shape = shape._shape.shape = hull;
+}
+
+void ShapeHelper<ConvexHull>::set(Shapes::Shape<ConvexHull>& shape, ConvexHull&& hull) {
+    shape._transformedShape.shape = shape._shape.shape = std::move(hull);
+}
+
+/* The data are the same, only the transformation needs to be updated */
+void ShapeHelper<ConvexHull>::transform(Shapes::Shape<ConvexHull>& shape, const Matrix4& absoluteTransformationMatrix) {
+    shape._transformedShape.shape.setTransformation(absoluteTransformationMatrix*shape._shape.shape.transformation());
+}
+
 }}}
@@ -111,6 +111,10 @@ template<class T> class Shape: public AbstractShape<T::Dimensions> {
         void clean(const MatrixTypeFor<T::Dimensions, Float>& absoluteTransformationMatrix) override;
 
     private:
+        const Implementation::AbstractShape<T::Dimensions>& abstractShape() const override {
+            return _shape;
+        }
+
         const Implementation::AbstractShape<T::Dimensions>& abstractTransformedShape() const override {
             return _transformedShape;
         }
@@ -120,6 +124,7 @@ template<class T> class Shape: public AbstractShape<T::Dimensions> {
 
 template<class T> inline Shape<T>& Shape<T>::setShape(const T& shape) {
     Implementation::ShapeHelper<T>::set(*this, shape);
+    this->markShapeDirty();
     this->object().setDirty();
     return *this;
 }
@@ -150,6 +155,13 @@ namespace Implementation {
 
         static void transform(Shapes::Shape<Composition<dimensions>>& shape, const MatrixTypeFor<dimensions, Float>& absoluteTransformationMatrix);
     };
+
+    template<> struct MAGNUM_SHAPES_EXPORT ShapeHelper<ConvexHull> {
+        static void set(Shapes::Shape<ConvexHull>& shape, const ConvexHull& hull);
+        static void set(Shapes::Shape<ConvexHull>& shape, ConvexHull&& hull);
+
+        static void transform(Shapes::Shape<ConvexHull>& shape, const Matrix4& absoluteTransformationMatrix);
+    };
 }
 
 }}
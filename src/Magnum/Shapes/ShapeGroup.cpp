@@ -25,19 +25,53 @@
 
 #include "ShapeGroup.h"
 
+#include <algorithm>
+
 #include "Magnum/Shapes/AbstractShape.h"
+#include "Magnum/Shapes/Implementation/CollisionDispatch.h"
 
 namespace Magnum { namespace Shapes {
 
+/* Bounds feature remembering the shape it was created for */
+template<UnsignedInt dimensions> class ShapeGroup<dimensions>::ShapeBounds: public SceneGraph::Bounds<dimensions, Float> {
+    public:
+        explicit ShapeBounds(AbstractShape<dimensions>& shape, const RangeTypeFor<dimensions, Float>& bounds, SceneGraph::SpatialIndex<dimensions, Float>& index): SceneGraph::Bounds<dimensions, Float>{shape.object(), bounds, &index}, shape(shape) {}
+
+        AbstractShape<dimensions>& shape;
+};
+
+namespace {
+
+template<UnsignedInt dimensions> bool isBounded(const RangeTypeFor<dimensions, Float>& bounds) {
+    return (bounds.min() > VectorTypeFor<dimensions, Float>{-Constants::inf()}).all() &&
+           (bounds.max() < VectorTypeFor<dimensions, Float>{Constants::inf()}).all();
+}
+
+}
+
+template<UnsignedInt dimensions> ShapeGroup<dimensions>::~ShapeGroup() {
+    /* Deleting the bounds while the index still exists, the shapes are then
+       removed from the group without calling featureRemoved() */
+    for(std::size_t i = 0; i != this->size(); ++i) {
+        AbstractShape<dimensions>& shape = (*this)[i];
+        delete shape._bounds;
+        shape._bounds = nullptr;
+        shape._dirtyListed = false;
+    }
+}
+
 template<UnsignedInt dimensions> void ShapeGroup<dimensions>::setClean() {
-    /* Clean all objects */
-    if(!this->isEmpty()) {
-        std::vector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>> objects;
-        objects.reserve(this->size());
-        for(std::size_t i = 0; i != this->size(); ++i)
-            objects.push_back((*this)[i].object());
-
-        SceneGraph::AbstractObject<dimensions, Float>::setClean(objects);
+    /* Clean each scene containing some of the objects just once, objects
+       which are not part of any scene are cleaned one by one */
+    std::vector<SceneGraph::AbstractObject<dimensions, Float>*> scenes;
+    for(std::size_t i = 0; i != this->size(); ++i) {
+        SceneGraph::AbstractObject<dimensions, Float>& object = (*this)[i].object();
+        SceneGraph::AbstractObject<dimensions, Float>* const scene = object.scene();
+        if(scene && std::find(scenes.begin(), scenes.end(), scene) != scenes.end())
+            continue;
+
+        if(scene) scenes.push_back(scene);
+        object.cleanDirtyScene();
     }
 
     dirty = false;
@@ -52,6 +86,87 @@ template<UnsignedInt dimensions> AbstractShape<dimensions>* ShapeGroup<dimension
     return nullptr;
 }
 
+template<UnsignedInt dimensions> std::pair<AbstractShape<dimensions>*, Float> ShapeGroup<dimensions>::firstImpact(const AbstractShape<dimensions>& shape, const MatrixTypeFor<dimensions, Float>& previousTransformation) {
+    setClean();
+    updateBounds();
+
+    /* Compute time of impact only for shapes near the motion, unbounded
+       shapes are not in the index so they are tested always */
+    const Implementation::Sweep<dimensions> sweep = Implementation::sweep(shape.abstractShape(), previousTransformation, shape.abstractTransformedShape());
+    std::vector<AbstractShape<dimensions>*> candidates{unboundedShapes};
+    for(SceneGraph::Bounds<dimensions, Float>* bounds: index.range(Implementation::bounds(sweep)))
+        candidates.push_back(&static_cast<ShapeBounds*>(bounds)->shape);
+
+    std::pair<AbstractShape<dimensions>*, Float> out{nullptr, Constants::inf()};
+    for(AbstractShape<dimensions>* other: candidates) {
+        if(other == &shape) continue;
+
+        const Float time = Implementation::timeOfImpact(sweep, other->abstractTransformedShape());
+        if(time < out.second) out = {other, time};
+    }
+
+    return out;
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::featureAdded(AbstractShape<dimensions>& shape) {
+    /* The shape is not fully constructed yet, so only scheduling the bounds
+       computation for later */
+    addToDirtyList(shape);
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::featureRemoved(AbstractShape<dimensions>& shape) {
+    if(shape._dirtyListed) {
+        dirtyShapes[shape._dirtyIndex] = nullptr;
+        shape._dirtyListed = false;
+    }
+
+    /* The bounds are created after the shape, so when the object is
+       destroyed, they are still alive at this point */
+    delete shape._bounds;
+    shape._bounds = nullptr;
+
+    const auto found = std::find(unboundedShapes.begin(), unboundedShapes.end(), &shape);
+    if(found != unboundedShapes.end()) unboundedShapes.erase(found);
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::addToDirtyList(AbstractShape<dimensions>& shape) {
+    if(shape._dirtyListed) return;
+
+    shape._dirtyIndex = dirtyShapes.size();
+    shape._dirtyListed = true;
+    dirtyShapes.push_back(&shape);
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::updateBounds() {
+    /* Only shapes which were added or changed are listed, bounds of the
+       moved ones are updated by the index */
+    for(AbstractShape<dimensions>* shape: dirtyShapes) {
+        /* Shape removed from the group in the meantime */
+        if(!shape) continue;
+        shape->_dirtyListed = false;
+
+        const RangeTypeFor<dimensions, Float> bounds = Implementation::bounds(shape->abstractShape());
+        const auto unbounded = std::find(unboundedShapes.begin(), unboundedShapes.end(), shape);
+
+        /* Unbounded shapes can't be in the index */
+        if(!isBounded<dimensions>(bounds)) {
+            delete shape->_bounds;
+            shape->_bounds = nullptr;
+            if(unbounded == unboundedShapes.end()) unboundedShapes.push_back(shape);
+            continue;
+        }
+
+        if(unbounded != unboundedShapes.end()) unboundedShapes.erase(unbounded);
+
+        if(!shape->_bounds)
+            shape->_bounds = new ShapeBounds{*shape, bounds, index};
+        else if(shape->_bounds->bounds() != bounds)
+            shape->_bounds->setBounds(bounds);
+    }
+
+    dirtyShapes.clear();
+}
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template class MAGNUM_SHAPES_EXPORT ShapeGroup<2>;
 template class MAGNUM_SHAPES_EXPORT ShapeGroup<3>;
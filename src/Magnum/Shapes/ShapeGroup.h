@@ -29,9 +29,11 @@
  * @brief Class @ref Magnum::Shapes::ShapeGroup, typedef @ref Magnum::Shapes::ShapeGroup2D, @ref Magnum::Shapes::ShapeGroup3D
  */
 
+#include <utility>
 #include <vector>
 
 #include "Magnum/SceneGraph/FeatureGroup.h"
+#include "Magnum/SceneGraph/SpatialIndex.h"
 #include "Magnum/Shapes/AbstractShape.h"
 #include "Magnum/Shapes/visibility.h"
 
@@ -54,6 +56,14 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT ShapeGroup: public S
          */
         explicit ShapeGroup(): dirty(true) {}
 
+        /**
+         * @brief Destructor
+         *
+         * Deletes bounds attached to objects of the shapes, see
+         * @ref firstImpact().
+         */
+        ~ShapeGroup();
+
         /**
          * @brief Whether the group is dirty
          * @return True if any object in the group is dirty, false otherwise.
@@ -74,7 +84,10 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT ShapeGroup: public S
          * @brief Set the group and all bodies as clean
          *
          * This function is called before computing any collisions to ensure
-         * all objects are cleaned.
+         * all objects are cleaned. All dirty objects in every scene
+         * containing some of the shapes are cleaned at once using
+         * @ref SceneGraph::Scene::cleanDirty(), objects which are not part
+         * of any scene are cleaned individually.
          */
         void setClean();
 
@@ -87,8 +100,45 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT ShapeGroup: public S
          */
         AbstractShape<dimensions>* firstCollision(const AbstractShape<dimensions>& shape);
 
+        /**
+         * @brief First impact of given moving shape with other shapes in the group
+         * @param shape                     Moving sphere or capsule
+         * @param previousTransformation    Absolute transformation of the
+         *      object at the beginning of the motion
+         *
+         * Returns shape which is first touched by given one when moving from
+         * @p previousTransformation to its current absolute transformation
+         * together with the time of impact, see
+         * @ref AbstractShape::timeOfImpact() for details. If there isn't
+         * any impact, returns `nullptr` and infinity. Other shapes in the
+         * group are considered static. Calls @ref setClean() before the
+         * operation.
+         *
+         * The group keeps bounding boxes of the shapes in a
+         * @ref SceneGraph::SpatialIndex, so the time of impact is computed
+         * only for shapes with bounds intersecting bounds of the whole
+         * motion and finding them takes logarithmic time. For that the group
+         * attaches a @ref SceneGraph::Bounds feature to object of each
+         * bounded shape. The bounds are recomputed only for shapes which
+         * changed since the last call, moved ones are just updated in the
+         * index. Unbounded shapes, such as planes, are tested always. One
+         * sweep per frame thus can replace repeated @ref firstCollision()
+         * calls for intermediate positions of fast moving objects.
+         */
+        std::pair<AbstractShape<dimensions>*, Float> firstImpact(const AbstractShape<dimensions>& shape, const MatrixTypeFor<dimensions, Float>& previousTransformation);
+
     private:
+        class ShapeBounds;
+
+        void featureAdded(AbstractShape<dimensions>& shape) override;
+        void featureRemoved(AbstractShape<dimensions>& shape) override;
+
+        void MAGNUM_SHAPES_LOCAL addToDirtyList(AbstractShape<dimensions>& shape);
+        void MAGNUM_SHAPES_LOCAL updateBounds();
+
         bool dirty;
+        std::vector<AbstractShape<dimensions>*> dirtyShapes, unboundedShapes;
+        SceneGraph::SpatialIndex<dimensions, Float> index;
 };
 
 /**
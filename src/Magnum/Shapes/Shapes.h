@@ -86,6 +86,8 @@ typedef InvertedSphere<3> InvertedSphere3D;
 
 class Plane;
 
+class ConvexHull;
+
 template<UnsignedInt> class Point;
 typedef Point<2> Point2D;
 typedef Point<3> Point3D;
@@ -0,0 +1,156 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <random>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shapes/BoundingVolume.h"
+#include "Magnum/Test/BenchmarkTimer.h"
+
+namespace Magnum { namespace Shapes { namespace Test {
+
+struct BoundingVolumeBenchmark: TestSuite::Tester {
+    explicit BoundingVolumeBenchmark();
+
+    void axisAlignedBox();
+    void sphere();
+    void orientedBox();
+};
+
+namespace {
+
+constexpr std::size_t Count = 1 << 20;
+constexpr std::size_t Iterations = 5;
+
+/* Elongated box-shaped cloud, rotated and translated away from origin so
+   neither of the axis-aligned volumes fit it well */
+std::vector<Vector3> points() {
+    std::mt19937 generator;
+    std::uniform_real_distribution<Float> distribution{-1.0f, 1.0f};
+    const Matrix4 transformation =
+        Matrix4::translation({100.0f, -50.0f, 20.0f})*
+        Matrix4::rotation(Deg(35.0f), Vector3(1.0f, 1.0f, 0.0f).normalized());
+
+    std::vector<Vector3> out(Count);
+    for(Vector3& point: out)
+        point = transformation.transformPoint(Vector3{10.0f, 2.0f, 0.5f}*Vector3{distribution(generator), distribution(generator), distribution(generator)});
+    return out;
+}
+
+}
+
+BoundingVolumeBenchmark::BoundingVolumeBenchmark() {
+    addTests({&BoundingVolumeBenchmark::axisAlignedBox,
+              &BoundingVolumeBenchmark::sphere,
+              &BoundingVolumeBenchmark::orientedBox});
+}
+
+void BoundingVolumeBenchmark::axisAlignedBox() {
+    const std::vector<Vector3> data = points();
+
+    /* Plain loop as the baseline */
+    Vector3 min, max;
+    Magnum::Test::BenchmarkTimer loopTimer{Iterations};
+    loopTimer.start();
+    for(std::size_t i = 0; i != Iterations; ++i) {
+        min = max = data[0];
+        for(const Vector3& point: data) {
+            min = Math::min(min, point);
+            max = Math::max(max, point);
+        }
+    }
+    loopTimer.stop();
+    const Double loopTime = loopTimer.milliseconds();
+
+    AxisAlignedBox3D box;
+    Magnum::Test::BenchmarkTimer timer{Iterations};
+    timer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        box = boundingAxisAlignedBox({data.data(), data.size()});
+    timer.stop();
+    const Double time = timer.milliseconds();
+
+    CORRADE_COMPARE(box.min(), min);
+    CORRADE_COMPARE(box.max(), max);
+    Debug() << "   " << data.size() << "points, loop:" << loopTime << "ms, boundingAxisAlignedBox():" << time << "ms";
+}
+
+void BoundingVolumeBenchmark::sphere() {
+    const std::vector<Vector3> data = points();
+
+    /* Sphere around the axis-aligned box as the baseline */
+    const AxisAlignedBox3D box = boundingAxisAlignedBox({data.data(), data.size()});
+    const Float boxRadius = (box.max() - box.min()).length()*0.5f;
+
+    Sphere3D sphere;
+    Magnum::Test::BenchmarkTimer timer{Iterations};
+    timer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        sphere = boundingSphere({data.data(), data.size()});
+    timer.stop();
+    const Double time = timer.milliseconds();
+
+    Sphere3D minimalSphere;
+    Magnum::Test::BenchmarkTimer minimalTimer{Iterations};
+    minimalTimer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        minimalSphere = minimalBoundingSphere({data.data(), data.size()});
+    minimalTimer.stop();
+    const Double minimalTime = minimalTimer.milliseconds();
+
+    CORRADE_VERIFY(minimalSphere.radius() <= sphere.radius());
+    Debug() << "   " << data.size() << "points, box radius:" << boxRadius;
+    Debug() << "    boundingSphere():" << time << "ms, radius" << sphere.radius();
+    Debug() << "    minimalBoundingSphere():" << minimalTime << "ms, radius" << minimalSphere.radius();
+}
+
+void BoundingVolumeBenchmark::orientedBox() {
+    const std::vector<Vector3> data = points();
+
+    const AxisAlignedBox3D aabb = boundingAxisAlignedBox({data.data(), data.size()});
+    const Float aabbVolume = (aabb.max() - aabb.min()).product();
+
+    Box3D box;
+    Magnum::Test::BenchmarkTimer timer{Iterations};
+    timer.start();
+    for(std::size_t i = 0; i != Iterations; ++i)
+        box = orientedBoundingBox({data.data(), data.size()});
+    timer.stop();
+    const Double time = timer.milliseconds();
+
+    /* The box is unit-size, so the scaled axes are half extents */
+    const Matrix4 transformation = box.transformation();
+    const Float volume = 8.0f*transformation[0].xyz().length()*transformation[1].xyz().length()*transformation[2].xyz().length();
+    CORRADE_VERIFY(volume < aabbVolume);
+    Debug() << "   " << data.size() << "points, axis-aligned box volume:" << aabbVolume;
+    Debug() << "    orientedBoundingBox():" << time << "ms, volume" << volume;
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shapes::Test::BoundingVolumeBenchmark)
@@ -0,0 +1,210 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shapes/BoundingVolume.h"
+
+namespace Magnum { namespace Shapes { namespace Test {
+
+struct BoundingVolumeTest: TestSuite::Tester {
+    explicit BoundingVolumeTest();
+
+    void empty();
+    void axisAlignedBox();
+    void sphere();
+    void minimalSphere();
+    void minimalSphereDegenerate();
+    void orientedBox();
+    void orientedBoxAxisAligned();
+};
+
+BoundingVolumeTest::BoundingVolumeTest() {
+    addTests({&BoundingVolumeTest::empty,
+              &BoundingVolumeTest::axisAlignedBox,
+              &BoundingVolumeTest::sphere,
+              &BoundingVolumeTest::minimalSphere,
+              &BoundingVolumeTest::minimalSphereDegenerate,
+              &BoundingVolumeTest::orientedBox,
+              &BoundingVolumeTest::orientedBoxAxisAligned});
+}
+
+namespace {
+
+/* Corners of a box with half extents 10, 2 and 0.5 and some points inside,
+   rotated and translated */
+std::vector<Vector3> rotatedBoxPoints(const Matrix4& transformation) {
+    std::vector<Vector3> points;
+    for(UnsignedInt i = 0; i != 8; ++i)
+        points.push_back({i & 1 ? 10.0f : -10.0f, i & 2 ? 2.0f : -2.0f, i & 4 ? 0.5f : -0.5f});
+    for(Int i = -10; i <= 10; ++i)
+        points.push_back({i*0.9f, 0.0f, 0.0f});
+
+    for(Vector3& point: points) point = transformation.transformPoint(point);
+    return points;
+}
+
+}
+
+void BoundingVolumeTest::empty() {
+    CORRADE_COMPARE(boundingAxisAlignedBox(nullptr).min(), Vector3());
+    CORRADE_COMPARE(boundingAxisAlignedBox(nullptr).max(), Vector3());
+    CORRADE_COMPARE(boundingSphere(nullptr).radius(), 0.0f);
+    CORRADE_COMPARE(minimalBoundingSphere(nullptr).radius(), 0.0f);
+    CORRADE_COMPARE(orientedBoundingBox(nullptr).transformation(), Matrix4(Math::ZeroInit));
+}
+
+void BoundingVolumeTest::axisAlignedBox() {
+    /* Seven points to test both the vectorized and the remaining part */
+    const Vector3 points[]{
+        { 1.0f,  2.0f,  3.0f},
+        {-1.0f,  5.0f,  0.0f},
+        { 0.5f, -3.0f,  2.0f},
+        { 7.0f,  1.0f, -4.0f},
+        { 2.0f,  0.0f,  9.0f},
+        {-6.0f,  1.0f,  1.0f},
+        { 0.0f,  8.0f, -1.0f}};
+
+    const AxisAlignedBox3D box = boundingAxisAlignedBox(points);
+    CORRADE_COMPARE(box.min(), Vector3(-6.0f, -3.0f, -4.0f));
+    CORRADE_COMPARE(box.max(), Vector3(7.0f, 8.0f, 9.0f));
+
+    /* Less than four points */
+    const AxisAlignedBox3D box2 = boundingAxisAlignedBox({points, 2});
+    CORRADE_COMPARE(box2.min(), Vector3(-1.0f, 2.0f, 0.0f));
+    CORRADE_COMPARE(box2.max(), Vector3(1.0f, 5.0f, 3.0f));
+}
+
+void BoundingVolumeTest::sphere() {
+    const std::vector<Vector3> points = rotatedBoxPoints(
+        Matrix4::translation({3.0f, -1.0f, 7.0f})*
+        Matrix4::rotation(Deg(35.0f), Vector3(1.0f, 1.0f, 0.0f).normalized()));
+
+    const Sphere3D sphere = boundingSphere({points.data(), points.size()});
+    for(const Vector3& point: points)
+        CORRADE_VERIFY((point - sphere.position()).length() <= sphere.radius());
+
+    /* Not minimal, but not much bigger */
+    const Float minimal = minimalBoundingSphere({points.data(), points.size()}).radius();
+    CORRADE_VERIFY(sphere.radius() >= minimal);
+    CORRADE_VERIFY(sphere.radius() < minimal*1.1f);
+}
+
+void BoundingVolumeTest::minimalSphere() {
+    /* Cube corners and some points inside */
+    std::vector<Vector3> points;
+    for(Int i = -4; i <= 4; ++i)
+        points.push_back(Vector3{2.0f, -1.0f, 4.0f} + Vector3(i*0.2f));
+    for(UnsignedInt i = 0; i != 8; ++i)
+        points.push_back(Vector3{i & 1 ? 3.0f : 1.0f, i & 2 ? 0.0f : -2.0f, i & 4 ? 5.0f : 3.0f});
+
+    const Sphere3D sphere = minimalBoundingSphere({points.data(), points.size()});
+    CORRADE_COMPARE(sphere.position(), Vector3(2.0f, -1.0f, 4.0f));
+    CORRADE_COMPARE(sphere.radius(), Constants::sqrt3());
+
+    /* Regular tetrahedron, the sphere touches all four vertices */
+    const Vector3 tetrahedron[]{
+        { 1.0f,  1.0f,  1.0f},
+        { 1.0f, -1.0f, -1.0f},
+        {-1.0f,  1.0f, -1.0f},
+        {-1.0f, -1.0f,  1.0f}};
+    const Sphere3D tetrahedronSphere = minimalBoundingSphere(tetrahedron);
+    CORRADE_COMPARE(tetrahedronSphere.position(), Vector3());
+    CORRADE_COMPARE(tetrahedronSphere.radius(), Constants::sqrt3());
+
+    /* Obtuse triangle, the sphere is spanned by the longest edge */
+    const Vector3 triangle[]{
+        {-2.0f, 0.0f, 0.0f},
+        { 2.0f, 0.0f, 0.0f},
+        { 0.0f, 0.5f, 0.0f}};
+    const Sphere3D triangleSphere = minimalBoundingSphere(triangle);
+    CORRADE_COMPARE(triangleSphere.position(), Vector3());
+    CORRADE_COMPARE(triangleSphere.radius(), 2.0f);
+}
+
+void BoundingVolumeTest::minimalSphereDegenerate() {
+    /* Single point repeated */
+    const Vector3 point[]{Vector3(1.5f), Vector3(1.5f), Vector3(1.5f)};
+    const Sphere3D pointSphere = minimalBoundingSphere(point);
+    CORRADE_COMPARE(pointSphere.position(), Vector3(1.5f));
+    CORRADE_COMPARE(pointSphere.radius(), 0.0f);
+
+    /* Collinear points */
+    std::vector<Vector3> line;
+    for(Int i = 0; i <= 10; ++i)
+        line.push_back(Vector3{1.0f, 2.0f, 2.0f}*Float(i));
+    const Sphere3D lineSphere = minimalBoundingSphere({line.data(), line.size()});
+    CORRADE_COMPARE(lineSphere.position(), (Vector3{5.0f, 10.0f, 10.0f}));
+    CORRADE_COMPARE(lineSphere.radius(), 15.0f);
+
+    /* Coplanar grid, all corners on the boundary */
+    std::vector<Vector3> grid;
+    for(Int i = -3; i <= 3; ++i)
+        for(Int j = -3; j <= 3; ++j)
+            grid.push_back({Float(i), 1.0f, Float(j)});
+    const Sphere3D gridSphere = minimalBoundingSphere({grid.data(), grid.size()});
+    CORRADE_COMPARE(gridSphere.position(), Vector3::yAxis());
+    CORRADE_COMPARE(gridSphere.radius(), 3.0f*Constants::sqrt2());
+}
+
+void BoundingVolumeTest::orientedBox() {
+    const Matrix4 transformation =
+        Matrix4::translation({3.0f, -1.0f, 7.0f})*
+        Matrix4::rotation(Deg(35.0f), Vector3(1.0f, 1.0f, 0.0f).normalized());
+    const std::vector<Vector3> points = rotatedBoxPoints(transformation);
+
+    /* Axes are sorted by extent, sign of each may differ */
+    const Matrix4 box = orientedBoundingBox({points.data(), points.size()}).transformation();
+    CORRADE_COMPARE(box.translation(), transformation.translation());
+    CORRADE_COMPARE(box[0].xyz().length(), 10.0f);
+    CORRADE_COMPARE(box[1].xyz().length(), 2.0f);
+    CORRADE_COMPARE(box[2].xyz().length(), 0.5f);
+    CORRADE_COMPARE(Math::abs(Math::dot(box[0].xyz().normalized(), transformation[0].xyz())), 1.0f);
+    CORRADE_COMPARE(Math::abs(Math::dot(box[1].xyz().normalized(), transformation[1].xyz())), 1.0f);
+
+    /* Much tighter than the axis-aligned one */
+    const AxisAlignedBox3D aabb = boundingAxisAlignedBox({points.data(), points.size()});
+    CORRADE_VERIFY((aabb.max() - aabb.min()).product() > 5.0f*80.0f);
+}
+
+void BoundingVolumeTest::orientedBoxAxisAligned() {
+    /* Points along the diagonal make the principal axes diagonal as well,
+       but the axis-aligned box is smaller */
+    std::vector<Vector3> points;
+    for(UnsignedInt i = 0; i != 8; ++i)
+        points.push_back({i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f});
+    for(Int i = -10; i <= 10; ++i)
+        points.push_back({i*0.1f, i*0.1f, 0.0f});
+
+    const Box3D box = orientedBoundingBox({points.data(), points.size()});
+    CORRADE_COMPARE(box.transformation(), Matrix4::scaling(Vector3(1.0f)));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shapes::Test::BoundingVolumeTest)
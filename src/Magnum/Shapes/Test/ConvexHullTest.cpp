@@ -0,0 +1,286 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Box.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/ConvexHull.h"
+#include "Magnum/Shapes/LineSegment.h"
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/Sphere.h"
+
+#include "ShapeTestBase.h"
+
+namespace Magnum { namespace Shapes { namespace Test {
+
+struct ConvexHullTest: TestSuite::Tester {
+    explicit ConvexHullTest();
+
+    void construct();
+    void constructDegenerate();
+    void constructSimplified();
+    void transformed();
+
+    void collisionPoint();
+    void collisionPointFlat();
+    void collisionLineSegment();
+    void collisionSphere();
+    void collisionCapsule();
+    void collisionAxisAlignedBox();
+    void collisionBox();
+    void collisionConvexHull();
+};
+
+ConvexHullTest::ConvexHullTest() {
+    addTests({&ConvexHullTest::construct,
+              &ConvexHullTest::constructDegenerate,
+              &ConvexHullTest::constructSimplified,
+              &ConvexHullTest::transformed,
+
+              &ConvexHullTest::collisionPoint,
+              &ConvexHullTest::collisionPointFlat,
+              &ConvexHullTest::collisionLineSegment,
+              &ConvexHullTest::collisionSphere,
+              &ConvexHullTest::collisionCapsule,
+              &ConvexHullTest::collisionAxisAlignedBox,
+              &ConvexHullTest::collisionBox,
+              &ConvexHullTest::collisionConvexHull});
+}
+
+namespace {
+
+/* Cube with half extents 1, points on its faces and inside */
+std::vector<Vector3> cubePoints() {
+    std::vector<Vector3> points;
+    for(Int x = -2; x <= 2; ++x)
+        for(Int y = -2; y <= 2; ++y)
+            for(Int z = -2; z <= 2; ++z)
+                points.push_back(Vector3(x, y, z)*0.5f);
+    return points;
+}
+
+/* Octahedron with vertices at distance 1 from origin */
+ConvexHull octahedron() {
+    const Vector3 points[]{
+        Vector3::xAxis(), -Vector3::xAxis(),
+        Vector3::yAxis(), -Vector3::yAxis(),
+        Vector3::zAxis(), -Vector3::zAxis()};
+    return convexHull(points);
+}
+
+}
+
+void ConvexHullTest::construct() {
+    const std::vector<Vector3> points = cubePoints();
+    const ConvexHull hull = convexHull({points.data(), points.size()});
+
+    /* Coplanar and interior points are not part of the hull */
+    CORRADE_COMPARE(hull.vertices().size(), 8);
+    CORRADE_COMPARE(hull.indices().size(), 12*3);
+    CORRADE_COMPARE(hull.planes().size(), 12);
+    for(const Vector3& vertex: hull.vertices())
+        CORRADE_COMPARE(Math::abs(vertex), Vector3(1.0f));
+
+    /* All planes point outside and all points are inside or on the boundary */
+    for(const Vector4& plane: hull.planes()) {
+        CORRADE_COMPARE(plane.xyz().length(), 1.0f);
+        CORRADE_COMPARE(plane.w(), -1.0f);
+        for(const Vector3& point: points)
+            CORRADE_VERIFY(Math::dot(plane, Vector4(point, 1.0f)) < 1.0e-6f);
+    }
+}
+
+void ConvexHullTest::constructDegenerate() {
+    const ConvexHull empty = convexHull(nullptr);
+    CORRADE_VERIFY(empty.vertices().empty());
+    CORRADE_VERIFY(empty.indices().empty());
+
+    const Vector3 same[]{{1.0f, 2.0f, 3.0f}, {1.0f, 2.0f, 3.0f}};
+    const ConvexHull point = convexHull(same);
+    CORRADE_COMPARE(point.vertices().size(), 1);
+    CORRADE_VERIFY(point.indices().empty());
+
+    const Vector3 collinear[]{{1.0f, 1.0f, 1.0f}, {-2.0f, -2.0f, -2.0f}, {0.0f, 0.0f, 0.0f}, {3.0f, 3.0f, 3.0f}};
+    const ConvexHull line = convexHull(collinear);
+    CORRADE_COMPARE(line.vertices().size(), 2);
+    CORRADE_VERIFY(line.indices().empty());
+    CORRADE_COMPARE(line.vertices()[0] + line.vertices()[1], Vector3(1.0f));
+
+    /* Square with points on the edges and inside, faces in both directions */
+    const Vector3 flat[]{{0.0f, 0.0f, 1.0f}, {1.0f, 1.0f, 1.0f}, {-1.0f, 1.0f, 1.0f},
+                         {0.0f, 1.0f, 1.0f}, {1.0f, -1.0f, 1.0f}, {-1.0f, -1.0f, 1.0f},
+                         {0.5f, 0.2f, 1.0f}};
+    const ConvexHull polygon = convexHull(flat);
+    CORRADE_COMPARE(polygon.vertices().size(), 4);
+    CORRADE_COMPARE(polygon.indices().size(), 4*3);
+    CORRADE_COMPARE(polygon.planes()[0].xyz(), -polygon.planes()[1].xyz());
+    CORRADE_COMPARE(Math::abs(polygon.planes()[0].z()), 1.0f);
+}
+
+void ConvexHullTest::constructSimplified() {
+    /* Points on a sphere */
+    std::vector<Vector3> points;
+    for(Int i = 0; i != 32; ++i)
+        for(Int j = 1; j != 16; ++j)
+            points.push_back({Math::sin(Deg(j*11.25f))*Math::cos(Deg(i*11.25f)),
+                              Math::sin(Deg(j*11.25f))*Math::sin(Deg(i*11.25f)),
+                              Math::cos(Deg(j*11.25f))});
+    points.push_back(Vector3::zAxis());
+    points.push_back(-Vector3::zAxis());
+
+    const ConvexHull full = convexHull({points.data(), points.size()});
+    CORRADE_COMPARE(full.vertices().size(), points.size());
+
+    const ConvexHull simplified = convexHull({points.data(), points.size()}, 12);
+    CORRADE_COMPARE(simplified.vertices().size(), 12);
+    /* Closed triangle mesh with V - E + F = 2 */
+    CORRADE_COMPARE(simplified.indices().size(), (2*12 - 4)*3);
+
+    /* The simplified hull is inside the full one and its vertices are
+       subset of the input */
+    for(const Vector3& vertex: simplified.vertices()) {
+        CORRADE_COMPARE(vertex.length(), 1.0f);
+        CORRADE_VERIFY(full % Point3D(vertex*0.999f));
+    }
+
+    /* The limit is at least a tetrahedron */
+    CORRADE_COMPARE(convexHull({points.data(), points.size()}, 2).vertices().size(), 4);
+}
+
+void ConvexHullTest::transformed() {
+    const ConvexHull hull = octahedron();
+    const ConvexHull transformed = ConvexHull(hull.vertices(), hull.indices(), Matrix4::translation({1.0f, 2.0f, -3.0f}))
+        .transformed(Matrix4::scaling({2.0f, -1.0f, 1.5f}));
+
+    /* The data are untouched */
+    CORRADE_COMPARE(transformed.transformation(), Matrix4::scaling({2.0f, -1.0f, 1.5f})*Matrix4::translation({1.0f, 2.0f, -3.0f}));
+    CORRADE_COMPARE(transformed.vertices().size(), hull.vertices().size());
+    CORRADE_COMPARE(transformed.vertices()[0], hull.vertices()[0]);
+
+    CORRADE_COMPARE(transformed.support(Vector3::xAxis()), Vector3(4.0f, -2.0f, -4.5f));
+    CORRADE_COMPARE(transformed.support(Vector3::yAxis()), Vector3(2.0f, -1.0f, -4.5f));
+}
+
+void ConvexHullTest::collisionPoint() {
+    const ConvexHull hull = octahedron().transformed(Matrix4::translation({1.0f, 2.0f, 3.0f})*Matrix4::scaling(Vector3(2.0f)));
+    const Shapes::Point3D point({1.5f, 2.5f, 3.5f});
+    const Shapes::Point3D point1({2.0f, 2.9f, 3.0f});
+    const Shapes::Point3D point2({2.0f, 3.1f, 3.0f});
+
+    VERIFY_COLLIDES(hull, point);
+    VERIFY_COLLIDES(hull, point1);
+    VERIFY_NOT_COLLIDES(hull, point2);
+    VERIFY_NOT_COLLIDES(ConvexHull{}, point);
+}
+
+void ConvexHullTest::collisionPointFlat() {
+    /* Unit square, two-sided */
+    const Vector3 square[]{{-1.0f, -1.0f, 0.0f}, {1.0f, -1.0f, 0.0f},
+                           {1.0f, 1.0f, 0.0f}, {-1.0f, 1.0f, 0.0f}};
+    const ConvexHull hull = convexHull(square);
+    CORRADE_COMPARE(hull.planes().size(), 4 + 4);
+
+    const Shapes::Point3D inside({0.5f, -0.25f, 0.0f});
+    const Shapes::Point3D above({0.5f, -0.25f, 0.1f});
+    VERIFY_COLLIDES(hull, inside);
+    VERIFY_NOT_COLLIDES(hull, above);
+
+    /* Coplanar points outside of the polygon */
+    const Shapes::Point3D far({100.0f, 0.0f, 0.0f});
+    const Shapes::Point3D corner({-1.5f, 1.5f, 0.0f});
+    VERIFY_NOT_COLLIDES(hull, far);
+    VERIFY_NOT_COLLIDES(hull, corner);
+}
+
+void ConvexHullTest::collisionLineSegment() {
+    const ConvexHull hull = octahedron();
+    const Shapes::LineSegment3D segment({-2.0f, 0.1f, 0.1f}, {2.0f, 0.1f, 0.1f});
+    const Shapes::LineSegment3D segment1({0.4f, 0.4f, -2.0f}, {0.4f, 0.4f, 2.0f});
+    const Shapes::LineSegment3D segment2({0.6f, 0.6f, -2.0f}, {0.6f, 0.6f, 2.0f});
+
+    VERIFY_COLLIDES(hull, segment);
+    VERIFY_COLLIDES(hull, segment1);
+    VERIFY_NOT_COLLIDES(hull, segment2);
+}
+
+void ConvexHullTest::collisionSphere() {
+    const ConvexHull hull = octahedron();
+    /* Distance of the face from origin is 1/sqrt(3) */
+    const Shapes::Sphere3D sphere({0.0f, 0.0f, 0.0f}, 0.1f);
+    const Shapes::Sphere3D sphere1(Vector3(1.0f), Constants::sqrt3() - 0.5f);
+    const Shapes::Sphere3D sphere2(Vector3(1.0f), Constants::sqrt3()*2.0f/3.0f - 0.01f);
+
+    VERIFY_COLLIDES(hull, sphere);
+    VERIFY_COLLIDES(hull, sphere1);
+    VERIFY_NOT_COLLIDES(hull, sphere2);
+}
+
+void ConvexHullTest::collisionCapsule() {
+    const ConvexHull hull = octahedron();
+    const Shapes::Capsule3D capsule({2.0f, -1.0f, 0.0f}, {2.0f, 1.0f, 0.0f}, 1.1f);
+    const Shapes::Capsule3D capsule1({2.0f, -1.0f, 0.0f}, {2.0f, 1.0f, 0.0f}, 0.9f);
+
+    VERIFY_COLLIDES(hull, capsule);
+    VERIFY_NOT_COLLIDES(hull, capsule1);
+}
+
+void ConvexHullTest::collisionAxisAlignedBox() {
+    const ConvexHull hull = octahedron();
+    const Shapes::AxisAlignedBox3D box({0.9f, -0.1f, -0.1f}, {2.0f, 0.1f, 0.1f});
+    const Shapes::AxisAlignedBox3D box1({0.4f, 0.4f, 0.4f}, {2.0f, 2.0f, 2.0f});
+
+    VERIFY_COLLIDES(hull, box);
+    VERIFY_NOT_COLLIDES(hull, box1);
+}
+
+void ConvexHullTest::collisionBox() {
+    const ConvexHull hull = octahedron();
+    const Shapes::Box3D box(Matrix4::translation(Vector3(0.5f))*Matrix4::rotation(Deg(45.0f), Vector3::zAxis())*Matrix4::scaling(Vector3(0.5f)));
+    const Shapes::Box3D box1(Matrix4::translation(Vector3(1.5f))*Matrix4::rotation(Deg(45.0f), Vector3::zAxis())*Matrix4::scaling(Vector3(0.5f)));
+
+    VERIFY_COLLIDES(hull, box);
+    VERIFY_NOT_COLLIDES(hull, box1);
+}
+
+void ConvexHullTest::collisionConvexHull() {
+    const std::vector<Vector3> points = cubePoints();
+    const ConvexHull hull = convexHull({points.data(), points.size()});
+    const ConvexHull hull1 = octahedron().transformed(Matrix4::translation({1.9f, 0.5f, 0.0f}));
+    const ConvexHull hull2 = octahedron().transformed(Matrix4::translation({2.1f, 0.0f, 0.0f}));
+    const ConvexHull hull3 = octahedron().transformed(Matrix4::translation({2.0f, 2.0f, 0.0f}));
+
+    VERIFY_COLLIDES(hull, hull1);
+    VERIFY_NOT_COLLIDES(hull, hull2);
+    VERIFY_NOT_COLLIDES(hull, hull3);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shapes::Test::ConvexHullTest)
@@ -0,0 +1,286 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Box.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/Collision.h"
+#include "Magnum/Shapes/Cylinder.h"
+#include "Magnum/Shapes/LineSegment.h"
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/Shape.h"
+#include "Magnum/Shapes/Sphere.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace Shapes { namespace Test {
+
+/* Pairs without specialized implementation, going through the generic GJK
+   and EPA path in collision dispatch */
+struct GjkTest: TestSuite::Tester {
+    explicit GjkTest();
+
+    void collidesBox();
+    void collidesCapsule();
+    void collidesCylinder();
+    void collidesUnsupported();
+
+    void collisionBox();
+    void collisionSphereInsideBox();
+    void collisionCapsule();
+    void collisionCapsuleCrossing();
+    void collisionCylinder();
+
+    void timeOfImpactBox();
+    void timeOfImpactCapsule();
+    void timeOfImpactCylinder();
+};
+
+GjkTest::GjkTest() {
+    addTests({&GjkTest::collidesBox,
+              &GjkTest::collidesCapsule,
+              &GjkTest::collidesCylinder,
+              &GjkTest::collidesUnsupported,
+
+              &GjkTest::collisionBox,
+              &GjkTest::collisionSphereInsideBox,
+              &GjkTest::collisionCapsule,
+              &GjkTest::collisionCapsuleCrossing,
+              &GjkTest::collisionCylinder,
+
+              &GjkTest::timeOfImpactBox,
+              &GjkTest::timeOfImpactCapsule,
+              &GjkTest::timeOfImpactCylinder});
+}
+
+namespace {
+
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+
+/* The pairs are tested through the public shape API, with the first shape
+   attached to object with given transformation and the second one to object
+   with identity transformation */
+template<class A, class B> bool collides(const A& a, const B& b) {
+    Scene3D scene;
+    Object3D objectA(&scene), objectB(&scene);
+    Shape<A> shapeA(objectA, a);
+    Shape<B> shapeB(objectB, b);
+    objectA.setClean();
+    objectB.setClean();
+
+    const bool out = shapeA.collides(shapeB);
+    CORRADE_INTERNAL_ASSERT(out == shapeB.collides(shapeA));
+    return out;
+}
+
+template<class A, class B> Collision3D collision(const A& a, const B& b) {
+    Scene3D scene;
+    Object3D objectA(&scene), objectB(&scene);
+    Shape<A> shapeA(objectA, a);
+    Shape<B> shapeB(objectB, b);
+    objectA.setClean();
+    objectB.setClean();
+
+    return shapeA.collision(shapeB);
+}
+
+template<class A, class B> Float timeOfImpact(const A& a, const Matrix4& previousTransformation, const Matrix4& transformation, const B& b) {
+    Scene3D scene;
+    Object3D objectA(&scene), objectB(&scene);
+    objectA.setTransformation(transformation);
+    Shape<A> shapeA(objectA, a);
+    Shape<B> shapeB(objectB, b);
+    objectA.setClean();
+    objectB.setClean();
+
+    return shapeA.timeOfImpact(shapeB, previousTransformation);
+}
+
+}
+
+void GjkTest::collidesBox() {
+    const Box3D box(Matrix4::rotation(Deg(45.0f), Vector3::zAxis()));
+    const Box3D box1(Matrix4::translation({2.3f, 0.0f, 0.0f}));
+    const Box3D box2(Matrix4::translation({2.5f, 0.0f, 0.0f}));
+    const AxisAlignedBox3D box3({1.3f, -0.1f, -0.1f}, {3.0f, 0.1f, 0.1f});
+    const Sphere3D sphere({2.0f, 2.0f, 0.0f}, 1.4f);
+
+    CORRADE_VERIFY(collides(box, box1));
+    CORRADE_VERIFY(!collides(box, box2));
+    CORRADE_VERIFY(collides(box, box3));
+    CORRADE_VERIFY(!collides(box, sphere));
+    CORRADE_VERIFY(collides(box1, sphere));
+}
+
+void GjkTest::collidesCapsule() {
+    const Capsule3D capsule({-1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, 0.5f);
+    const Capsule3D capsule1({0.0f, -1.0f, 0.9f}, {0.0f, 1.0f, 0.9f}, 0.5f);
+    const Capsule3D capsule2({0.0f, -1.0f, 1.1f}, {0.0f, 1.0f, 1.1f}, 0.5f);
+    const Box3D box(Matrix4::translation({2.4f, 0.0f, 0.0f}));
+
+    CORRADE_VERIFY(collides(capsule, capsule1));
+    CORRADE_VERIFY(!collides(capsule, capsule2));
+    CORRADE_VERIFY(collides(capsule, box));
+    CORRADE_VERIFY(!collides(capsule2, box));
+}
+
+void GjkTest::collidesCylinder() {
+    /* The cylinder is infinite */
+    const Cylinder3D cylinder({0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 0.5f);
+    const Box3D box(Matrix4::translation({1.4f, 100.0f, 0.0f}));
+    const Box3D box1(Matrix4::translation({1.6f, -100.0f, 0.0f}));
+    const Capsule3D capsule({-3.0f, 5.0f, 0.0f}, {3.0f, 5.0f, 0.0f}, 0.1f);
+
+    CORRADE_VERIFY(collides(cylinder, box));
+    CORRADE_VERIFY(!collides(cylinder, box1));
+    CORRADE_VERIFY(collides(cylinder, capsule));
+}
+
+void GjkTest::collidesUnsupported() {
+    /* Not possible because of numerical instability */
+    CORRADE_VERIFY(!collides(LineSegment3D({-1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}), Point3D{Vector3{}}));
+
+    /* Not convex */
+    CORRADE_VERIFY(!collides(InvertedSphere3D({}, 1.0f), Box3D{Matrix4{}}));
+
+    /* Both infinite */
+    CORRADE_VERIFY(!collides(Cylinder3D({}, Vector3::xAxis(), 1.0f), Cylinder3D({}, Vector3::yAxis(), 1.0f)));
+}
+
+void GjkTest::collisionBox() {
+    const Box3D box(Matrix4::translation({1.5f, 0.2f, 0.0f}));
+    const Box3D box1{Matrix4{}};
+
+    const Collision3D collision = Test::collision(box, box1);
+    CORRADE_VERIFY(collision);
+    CORRADE_COMPARE(collision.separationNormal(), Vector3::xAxis());
+    CORRADE_COMPARE(collision.separationDistance(), 0.5f);
+    CORRADE_COMPARE(collision.position().x(), 1.0f);
+
+    CORRADE_VERIFY(!Test::collision(box, Box3D(Matrix4::translation({-0.6f, 0.0f, 0.0f}))));
+}
+
+void GjkTest::collisionSphereInsideBox() {
+    const Sphere3D sphere({0.6f, 0.0f, 0.0f}, 0.5f);
+    const AxisAlignedBox3D box({-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f});
+
+    const Collision3D collision = Test::collision(sphere, box);
+    CORRADE_VERIFY(collision);
+    CORRADE_COMPARE(collision.separationNormal(), Vector3::xAxis());
+    CORRADE_COMPARE(collision.separationDistance(), 0.9f);
+    CORRADE_COMPARE(collision.position(), Vector3::xAxis());
+
+    /* Flipped order */
+    const Collision3D flipped = Test::collision(box, sphere);
+    CORRADE_VERIFY(flipped);
+    CORRADE_COMPARE(flipped.separationNormal(), -Vector3::xAxis());
+    CORRADE_COMPARE(flipped.separationDistance(), 0.9f);
+    CORRADE_COMPARE(flipped.position(), Vector3::xAxis(0.1f));
+}
+
+void GjkTest::collisionCapsule() {
+    const Capsule3D capsule({-1.0f, 0.0f, 0.1f}, {1.0f, 0.0f, 0.1f}, 0.2f);
+    const Capsule3D capsule1({0.0f, -1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 0.3f);
+
+    /* Only the rounded parts overlap */
+    const Collision3D collision = Test::collision(capsule, capsule1);
+    CORRADE_VERIFY(collision);
+    CORRADE_COMPARE(collision.separationNormal(), Vector3::zAxis());
+    CORRADE_COMPARE(collision.separationDistance(), 0.4f);
+    CORRADE_COMPARE(collision.position(), Vector3::zAxis(0.3f));
+}
+
+void GjkTest::collisionCapsuleCrossing() {
+    const Capsule3D capsule({-1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, 0.2f);
+    const Capsule3D capsule1({0.0f, -1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 0.3f);
+
+    /* The segments intersect, separation along the plane normal */
+    const Collision3D collision = Test::collision(capsule, capsule1);
+    CORRADE_VERIFY(collision);
+    CORRADE_COMPARE(Math::abs(collision.separationNormal()), Vector3::zAxis());
+    CORRADE_COMPARE(collision.separationDistance(), 0.5f);
+}
+
+void GjkTest::collisionCylinder() {
+    const Cylinder3D cylinder({0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 0.5f);
+    const Box3D box(Matrix4::translation({1.2f, 100.0f, 0.0f}));
+
+    const Collision3D collision = Test::collision(cylinder, box);
+    CORRADE_VERIFY(collision);
+    CORRADE_COMPARE(collision.separationNormal(), -Vector3::xAxis());
+    CORRADE_COMPARE(collision.separationDistance(), 0.3f);
+    CORRADE_COMPARE(collision.position().x(), 0.2f);
+}
+
+void GjkTest::timeOfImpactBox() {
+    const Sphere3D sphere({}, 0.5f);
+    const AxisAlignedBox3D box({-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f});
+
+    /* Both ends of the motion are outside, the sphere touches the box face
+       at x = -1.5 */
+    const Matrix4 previous = Matrix4::translation({-10.0f, -2.0f, 0.0f});
+    const Matrix4 current = Matrix4::translation({10.0f, 2.0f, 0.0f});
+    CORRADE_VERIFY(!collides(sphere.transformed(previous), box));
+    CORRADE_VERIFY(!collides(sphere.transformed(current), box));
+    CORRADE_COMPARE(timeOfImpact(sphere, previous, current, box), 0.425f);
+
+    /* Passing by */
+    CORRADE_COMPARE(timeOfImpact(sphere, Matrix4::translation({-10.0f, 1.6f, 0.0f}), Matrix4::translation({10.0f, 1.6f, 0.0f}), box), Constants::inf());
+
+    /* Moving away */
+    CORRADE_COMPARE(timeOfImpact(sphere, current, Matrix4::translation({20.0f, 4.0f, 0.0f}), box), Constants::inf());
+
+    /* Overlapping already at the beginning */
+    CORRADE_COMPARE(timeOfImpact(sphere, Matrix4::translation({1.2f, 0.0f, 0.0f}), current, box), 0.0f);
+}
+
+void GjkTest::timeOfImpactCapsule() {
+    const Capsule3D capsule({-1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, 0.25f);
+    const Box3D box{Matrix4{}};
+
+    /* Falling onto the box */
+    CORRADE_COMPARE(timeOfImpact(capsule, Matrix4::translation(Vector3::zAxis(5.0f)), Matrix4::translation(Vector3::zAxis(-5.0f)), box), 0.375f);
+
+    /* Rotating vertically while moving above the box, the lower end stays
+       above it */
+    const Capsule3D capsule1({0.0f, 0.0f, -1.0f}, {0.0f, 0.0f, 1.0f}, 0.5f);
+    CORRADE_COMPARE(timeOfImpact(capsule1, Matrix4::translation({3.0f, 0.0f, 3.0f}), Matrix4::translation({-3.0f, 0.0f, 3.0f})*Matrix4::rotationY(Deg(90.0f)), box), Constants::inf());
+}
+
+void GjkTest::timeOfImpactCylinder() {
+    /* The cylinder is infinite */
+    const Cylinder3D cylinder({0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 0.5f);
+    const Sphere3D sphere({0.0f, 30.0f, 0.0f}, 0.5f);
+
+    CORRADE_COMPARE(timeOfImpact(sphere, Matrix4::translation(Vector3::xAxis(-10.0f)), Matrix4::translation(Vector3::xAxis(10.0f)), cylinder), 0.45f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shapes::Test::GjkTest)
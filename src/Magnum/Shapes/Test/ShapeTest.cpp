@@ -25,7 +25,11 @@
 
 #include <Corrade/TestSuite/Tester.h>
 
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Capsule.h"
 #include "Magnum/Shapes/Composition.h"
+#include "Magnum/Shapes/ConvexHull.h"
+#include "Magnum/Shapes/Plane.h"
 #include "Magnum/Shapes/Point.h"
 #include "Magnum/Shapes/Shape.h"
 #include "Magnum/Shapes/ShapeGroup.h"
@@ -43,7 +47,11 @@ struct ShapeTest: TestSuite::Tester {
     void collides();
     void collision();
     void firstCollision();
+    void timeOfImpact();
+    void firstImpact();
+    void firstImpactDestruction();
     void shapeGroup();
+    void convexHull();
 };
 
 typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
@@ -56,7 +64,11 @@ ShapeTest::ShapeTest() {
               &ShapeTest::collides,
               &ShapeTest::collision,
               &ShapeTest::firstCollision,
-              &ShapeTest::shapeGroup});
+              &ShapeTest::timeOfImpact,
+              &ShapeTest::firstImpact,
+              &ShapeTest::firstImpactDestruction,
+              &ShapeTest::shapeGroup,
+              &ShapeTest::convexHull});
 }
 
 void ShapeTest::clean() {
@@ -206,6 +218,154 @@ void ShapeTest::firstCollision() {
     CORRADE_VERIFY(!shapes.isDirty());
 }
 
+void ShapeTest::timeOfImpact() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D a(&scene);
+    Shape<Shapes::Sphere3D> aShape(a, {{}, 0.5f}, &shapes);
+    a.translate({10.0f, 0.0f, 3.0f});
+
+    Object3D b(&scene);
+    Shape<Shapes::Sphere3D> bShape(b, {{0.0f, 0.0f, 3.0f}, 1.0f}, &shapes);
+    Shape<Shapes::Plane> bShape2(b, {{0.0f, 0.0f, -2.0f}, Vector3::zAxis()}, &shapes);
+    shapes.setClean();
+
+    /* The sphere passed through the other one during the motion */
+    const Matrix4 previous = Matrix4::translation({-10.0f, 0.0f, 3.0f});
+    CORRADE_VERIFY(!aShape.collides(bShape));
+    CORRADE_COMPARE(aShape.timeOfImpact(bShape, previous), 0.425f);
+    CORRADE_COMPARE(aShape.timeOfImpact(bShape2, previous), Constants::inf());
+
+    /* Capsule falling through the plane */
+    Object3D c(&scene);
+    Shape<Shapes::Capsule3D> cShape(c, {{-1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, 0.25f}, &shapes);
+    c.translate(Vector3::zAxis(-12.0f));
+    shapes.setClean();
+    CORRADE_COMPARE(cShape.timeOfImpact(bShape2, Matrix4::translation(Vector3::zAxis(8.0f))), 0.4875f);
+}
+
+void ShapeTest::firstImpact() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D a(&scene);
+    Shape<Shapes::Sphere3D> aShape(a, {{}, 0.5f}, &shapes);
+    a.translate(Vector3::xAxis(10.0f));
+
+    /* Two boxes on the way and a point far away */
+    Object3D b(&scene);
+    Shape<Shapes::AxisAlignedBox3D> bShape(b, {Vector3(-1.0f), Vector3(1.0f)}, &shapes);
+    b.translate(Vector3::xAxis(4.0f));
+
+    Object3D c(&scene);
+    Shape<Shapes::AxisAlignedBox3D> cShape(c, {Vector3(-1.0f), Vector3(1.0f)}, &shapes);
+    c.translate(Vector3::xAxis(-4.0f));
+
+    Object3D d(&scene);
+    Shape<Shapes::Point3D> dShape(d, {{0.0f, 50.0f, 0.0f}}, &shapes);
+
+    /* The nearer box is hit first */
+    std::pair<AbstractShape3D*, Float> impact = shapes.firstImpact(aShape, Matrix4::translation(Vector3::xAxis(-10.0f)));
+    CORRADE_VERIFY(impact.first == &cShape);
+    CORRADE_COMPARE(impact.second, 0.225f);
+    CORRADE_VERIFY(!shapes.isDirty());
+
+    /* Moving back hits the other one */
+    a.resetTransformation().translate(Vector3::xAxis(-10.0f));
+    impact = shapes.firstImpact(aShape, Matrix4::translation(Vector3::xAxis(10.0f)));
+    CORRADE_VERIFY(impact.first == &bShape);
+    CORRADE_COMPARE(impact.second, 0.225f);
+
+    /* Moving the boxes away updates their bounds, no impact */
+    b.translate(Vector3::yAxis(5.0f));
+    c.translate(Vector3::yAxis(5.0f));
+    impact = shapes.firstImpact(aShape, Matrix4::translation(Vector3::xAxis(10.0f)));
+    CORRADE_VERIFY(!impact.first);
+    CORRADE_COMPARE(impact.second, Constants::inf());
+
+    /* Moving one back is reflected as well */
+    c.translate(Vector3::yAxis(-5.0f));
+    impact = shapes.firstImpact(aShape, Matrix4::translation(Vector3::xAxis(10.0f)));
+    CORRADE_VERIFY(impact.first == &cShape);
+    CORRADE_COMPARE(impact.second, 0.625f);
+
+    /* Changing the shape updates its bounds too, without leaving the
+       object dirty */
+    cShape.setShape({Vector3(-0.25f), Vector3(0.25f)});
+    impact = shapes.firstImpact(aShape, Matrix4::translation(Vector3::xAxis(10.0f)));
+    CORRADE_VERIFY(impact.first == &cShape);
+    CORRADE_COMPARE(impact.second, 0.6625f);
+    CORRADE_VERIFY(!c.isDirty());
+    CORRADE_VERIFY(!shapes.isDirty());
+
+    /* Unbounded shapes are tested always */
+    Object3D e(&scene);
+    Shape<Shapes::Plane> eShape(e, {{}, Vector3::xAxis()}, &shapes);
+    impact = shapes.firstImpact(aShape, Matrix4::translation(Vector3::xAxis(10.0f)));
+    CORRADE_VERIFY(impact.first == &eShape);
+    CORRADE_COMPARE(impact.second, 0.475f);
+
+    /* Removed shapes are not tested anymore */
+    shapes.remove(eShape);
+    impact = shapes.firstImpact(aShape, Matrix4::translation(Vector3::xAxis(10.0f)));
+    CORRADE_VERIFY(impact.first == &cShape);
+    CORRADE_COMPARE(impact.second, 0.6625f);
+
+    shapes.remove(cShape);
+    impact = shapes.firstImpact(aShape, Matrix4::translation(Vector3::xAxis(10.0f)));
+    CORRADE_VERIFY(!impact.first);
+
+    /* Added back */
+    shapes.add(cShape);
+    impact = shapes.firstImpact(aShape, Matrix4::translation(Vector3::xAxis(10.0f)));
+    CORRADE_VERIFY(impact.first == &cShape);
+    CORRADE_COMPARE(impact.second, 0.6625f);
+}
+
+void ShapeTest::firstImpactDestruction() {
+    Scene3D scene;
+
+    Object3D a(&scene);
+    Shape<Shapes::Sphere3D> aShape(a, {{}, 0.5f});
+    a.translate(Vector3::xAxis(10.0f));
+
+    Object3D b(&scene);
+    Shape<Shapes::Sphere3D> bShape(b, {{}, 1.0f});
+    b.translate(Vector3::xAxis(8.0f));
+
+    {
+        /* Group destroyed before the shapes deletes the bounds */
+        ShapeGroup3D shapes;
+        shapes.add(aShape).add(bShape);
+        CORRADE_VERIFY(shapes.firstImpact(aShape, {}).first == &bShape);
+    }
+
+    CORRADE_VERIFY(!bShape.group());
+
+    /* The shapes can be then added to another group */
+    ShapeGroup3D shapes;
+    shapes.add(aShape).add(bShape);
+    std::pair<AbstractShape3D*, Float> impact = shapes.firstImpact(aShape, {});
+    CORRADE_VERIFY(impact.first == &bShape);
+    CORRADE_COMPARE(impact.second, 0.65f);
+
+    {
+        /* Object destroyed together with its shape and bounds */
+        Object3D c(&scene);
+        auto cShape = new Shape<Shapes::Sphere3D>(c, {{}, 1.0f}, &shapes);
+        c.translate(Vector3::xAxis(5.0f));
+        impact = shapes.firstImpact(aShape, {});
+        CORRADE_VERIFY(impact.first == cShape);
+        CORRADE_COMPARE(impact.second, 0.35f);
+    }
+
+    CORRADE_COMPARE(shapes.size(), 2);
+    impact = shapes.firstImpact(aShape, {});
+    CORRADE_VERIFY(impact.first == &bShape);
+    CORRADE_COMPARE(impact.second, 0.65f);
+}
+
 void ShapeTest::shapeGroup() {
     Scene2D scene;
     ShapeGroup2D shapes;
@@ -222,6 +382,29 @@ void ShapeTest::shapeGroup() {
     CORRADE_COMPARE(point.position(), Vector2(5.25f, -1.0f));
 }
 
+void ShapeTest::convexHull() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    const Vector3 points[]{{-1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f},
+                           {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
+    Object3D a(&scene);
+    auto shape = new Shape<Shapes::ConvexHull>(a, Shapes::convexHull(points), &shapes);
+    const Vector3* data = shape->transformedShape().vertices().data();
+
+    Object3D b(&scene);
+    Shape<Shapes::Sphere3D> bShape(b, {{5.0f, 0.25f, 0.25f}, 0.5f}, &shapes);
+    shapes.setClean();
+    CORRADE_VERIFY(!shape->collides(bShape));
+
+    /* Only the transformation is updated, the data are not copied */
+    a.translate(Vector3::xAxis(5.0f));
+    shapes.setClean();
+    CORRADE_COMPARE(shape->transformedShape().transformation(), Matrix4::translation(Vector3::xAxis(5.0f)));
+    CORRADE_VERIFY(shape->transformedShape().vertices().data() == data);
+    CORRADE_VERIFY(shape->collides(bShape));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shapes::Test::ShapeTest)
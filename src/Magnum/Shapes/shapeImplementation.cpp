@@ -61,6 +61,7 @@ Debug operator<<(Debug debug, ShapeDimensionTraits<3>::Type value) {
         _val(AxisAlignedBox)
         _val(Box)
         _val(Plane)
+        _val(ConvexHull)
         _val(Composition)
         #undef _val
     }
@@ -83,7 +83,8 @@ template<> struct ShapeDimensionTraits<3> {
         AxisAlignedBox = 17,
         Box = 19,
         Plane = 23,
-        Composition = 29
+        ConvexHull = 29,
+        Composition = 31
     };
 };
 
@@ -144,6 +145,11 @@ template<> struct TypeOf<Shapes::Plane> {
         return ShapeDimensionTraits<3>::Type::Plane;
     }
 };
+template<> struct TypeOf<Shapes::ConvexHull> {
+    constexpr static ShapeDimensionTraits<3>::Type type() {
+        return ShapeDimensionTraits<3>::Type::ConvexHull;
+    }
+};
 template<UnsignedInt dimensions> struct TypeOf<Shapes::Composition<dimensions>> {
     constexpr static typename ShapeDimensionTraits<dimensions>::Type type() {
         return ShapeDimensionTraits<dimensions>::Type::Composition;
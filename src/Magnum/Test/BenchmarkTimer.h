@@ -0,0 +1,66 @@
+#ifndef Magnum_Test_BenchmarkTimer_h
+#define Magnum_Test_BenchmarkTimer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+
+#include "Magnum/Types.h"
+
+namespace Magnum { namespace Test {
+
+/* Accumulates wall-clock time spent between start() and stop() calls and
+   reports it averaged over given iteration count. Calling start() and stop()
+   repeatedly sums the intervals, which allows measuring just a part of each
+   iteration. */
+class BenchmarkTimer {
+    public:
+        explicit BenchmarkTimer(std::size_t iterations): _iterations{iterations}, _duration{} {}
+
+        void start() { _begin = Clock::now(); }
+
+        void stop() { _duration += Clock::now() - _begin; }
+
+        /* Average duration of one iteration in milliseconds */
+        Double milliseconds() const {
+            return std::chrono::duration<Double, std::milli>(_duration).count()/_iterations;
+        }
+
+        /* Average duration of one iteration in microseconds */
+        Double microseconds() const {
+            return std::chrono::duration<Double, std::micro>(_duration).count()/_iterations;
+        }
+
+    private:
+        typedef std::chrono::high_resolution_clock Clock;
+
+        std::size_t _iterations;
+        Clock::duration _duration;
+        Clock::time_point _begin;
+};
+
+}}
+
+#endif